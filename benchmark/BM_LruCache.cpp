@@ -29,10 +29,72 @@
 
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include <nfx/cache/CompactLruCache.h>
 #include <nfx/cache/LruCache.h>
+#include <nfx/cache/ShardedLruCache.h>
+
+//=====================================================================
+// Heap allocation counting
+//=====================================================================
+
+namespace
+{
+	/** @brief Number of calls to the replaceable global operator new */
+	std::atomic<std::uint64_t> g_allocationCount{ 0 };
+
+	/** @brief Bytes currently allocated through the replaceable global operator new */
+	std::atomic<std::int64_t> g_liveBytes{ 0 };
+
+	/** @brief Header in front of every block, recording its requested size */
+	constexpr std::size_t ALLOCATION_HEADER{ alignof( std::max_align_t ) };
+} // namespace
+
+void* operator new( std::size_t size )
+{
+	g_allocationCount.fetch_add( 1, std::memory_order_relaxed );
+
+	if ( auto* block{ static_cast<std::byte*>( std::malloc( ALLOCATION_HEADER + size ) ) } )
+	{
+		*reinterpret_cast<std::size_t*>( block ) = size;
+		g_liveBytes.fetch_add( static_cast<std::int64_t>( size ), std::memory_order_relaxed );
+
+		return block + ALLOCATION_HEADER;
+	}
+
+	throw std::bad_alloc{};
+}
+
+void operator delete( void* ptr ) noexcept
+{
+	if ( ptr == nullptr )
+	{
+		return;
+	}
+
+	std::byte* block{ static_cast<std::byte*>( ptr ) - ALLOCATION_HEADER };
+	g_liveBytes.fetch_sub( static_cast<std::int64_t>( *reinterpret_cast<std::size_t*>( block ) ), std::memory_order_relaxed );
+	std::free( block );
+}
+
+void operator delete( void* ptr, std::size_t ) noexcept
+{
+	operator delete( ptr );
+}
 
 namespace nfx::cache::benchmark
 {
@@ -116,6 +178,86 @@ namespace nfx::cache::benchmark
 		state.SetItemsProcessed( state.iterations() );
 	}
 
+	//----------------------------------------------
+	// Cache operations - callables
+	//----------------------------------------------
+
+	/** @brief Number of distinct keys cycled through by the callable benchmarks */
+	static constexpr int CALLABLE_KEY_COUNT{ 1024 };
+
+	/** @brief Request context whose fields the factories capture, as a handler building values would */
+	struct FactoryContext
+	{
+		std::string prefix{ "value_" };
+		std::int64_t tenant{ 7 };
+	};
+
+	/**
+	 * @brief get() with a capturing factory, passed either through std::function or as a template callable
+	 * @details The lambda captures four words, more than std::function stores inline, so wrapping it
+	 *          allocates on every call whether the lookup hits or not.
+	 */
+	static void runGetCallable( ::benchmark::State& state, bool hit, bool typeErased )
+	{
+		using Cache = LruCache<int, std::string>;
+
+		Cache cache{ LruCacheOptions{ CALLABLE_KEY_COUNT } };
+		FactoryContext context;
+		int next{ 0 };
+
+		for ( int key{ 0 }; key < CALLABLE_KEY_COUNT; ++key, ++next )
+		{
+			cache.get( key, [&context, key]() { return context.prefix + std::to_string( key ); } );
+		}
+
+		const std::uint64_t allocationsBefore{ g_allocationCount.load( std::memory_order_relaxed ) };
+
+		for ( auto _ : state )
+		{
+			const int key{ hit ? next % CALLABLE_KEY_COUNT : next };
+			auto factory = [prefix = std::string_view{ context.prefix }, tenant = context.tenant, key]() {
+				return std::string{ prefix } + std::to_string( key + tenant );
+			};
+
+			std::string* value;
+			if ( typeErased )
+			{
+				value = cache.get( key, Cache::FactoryFunction{ factory } );
+			}
+			else
+			{
+				value = cache.get( key, factory );
+			}
+			::benchmark::DoNotOptimize( value );
+			++next;
+		}
+
+		const std::uint64_t allocations{ g_allocationCount.load( std::memory_order_relaxed ) - allocationsBefore };
+
+		state.counters["allocs_per_op"] = ::benchmark::Counter( static_cast<double>( allocations ), ::benchmark::Counter::kAvgIterations );
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	static void BM_LruCache_Get_Hit_StdFunction( ::benchmark::State& state )
+	{
+		runGetCallable( state, true, true );
+	}
+
+	static void BM_LruCache_Get_Hit_Template( ::benchmark::State& state )
+	{
+		runGetCallable( state, true, false );
+	}
+
+	static void BM_LruCache_Get_Miss_StdFunction( ::benchmark::State& state )
+	{
+		runGetCallable( state, false, true );
+	}
+
+	static void BM_LruCache_Get_Miss_Template( ::benchmark::State& state )
+	{
+		runGetCallable( state, false, false );
+	}
+
 	//----------------------------------------------
 	// Lookup - find
 	//----------------------------------------------
@@ -161,6 +303,196 @@ namespace nfx::cache::benchmark
 		state.SetItemsProcessed( state.iterations() );
 	}
 
+	//----------------------------------------------
+	// Lookup - index comparison
+	//----------------------------------------------
+
+	/** @brief Distance between consecutive lookup keys, so successive lookups land far apart in the index */
+	static constexpr int INDEX_LOOKUP_STRIDE{ 104729 };
+
+	template <typename TIndex>
+	using IndexBenchmarkCache = LruCache<int, int, std::hash<int>, std::equal_to<int>, TIndex>;
+
+	/** @brief Cache holding keys [0, entries), kept across benchmark invocations since large sizes are slow to populate */
+	template <typename TIndex>
+	static IndexBenchmarkCache<TIndex>& indexBenchmarkCache( int entries )
+	{
+		static std::unique_ptr<IndexBenchmarkCache<TIndex>> cache;
+		static int populatedEntries{ 0 };
+
+		if ( !cache || populatedEntries != entries )
+		{
+			cache.reset();
+			cache = std::make_unique<IndexBenchmarkCache<TIndex>>( LruCacheOptions{ static_cast<std::size_t>( entries ) } );
+
+			for ( int i{ 0 }; i < entries; ++i )
+			{
+				cache->get( i, [i]() { return i; } );
+			}
+
+			populatedEntries = entries;
+		}
+
+		return *cache;
+	}
+
+	template <typename TIndex>
+	static void runIndexLookup( ::benchmark::State& state, bool hit )
+	{
+		const auto entries{ static_cast<int>( state.range( 0 ) ) };
+		auto& cache{ indexBenchmarkCache<TIndex>( entries ) };
+
+		// Misses look up keys just above the populated range
+		const int offset{ hit ? 0 : entries };
+		std::int64_t index{ 0 };
+
+		for ( auto _ : state )
+		{
+			auto* result = cache.find( offset + static_cast<int>( index ) );
+			::benchmark::DoNotOptimize( result );
+			index = ( index + INDEX_LOOKUP_STRIDE ) % entries;
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	static void BM_LruCache_Find_Hit_NodeIndex( ::benchmark::State& state )
+	{
+		runIndexLookup<NodeIndex>( state, true );
+	}
+
+	static void BM_LruCache_Find_Hit_FlatIndex( ::benchmark::State& state )
+	{
+		runIndexLookup<FlatIndex>( state, true );
+	}
+
+	static void BM_LruCache_Find_Miss_NodeIndex( ::benchmark::State& state )
+	{
+		runIndexLookup<NodeIndex>( state, false );
+	}
+
+	static void BM_LruCache_Find_Miss_FlatIndex( ::benchmark::State& state )
+	{
+		runIndexLookup<FlatIndex>( state, false );
+	}
+
+	//----------------------------------------------
+	// Lookup - batches
+	//----------------------------------------------
+
+	/** @brief Number of keys per batch, the size of a typical multi-key RPC */
+	static constexpr std::size_t LOOKUP_BATCH_SIZE{ 100 };
+
+	/** @brief Look up a batch of hits spread over the index, either key by key or with findMany() */
+	template <typename TIndex>
+	static void runBatchLookup( ::benchmark::State& state, bool batched )
+	{
+		const auto entries{ static_cast<int>( state.range( 0 ) ) };
+		auto& cache{ indexBenchmarkCache<TIndex>( entries ) };
+
+		std::vector<int> keys( LOOKUP_BATCH_SIZE );
+		std::vector<int*> results( LOOKUP_BATCH_SIZE );
+		std::int64_t index{ 0 };
+
+		for ( auto _ : state )
+		{
+			for ( auto& key : keys )
+			{
+				key = static_cast<int>( index );
+				index = ( index + INDEX_LOOKUP_STRIDE ) % entries;
+			}
+
+			if ( batched )
+			{
+				::benchmark::DoNotOptimize( cache.findMany( keys, results ) );
+			}
+			else
+			{
+				for ( std::size_t i{ 0 }; i < keys.size(); ++i )
+				{
+					results[i] = cache.find( keys[i] );
+				}
+			}
+
+			::benchmark::DoNotOptimize( results.data() );
+		}
+
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( LOOKUP_BATCH_SIZE ) );
+	}
+
+	static void BM_LruCache_FindBatch_Loop_NodeIndex( ::benchmark::State& state )
+	{
+		runBatchLookup<NodeIndex>( state, false );
+	}
+
+	static void BM_LruCache_FindBatch_FindMany_NodeIndex( ::benchmark::State& state )
+	{
+		runBatchLookup<NodeIndex>( state, true );
+	}
+
+	static void BM_LruCache_FindBatch_Loop_FlatIndex( ::benchmark::State& state )
+	{
+		runBatchLookup<FlatIndex>( state, false );
+	}
+
+	static void BM_LruCache_FindBatch_FindMany_FlatIndex( ::benchmark::State& state )
+	{
+		runBatchLookup<FlatIndex>( state, true );
+	}
+
+	//----------------------------------------------
+	// Lookup - clock comparison
+	//----------------------------------------------
+
+	/** @brief Hit path of get() (lookup, expiration check, renewal, cleanup check) with a given time source */
+	template <typename TClock>
+	static void BM_LruCache_Get_Hit_Clock( ::benchmark::State& state )
+	{
+		LruCache<int, int, std::hash<int>, std::equal_to<int>, NodeIndex, LruPolicy, TClock> cache{ LruCacheOptions{ 0, std::chrono::minutes( 10 ), std::chrono::minutes( 1 ) } };
+
+		for ( int i = 0; i < 1000; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		int key{ 0 };
+		for ( auto _ : state )
+		{
+			auto* result = cache.get( key % 1000, []() { return -1; } );
+			::benchmark::DoNotOptimize( result );
+			key++;
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	//----------------------------------------------
+	// Lookup - statistics overhead
+	//----------------------------------------------
+
+	/** @brief Hit path of get() with statistics disabled (NoStats) or counted (StripedStats) */
+	template <typename TStats>
+	static void BM_LruCache_Get_Hit_Stats( ::benchmark::State& state )
+	{
+		LruCache<int, int, std::hash<int>, std::equal_to<int>, NodeIndex, LruPolicy, SteadyClock, TStats> cache;
+
+		for ( int i = 0; i < 1000; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		int key{ 0 };
+		for ( auto _ : state )
+		{
+			auto* result = cache.get( key % 1000, []() { return -1; } );
+			::benchmark::DoNotOptimize( result );
+			key++;
+		}
+
+		state.counters["hit_ratio"] = cache.stats().hitRatio();
+		state.SetItemsProcessed( state.iterations() );
+	}
+
 	//----------------------------------------------
 	// Modification operations
 	//----------------------------------------------
@@ -319,6 +651,67 @@ namespace nfx::cache::benchmark
 		state.SetItemsProcessed( state.iterations() * numExpiredEntries );
 	}
 
+	static void BM_LruCache_CleanupExpired_LargeLiveSet( ::benchmark::State& state )
+	{
+		const int numLiveEntries = static_cast<int>( state.range( 0 ) );
+		const int numExpiredEntries = 10;
+		LruCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::hours( 1 ) } };
+
+		for ( int i = 0; i < numLiveEntries; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		int key{ numLiveEntries };
+		for ( auto _ : state )
+		{
+			state.PauseTiming();
+			for ( int i = 0; i < numExpiredEntries; ++i, ++key )
+			{
+				cache.get( key, [key]() { return key; }, []( CacheEntry& entry ) { entry.slidingExpiration = std::chrono::milliseconds( 0 ); } );
+			}
+			state.ResumeTiming();
+
+			// Only the handful of expired entries should be visited, not the live set
+			cache.cleanupExpired();
+		}
+
+		state.SetItemsProcessed( state.iterations() * numExpiredEntries );
+	}
+
+	/**
+	 * @brief Logging-style churn: every operation inserts a unique key that expires 1 ms later
+	 * @details Time is driven by ManualClock, 10 us per operation, with a cleanup cycle due every
+	 *          millisecond, so about 100 entries expire per cycle. Reports the expired entries
+	 *          still held at the end (backlog) next to the per-operation latency.
+	 */
+	static void runExpiredChurn( ::benchmark::State& state, const LruCacheOptions& options )
+	{
+		using Cache = LruCache<int, int, std::hash<int>, std::equal_to<int>, NodeIndex, LruPolicy, ManualClock>;
+		Cache cache{ options };
+
+		int key{ 0 };
+		for ( auto _ : state )
+		{
+			cache.get( key, [key]() { return key; } );
+			++key;
+			ManualClock::advance( std::chrono::microseconds( 10 ) );
+		}
+
+		// About 100 entries are still live at any time
+		state.counters["expired_backlog"] = static_cast<double>( cache.size() ) - std::min( 100.0, static_cast<double>( key ) );
+	}
+
+	static void BM_LruCache_ExpiredChurn_FixedBudget( ::benchmark::State& state )
+	{
+		runExpiredChurn( state, LruCacheOptions{ 0, std::chrono::milliseconds( 1 ), std::chrono::milliseconds( 1 ) } );
+	}
+
+	static void BM_LruCache_ExpiredChurn_AdaptiveBudget( ::benchmark::State& state )
+	{
+		runExpiredChurn( state, LruCacheOptions{ 0, std::chrono::milliseconds( 1 ), std::chrono::milliseconds( 1 ) }.setAdaptiveCleanup( true ) );
+	}
+
 	//----------------------------------------------
 	// Complex value types
 	//----------------------------------------------
@@ -417,65 +810,697 @@ namespace nfx::cache::benchmark
 		state.SetItemsProcessed( state.iterations() );
 	}
 
-	//=====================================================================
-	// Benchmarks registration
-	//=====================================================================
-
 	//----------------------------------------------
-	// Construction
+	// Allocation churn
 	//----------------------------------------------
 
-	BENCHMARK( BM_LruCache_Construction_Default );
-	BENCHMARK( BM_LruCache_Construction_WithOptions );
-
-	//----------------------------------------------
-	// Cache operations - get
-	//----------------------------------------------
+	/** @brief Cache full at its size limit where every get() misses, evicting one entry and inserting another */
+	static void runChurnWorkload( ::benchmark::State& state, const LruCacheOptions& options )
+	{
+		LruCache<int, int> cache{ options };
+		int next{ 0 };
 
-	BENCHMARK( BM_LruCache_Get_NewEntry );
-	BENCHMARK( BM_LruCache_Get_ExistingEntry );
-	BENCHMARK( BM_LruCache_Get_WithConfig );
+		// Fill to capacity and churn once so the steady state is measured
+		for ( std::size_t i{ 0 }; i < 2 * options.sizeLimit(); ++i, ++next )
+		{
+			cache.get( next, [next]() { return next; } );
+		}
 
-	//----------------------------------------------
-	// Lookup - find
-	//----------------------------------------------
+		const std::uint64_t allocationsBefore{ g_allocationCount.load( std::memory_order_relaxed ) };
 
-	BENCHMARK( BM_LruCache_Find_Hit );
-	BENCHMARK( BM_LruCache_Find_Miss );
+		for ( auto _ : state )
+		{
+			auto* value = cache.get( next, [next]() { return next; } );
+			::benchmark::DoNotOptimize( value );
+			++next;
+		}
 
-	//----------------------------------------------
-	// Modification operations
-	//----------------------------------------------
+		const std::uint64_t allocations{ g_allocationCount.load( std::memory_order_relaxed ) - allocationsBefore };
 
-	BENCHMARK( BM_LruCache_Remove );
-	BENCHMARK( BM_LruCache_Clear )
-		->Arg( 10 )
-		->Arg( 100 )
-		->Arg( 1000 )
-		->Arg( 10000 );
+		state.counters["allocs_per_op"] = ::benchmark::Counter( static_cast<double>( allocations ), ::benchmark::Counter::kAvgIterations );
+		state.SetItemsProcessed( state.iterations() );
+	}
 
-	//----------------------------------------------
-	// State inspection
-	//----------------------------------------------
+	static void BM_LruCache_Churn_HeapNodes( ::benchmark::State& state )
+	{
+		runChurnWorkload( state, LruCacheOptions{ 10000 } );
+	}
 
-	BENCHMARK( BM_LruCache_Size );
-	BENCHMARK( BM_LruCache_IsEmpty );
+	static void BM_LruCache_Churn_SlabNodes( ::benchmark::State& state )
+	{
+		runChurnWorkload( state, LruCacheOptions{ 10000 }.setSlabStorage( true ) );
+	}
 
 	//----------------------------------------------
-	// LRU eviction
+	// Memory footprint
 	//----------------------------------------------
 
-	BENCHMARK( BM_LruCache_LRU_Eviction );
-	BENCHMARK( BM_LruCache_LRU_Access_Pattern );
+	/** @brief 16-byte value, so an entry carries 24 bytes of key and value payload */
+	struct SmallValue
+	{
+		std::uint64_t first;
+		std::uint64_t second;
+	};
+
+	/**
+	 * @brief Fill a cache to state.range( 0 ) entries and report heap bytes per entry
+	 * @details overhead_per_entry is everything beyond the 8-byte key and 16-byte value:
+	 *          entry metadata, index buckets, node headers and allocation padding.
+	 */
+	template <typename TCache>
+	static void runMemoryFootprint( ::benchmark::State& state, const LruCacheOptions& options )
+	{
+		const auto entries{ static_cast<std::uint64_t>( state.range( 0 ) ) };
+		double bytesPerEntry{ 0.0 };
 
-	//----------------------------------------------
-	// Expiration
-	//----------------------------------------------
+		for ( auto _ : state )
+		{
+			const std::int64_t bytesBefore{ g_liveBytes.load( std::memory_order_relaxed ) };
+			{
+				TCache cache{ options };
+				for ( std::uint64_t key{ 0 }; key < entries; ++key )
+				{
+					cache.get( key, [key]() { return SmallValue{ key, key }; } );
+				}
+
+				bytesPerEntry = static_cast<double>( g_liveBytes.load( std::memory_order_relaxed ) - bytesBefore ) / static_cast<double>( entries );
+				::benchmark::DoNotOptimize( cache );
+			}
+		}
+
+		state.counters["bytes_per_entry"] = bytesPerEntry;
+		state.counters["overhead_per_entry"] = bytesPerEntry - static_cast<double>( sizeof( std::uint64_t ) + sizeof( SmallValue ) );
+	}
+
+	static void BM_LruCache_Memory_NodeIndex( ::benchmark::State& state )
+	{
+		runMemoryFootprint<LruCache<std::uint64_t, SmallValue>>( state, LruCacheOptions{ static_cast<std::size_t>( state.range( 0 ) ) } );
+	}
+
+	static void BM_LruCache_Memory_FlatIndex( ::benchmark::State& state )
+	{
+		using Cache = LruCache<std::uint64_t, SmallValue, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>, FlatIndex>;
+
+		runMemoryFootprint<Cache>( state, LruCacheOptions{ static_cast<std::size_t>( state.range( 0 ) ) } );
+	}
+
+	static void BM_CompactLruCache_Memory( ::benchmark::State& state )
+	{
+		runMemoryFootprint<CompactLruCache<std::uint64_t, SmallValue>>( state, LruCacheOptions{ static_cast<std::size_t>( state.range( 0 ) ) } );
+	}
+
+	//----------------------------------------------
+	// Hit ratio - eviction policies
+	//----------------------------------------------
+
+	/** @brief Number of distinct keys in the hit ratio traces */
+	static constexpr int TRACE_KEY_SPACE{ 100000 };
+
+	/** @brief Number of requests in the hit ratio traces */
+	static constexpr std::size_t TRACE_LENGTH{ 1000000 };
+
+	/**
+	 * @brief Build a deterministic request trace following a Zipf distribution (s = 0.99)
+	 * @param scanLength Length of a one-off sequential scan injected every 50000 requests (0 = none)
+	 */
+	static std::vector<int> buildHitRatioTrace( int scanLength )
+	{
+		std::vector<double> cumulative( TRACE_KEY_SPACE );
+		double total{ 0.0 };
+		for ( int rank = 0; rank < TRACE_KEY_SPACE; ++rank )
+		{
+			total += 1.0 / std::pow( rank + 1, 0.99 );
+			cumulative[rank] = total;
+		}
+
+		std::vector<int> trace;
+		trace.reserve( TRACE_LENGTH );
+		std::uint64_t seed{ 0x2545F4914F6CDD1Dull };
+		int nextScanKey{ TRACE_KEY_SPACE };
+
+		while ( trace.size() < TRACE_LENGTH )
+		{
+			if ( scanLength > 0 && trace.size() % 50000 == 0 )
+			{
+				// Keys outside the Zipf key space are requested exactly once
+				for ( int i = 0; i < scanLength; ++i )
+				{
+					trace.push_back( nextScanKey++ );
+				}
+			}
+
+			seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+			const double target{ static_cast<double>( seed >> 11 ) / static_cast<double>( 1ull << 53 ) * total };
+			const auto rank{ std::lower_bound( cumulative.begin(), cumulative.end(), target ) - cumulative.begin() };
+
+			// Scatter ranks so popular keys are not adjacent integers
+			trace.push_back( static_cast<int>( ( static_cast<std::uint64_t>( rank ) * 7919 ) % TRACE_KEY_SPACE ) );
+		}
+
+		return trace;
+	}
+
+	/** @brief Replay a trace against a cache of size state.range( 0 ) and report the hit ratio */
+	template <typename TPolicy>
+	static void runHitRatio( ::benchmark::State& state, const std::vector<int>& trace )
+	{
+		std::size_t hits{ 0 };
+		std::size_t requests{ 0 };
+
+		for ( auto _ : state )
+		{
+			LruCache<int, int, std::hash<int>, std::equal_to<int>, NodeIndex, TPolicy> cache{ LruCacheOptions{ static_cast<std::size_t>( state.range( 0 ) ) } };
+
+			for ( int key : trace )
+			{
+				bool loaded{ false };
+				auto* value = cache.get( key, [key, &loaded]() { loaded = true; return key; } );
+				::benchmark::DoNotOptimize( value );
+				hits += loaded ? 0 : 1;
+			}
+			requests += trace.size();
+		}
+
+		state.counters["hit_ratio"] = static_cast<double>( hits ) / static_cast<double>( requests );
+		state.SetItemsProcessed( static_cast<std::int64_t>( requests ) );
+	}
+
+	template <typename TPolicy>
+	static void BM_LruCache_HitRatio_Zipf( ::benchmark::State& state )
+	{
+		static const std::vector<int> trace{ buildHitRatioTrace( 0 ) };
+
+		runHitRatio<TPolicy>( state, trace );
+	}
+
+	template <typename TPolicy>
+	static void BM_LruCache_HitRatio_ZipfWithScans( ::benchmark::State& state )
+	{
+		static const std::vector<int> trace{ buildHitRatioTrace( 5000 ) };
+
+		runHitRatio<TPolicy>( state, trace );
+	}
+
+	//----------------------------------------------
+	// Multi-threaded scaling
+	//----------------------------------------------
+
+	/** @brief Number of distinct keys shared by all threads in multi-threaded benchmarks */
+	static constexpr int MULTI_THREADED_KEY_SPACE{ 10000 };
+
+	template <typename TCache>
+	static bool populateMultiThreadedCache( TCache& cache )
+	{
+		for ( int i = 0; i < MULTI_THREADED_KEY_SPACE; ++i )
+		{
+			cache.get( i, [i]() { return std::string{ "value_" + std::to_string( i ) }; } );
+		}
+
+		return true;
+	}
+
+	template <typename TCache>
+	static void runMultiThreadedWorkload( ::benchmark::State& state, TCache& cache, int writePercent )
+	{
+		// Per-thread LCG so threads do not walk the key space in lockstep
+		std::uint32_t seed{ static_cast<std::uint32_t>( state.thread_index() + 1 ) * 2654435761u };
+
+		for ( auto _ : state )
+		{
+			seed = seed * 1664525u + 1013904223u;
+			const int key{ static_cast<int>( ( seed >> 8 ) % MULTI_THREADED_KEY_SPACE ) };
+
+			if ( static_cast<int>( seed % 100 ) < writePercent )
+			{
+				bool removed = cache.remove( key );
+				auto* value = cache.get( key, [key]() { return std::string{ "value_" + std::to_string( key ) }; } );
+				::benchmark::DoNotOptimize( removed );
+				::benchmark::DoNotOptimize( value );
+			}
+			else
+			{
+				auto* value = cache.find( key );
+				::benchmark::DoNotOptimize( value );
+			}
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	static void BM_LruCache_MultiThreaded_FindHit( ::benchmark::State& state )
+	{
+		static LruCache<int, std::string> cache{ LruCacheOptions{ MULTI_THREADED_KEY_SPACE } };
+		[[maybe_unused]] static const bool populated{ populateMultiThreadedCache( cache ) };
+
+		runMultiThreadedWorkload( state, cache, 0 );
+	}
+
+	static void BM_ShardedLruCache_MultiThreaded_FindHit( ::benchmark::State& state )
+	{
+		static ShardedLruCache<int, std::string> cache{ LruCacheOptions{ MULTI_THREADED_KEY_SPACE } };
+		[[maybe_unused]] static const bool populated{ populateMultiThreadedCache( cache ) };
+
+		runMultiThreadedWorkload( state, cache, 0 );
+	}
+
+	static void BM_LruCache_MultiThreaded_Mixed( ::benchmark::State& state )
+	{
+		static LruCache<int, std::string> cache{ LruCacheOptions{ MULTI_THREADED_KEY_SPACE } };
+		[[maybe_unused]] static const bool populated{ populateMultiThreadedCache( cache ) };
+
+		runMultiThreadedWorkload( state, cache, 10 );
+	}
+
+	static void BM_ShardedLruCache_MultiThreaded_Mixed( ::benchmark::State& state )
+	{
+		static ShardedLruCache<int, std::string> cache{ LruCacheOptions{ MULTI_THREADED_KEY_SPACE } };
+		[[maybe_unused]] static const bool populated{ populateMultiThreadedCache( cache ) };
+
+		runMultiThreadedWorkload( state, cache, 10 );
+	}
+
+	static void BM_LruCache_ReadHeavy_Exclusive( ::benchmark::State& state )
+	{
+		static LruCache<int, std::string> cache{ LruCacheOptions{ MULTI_THREADED_KEY_SPACE } };
+		[[maybe_unused]] static const bool populated{ populateMultiThreadedCache( cache ) };
+
+		runMultiThreadedWorkload( state, cache, 3 );
+	}
+
+	static void BM_LruCache_ReadHeavy_ReadOptimized( ::benchmark::State& state )
+	{
+		static LruCache<int, std::string> cache{ LruCacheOptions{ MULTI_THREADED_KEY_SPACE }.setReadOptimized( true ) };
+		[[maybe_unused]] static const bool populated{ populateMultiThreadedCache( cache ) };
+
+		runMultiThreadedWorkload( state, cache, 3 );
+	}
+
+	static void BM_LruCache_FindHit_SlidingExpiration( ::benchmark::State& state )
+	{
+		static LruCache<int, std::string> cache{ LruCacheOptions{ MULTI_THREADED_KEY_SPACE }.setReadOptimized( true ) };
+		[[maybe_unused]] static const bool populated{ populateMultiThreadedCache( cache ) };
+
+		runMultiThreadedWorkload( state, cache, 0 );
+	}
+
+	static void BM_LruCache_FindHit_AbsoluteExpiration( ::benchmark::State& state )
+	{
+		static LruCache<int, std::string> cache{ LruCacheOptions{ MULTI_THREADED_KEY_SPACE }.setExpirationMode( ExpirationMode::Absolute ).setReadOptimized( true ) };
+		[[maybe_unused]] static const bool populated{ populateMultiThreadedCache( cache ) };
+
+		runMultiThreadedWorkload( state, cache, 0 );
+	}
+
+	//----------------------------------------------
+	// Snapshots
+	//----------------------------------------------
+
+	/** @brief Number of entries in the snapshot benchmarks */
+	static constexpr int SNAPSHOT_ENTRIES{ 200000 };
+
+	/** @brief Snapshot of SNAPSHOT_ENTRIES string entries, written once */
+	static const std::string& snapshotBytes()
+	{
+		static const std::string bytes{ []() {
+			LruCache<int, std::string> cache{ LruCacheOptions{ SNAPSHOT_ENTRIES } };
+			for ( int i = 0; i < SNAPSHOT_ENTRIES; ++i )
+			{
+				cache.get( i, [i]() { return std::string{ "value_" + std::to_string( i ) }; } );
+			}
+
+			std::ostringstream out;
+			cache.saveSnapshot( out );
+
+			return out.str();
+		}() };
+
+		return bytes;
+	}
+
+	static void BM_LruCache_Snapshot_Save( ::benchmark::State& state )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{ SNAPSHOT_ENTRIES } };
+		std::istringstream in{ snapshotBytes() };
+		cache.loadSnapshot( in );
+
+		for ( auto _ : state )
+		{
+			std::ostringstream out;
+			::benchmark::DoNotOptimize( cache.saveSnapshot( out ) );
+		}
+
+		state.SetItemsProcessed( state.iterations() * SNAPSHOT_ENTRIES );
+	}
+
+	static void BM_LruCache_Snapshot_Load( ::benchmark::State& state )
+	{
+		for ( auto _ : state )
+		{
+			state.PauseTiming();
+			auto cache{ std::make_unique<LruCache<int, std::string>>( LruCacheOptions{ SNAPSHOT_ENTRIES } ) };
+			std::istringstream in{ snapshotBytes() };
+			state.ResumeTiming();
+
+			::benchmark::DoNotOptimize( cache->loadSnapshot( in, static_cast<std::size_t>( state.range( 0 ) ) ) );
+
+			state.PauseTiming();
+			cache.reset();
+			state.ResumeTiming();
+		}
+
+		state.SetItemsProcessed( state.iterations() * SNAPSHOT_ENTRIES );
+	}
+
+	//----------------------------------------------
+	// Asynchronous get
+	//----------------------------------------------
+
+	/**
+	 * @brief getAsync() hits awaited the way co_await does, without a coroutine frame around them
+	 * @details Reports allocs_per_op: a hit is resolved before getAsync() returns and must not allocate.
+	 */
+	static void BM_LruCache_GetAsync_Hit( ::benchmark::State& state )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{ CALLABLE_KEY_COUNT } };
+		for ( int key{ 0 }; key < CALLABLE_KEY_COUNT; ++key )
+		{
+			cache.get( key, [key]() { return std::to_string( key ); } );
+		}
+
+		int next{ 0 };
+		const std::uint64_t allocationsBefore{ g_allocationCount.load( std::memory_order_relaxed ) };
+
+		for ( auto _ : state )
+		{
+			const int key{ next++ % CALLABLE_KEY_COUNT };
+			auto awaitable{ cache.getAsync( key, [key]() { return std::to_string( key ); } ) };
+			if ( awaitable.await_ready() )
+			{
+				::benchmark::DoNotOptimize( awaitable.await_resume().get() );
+			}
+		}
+
+		const std::uint64_t allocations{ g_allocationCount.load( std::memory_order_relaxed ) - allocationsBefore };
+
+		state.counters["allocs_per_op"] = ::benchmark::Counter( static_cast<double>( allocations ), ::benchmark::Counter::kAvgIterations );
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	//----------------------------------------------
+	// In-place writes
+	//----------------------------------------------
+
+	/** @brief Value replaced by the write benchmarks, long enough to live on the heap */
+	static const std::string REPLACEMENT_VALUE( 64, 'x' );
+
+	static void BM_LruCache_Replace_RemoveThenGet( ::benchmark::State& state )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{ CALLABLE_KEY_COUNT } };
+		int next{ 0 };
+		const std::uint64_t allocationsBefore{ g_allocationCount.load( std::memory_order_relaxed ) };
+
+		for ( auto _ : state )
+		{
+			const int key{ next++ % CALLABLE_KEY_COUNT };
+			cache.remove( key );
+			auto* value = cache.get( key, []() { return REPLACEMENT_VALUE; } );
+			::benchmark::DoNotOptimize( value );
+		}
+
+		const std::uint64_t allocations{ g_allocationCount.load( std::memory_order_relaxed ) - allocationsBefore };
+
+		state.counters["allocs_per_op"] = ::benchmark::Counter( static_cast<double>( allocations ), ::benchmark::Counter::kAvgIterations );
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	static void BM_LruCache_Replace_InsertOrAssign( ::benchmark::State& state )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{ CALLABLE_KEY_COUNT } };
+		int next{ 0 };
+		const std::uint64_t allocationsBefore{ g_allocationCount.load( std::memory_order_relaxed ) };
+
+		for ( auto _ : state )
+		{
+			const int key{ next++ % CALLABLE_KEY_COUNT };
+			auto [value, inserted] = cache.insertOrAssign( key, REPLACEMENT_VALUE );
+			::benchmark::DoNotOptimize( value );
+		}
+
+		const std::uint64_t allocations{ g_allocationCount.load( std::memory_order_relaxed ) - allocationsBefore };
+
+		state.counters["allocs_per_op"] = ::benchmark::Counter( static_cast<double>( allocations ), ::benchmark::Counter::kAvgIterations );
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	//----------------------------------------------
+	// Negative caching
+	//----------------------------------------------
+
+	/** @brief Lookups of keys the backend does not have, with or without tombstones remembering them */
+	static void getAbsentKeys( ::benchmark::State& state, std::chrono::milliseconds negativeExpiration )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{ CALLABLE_KEY_COUNT }.setNegativeExpiration( negativeExpiration ) };
+		int next{ 0 };
+		std::uint64_t backendCalls{ 0 };
+		const std::uint64_t allocationsBefore{ g_allocationCount.load( std::memory_order_relaxed ) };
+
+		for ( auto _ : state )
+		{
+			const int key{ next++ % CALLABLE_KEY_COUNT };
+			auto* value = cache.get( key, [&backendCalls]() -> std::optional<std::string> {
+				++backendCalls;
+				return std::nullopt;
+			} );
+			::benchmark::DoNotOptimize( value );
+		}
+
+		const std::uint64_t allocations{ g_allocationCount.load( std::memory_order_relaxed ) - allocationsBefore };
+
+		state.counters["allocs_per_op"] = ::benchmark::Counter( static_cast<double>( allocations ), ::benchmark::Counter::kAvgIterations );
+		state.counters["backend_calls_per_op"] = ::benchmark::Counter( static_cast<double>( backendCalls ), ::benchmark::Counter::kAvgIterations );
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	static void BM_LruCache_GetAbsent_NoTombstones( ::benchmark::State& state )
+	{
+		getAbsentKeys( state, std::chrono::milliseconds{ 0 } );
+	}
+
+	static void BM_LruCache_GetAbsent_Tombstones( ::benchmark::State& state )
+	{
+		getAbsentKeys( state, std::chrono::minutes{ 10 } );
+	}
+
+	//----------------------------------------------
+	// Second tier
+	//----------------------------------------------
+
+	/** @brief Entries the first tier holds while the working set cycles over CALLABLE_KEY_COUNT keys */
+	static constexpr std::size_t SECOND_TIER_RESIDENT{ 256 };
+
+	/** @brief Round trip charged for every backend load */
+	static constexpr std::chrono::microseconds SECOND_TIER_BACKEND_LATENCY{ 20 };
+
+	/** @brief Build a 4 KiB record of repetitive, mildly varying text, as serialized documents tend to be */
+	static std::string secondTierRecord( int key )
+	{
+		std::string record;
+		for ( int field{ 0 }; record.size() < 4096; ++field )
+		{
+			record += "{\"id\":" + std::to_string( key ) + ",\"field\":" + std::to_string( field ) + ",\"value\":" + std::to_string( ( key * 31 + field ) % 97 ) + "}";
+		}
+		record.resize( 4096 );
+
+		return record;
+	}
+
+	/** @brief Misses on recently evicted keys, served by the backend or by the compressed second tier */
+	static void getEvictedKeys( ::benchmark::State& state, std::size_t secondTierMemoryLimit )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{ SECOND_TIER_RESIDENT }.setSecondTierMemoryLimit( secondTierMemoryLimit ) };
+		int next{ 0 };
+		std::uint64_t backendCalls{ 0 };
+
+		for ( auto _ : state )
+		{
+			const int key{ next++ % CALLABLE_KEY_COUNT };
+			auto* value = cache.get( key, [&backendCalls, key]() {
+				++backendCalls;
+				const auto deadline{ std::chrono::steady_clock::now() + SECOND_TIER_BACKEND_LATENCY };
+				while ( std::chrono::steady_clock::now() < deadline )
+				{
+				}
+
+				return secondTierRecord( key );
+			} );
+			::benchmark::DoNotOptimize( value );
+		}
+
+		state.counters["backend_calls_per_op"] = ::benchmark::Counter( static_cast<double>( backendCalls ), ::benchmark::Counter::kAvgIterations );
+		state.counters["second_tier_bytes"] = static_cast<double>( cache.secondTierMemoryUsage() );
+		state.counters["second_tier_entries"] = static_cast<double>( cache.secondTierSize() );
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	static void BM_LruCache_GetEvicted_Backend( ::benchmark::State& state )
+	{
+		getEvictedKeys( state, 0 );
+	}
+
+	static void BM_LruCache_GetEvicted_SecondTier( ::benchmark::State& state )
+	{
+		getEvictedKeys( state, std::size_t{ 4 } << 20 );
+	}
+
+	/** @brief Compression ratio and speed of the built-in codec on one record */
+	static void BM_LzCodec_RoundTrip( ::benchmark::State& state )
+	{
+		const std::string record{ secondTierRecord( 42 ) };
+		const std::span<const std::byte> input{ reinterpret_cast<const std::byte*>( record.data() ), record.size() };
+		std::vector<std::byte> block;
+		std::vector<std::byte> restored;
+
+		for ( auto _ : state )
+		{
+			block.clear();
+			restored.clear();
+			LzCodec::compress( input, block );
+			LzCodec::decompress( block, restored );
+			::benchmark::DoNotOptimize( restored.data() );
+		}
+
+		state.counters["ratio"] = static_cast<double>( record.size() ) / static_cast<double>( block.size() );
+		state.SetBytesProcessed( static_cast<std::int64_t>( state.iterations() ) * static_cast<std::int64_t>( record.size() ) );
+	}
+
+	//=====================================================================
+	// Benchmarks registration
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_Construction_Default );
+	BENCHMARK( BM_LruCache_Construction_WithOptions );
+
+	//----------------------------------------------
+	// Cache operations - get
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_Get_NewEntry );
+	BENCHMARK( BM_LruCache_Get_ExistingEntry );
+	BENCHMARK( BM_LruCache_Get_WithConfig );
+
+	//----------------------------------------------
+	// Cache operations - callables
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_Get_Hit_StdFunction );
+	BENCHMARK( BM_LruCache_Get_Hit_Template );
+	BENCHMARK( BM_LruCache_Get_Miss_StdFunction );
+	BENCHMARK( BM_LruCache_Get_Miss_Template );
+
+	//----------------------------------------------
+	// Lookup - find
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_Find_Hit );
+	BENCHMARK( BM_LruCache_Find_Miss );
+
+	//----------------------------------------------
+	// Lookup - index comparison
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_Find_Hit_NodeIndex )
+		->Arg( 1000 )
+		->Arg( 1000000 )
+		->Arg( 10000000 );
+	BENCHMARK( BM_LruCache_Find_Hit_FlatIndex )
+		->Arg( 1000 )
+		->Arg( 1000000 )
+		->Arg( 10000000 );
+	BENCHMARK( BM_LruCache_Find_Miss_NodeIndex )
+		->Arg( 1000 )
+		->Arg( 1000000 )
+		->Arg( 10000000 );
+	BENCHMARK( BM_LruCache_Find_Miss_FlatIndex )
+		->Arg( 1000 )
+		->Arg( 1000000 )
+		->Arg( 10000000 );
+
+	//----------------------------------------------
+	// Lookup - batches
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_FindBatch_Loop_NodeIndex )
+		->Arg( 1000 )
+		->Arg( 1000000 );
+	BENCHMARK( BM_LruCache_FindBatch_FindMany_NodeIndex )
+		->Arg( 1000 )
+		->Arg( 1000000 );
+	BENCHMARK( BM_LruCache_FindBatch_Loop_FlatIndex )
+		->Arg( 1000 )
+		->Arg( 1000000 );
+	BENCHMARK( BM_LruCache_FindBatch_FindMany_FlatIndex )
+		->Arg( 1000 )
+		->Arg( 1000000 );
+
+	//----------------------------------------------
+	// Lookup - clock comparison
+	//----------------------------------------------
+
+	BENCHMARK_TEMPLATE( BM_LruCache_Get_Hit_Clock, SteadyClock );
+	BENCHMARK_TEMPLATE( BM_LruCache_Get_Hit_Clock, CoarseClock<> );
+
+	//----------------------------------------------
+	// Lookup - statistics overhead
+	//----------------------------------------------
+
+	BENCHMARK_TEMPLATE( BM_LruCache_Get_Hit_Stats, NoStats );
+	BENCHMARK_TEMPLATE( BM_LruCache_Get_Hit_Stats, StripedStats );
+
+	//----------------------------------------------
+	// Modification operations
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_Remove );
+	BENCHMARK( BM_LruCache_Clear )
+		->Arg( 10 )
+		->Arg( 100 )
+		->Arg( 1000 )
+		->Arg( 10000 );
+
+	//----------------------------------------------
+	// State inspection
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_Size );
+	BENCHMARK( BM_LruCache_IsEmpty );
+
+	//----------------------------------------------
+	// LRU eviction
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_LRU_Eviction );
+	BENCHMARK( BM_LruCache_LRU_Access_Pattern );
+
+	//----------------------------------------------
+	// Expiration
+	//----------------------------------------------
 
 	BENCHMARK( BM_LruCache_CleanupExpired )
 		->Arg( 10 )
 		->Arg( 100 )
 		->Arg( 1000 );
+	BENCHMARK( BM_LruCache_CleanupExpired_LargeLiveSet )
+		->Arg( 100000 )
+		->Arg( 1000000 )
+		->Arg( 5000000 )
+		->Iterations( 200 )
+		->Unit( ::benchmark::kMicrosecond );
+	BENCHMARK( BM_LruCache_ExpiredChurn_FixedBudget )->Iterations( 1000000 );
+	BENCHMARK( BM_LruCache_ExpiredChurn_AdaptiveBudget )->Iterations( 1000000 );
 
 	//----------------------------------------------
 	// Complex value types
@@ -490,6 +1515,160 @@ namespace nfx::cache::benchmark
 
 	BENCHMARK( BM_LruCache_Scenario_DatabaseCache );
 	BENCHMARK( BM_LruCache_Scenario_WebCache );
+
+	//----------------------------------------------
+	// Allocation churn
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_Churn_HeapNodes );
+	BENCHMARK( BM_LruCache_Churn_SlabNodes );
+
+	//----------------------------------------------
+	// Memory footprint
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_Memory_NodeIndex )
+		->Arg( 10'000'000 )
+		->Iterations( 1 )
+		->Unit( ::benchmark::kMillisecond );
+	BENCHMARK( BM_LruCache_Memory_FlatIndex )
+		->Arg( 10'000'000 )
+		->Iterations( 1 )
+		->Unit( ::benchmark::kMillisecond );
+	BENCHMARK( BM_CompactLruCache_Memory )
+		->Arg( 10'000'000 )
+		->Iterations( 1 )
+		->Unit( ::benchmark::kMillisecond );
+
+	//----------------------------------------------
+	// Hit ratio - eviction policies
+	//----------------------------------------------
+
+	BENCHMARK_TEMPLATE( BM_LruCache_HitRatio_Zipf, LruPolicy )
+		->Arg( 1000 )
+		->Arg( 10000 )
+		->Iterations( 1 )
+		->Unit( ::benchmark::kMillisecond );
+	BENCHMARK_TEMPLATE( BM_LruCache_HitRatio_Zipf, SlruPolicy )
+		->Arg( 1000 )
+		->Arg( 10000 )
+		->Iterations( 1 )
+		->Unit( ::benchmark::kMillisecond );
+	BENCHMARK_TEMPLATE( BM_LruCache_HitRatio_Zipf, ClockPolicy )
+		->Arg( 1000 )
+		->Arg( 10000 )
+		->Iterations( 1 )
+		->Unit( ::benchmark::kMillisecond );
+	BENCHMARK_TEMPLATE( BM_LruCache_HitRatio_Zipf, WTinyLfuPolicy )
+		->Arg( 1000 )
+		->Arg( 10000 )
+		->Iterations( 1 )
+		->Unit( ::benchmark::kMillisecond );
+	BENCHMARK_TEMPLATE( BM_LruCache_HitRatio_ZipfWithScans, LruPolicy )
+		->Arg( 1000 )
+		->Arg( 10000 )
+		->Iterations( 1 )
+		->Unit( ::benchmark::kMillisecond );
+	BENCHMARK_TEMPLATE( BM_LruCache_HitRatio_ZipfWithScans, SlruPolicy )
+		->Arg( 1000 )
+		->Arg( 10000 )
+		->Iterations( 1 )
+		->Unit( ::benchmark::kMillisecond );
+	BENCHMARK_TEMPLATE( BM_LruCache_HitRatio_ZipfWithScans, ClockPolicy )
+		->Arg( 1000 )
+		->Arg( 10000 )
+		->Iterations( 1 )
+		->Unit( ::benchmark::kMillisecond );
+	BENCHMARK_TEMPLATE( BM_LruCache_HitRatio_ZipfWithScans, WTinyLfuPolicy )
+		->Arg( 1000 )
+		->Arg( 10000 )
+		->Iterations( 1 )
+		->Unit( ::benchmark::kMillisecond );
+
+	//----------------------------------------------
+	// Multi-threaded scaling
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_MultiThreaded_FindHit )
+		->ThreadRange( 1, 32 )
+		->UseRealTime();
+	BENCHMARK( BM_ShardedLruCache_MultiThreaded_FindHit )
+		->ThreadRange( 1, 32 )
+		->UseRealTime();
+	BENCHMARK( BM_LruCache_MultiThreaded_Mixed )
+		->ThreadRange( 1, 32 )
+		->UseRealTime();
+	BENCHMARK( BM_ShardedLruCache_MultiThreaded_Mixed )
+		->ThreadRange( 1, 32 )
+		->UseRealTime();
+
+	//----------------------------------------------
+	// Read-heavy workload (97% hits): exclusive lock vs read-optimized mode
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_ReadHeavy_Exclusive )
+		->Threads( 1 )
+		->Threads( 4 )
+		->Threads( 16 )
+		->Threads( 64 )
+		->UseRealTime();
+	BENCHMARK( BM_LruCache_ReadHeavy_ReadOptimized )
+		->Threads( 1 )
+		->Threads( 4 )
+		->Threads( 16 )
+		->Threads( 64 )
+		->UseRealTime();
+
+	//----------------------------------------------
+	// Read-only hits: sliding vs absolute expiration
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_FindHit_SlidingExpiration )
+		->ThreadRange( 1, 32 )
+		->UseRealTime();
+	BENCHMARK( BM_LruCache_FindHit_AbsoluteExpiration )
+		->ThreadRange( 1, 32 )
+		->UseRealTime();
+
+	//----------------------------------------------
+	// Snapshots
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_Snapshot_Save )
+		->Unit( ::benchmark::kMillisecond );
+	BENCHMARK( BM_LruCache_Snapshot_Load )
+		->Arg( 1 )
+		->Arg( 4 )
+		->Unit( ::benchmark::kMillisecond )
+		->UseRealTime();
+
+	//----------------------------------------------
+	// Asynchronous get
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_GetAsync_Hit );
+
+	//----------------------------------------------
+	// In-place writes
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_Replace_RemoveThenGet );
+	BENCHMARK( BM_LruCache_Replace_InsertOrAssign );
+
+	//----------------------------------------------
+	// Negative caching
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_GetAbsent_NoTombstones );
+	BENCHMARK( BM_LruCache_GetAbsent_Tombstones );
+
+	//----------------------------------------------
+	// Second tier
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_GetEvicted_Backend );
+	BENCHMARK( BM_LruCache_GetEvicted_SecondTier );
+	BENCHMARK( BM_LzCodec_RoundTrip );
 } // namespace nfx::cache::benchmark
 
 BENCHMARK_MAIN();
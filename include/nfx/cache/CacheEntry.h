@@ -0,0 +1,207 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file CacheEntry.h
+ * @brief Per-entry cache metadata shared by caches, eviction policies and the expiration index
+ * @details Expiration state plus the intrusive links used by eviction policies and TimerWheel
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// ExpirationMode enum
+	//=====================================================================
+
+	/** @brief How the lifetime of a cache entry is measured */
+	enum class ExpirationMode : std::uint8_t
+	{
+		/** @brief Expire slidingExpiration after the last access; every hit renews the entry */
+		Sliding,
+
+		/** @brief Expire absoluteExpiration after the value was stored; hits write no timestamp */
+		Absolute,
+
+		/** @brief Expire at whichever of the sliding and absolute deadlines comes first */
+		SlidingAndAbsolute
+	};
+
+	//=====================================================================
+	// CacheEntry struct
+	//=====================================================================
+
+	/** @brief Cache entry metadata with intrusive eviction and expiration list support */
+	struct CacheEntry final
+	{
+		/** @brief Timestamp of the last access to this cache entry */
+		std::chrono::steady_clock::time_point lastAccessed;
+
+		/** @brief Timestamp at which the current value was stored, the reference of refresh-ahead */
+		std::chrono::steady_clock::time_point writeTime;
+
+		/** @brief Sliding expiration time for this specific entry */
+		std::chrono::milliseconds slidingExpiration;
+
+		/** @brief Time to live from writeTime, used by the Absolute and SlidingAndAbsolute modes */
+		std::chrono::milliseconds absoluteExpiration{ std::chrono::hours( 1 ) };
+
+		/** @brief Size of this cache entry for memory accounting */
+		std::size_t size{ 1 };
+
+		/** @brief Previous entry in the eviction policy's intrusive list */
+		CacheEntry* lruPrev{ nullptr };
+
+		/** @brief Next entry in the eviction policy's intrusive list */
+		CacheEntry* lruNext{ nullptr };
+
+		/** @brief Pointer to the key for this cache entry */
+		const void* keyPtr{ nullptr };
+
+		/** @brief Next entry in the same timer wheel bucket */
+		CacheEntry* expiryNext{ nullptr };
+
+		/** @brief Link pointing at this entry in its timer wheel bucket (nullptr when not scheduled) */
+		CacheEntry** expiryPrevNext{ nullptr };
+
+		/** @brief Eviction policy state (list segment or reference bit) */
+		std::uint8_t policyState{ 0 };
+
+		/** @brief True while a background reload of this entry is scheduled or running */
+		bool refreshing{ false };
+
+		/** @brief Deadline(s) the entry expires at (honored by LruCache and ShardedLruCache) */
+		ExpirationMode expirationMode{ ExpirationMode::Sliding };
+
+		/** @brief Number of value handles pinning this entry, updated through std::atomic_ref (high bit: removed while pinned) */
+		alignas( std::atomic_ref<std::uint32_t>::required_alignment ) std::uint32_t pinCount{ 0 };
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct cache entry with specified expiration time
+		 * @param expiration Sliding expiration time for this entry
+		 */
+		inline CacheEntry( std::chrono::milliseconds expiration = std::chrono::hours( 1 ) );
+
+		//----------------------------------------------
+		// Expiration checking
+		//----------------------------------------------
+
+		/**
+		 * @brief Check if this cache entry has expired according to its expiration mode
+		 * @return True if the entry has expired and should be evicted, false otherwise
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline bool isExpired() const noexcept;
+
+		/**
+		 * @brief Check if this cache entry has expired at a given point in time
+		 * @param now Current time, read once by the caller
+		 * @return True if the entry has expired and should be evicted, false otherwise
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline bool isExpired( std::chrono::steady_clock::time_point now ) const noexcept;
+
+		//----------------------------------------------
+		// Access management
+		//----------------------------------------------
+
+		/**
+		 * @brief Update the last accessed timestamp to current time
+		 * @details Resets the sliding expiration timer for this cache entry. Does nothing in
+		 *          ExpirationMode::Absolute, so that hits leave the entry's cache line clean.
+		 */
+		void inline touch() noexcept;
+
+		/**
+		 * @brief Update the last accessed timestamp to a given point in time
+		 * @param now Current time, read once by the caller
+		 * @details Resets the sliding expiration timer for this cache entry. Does nothing in
+		 *          ExpirationMode::Absolute, so that hits leave the entry's cache line clean.
+		 */
+		void inline touch( std::chrono::steady_clock::time_point now ) noexcept;
+
+		/**
+		 * @brief Start both expiration timers, for a value that was just stored
+		 * @param now Current time, read once by the caller
+		 * @details Sets lastAccessed and writeTime, whatever the expiration mode
+		 */
+		void inline resetTimestamps( std::chrono::steady_clock::time_point now ) noexcept;
+	};
+
+	//=====================================================================
+	// Entry callables
+	//=====================================================================
+
+	/**
+	 * @brief Callable creating the value of a missing entry
+	 * @details Any invocable whose result constructs a TValue: a lambda, a function object or a
+	 *          std::function. Caches take it by reference, so it is never copied or type-erased.
+	 */
+	template <typename Factory, typename TValue>
+	concept EntryFactory = std::invocable<Factory&> && std::constructible_from<TValue, std::invoke_result_t<Factory&>>;
+
+	/**
+	 * @brief Callable loading the value of a missing entry, or reporting that the key has none
+	 * @details Returns a std::optional<TValue>: std::nullopt means the key does not exist at the
+	 *          source, which caches may remember for a while instead of asking again.
+	 */
+	template <typename Factory, typename TValue>
+	concept OptionalEntryFactory = std::invocable<Factory&> && std::same_as<std::invoke_result_t<Factory&>, std::optional<TValue>>;
+
+	/**
+	 * @brief Callable accepted by get(): an EntryFactory or an OptionalEntryFactory
+	 */
+	template <typename Factory, typename TValue>
+	concept EntryLoader = EntryFactory<Factory, TValue> || OptionalEntryFactory<Factory, TValue>;
+
+	/**
+	 * @brief Optional callable adjusting the metadata of a new entry
+	 * @details nullptr, or any invocable taking a CacheEntry&, including a possibly empty std::function
+	 */
+	template <typename Configure>
+	concept EntryConfigurator = std::same_as<std::remove_cvref_t<Configure>, std::nullptr_t> || std::invocable<Configure&, CacheEntry&>;
+
+	/**
+	 * @brief Apply an optional configure callable to the metadata of a new entry
+	 * @param configure nullptr, a callable, or a nullable callable such as std::function (skipped when empty)
+	 * @param entry Metadata of the entry being created
+	 */
+	template <EntryConfigurator Configure>
+	inline void configureEntry( Configure& configure, CacheEntry& entry );
+} // namespace nfx::cache
+
+#include "nfx/detail/cache/CacheEntry.inl"
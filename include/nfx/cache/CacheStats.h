@@ -0,0 +1,254 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file CacheStats.h
+ * @brief Runtime statistics collectors for caches
+ * @details Collectors are plugged into LruCache as a template parameter. NoStats (the default)
+ *          has empty inline recorders, so statistics cost nothing unless StripedStats is selected.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// CacheStats struct
+	//=====================================================================
+
+	/** @brief Snapshot of a cache's counters since construction */
+	struct CacheStats final
+	{
+		/** @brief Lookups that found a live entry */
+		std::uint64_t hits{ 0 };
+
+		/** @brief Lookups that found no live entry */
+		std::uint64_t misses{ 0 };
+
+		/** @brief Entries inserted */
+		std::uint64_t inserts{ 0 };
+
+		/** @brief Entries evicted to respect the size or memory limit */
+		std::uint64_t evictions{ 0 };
+
+		/** @brief Expired entries removed, on lookup or by cleanup */
+		std::uint64_t expirations{ 0 };
+
+		/** @brief Factory calls (one per get() miss, one per getMany() batch) */
+		std::uint64_t loads{ 0 };
+
+		/** @brief Factory calls that threw */
+		std::uint64_t loadFailures{ 0 };
+
+		/** @brief Time spent in factory calls */
+		std::chrono::nanoseconds totalLoadTime{ 0 };
+
+		//----------------------------------------------
+		// Derived values
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the share of lookups that hit
+		 * @return hits / (hits + misses), or 0 when there was no lookup
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline double hitRatio() const noexcept;
+
+		/**
+		 * @brief Get the mean factory call duration
+		 * @return totalLoadTime / loads, or 0 when nothing was loaded
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::chrono::nanoseconds averageLoadTime() const noexcept;
+
+		//----------------------------------------------
+		// Aggregation
+		//----------------------------------------------
+
+		/**
+		 * @brief Add the counters of another snapshot
+		 * @param other Snapshot to add
+		 * @return This snapshot
+		 */
+		inline CacheStats& operator+=( const CacheStats& other ) noexcept;
+	};
+
+	//=====================================================================
+	// NoStats class
+	//=====================================================================
+
+	/** @brief Statistics disabled (default): every recorder is an empty inline function */
+	class NoStats final
+	{
+	public:
+		//----------------------------------------------
+		// Recording
+		//----------------------------------------------
+
+		void recordHits( std::uint64_t ) noexcept {}
+		void recordMisses( std::uint64_t ) noexcept {}
+		void recordInserts( std::uint64_t ) noexcept {}
+		void recordEvictions( std::uint64_t ) noexcept {}
+		void recordExpirations( std::uint64_t ) noexcept {}
+
+		/**
+		 * @brief Start timing a factory call
+		 * @return Default time point, without reading the clock
+		 */
+		[[nodiscard]] std::chrono::steady_clock::time_point loadStart() const noexcept { return {}; }
+
+		void recordLoad( std::chrono::steady_clock::time_point, bool ) noexcept {}
+
+		//----------------------------------------------
+		// Snapshot
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the counters
+		 * @return All-zero snapshot
+		 */
+		[[nodiscard]] CacheStats snapshot() const noexcept { return {}; }
+	};
+
+	//=====================================================================
+	// StripedStats class
+	//=====================================================================
+
+	/**
+	 * @brief Statistics counted in cache-line padded per-thread stripes
+	 * @details Each thread increments the relaxed counters of its own stripe, so recording adds
+	 *          no contention between threads. snapshot() sums the stripes without any lock; counters
+	 *          recorded concurrently may or may not be included.
+	 */
+	class StripedStats final
+	{
+	public:
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/** @brief Construct zeroed counters, one stripe per hardware thread (up to MAX_STRIPES) */
+		inline StripedStats();
+
+		//----------------------------------------------
+		// Recording
+		//----------------------------------------------
+
+		/**
+		 * @brief Count lookups that found a live entry
+		 * @param count Number of hits
+		 */
+		inline void recordHits( std::uint64_t count ) noexcept;
+
+		/**
+		 * @brief Count lookups that found no live entry
+		 * @param count Number of misses
+		 */
+		inline void recordMisses( std::uint64_t count ) noexcept;
+
+		/**
+		 * @brief Count inserted entries
+		 * @param count Number of inserts
+		 */
+		inline void recordInserts( std::uint64_t count ) noexcept;
+
+		/**
+		 * @brief Count entries evicted by the size or memory limit
+		 * @param count Number of evictions
+		 */
+		inline void recordEvictions( std::uint64_t count ) noexcept;
+
+		/**
+		 * @brief Count removed expired entries
+		 * @param count Number of expirations
+		 */
+		inline void recordExpirations( std::uint64_t count ) noexcept;
+
+		/**
+		 * @brief Start timing a factory call
+		 * @return Current steady_clock time
+		 */
+		[[nodiscard]] inline std::chrono::steady_clock::time_point loadStart() const noexcept;
+
+		/**
+		 * @brief Count a factory call and its duration
+		 * @param start Value returned by loadStart() before the call
+		 * @param failed True if the factory threw
+		 */
+		inline void recordLoad( std::chrono::steady_clock::time_point start, bool failed ) noexcept;
+
+		//----------------------------------------------
+		// Snapshot
+		//----------------------------------------------
+
+		/**
+		 * @brief Sum the counters of every stripe
+		 * @return Counters since construction
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline CacheStats snapshot() const noexcept;
+
+	private:
+		//----------------------------------------------
+		// Stripes
+		//----------------------------------------------
+
+		/** @brief Maximum number of stripes */
+		static constexpr std::size_t MAX_STRIPES = 64;
+
+		/** @brief Counters of one stripe, alone on their cache line */
+		struct alignas( 64 ) Stripe
+		{
+			std::atomic<std::uint64_t> hits{ 0 };
+			std::atomic<std::uint64_t> misses{ 0 };
+			std::atomic<std::uint64_t> inserts{ 0 };
+			std::atomic<std::uint64_t> evictions{ 0 };
+			std::atomic<std::uint64_t> expirations{ 0 };
+			std::atomic<std::uint64_t> loads{ 0 };
+			std::atomic<std::uint64_t> loadFailures{ 0 };
+			std::atomic<std::int64_t> loadNanos{ 0 };
+		};
+
+		/**
+		 * @brief Get the calling thread's stripe
+		 * @return Stripe selected by a hash of the thread id
+		 */
+		[[nodiscard]] inline Stripe& local() noexcept;
+
+		/** @brief Counter stripes */
+		std::unique_ptr<Stripe[]> m_stripes;
+
+		/** @brief Mask applied to the thread hash to select a stripe */
+		std::size_t m_mask;
+	};
+} // namespace nfx::cache
+
+#include "nfx/detail/cache/CacheStats.inl"
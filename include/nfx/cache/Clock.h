@@ -0,0 +1,190 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file Clock.h
+ * @brief Time sources for cache expiration
+ * @details Clocks are plugged into LruCache as a template parameter. Every clock provides a
+ *          static now() returning a std::chrono::steady_clock::time_point, so entries and the
+ *          expiration index keep one time representation whatever the time source.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// SteadyClock class
+	//=====================================================================
+
+	/** @brief Precise clock reading std::chrono::steady_clock on every call (default) */
+	class SteadyClock final
+	{
+	public:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		/** @brief Point in time produced by this clock */
+		using time_point = std::chrono::steady_clock::time_point;
+
+		//----------------------------------------------
+		// Time access
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the current time
+		 * @return Current steady_clock time
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] static inline time_point now() noexcept;
+	};
+
+	//=====================================================================
+	// CoarseClock class
+	//=====================================================================
+
+	/**
+	 * @brief Cheap clock reading a timestamp cached by a ticker thread
+	 * @tparam ResolutionMs Interval between ticker updates, in milliseconds
+	 * @details now() is a single relaxed atomic load. The ticker thread starts on the first call
+	 *          and is shared by every cache using the same resolution. Expiration checks are
+	 *          late by at most one resolution interval.
+	 */
+	template <std::size_t ResolutionMs = 10>
+	class CoarseClock final
+	{
+	public:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		/** @brief Point in time produced by this clock */
+		using time_point = std::chrono::steady_clock::time_point;
+
+		//----------------------------------------------
+		// Time access
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the time of the last tick
+		 * @return steady_clock time, at most one resolution interval old
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] static inline time_point now() noexcept;
+
+		/**
+		 * @brief Get the interval between ticks
+		 * @return Tick interval
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] static constexpr std::chrono::milliseconds resolution() noexcept;
+
+	private:
+		/** @brief Background thread publishing steady_clock::now() once per resolution interval */
+		class Ticker final
+		{
+		public:
+			inline Ticker();
+			inline ~Ticker();
+
+			Ticker( const Ticker& ) = delete;
+			Ticker& operator=( const Ticker& ) = delete;
+
+			/** @brief Last published time, as steady_clock ticks */
+			std::atomic<std::chrono::steady_clock::rep> m_time;
+
+		private:
+			std::mutex m_mutex;
+			std::condition_variable m_stopSignal;
+			bool m_stop;
+			std::thread m_thread;
+		};
+
+		/**
+		 * @brief Get the ticker shared by this resolution, starting it on first use
+		 * @return Shared ticker
+		 */
+		[[nodiscard]] static inline Ticker& ticker();
+	};
+
+	//=====================================================================
+	// ManualClock class
+	//=====================================================================
+
+	/**
+	 * @brief Clock that only moves when told to, for deterministic expiration tests
+	 * @details The time is process-wide: every cache using ManualClock sees the same time.
+	 */
+	class ManualClock final
+	{
+	public:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		/** @brief Point in time produced by this clock */
+		using time_point = std::chrono::steady_clock::time_point;
+
+		//----------------------------------------------
+		// Time access
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the current manual time
+		 * @return Current time
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] static inline time_point now() noexcept;
+
+		//----------------------------------------------
+		// Time control
+		//----------------------------------------------
+
+		/**
+		 * @brief Move the time forward
+		 * @param duration Amount of time to add
+		 */
+		static inline void advance( std::chrono::steady_clock::duration duration ) noexcept;
+
+		/**
+		 * @brief Set the current time
+		 * @param time New current time
+		 */
+		static inline void set( time_point time ) noexcept;
+
+	private:
+		/** @brief Current time, as steady_clock ticks */
+		static inline std::atomic<std::chrono::steady_clock::rep> s_time{ 0 };
+	};
+} // namespace nfx::cache
+
+#include "nfx/detail/cache/Clock.inl"
@@ -0,0 +1,528 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file CompactLruCache.h
+ * @brief Thread-safe LRU cache with compact per-entry metadata
+ * @details Entries live in chunked slot arrays and are linked by 32-bit slot indices, with
+ *          32-bit timestamps relative to a cache epoch and shared expiration classes instead
+ *          of per-entry durations. Meant for very large caches of small keys and values.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "nfx/cache/CacheEntry.h"
+#include "nfx/cache/Clock.h"
+#include "nfx/cache/LruCache.h"
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// CompactEntry struct
+	//=====================================================================
+
+	/**
+	 * @brief Per-entry metadata of CompactLruCache
+	 * @details 16 bytes, against 88 for CacheEntry. The key index lives in the cache's bucket
+	 *          array and the entry size is not tracked, so only count limits are supported.
+	 */
+	struct CompactEntry final
+	{
+		/** @brief Slot index marking the end of a list */
+		static constexpr std::uint32_t NIL = 0xFFFFFFFFu;
+
+		/** @brief Time of the last access, in milliseconds since the cache epoch */
+		std::uint32_t lastAccessed{ 0 };
+
+		/** @brief More recently used slot of the same expiration class */
+		std::uint32_t prev{ NIL };
+
+		/** @brief Less recently used slot of the same expiration class (next free slot once released) */
+		std::uint32_t next{ NIL };
+
+		/** @brief Index of the entry's sliding expiration in the cache's expiration class table */
+		std::uint8_t expirationClass{ 0 };
+	};
+
+	//=====================================================================
+	// CompactLruCache class
+	//=====================================================================
+
+	/**
+	 * @brief Thread-safe LRU cache with sliding expiration and 16-byte entry metadata
+	 * @tparam TKey Key type for cache entries
+	 * @tparam TValue Value type for cached objects
+	 * @tparam Hash Hash function object for keys
+	 * @tparam KeyEqual Equality comparison function object for keys
+	 * @tparam Clock Time source for expiration (SteadyClock, CoarseClock or ManualClock)
+	 * @details Entries of one expiration class form a recency list, so the least recently used
+	 *          entry of the cache is the oldest tail among the classes and expired entries of a
+	 *          class are always at its tail: a single pair of links serves both eviction and
+	 *          expiration. Keys are indexed by a linear-probing array of (slot, hash) pairs.
+	 *          Eviction is LRU only; of LruCacheOptions, the size limit, sliding expiration,
+	 *          background cleanup interval and (fixed) cleanup budget are honored.
+	 */
+	template <typename TKey, typename TValue, typename Hash = std::hash<TKey>, typename KeyEqual = std::equal_to<TKey>, typename Clock = SteadyClock>
+	class CompactLruCache final
+	{
+	public:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		/** @brief Function type for creating cache values when not found */
+		using FactoryFunction = std::function<TValue()>;
+
+		/** @brief Function type for configuring cache entry metadata (only slidingExpiration is used) */
+		using ConfigFunction = std::function<void( CacheEntry& )>;
+
+		//----------------------------------------------
+		// Constants
+		//----------------------------------------------
+
+		/** @brief Maximum number of distinct sliding expirations */
+		static constexpr std::size_t MAX_EXPIRATION_CLASSES = 256;
+
+		/** @brief Longest sliding expiration (about 12.4 days); longer ones are clamped */
+		static constexpr std::chrono::milliseconds MAX_EXPIRATION{ ( std::int64_t{ 1 } << 30 ) - 1 };
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct memory cache with specified options
+		 * @param options Configuration options for cache behavior
+		 */
+		inline explicit CompactLruCache( const LruCacheOptions& options = {} );
+
+		//----------------------------------------------
+		// Copy and move operations
+		//----------------------------------------------
+
+		CompactLruCache( const CompactLruCache& ) = delete;
+		CompactLruCache( CompactLruCache&& ) = delete;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		CompactLruCache& operator=( const CompactLruCache& ) = delete;
+		CompactLruCache& operator=( CompactLruCache&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		/** @brief Destroy every cached key and value */
+		inline ~CompactLruCache();
+
+		//----------------------------------------------
+		// Cache operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Get a cache entry, creating it with factory function if not found
+		 * @param key The cache key
+		 * @param factory Callable creating the value if not cached
+		 * @param configure Optional callable configuring the new cache entry (only slidingExpiration is used)
+		 * @return Pointer to the cached value (never null; throws on factory failure)
+		 * @details Same single-flight loading as LruCache::get(): the factory runs without the
+		 *          cache lock and concurrent misses on one key share a single load.
+		 * @warning A factory must not call get() for its own key, as it would wait on itself
+		 */
+		template <EntryFactory<TValue> Factory, EntryConfigurator Configure = std::nullptr_t>
+		inline TValue* get( const TKey& key, Factory&& factory, Configure&& configure = nullptr );
+
+		//----------------------------------------------
+		// Lookup operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Find a cached value without creating it
+		 * @param key The cache key
+		 * @return Pointer to the cached value if found and not expired, nullptr otherwise
+		 */
+		inline TValue* find( const TKey& key );
+
+		//----------------------------------------------
+		// Modification operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Remove an entry from the cache
+		 * @param key The cache key to remove
+		 * @return True if entry was removed, false if not found
+		 */
+		inline bool remove( const TKey& key );
+
+		/**
+		 * @brief Clear all cache entries (slot and index capacity is kept)
+		 */
+		inline void clear();
+
+		/**
+		 * @brief Get current cache size
+		 * @return Number of entries in cache
+		 */
+		inline std::size_t size() const;
+
+		//----------------------------------------------
+		// State inspection
+		//----------------------------------------------
+
+		/**
+		 * @brief Check if cache is empty
+		 * @return True if cache contains no entries
+		 */
+		inline bool isEmpty() const;
+
+		/**
+		 * @brief Get the number of distinct sliding expirations seen so far
+		 * @return Expiration class count (at least 1, the default expiration)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t expirationClassCount() const;
+
+		/**
+		 * @brief Manually trigger cleanup of expired entries
+		 */
+		inline void cleanupExpired();
+
+	private:
+		//----------------------------------------------
+		// Constants
+		//----------------------------------------------
+
+		/** @brief log2 of the largest slot chunk */
+		static constexpr unsigned MAX_CHUNK_BITS = 12;
+
+		/** @brief Smallest bucket array */
+		static constexpr std::size_t MIN_BUCKETS = 16;
+
+		/** @brief Age of the epoch, in milliseconds, at which timestamps are rebased */
+		static constexpr std::int64_t REBASE_THRESHOLD = std::int64_t{ 3 } << 30;
+
+		//----------------------------------------------
+		// Internal data structures
+		//----------------------------------------------
+
+		/** @brief Storage for one entry; key and value are only alive while the slot is in use */
+		struct Slot
+		{
+			Slot() noexcept {}
+			~Slot() {}
+
+			Slot( const Slot& ) = delete;
+			Slot& operator=( const Slot& ) = delete;
+
+			union
+			{
+				/** @brief The cache key */
+				TKey key;
+			};
+
+			union
+			{
+				/** @brief The cached value */
+				TValue value;
+			};
+
+			/** @brief Compact entry metadata */
+			CompactEntry metadata;
+		};
+
+		/** @brief Key index bucket */
+		struct Bucket
+		{
+			/** @brief Slot holding the key (CompactEntry::NIL when empty) */
+			std::uint32_t slot;
+
+			/** @brief Mixed hash of the key; its top bits select the home bucket */
+			std::uint32_t hash;
+		};
+
+		/** @brief Entries sharing one sliding expiration, most recently used first */
+		struct ExpirationClass
+		{
+			/** @brief Sliding expiration in milliseconds */
+			std::uint32_t duration;
+
+			/** @brief Most recently used slot */
+			std::uint32_t head{ CompactEntry::NIL };
+
+			/** @brief Least recently used slot */
+			std::uint32_t tail{ CompactEntry::NIL };
+		};
+
+		/** @brief State shared between the thread running a factory and threads waiting on it */
+		struct PendingLoad
+		{
+			/** @brief Key being loaded (the loader's argument) */
+			const TKey* key;
+
+			/** @brief Number of threads waiting on this load */
+			std::size_t waiterCount{ 0 };
+
+			/** @brief True once the value was inserted or the factory failed */
+			bool completed{ false };
+
+			/** @brief Exception thrown by the factory, rethrown in every waiter */
+			std::exception_ptr error;
+
+			/** @brief Construct the state of a load of the key at loadKey, not completed and without waiters */
+			explicit PendingLoad( const TKey* loadKey ) noexcept;
+		};
+
+		mutable std::mutex m_mutex;
+		LruCacheOptions m_options;
+
+		/** @brief Slot chunks of 2^m_chunkBits slots, allocated on demand and never moved */
+		std::vector<std::unique_ptr<Slot[]>> m_chunks;
+
+		/** @brief log2 of the chunk size */
+		unsigned m_chunkBits;
+
+		/** @brief Number of slots handed out at least once */
+		std::uint32_t m_slotCount;
+
+		/** @brief First released slot (free slots are chained through CompactEntry::next) */
+		std::uint32_t m_freeSlot;
+
+		/** @brief Linear-probing key index (power-of-two size) */
+		std::vector<Bucket> m_buckets;
+
+		/** @brief Shift turning a mixed hash into a home bucket */
+		unsigned m_bucketShift;
+
+		/** @brief Inserts left before the index must grow */
+		std::size_t m_growthLeft;
+
+		/** @brief Number of entries */
+		std::size_t m_size;
+
+		/** @brief Sliding expirations in use, indexed by CompactEntry::expirationClass */
+		std::vector<ExpirationClass> m_classes;
+
+		/** @brief Time that entry timestamps are relative to */
+		std::chrono::steady_clock::time_point m_epoch;
+
+		/** @brief Last time background cleanup was performed */
+		std::chrono::steady_clock::time_point m_lastCleanupTime;
+
+		/** @brief Loads currently running outside the lock (at most one per loading thread) */
+		std::vector<PendingLoad*> m_pendingLoads;
+
+		/** @brief Signalled under m_mutex when a load finishes and when the last waiter of a load leaves */
+		std::condition_variable m_loadSignal;
+
+		Hash m_hasher;
+		KeyEqual m_keyEqual;
+
+		//----------------------------------------------
+		// Slot storage
+		//----------------------------------------------
+
+		/**
+		 * @brief Get a slot by index
+		 * @param index Slot index below m_slotCount
+		 * @return Slot reference
+		 */
+		[[nodiscard]] inline Slot& slotAt( std::uint32_t index ) const noexcept;
+
+		/**
+		 * @brief Take a free slot, allocating a new chunk when needed
+		 * @return Index of an unused slot
+		 */
+		[[nodiscard]] inline std::uint32_t acquireSlot();
+
+		/**
+		 * @brief Destroy a slot's key and value and put it on the free list
+		 * @param index Slot in use, already unlinked and removed from the index
+		 */
+		inline void releaseSlot( std::uint32_t index ) noexcept;
+
+		/**
+		 * @brief Destroy every live key and value
+		 */
+		inline void destroyAll() noexcept;
+
+		/**
+		 * @brief Store a new entry at the head of its expiration class
+		 * @param key The cache key (must not be present)
+		 * @param hash Mixed hash of the key
+		 * @param value Value to move into the slot
+		 * @param expirationClass Class of the entry's sliding expiration
+		 * @param nowTicks Current time in epoch-relative milliseconds
+		 * @return Slot index of the new entry
+		 */
+		inline std::uint32_t insert( const TKey& key, std::uint32_t hash, TValue&& value, std::uint8_t expirationClass, std::uint32_t nowTicks );
+
+		//----------------------------------------------
+		// Key index
+		//----------------------------------------------
+
+		/**
+		 * @brief Mix a user hash so its top bits are usable as a bucket index
+		 * @param key Key to hash
+		 * @return Mixed 32-bit hash
+		 */
+		[[nodiscard]] inline std::uint32_t hashOf( const TKey& key ) const;
+
+		/**
+		 * @brief Find the bucket holding a key
+		 * @param key Key to look up
+		 * @param hash Mixed hash of the key
+		 * @return Bucket index, or m_buckets.size() if not found
+		 */
+		[[nodiscard]] inline std::size_t findBucket( const TKey& key, std::uint32_t hash ) const;
+
+		/**
+		 * @brief Add a slot to the index (the index must have room)
+		 * @param slot Slot index
+		 * @param hash Mixed hash of the slot's key
+		 */
+		inline void insertBucket( std::uint32_t slot, std::uint32_t hash ) noexcept;
+
+		/**
+		 * @brief Remove a bucket, shifting the following probe run back into the hole
+		 * @param bucket Bucket index
+		 */
+		inline void eraseBucket( std::size_t bucket ) noexcept;
+
+		/**
+		 * @brief Resize the index for a number of entries under the 3/4 maximum load factor
+		 * @param count Number of entries to hold
+		 */
+		inline void reserveBuckets( std::size_t count );
+
+		//----------------------------------------------
+		// Recency and expiration
+		//----------------------------------------------
+
+		/**
+		 * @brief Convert a time to epoch-relative milliseconds, rebasing timestamps when the epoch gets old
+		 * @param now Current time
+		 * @return Milliseconds since m_epoch
+		 */
+		[[nodiscard]] inline std::uint32_t ticksAt( std::chrono::steady_clock::time_point now ) noexcept;
+
+		/**
+		 * @brief Get the class of a sliding expiration, adding it if there is room
+		 * @param expiration Sliding expiration
+		 * @return Class index (the closest shorter class when the table is full)
+		 */
+		[[nodiscard]] inline std::uint8_t classFor( std::chrono::milliseconds expiration );
+
+		/**
+		 * @brief Check if a slot's entry has expired
+		 * @param index Slot in use
+		 * @param nowTicks Current time in epoch-relative milliseconds
+		 * @return True if the entry is strictly older than its sliding expiration
+		 */
+		[[nodiscard]] inline bool isExpired( std::uint32_t index, std::uint32_t nowTicks ) const noexcept;
+
+		/**
+		 * @brief Link a slot at the head of its expiration class
+		 * @param index Slot in use, not linked
+		 */
+		inline void linkFront( std::uint32_t index ) noexcept;
+
+		/**
+		 * @brief Unlink a slot from its expiration class
+		 * @param index Linked slot
+		 */
+		inline void unlink( std::uint32_t index ) noexcept;
+
+		/**
+		 * @brief Renew a slot's expiration and mark it most recently used
+		 * @param index Linked slot
+		 * @param nowTicks Current time in epoch-relative milliseconds
+		 */
+		inline void touch( std::uint32_t index, std::uint32_t nowTicks ) noexcept;
+
+		/**
+		 * @brief Remove an entry through its index bucket
+		 * @param bucket Bucket of the entry
+		 */
+		inline void eraseAt( std::size_t bucket ) noexcept;
+
+		/**
+		 * @brief Remove the entry stored in a slot
+		 * @param index Slot in use
+		 */
+		inline void eraseSlot( std::uint32_t index );
+
+		/**
+		 * @brief Evict least recently used entries until a new entry fits the size limit
+		 */
+		inline void evictUntilFits();
+
+		/**
+		 * @brief Remove expired entries from the tail of every expiration class
+		 * @param nowTicks Current time in epoch-relative milliseconds
+		 * @param budget Maximum number of entries to remove
+		 */
+		inline void expire( std::uint32_t nowTicks, std::size_t budget );
+
+		/**
+		 * @brief Check if background cleanup should run and perform it if needed
+		 * @param now Current time, read once by the calling operation
+		 */
+		inline void checkAndPerformBackgroundCleanup( std::chrono::steady_clock::time_point now );
+
+		//----------------------------------------------
+		// Single-flight loading
+		//----------------------------------------------
+
+		/**
+		 * @brief Find the in-flight load for a key
+		 * @param key The key to look up
+		 * @return Pending load state, or nullptr if the key is not being loaded
+		 * @note Must be called with m_mutex held
+		 */
+		[[nodiscard]] inline PendingLoad* findPendingLoad( const TKey& key ) const;
+
+		/**
+		 * @brief Publish the outcome of an in-flight load, wake its waiters and wait for them to leave
+		 * @param lock Lock holding m_mutex
+		 * @param pending The pending load state
+		 * @param error Exception thrown by the factory, or nullptr on success
+		 */
+		inline void completePendingLoad( std::unique_lock<std::mutex>& lock, PendingLoad& pending, std::exception_ptr error );
+	};
+} // namespace nfx::cache
+
+#include "nfx/detail/cache/CompactLruCache.inl"
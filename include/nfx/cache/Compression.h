@@ -0,0 +1,131 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file Compression.h
+ * @brief Byte codecs compressing the values kept in the second tier of a cache
+ * @details LzCodec is a small LZ77 compressor in the spirit of LZ4: greedy matching through a
+ *          hash table of recent positions, and a block of sequences each made of a token byte,
+ *          literal bytes and a back-reference. It favours speed over ratio, which suits values
+ *          that are compressed on eviction and decompressed on the request path.
+ *          CompressionCodec wraps any pair of functions with the same signatures, so a cache
+ *          can use another library instead.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// LzCodec struct
+	//=====================================================================
+
+	/**
+	 * @brief Built-in LZ77 block compressor
+	 * @details A block starts with the uncompressed length as a varint, followed by sequences:
+	 *          a token (literal count in the high nibble, match length minus 4 in the low one,
+	 *          15 meaning more length bytes follow), the literals, then a 16-bit match offset.
+	 *          The last sequence has literals only.
+	 */
+	struct LzCodec final
+	{
+		/** @brief Shortest back-reference emitted */
+		static constexpr std::size_t MIN_MATCH = 4;
+
+		/** @brief Farthest back-reference emitted */
+		static constexpr std::size_t MAX_OFFSET = 65535;
+
+		/** @brief Number of bits of the match finder's hash table index */
+		static constexpr unsigned HASH_BITS = 12;
+
+		/**
+		 * @brief Compress bytes into a block
+		 * @param input Bytes to compress
+		 * @param output Buffer the block is appended to
+		 */
+		static inline void compress( std::span<const std::byte> input, std::vector<std::byte>& output );
+
+		/**
+		 * @brief Decompress a block
+		 * @param input Block written by compress()
+		 * @param output Buffer the original bytes are appended to
+		 * @throws std::runtime_error if input is not a valid block
+		 */
+		static inline void decompress( std::span<const std::byte> input, std::vector<std::byte>& output );
+
+	private:
+		/**
+		 * @brief Append the part of a length that did not fit in its token nibble
+		 * @param output Buffer to append to
+		 * @param length Length minus 15, written as 255-valued bytes and a final smaller byte
+		 */
+		static inline void writeExtraLength( std::vector<std::byte>& output, std::size_t length );
+
+		/**
+		 * @brief Read the part of a length that did not fit in its token nibble
+		 * @param input Block being decoded
+		 * @param position Read position, advanced past the length bytes
+		 * @return Length to add to 15
+		 * @throws std::runtime_error if the block ends inside the length
+		 */
+		[[nodiscard]] static inline std::size_t readExtraLength( std::span<const std::byte> input, std::size_t& position );
+
+		/**
+		 * @brief Hash the 4 bytes at a position into the match finder's table
+		 * @param data Start of the 4 bytes
+		 * @return Table index
+		 */
+		[[nodiscard]] static inline std::uint32_t hashAt( const std::byte* data ) noexcept;
+	};
+
+	//=====================================================================
+	// CompressionCodec struct
+	//=====================================================================
+
+	/**
+	 * @brief Pair of functions compressing and decompressing byte buffers
+	 * @details Defaults to LzCodec. Both functions append to their output buffer, and decompress()
+	 *          reports malformed input by throwing. They are called without the cache lock held,
+	 *          possibly from several threads at once.
+	 */
+	struct CompressionCodec final
+	{
+		/** @brief Function transforming input and appending the result to output */
+		using Function = std::function<void( std::span<const std::byte> input, std::vector<std::byte>& output )>;
+
+		/** @brief Compresses the serialized value */
+		Function compress{ &LzCodec::compress };
+
+		/** @brief Restores the serialized value from what compress() produced */
+		Function decompress{ &LzCodec::decompress };
+	};
+} // namespace nfx::cache
+
+#include "nfx/detail/cache/Compression.inl"
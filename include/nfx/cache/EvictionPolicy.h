@@ -0,0 +1,490 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file EvictionPolicy.h
+ * @brief Eviction policies selecting which cache entry to drop when a limit is reached
+ * @details Policies order entries through the intrusive links of CacheEntry and are plugged
+ *          into LruCache as a template parameter. Every policy provides:
+ *          - a constructor taking the cache's size limit (0 = bounded by memory only)
+ *          - onInsert( entry, hashOf ) / onAccess( entry, hashOf ) / onRemove( entry )
+ *          - victim( hashOf ) returning the next entry to evict (nullptr when empty)
+ *          - onSkip( entry ) passing over a victim that cannot be evicted, without counting a use
+ *          - clear()
+ *          hashOf( entry ) returns the key hash of an entry, for frequency-based policies.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "nfx/cache/CacheEntry.h"
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// PolicyList class
+	//=====================================================================
+
+	/** @brief Intrusive doubly-linked list of cache entries, most recent first */
+	class PolicyList final
+	{
+	public:
+		//----------------------------------------------
+		// Modification operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Link an entry at the front (most recent end)
+		 * @param entry Entry that is not in any list
+		 */
+		inline void pushFront( CacheEntry* entry ) noexcept;
+
+		/**
+		 * @brief Unlink an entry
+		 * @param entry Entry in this list
+		 */
+		inline void remove( CacheEntry* entry ) noexcept;
+
+		/**
+		 * @brief Move an entry to the front
+		 * @param entry Entry in this list
+		 */
+		inline void moveToFront( CacheEntry* entry ) noexcept;
+
+		/** @brief Forget every entry without unlinking them individually */
+		inline void clear() noexcept;
+
+		//----------------------------------------------
+		// State inspection
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the most recent entry
+		 * @return Front entry, or nullptr if empty
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline CacheEntry* front() const noexcept;
+
+		/**
+		 * @brief Get the least recent entry
+		 * @return Back entry, or nullptr if empty
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline CacheEntry* back() const noexcept;
+
+		/**
+		 * @brief Get the number of linked entries
+		 * @return Entry count
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t size() const noexcept;
+
+	private:
+		/** @brief Most recent entry */
+		CacheEntry* m_head{ nullptr };
+
+		/** @brief Least recent entry */
+		CacheEntry* m_tail{ nullptr };
+
+		/** @brief Number of linked entries */
+		std::size_t m_size{ 0 };
+	};
+
+	//=====================================================================
+	// FrequencySketch class
+	//=====================================================================
+
+	/**
+	 * @brief Count-min sketch estimating how often a key hash was seen recently
+	 * @details Four rows of counters saturating at 15, each row four counters wide per expected
+	 *          entry to keep collisions rare. All counters are halved once the number of increments
+	 *          reaches ten times the expected entry count, so old popularity fades out.
+	 */
+	class FrequencySketch final
+	{
+	public:
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct a sketch sized for a number of distinct keys
+		 * @param capacity Expected number of entries in the cache
+		 */
+		inline explicit FrequencySketch( std::size_t capacity = 0 );
+
+		//----------------------------------------------
+		// Operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Widen the sketch if it is too narrow for a number of entries (counts are reset)
+		 * @param capacity Number of entries the sketch should handle
+		 */
+		inline void ensureCapacity( std::size_t capacity );
+
+		/**
+		 * @brief Record one occurrence of a key
+		 * @param hash Key hash
+		 */
+		inline void increment( std::size_t hash ) noexcept;
+
+		/**
+		 * @brief Estimate the recent frequency of a key
+		 * @param hash Key hash
+		 * @return Estimated count (0 to 15)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::uint8_t frequency( std::size_t hash ) const noexcept;
+
+		/** @brief Reset every counter */
+		inline void clear() noexcept;
+
+	private:
+		//----------------------------------------------
+		// Constants
+		//----------------------------------------------
+
+		/** @brief Number of counter rows */
+		static constexpr std::size_t DEPTH = 4;
+
+		/** @brief Saturation value of a counter */
+		static constexpr std::uint8_t MAX_COUNT = 15;
+
+		/** @brief Counter columns per expected entry */
+		static constexpr std::size_t COLUMNS_PER_ENTRY = 4;
+
+		/** @brief Increments per expected entry before all counters are halved */
+		static constexpr std::size_t SAMPLE_FACTOR = 10;
+
+		/** @brief Per-row hash multipliers */
+		static constexpr std::array<std::uint64_t, DEPTH> SEEDS{ 0xC3A5C85C97CB3127ull, 0xB492B66FBE98F273ull, 0x9AE16A3B2F90404Full, 0xCBF29CE484222325ull };
+
+		//----------------------------------------------
+		// Private helper methods
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the counter index of a key in a row
+		 * @param hash Key hash
+		 * @param row Row number
+		 * @return Index into m_counters
+		 */
+		[[nodiscard]] inline std::size_t indexOf( std::size_t hash, std::size_t row ) const noexcept;
+
+		/** @brief Halve every counter */
+		inline void age() noexcept;
+
+		/** @brief Counters, DEPTH rows of m_width columns */
+		std::vector<std::uint8_t> m_counters;
+
+		/** @brief Columns per row (power of two) */
+		std::size_t m_width{ 0 };
+
+		/** @brief Increments since the last aging */
+		std::size_t m_additions{ 0 };
+	};
+
+	//=====================================================================
+	// LruPolicy class
+	//=====================================================================
+
+	/** @brief Least recently used eviction (default) */
+	class LruPolicy final
+	{
+	public:
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/** @brief Construct an empty policy */
+		inline explicit LruPolicy( std::size_t capacity = 0 ) noexcept;
+
+		//----------------------------------------------
+		// Policy operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Track a newly inserted entry
+		 * @param entry Entry that is not tracked yet
+		 * @param hashOf Callable returning the key hash of an entry
+		 */
+		template <typename EntryHash>
+		inline void onInsert( CacheEntry* entry, const EntryHash& hashOf ) noexcept;
+
+		/**
+		 * @brief Record a hit on a tracked entry
+		 * @param entry Tracked entry
+		 * @param hashOf Callable returning the key hash of an entry
+		 */
+		template <typename EntryHash>
+		inline void onAccess( CacheEntry* entry, const EntryHash& hashOf ) noexcept;
+
+		/**
+		 * @brief Stop tracking an entry
+		 * @param entry Tracked entry
+		 */
+		inline void onRemove( CacheEntry* entry ) noexcept;
+
+		/**
+		 * @brief Move a victim that cannot be evicted (pinned) past the next victim choices
+		 * @param entry Entry last returned by victim()
+		 * @details Unlike onAccess(), records nothing the policy would count as a use of the entry.
+		 */
+		inline void onSkip( CacheEntry* entry ) noexcept;
+
+		/**
+		 * @brief Select the next entry to evict (the entry stays tracked until onRemove)
+		 * @param hashOf Callable returning the key hash of an entry
+		 * @return Victim entry, or nullptr if no entry is tracked
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		template <typename EntryHash>
+		[[nodiscard]] inline CacheEntry* victim( const EntryHash& hashOf ) noexcept;
+
+		/** @brief Forget every tracked entry */
+		inline void clear() noexcept;
+
+	private:
+		/** @brief Entries by recency */
+		PolicyList m_list;
+	};
+
+	//=====================================================================
+	// SlruPolicy class
+	//=====================================================================
+
+	/**
+	 * @brief Segmented LRU eviction
+	 * @details New entries enter a probation segment and move to a protected segment (80% of the
+	 *          capacity) on their second access. Victims come from probation first, so a one-off
+	 *          scan only churns probation and leaves the protected hot set in place.
+	 */
+	class SlruPolicy final
+	{
+	public:
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct an empty policy
+		 * @param capacity Cache size limit (0 = protected segment sized from the current entry count)
+		 */
+		inline explicit SlruPolicy( std::size_t capacity = 0 ) noexcept;
+
+		//----------------------------------------------
+		// Policy operations
+		//----------------------------------------------
+
+		/** @copydoc LruPolicy::onInsert */
+		template <typename EntryHash>
+		inline void onInsert( CacheEntry* entry, const EntryHash& hashOf ) noexcept;
+
+		/** @copydoc LruPolicy::onAccess */
+		template <typename EntryHash>
+		inline void onAccess( CacheEntry* entry, const EntryHash& hashOf ) noexcept;
+
+		/** @copydoc LruPolicy::onRemove */
+		inline void onRemove( CacheEntry* entry ) noexcept;
+
+		/** @copydoc LruPolicy::onSkip */
+		inline void onSkip( CacheEntry* entry ) noexcept;
+
+		/** @copydoc LruPolicy::victim */
+		template <typename EntryHash>
+		[[nodiscard]] inline CacheEntry* victim( const EntryHash& hashOf ) noexcept;
+
+		/** @copydoc LruPolicy::clear */
+		inline void clear() noexcept;
+
+	private:
+		/** @brief Entry segments stored in CacheEntry::policyState */
+		enum Segment : std::uint8_t
+		{
+			PROBATION = 0,
+			PROTECTED = 1
+		};
+
+		/** @brief Share of the capacity reserved for the protected segment, in percent */
+		static constexpr std::size_t PROTECTED_PERCENT = 80;
+
+		/** @brief Demote least recent protected entries to probation while the segment is over its share */
+		inline void demoteProtectedOverflow() noexcept;
+
+		/** @brief Cache size limit */
+		std::size_t m_capacity;
+
+		/** @brief Entries seen once */
+		PolicyList m_probation;
+
+		/** @brief Entries seen at least twice */
+		PolicyList m_protected;
+	};
+
+	//=====================================================================
+	// ClockPolicy class
+	//=====================================================================
+
+	/**
+	 * @brief CLOCK (second chance) eviction
+	 * @details Entries form a ring; a hit only sets a reference bit instead of relinking the
+	 *          entry. The hand clears reference bits as it sweeps and evicts the first entry
+	 *          found without one.
+	 */
+	class ClockPolicy final
+	{
+	public:
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/** @brief Construct an empty policy */
+		inline explicit ClockPolicy( std::size_t capacity = 0 ) noexcept;
+
+		//----------------------------------------------
+		// Policy operations
+		//----------------------------------------------
+
+		/** @copydoc LruPolicy::onInsert */
+		template <typename EntryHash>
+		inline void onInsert( CacheEntry* entry, const EntryHash& hashOf ) noexcept;
+
+		/** @copydoc LruPolicy::onAccess */
+		template <typename EntryHash>
+		inline void onAccess( CacheEntry* entry, const EntryHash& hashOf ) noexcept;
+
+		/** @copydoc LruPolicy::onRemove */
+		inline void onRemove( CacheEntry* entry ) noexcept;
+
+		/** @copydoc LruPolicy::onSkip */
+		inline void onSkip( CacheEntry* entry ) noexcept;
+
+		/** @copydoc LruPolicy::victim */
+		template <typename EntryHash>
+		[[nodiscard]] inline CacheEntry* victim( const EntryHash& hashOf ) noexcept;
+
+		/** @copydoc LruPolicy::clear */
+		inline void clear() noexcept;
+
+	private:
+		/** @brief Next entry the hand examines (nullptr when the ring is empty) */
+		CacheEntry* m_hand;
+	};
+
+	//=====================================================================
+	// WTinyLfuPolicy class
+	//=====================================================================
+
+	/**
+	 * @brief Window TinyLFU eviction
+	 * @details New entries go to a small LRU window (1% of the capacity). Entries leaving the window
+	 *          join a segmented LRU main space, where they must beat the probation victim's
+	 *          estimated frequency (FrequencySketch) to stay. Recency bursts are absorbed by the
+	 *          window while frequently used entries survive scans.
+	 */
+	class WTinyLfuPolicy final
+	{
+	public:
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct an empty policy
+		 * @param capacity Cache size limit (0 = segments sized from the current entry count)
+		 */
+		inline explicit WTinyLfuPolicy( std::size_t capacity = 0 );
+
+		//----------------------------------------------
+		// Policy operations
+		//----------------------------------------------
+
+		/** @copydoc LruPolicy::onInsert */
+		template <typename EntryHash>
+		inline void onInsert( CacheEntry* entry, const EntryHash& hashOf );
+
+		/** @copydoc LruPolicy::onAccess */
+		template <typename EntryHash>
+		inline void onAccess( CacheEntry* entry, const EntryHash& hashOf ) noexcept;
+
+		/** @copydoc LruPolicy::onRemove */
+		inline void onRemove( CacheEntry* entry ) noexcept;
+
+		/** @copydoc LruPolicy::onSkip */
+		inline void onSkip( CacheEntry* entry ) noexcept;
+
+		/** @copydoc LruPolicy::victim */
+		template <typename EntryHash>
+		[[nodiscard]] inline CacheEntry* victim( const EntryHash& hashOf ) noexcept;
+
+		/** @copydoc LruPolicy::clear */
+		inline void clear() noexcept;
+
+	private:
+		/** @brief Entry segments stored in CacheEntry::policyState */
+		enum Segment : std::uint8_t
+		{
+			WINDOW = 0,
+			PROBATION = 1,
+			PROTECTED = 2
+		};
+
+		/** @brief Share of the capacity given to the admission window, in percent */
+		static constexpr std::size_t WINDOW_PERCENT = 1;
+
+		/** @brief Share of the main space reserved for the protected segment, in percent */
+		static constexpr std::size_t PROTECTED_PERCENT = 80;
+
+		/**
+		 * @brief Get the capacity used to size the segments
+		 * @return Size limit, or the current entry count when unbounded
+		 */
+		[[nodiscard]] inline std::size_t effectiveCapacity() const noexcept;
+
+		/** @brief Demote least recent protected entries to probation while the segment is over its share */
+		inline void demoteProtectedOverflow() noexcept;
+
+		/** @brief Cache size limit */
+		std::size_t m_capacity;
+
+		/** @brief Admission window */
+		PolicyList m_window;
+
+		/** @brief Main space entries seen once since admission */
+		PolicyList m_probation;
+
+		/** @brief Main space entries seen again */
+		PolicyList m_protected;
+
+		/** @brief Recent access frequencies */
+		FrequencySketch m_sketch;
+	};
+} // namespace nfx::cache
+
+#include "nfx/detail/cache/EvictionPolicy.inl"
@@ -0,0 +1,571 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file FlatHashMap.h
+ * @brief Open-addressing hash map with SIMD control byte probing and stable element addresses
+ * @details Swiss-table style index: one control byte per slot holding 7 bits of the hash, probed
+ *          16 slots at a time (SSE2 when available, scalar otherwise). Slots hold pointers to
+ *          individually allocated elements, so element addresses survive rehashing.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if !defined( NFX_LRUCACHE_DISABLE_SIMD ) && ( defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 ) )
+#	define NFX_LRUCACHE_HAS_SSE2 1
+#	include <emmintrin.h>
+#endif
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// Heterogeneous lookup
+	//=====================================================================
+
+	/**
+	 * @brief Satisfied when Hash and KeyEqual both declare is_transparent, so lookups may use any
+	 *        type they accept (e.g. std::string_view for std::string keys) without building a key
+	 */
+	template <typename Hash, typename KeyEqual>
+	concept TransparentKeyLookup = requires {
+		typename Hash::is_transparent;
+		typename KeyEqual::is_transparent;
+	};
+
+	/**
+	 * @brief Satisfied by the key type itself, and by any type usable with transparent Hash and KeyEqual
+	 */
+	template <typename K, typename TKey, typename Hash, typename KeyEqual>
+	concept LookupKeyFor = std::same_as<K, TKey> || TransparentKeyLookup<Hash, KeyEqual>;
+
+	//=====================================================================
+	// FlatHashGroup struct
+	//=====================================================================
+
+	/**
+	 * @brief Group of control bytes probed together by FlatHashMap
+	 * @details Each probe function returns a bit mask with bit i set when control byte i matches.
+	 *          The scalar variants are always available; match() dispatches to SSE2 when compiled in
+	 *          (define NFX_LRUCACHE_DISABLE_SIMD to force the scalar path).
+	 */
+	struct FlatHashGroup final
+	{
+		//----------------------------------------------
+		// Constants
+		//----------------------------------------------
+
+		/** @brief Number of control bytes in a group */
+		static constexpr std::size_t WIDTH = 16;
+
+		/** @brief Control byte of a slot that has never been used */
+		static constexpr std::int8_t EMPTY = -128;
+
+		/** @brief Control byte of a slot whose element was erased (tombstone) */
+		static constexpr std::int8_t DELETED = -2;
+
+		//----------------------------------------------
+		// Probing
+		//----------------------------------------------
+
+		/**
+		 * @brief Find slots whose control byte equals a hash fragment
+		 * @param ctrl First control byte of the group
+		 * @param h2 7-bit hash fragment
+		 * @return Bit mask of matching slots
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] static inline std::uint32_t match( const std::int8_t* ctrl, std::int8_t h2 ) noexcept;
+
+		/**
+		 * @brief Find empty slots
+		 * @param ctrl First control byte of the group
+		 * @return Bit mask of empty slots
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] static inline std::uint32_t matchEmpty( const std::int8_t* ctrl ) noexcept;
+
+		/**
+		 * @brief Find empty or deleted slots
+		 * @param ctrl First control byte of the group
+		 * @return Bit mask of free slots
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] static inline std::uint32_t matchEmptyOrDeleted( const std::int8_t* ctrl ) noexcept;
+
+		/** @copydoc match */
+		[[nodiscard]] static inline std::uint32_t matchScalar( const std::int8_t* ctrl, std::int8_t h2 ) noexcept;
+
+		/** @copydoc matchEmpty */
+		[[nodiscard]] static inline std::uint32_t matchEmptyScalar( const std::int8_t* ctrl ) noexcept;
+
+		/** @copydoc matchEmptyOrDeleted */
+		[[nodiscard]] static inline std::uint32_t matchEmptyOrDeletedScalar( const std::int8_t* ctrl ) noexcept;
+	};
+
+	//=====================================================================
+	// FlatHashMap class
+	//=====================================================================
+
+	/**
+	 * @brief Open-addressing hash map with stable element addresses
+	 * @tparam TKey Key type
+	 * @tparam TValue Mapped type
+	 * @tparam Hash Hash function for TKey
+	 * @tparam KeyEqual Equality comparison for TKey
+	 * @tparam Allocator Allocator for elements (rebound for the control and slot arrays)
+	 * @details Implements the subset of the std::unordered_map interface LruCache relies on.
+	 *          A lookup miss usually reads a single 16-byte control group and no element at all.
+	 *          Iterators and references stay valid across inserts; erase() only invalidates the
+	 *          erased element. Not thread-safe.
+	 */
+	template <typename TKey,
+		typename TValue,
+		typename Hash = std::hash<TKey>,
+		typename KeyEqual = std::equal_to<TKey>,
+		typename Allocator = std::allocator<std::pair<const TKey, TValue>>>
+	class FlatHashMap final
+	{
+	public:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		using key_type = TKey;
+		using mapped_type = TValue;
+		using value_type = std::pair<const TKey, TValue>;
+		using size_type = std::size_t;
+		using hasher = Hash;
+		using key_equal = KeyEqual;
+		using allocator_type = Allocator;
+
+		//----------------------------------------------
+		// Iterators
+		//----------------------------------------------
+
+		/** @brief Forward iterator over the occupied slots */
+		template <bool IsConst>
+		class Iterator final
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = typename FlatHashMap::value_type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+			using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+			/** @brief Construct a singular iterator */
+			Iterator() = default;
+
+			/** @brief Convert a mutable iterator to a const iterator */
+			template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+			Iterator( const Iterator<OtherConst>& other ) noexcept
+				: m_ctrl{ other.m_ctrl },
+				  m_slot{ other.m_slot },
+				  m_end{ other.m_end }
+			{
+			}
+
+			[[nodiscard]] reference operator*() const noexcept { return **m_slot; }
+			[[nodiscard]] pointer operator->() const noexcept { return *m_slot; }
+
+			Iterator& operator++() noexcept
+			{
+				++m_ctrl;
+				++m_slot;
+				skipFreeSlots();
+
+				return *this;
+			}
+
+			Iterator operator++( int ) noexcept
+			{
+				Iterator previous{ *this };
+				++*this;
+
+				return previous;
+			}
+
+			[[nodiscard]] bool operator==( const Iterator& other ) const noexcept { return m_ctrl == other.m_ctrl; }
+
+		private:
+			friend class FlatHashMap;
+
+			template <bool>
+			friend class Iterator;
+
+			Iterator( const std::int8_t* ctrl, value_type* const* slot, const std::int8_t* end ) noexcept
+				: m_ctrl{ ctrl },
+				  m_slot{ slot },
+				  m_end{ end }
+			{
+			}
+
+			void skipFreeSlots() noexcept
+			{
+				while ( m_ctrl != m_end && *m_ctrl < 0 )
+				{
+					++m_ctrl;
+					++m_slot;
+				}
+			}
+
+			const std::int8_t* m_ctrl{ nullptr };
+			value_type* const* m_slot{ nullptr };
+			const std::int8_t* m_end{ nullptr };
+		};
+
+		using iterator = Iterator<false>;
+		using const_iterator = Iterator<true>;
+
+		//----------------------------------------------
+		// Node handle
+		//----------------------------------------------
+
+		/**
+		 * @brief Owner of an element extracted from the map
+		 * @details The element keeps its address and is destroyed with the handle, like the node
+		 *          handles of std::unordered_map. Must not outlive the allocator's resource.
+		 */
+		class NodeHandle final
+		{
+		public:
+			/** @brief Construct an empty handle */
+			NodeHandle() = default;
+
+			NodeHandle( const NodeHandle& ) = delete;
+			NodeHandle& operator=( const NodeHandle& ) = delete;
+
+			NodeHandle( NodeHandle&& other ) noexcept
+				: m_node{ std::exchange( other.m_node, nullptr ) },
+				  m_allocator{ other.m_allocator }
+			{
+			}
+
+			NodeHandle& operator=( NodeHandle&& other ) noexcept
+			{
+				if ( this != &other )
+				{
+					reset();
+					m_node = std::exchange( other.m_node, nullptr );
+					m_allocator = other.m_allocator;
+				}
+
+				return *this;
+			}
+
+			/** @brief Destroy the owned element, if any */
+			~NodeHandle() { reset(); }
+
+			[[nodiscard]] bool empty() const noexcept { return m_node == nullptr; }
+			[[nodiscard]] explicit operator bool() const noexcept { return m_node != nullptr; }
+			[[nodiscard]] const key_type& key() const noexcept { return m_node->first; }
+			[[nodiscard]] mapped_type& mapped() const noexcept { return m_node->second; }
+
+		private:
+			friend class FlatHashMap;
+
+			/** @brief Allocator of the owned element (the map's NodeAllocator) */
+			using ElementAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
+
+			NodeHandle( value_type* node, const ElementAllocator& allocator ) noexcept
+				: m_node{ node },
+				  m_allocator{ allocator }
+			{
+			}
+
+			void reset() noexcept
+			{
+				if ( m_node != nullptr )
+				{
+					std::allocator_traits<ElementAllocator>::destroy( m_allocator, m_node );
+					std::allocator_traits<ElementAllocator>::deallocate( m_allocator, m_node, 1 );
+					m_node = nullptr;
+				}
+			}
+
+			value_type* m_node{ nullptr };
+			ElementAllocator m_allocator{};
+		};
+
+		using node_type = NodeHandle;
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct an empty map
+		 * @param capacity Number of elements to reserve room for
+		 * @param hash Hash function
+		 * @param equal Key equality comparison
+		 * @param allocator Element allocator
+		 */
+		inline explicit FlatHashMap( size_type capacity = 0,
+			const Hash& hash = Hash{},
+			const KeyEqual& equal = KeyEqual{},
+			const Allocator& allocator = Allocator{} );
+
+		//----------------------------------------------
+		// Copy and move operations
+		//----------------------------------------------
+
+		FlatHashMap( const FlatHashMap& ) = delete;
+		FlatHashMap( FlatHashMap&& ) = delete;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		FlatHashMap& operator=( const FlatHashMap& ) = delete;
+		FlatHashMap& operator=( FlatHashMap&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		/** @brief Destroy all elements */
+		inline ~FlatHashMap();
+
+		//----------------------------------------------
+		// Iteration
+		//----------------------------------------------
+
+		[[nodiscard]] inline iterator begin() noexcept;
+		[[nodiscard]] inline const_iterator begin() const noexcept;
+		[[nodiscard]] inline iterator end() noexcept;
+		[[nodiscard]] inline const_iterator end() const noexcept;
+
+		//----------------------------------------------
+		// Lookup operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Find an element by key
+		 * @param key Key to look up
+		 * @return Iterator to the element, or end() if not found
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline iterator find( const TKey& key );
+
+		/** @copydoc find */
+		[[nodiscard]] inline const_iterator find( const TKey& key ) const;
+
+		/**
+		 * @brief Find an element by any key comparable to TKey (transparent Hash and KeyEqual only)
+		 * @param key Key to look up, hashing and comparing equal to the stored key
+		 * @return Iterator to the element, or end() if not found
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		template <typename K>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		[[nodiscard]] inline iterator find( const K& key );
+
+		/** @copydoc find( const K& ) */
+		template <typename K>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		[[nodiscard]] inline const_iterator find( const K& key ) const;
+
+		/**
+		 * @brief Find an element by key with a hash computed beforehand
+		 * @param key Key to look up (TKey, or any comparable type with transparent Hash and KeyEqual)
+		 * @param hash Value returned by hash_code( key )
+		 * @return Iterator to the element, or end() if not found
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		template <typename K>
+			requires LookupKeyFor<K, TKey, Hash, KeyEqual>
+		[[nodiscard]] inline iterator find( const K& key, std::uint64_t hash );
+
+		/**
+		 * @brief Compute the hash used to place a key
+		 * @param key Key to hash (TKey, or any comparable type with transparent Hash and KeyEqual)
+		 * @return Mixed hash, valid for find( key, hash ) and prefetch( hash ) until the map is destroyed
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		template <typename K>
+			requires LookupKeyFor<K, TKey, Hash, KeyEqual>
+		[[nodiscard]] inline std::uint64_t hash_code( const K& key ) const;
+
+		/**
+		 * @brief Start loading the first group probed for a hash into the cache
+		 * @param hash Value returned by hash_code()
+		 * @details Lets batched lookups overlap the memory latency of several keys: prefetch a few
+		 *          keys ahead, then find() each one once its group is likely resident.
+		 */
+		inline void prefetch( std::uint64_t hash ) const noexcept;
+
+		//----------------------------------------------
+		// Modification operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Insert an element constructed from args if the key is not present
+		 * @param key Key to insert
+		 * @param args Arguments forwarded to the TValue constructor
+		 * @return Iterator to the element with this key, and true if it was inserted
+		 */
+		template <typename... Args>
+		inline std::pair<iterator, bool> try_emplace( const TKey& key, Args&&... args );
+
+		/**
+		 * @brief Erase the element at an iterator
+		 * @param pos Iterator to a valid element
+		 * @return Iterator following the erased element
+		 */
+		inline iterator erase( const_iterator pos );
+
+		/**
+		 * @brief Remove the element at an iterator without destroying it
+		 * @param pos Iterator to a valid element
+		 * @return Handle owning the element, which keeps its address
+		 */
+		inline node_type extract( const_iterator pos );
+
+		/** @brief Erase all elements (capacity is kept) */
+		inline void clear() noexcept;
+
+		/**
+		 * @brief Make room for at least count elements without rehashing
+		 * @param count Number of elements
+		 */
+		inline void reserve( size_type count );
+
+		//----------------------------------------------
+		// State inspection
+		//----------------------------------------------
+
+		[[nodiscard]] inline size_type size() const noexcept;
+		[[nodiscard]] inline bool empty() const noexcept;
+
+		/**
+		 * @brief Get the number of slots
+		 * @return Slot count (a multiple of FlatHashGroup::WIDTH, or 0)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline size_type capacity() const noexcept;
+
+		[[nodiscard]] inline hasher hash_function() const;
+		[[nodiscard]] inline key_equal key_eq() const;
+
+	private:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
+		using NodeTraits = std::allocator_traits<NodeAllocator>;
+		using CtrlAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::int8_t>;
+		using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type*>;
+
+		//----------------------------------------------
+		// Probing helpers
+		//----------------------------------------------
+
+		/**
+		 * @brief Scramble a user hash so both the group index and the 7-bit fragment are well mixed
+		 * @param key Key to hash
+		 * @return Mixed hash
+		 */
+		template <typename K>
+		[[nodiscard]] inline std::uint64_t hashOf( const K& key ) const;
+
+		/**
+		 * @brief Find the slot holding a key
+		 * @param key Key to look up
+		 * @param hash Mixed hash of the key
+		 * @return Slot index, or capacity() if not found
+		 */
+		template <typename K>
+		[[nodiscard]] inline size_type findSlot( const K& key, std::uint64_t hash ) const;
+
+		/**
+		 * @brief Find the first empty or deleted slot on the probe sequence of a hash
+		 * @param hash Mixed hash
+		 * @return Slot index
+		 */
+		[[nodiscard]] inline size_type findFreeSlot( std::uint64_t hash ) const noexcept;
+
+		/**
+		 * @brief Rebuild the index with a new slot count, dropping tombstones
+		 * @param newCapacity New slot count (a power of two, at least FlatHashGroup::WIDTH)
+		 * @details Elements are not moved, only their pointers are reinserted.
+		 */
+		inline void rehash( size_type newCapacity );
+
+		/**
+		 * @brief Get the slot count needed to hold count elements under the maximum load factor
+		 * @param count Number of elements
+		 * @return Slot count
+		 */
+		[[nodiscard]] static inline size_type capacityFor( size_type count ) noexcept;
+
+		/**
+		 * @brief Empty a slot, leaving a tombstone only where a probe chain may run through it
+		 * @param slot Index of an occupied slot
+		 * @return The element that occupied the slot
+		 */
+		inline value_type* releaseSlot( size_type slot ) noexcept;
+
+		/** @brief Destroy and deallocate one element */
+		inline void destroyNode( value_type* node ) noexcept;
+
+		//----------------------------------------------
+		// Data members
+		//----------------------------------------------
+
+		/** @brief One control byte per slot: EMPTY, DELETED or the 7-bit hash fragment of its element */
+		std::vector<std::int8_t, CtrlAllocator> m_ctrl;
+
+		/** @brief Element pointer per slot */
+		std::vector<value_type*, SlotAllocator> m_slots;
+
+		/** @brief Number of elements */
+		size_type m_size;
+
+		/** @brief Number of empty slots that can still be filled before the load factor is exceeded */
+		size_type m_growthLeft;
+
+		/** @brief Hash function */
+		Hash m_hasher;
+
+		/** @brief Key equality comparison */
+		KeyEqual m_keyEqual;
+
+		/** @brief Element allocator */
+		NodeAllocator m_nodeAllocator;
+	};
+} // namespace nfx::cache
+
+#include "nfx/detail/cache/FlatHashMap.inl"
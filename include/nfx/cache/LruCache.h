@@ -29,11 +29,39 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstdint>
+#include <coroutine>
+#include <exception>
+#include <filesystem>
 #include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <ranges>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "nfx/cache/CacheEntry.h"
+#include "nfx/cache/CacheStats.h"
+#include "nfx/cache/Clock.h"
+#include "nfx/cache/Compression.h"
+#include "nfx/cache/EvictionPolicy.h"
+#include "nfx/cache/FlatHashMap.h"
+#include "nfx/cache/MaintenanceScheduler.h"
+#include "nfx/cache/SlabAllocator.h"
+#include "nfx/cache/Snapshot.h"
 
 namespace nfx::cache
 {
@@ -46,6 +74,13 @@ namespace nfx::cache
 	 */
 	struct LruCacheOptions final
 	{
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		/** @brief Executor running background reloads and loads: receives a task to run exactly once, on any thread */
+		using Executor = std::function<void( std::function<void()> )>;
+
 		//----------------------------------------------
 		// Construction
 		//----------------------------------------------
@@ -86,271 +121,2267 @@ namespace nfx::cache
 		 */
 		[[nodiscard]] inline std::chrono::milliseconds backgroundCleanupInterval() const;
 
-	private:
-		/** Maximum number of entries allowed in cache (0 = unlimited) */
-		std::size_t m_sizeLimit{ 0 };
+		/**
+		 * @brief Get the maximum total size of cache entries allowed
+		 * @return Memory limit as the sum of CacheEntry::size values (0 = unlimited)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t memoryLimit() const;
 
-		/** Default time after last access before entries expire */
-		std::chrono::milliseconds m_slidingExpiration{ std::chrono::minutes{ 60 } };
+		/**
+		 * @brief Check if the read-optimized mode is enabled
+		 * @return True if cache hits are served under a shared lock with buffered recency updates
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline bool readOptimized() const;
 
-		/*
-		 * Background cleanup design:
-		 * - When enabled (interval > 0), cache tracks last cleanup time
-		 * - During get/find operations, checks if cleanup interval has elapsed
-		 * - If elapsed, performs incremental cleanup of expired entries
-		 * - Amortizes cleanup cost across normal operations without requiring separate thread
-		 * - Ideal for write-heavy scenarios with unique keys (logging, batch processing)
-		 * - For very low-activity caches, still requires occasional manual cleanupExpired() calls
+		/**
+		 * @brief Check if slab node storage is enabled
+		 * @return True if entries live in a preallocated, recycled slab of nodes
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
 		 */
-		std::chrono::milliseconds m_backgroundCleanupInterval{ std::chrono::milliseconds{ 0 } };
-	};
+		[[nodiscard]] inline bool slabStorage() const;
 
-	//=====================================================================
-	// CacheEntry struct
-	//=====================================================================
+		/**
+		 * @brief Check if the cache runs its maintenance on a dedicated thread
+		 * @return True if the cache owns a maintenance thread
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline bool maintenanceThread() const;
 
-	/** @brief Cache entry metadata with intrusive LRU list support */
-	struct CacheEntry final
-	{
-		/** @brief Timestamp of the last access to this cache entry */
-		std::chrono::steady_clock::time_point lastAccessed;
+		/**
+		 * @brief Get the shared scheduler running the cache's maintenance
+		 * @return Scheduler, or nullptr if none was set
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline MaintenanceScheduler* maintenanceScheduler() const;
 
-		/** @brief Sliding expiration time for this specific entry */
-		std::chrono::milliseconds slidingExpiration;
+		/**
+		 * @brief Get the number of expired entries removed per background cleanup cycle
+		 * @return Entries per cycle (the starting point in adaptive mode)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t cleanupBudget() const;
 
-		/** @brief Size of this cache entry for memory accounting */
-		std::size_t size{ 1 };
+		/**
+		 * @brief Check if the background cleanup budget adapts to the expiration backlog
+		 * @return True if adaptive cleanup is enabled
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline bool adaptiveCleanup() const;
 
-		/** @brief Previous entry in the LRU doubly-linked list */
-		CacheEntry* lruPrev{ nullptr };
+		/**
+		 * @brief Get the time an adaptive background cleanup cycle may take
+		 * @return Time budget per cycle
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::chrono::microseconds cleanupTimeBudget() const;
 
-		/** @brief Next entry in the LRU doubly-linked list */
-		CacheEntry* lruNext{ nullptr };
+		/**
+		 * @brief Get the age at which a get() hit reloads the entry in the background
+		 * @return Time since the value was stored (0 = refresh-ahead disabled)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::chrono::milliseconds refreshAfter() const;
 
-		/** @brief Pointer to the key for this cache entry */
-		const void* keyPtr{ nullptr };
+		/**
+		 * @brief Get how long get() keeps serving an expired value while it is reloaded
+		 * @return Stale-serve window after expiration (0 = expired entries are reloaded synchronously)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::chrono::milliseconds staleWhileRevalidate() const;
 
-		//----------------------------------------------
-		// Construction
-		//----------------------------------------------
+		/**
+		 * @brief Get the default time to live of entries, counted from when their value was stored
+		 * @return Absolute expiration, used by the Absolute and SlidingAndAbsolute modes
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::chrono::milliseconds absoluteExpiration() const;
 
 		/**
-		 * @brief Construct cache entry with specified expiration time
-		 * @param expiration Sliding expiration time for this entry
+		 * @brief Get the default expiration mode of entries
+		 * @return Whether entries expire after their last access, after they were stored, or both
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
 		 */
-		inline CacheEntry( std::chrono::milliseconds expiration = std::chrono::hours( 1 ) );
+		[[nodiscard]] inline ExpirationMode expirationMode() const;
 
-		//----------------------------------------------
-		// Expiration checking
-		//----------------------------------------------
+		/**
+		 * @brief Get how long get() remembers that a key has no value
+		 * @return Time to live of tombstones (0 = negative caching disabled)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::chrono::milliseconds negativeExpiration() const;
 
 		/**
-		 * @brief Check if this cache entry has expired based on sliding expiration
-		 * @return True if the entry has expired and should be evicted, false otherwise
+		 * @brief Get the maximum number of tombstones kept
+		 * @return Tombstone limit (0 = unlimited)
 		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
 		 */
-		[[nodiscard]] inline bool isExpired() const noexcept;
+		[[nodiscard]] inline std::size_t negativeSizeLimit() const;
 
-		//----------------------------------------------
-		// Access management
-		//----------------------------------------------
+		/**
+		 * @brief Get the budget of the compressed second tier
+		 * @return Maximum sum of compressed value sizes, in bytes (0 = second tier disabled)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t secondTierMemoryLimit() const;
 
 		/**
-		 * @brief Update the last accessed timestamp to current time
-		 * @details Resets the sliding expiration timer for this cache entry
+		 * @brief Get the serialized size below which evicted values are not kept in the second tier
+		 * @return Minimum serialized size, in bytes
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
 		 */
-		void inline touch() noexcept;
-	};
+		[[nodiscard]] inline std::size_t secondTierMinimumSize() const;
 
-	//=====================================================================
-	// LruCache class
-	//=====================================================================
+		/**
+		 * @brief Get the codec compressing the values of the second tier
+		 * @return Codec, LzCodec by default
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline const CompressionCodec& secondTierCodec() const;
+
+		/**
+		 * @brief Get the executor running background reloads
+		 * @return Executor, or an empty function for a new thread per reload
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline const Executor& refreshExecutor() const;
+
+		/**
+		 * @brief Get the executor running the loads of getAsync() and getFuture() misses
+		 * @return Executor, or an empty function for a new thread per load
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline const Executor& loadExecutor() const;
 
-	/**
-	 * @brief Thread-safe memory cache with size limits and expiration policies
-	 * @tparam TKey Key type for cache entries
-	 * @tparam TValue Value type for cached objects
-	 */
-	template <typename TKey, typename TValue>
-	class LruCache final
-	{
-	public:
 		//----------------------------------------------
-		// Type aliases
+		// Configuration
 		//----------------------------------------------
 
-		/** @brief Function type for creating cache values when not found */
-		using FactoryFunction = std::function<TValue()>;
+		/**
+		 * @brief Set the maximum number of cache entries allowed
+		 * @param sizeLimit Maximum number of entries (0 = unlimited)
+		 * @return Reference to this options object for chaining
+		 */
+		inline LruCacheOptions& setSizeLimit( std::size_t sizeLimit );
 
-		/** @brief Function type for configuring cache entry metadata */
-		using ConfigFunction = std::function<void( CacheEntry& )>;
+		/**
+		 * @brief Set the default sliding expiration time
+		 * @param slidingExpiration Default expiration time after last access
+		 * @return Reference to this options object for chaining
+		 */
+		inline LruCacheOptions& setSlidingExpiration( std::chrono::milliseconds slidingExpiration );
 
-		//----------------------------------------------
-		// Construction
-		//----------------------------------------------
+		/**
+		 * @brief Set the background cleanup interval
+		 * @param backgroundCleanupInterval Interval for automatic expired entry cleanup (0 = disabled)
+		 * @return Reference to this options object for chaining
+		 */
+		inline LruCacheOptions& setBackgroundCleanupInterval( std::chrono::milliseconds backgroundCleanupInterval );
 
 		/**
-		 * @brief Construct memory cache with specified options
-		 * @param options Configuration options for cache behavior
+		 * @brief Set the maximum total size of cache entries allowed
+		 * @param memoryLimit Budget compared against the sum of CacheEntry::size values, typically bytes (0 = unlimited)
+		 * @return Reference to this options object for chaining
+		 * @details Entry sizes come from the cache's SizeFunction or from a ConfigFunction setting
+		 *          CacheEntry::size. Both limits are enforced when a size limit is also set.
 		 */
-		inline explicit LruCache( const LruCacheOptions& options = {} );
+		inline LruCacheOptions& setMemoryLimit( std::size_t memoryLimit );
 
-		//----------------------------------------------
-		// Copy and move operations
-		//----------------------------------------------
+		/**
+		 * @brief Enable or disable the read-optimized mode
+		 * @param readOptimized True to serve hits under a shared lock
+		 * @return Reference to this options object for chaining
+		 * @details Hits only read the entry and record it in a per-thread-striped read buffer; the
+		 *          buffered recency and sliding expiration updates are drained into the LRU list by
+		 *          the next exclusive operation. Recommended for read-heavy workloads (>95% hits).
+		 */
+		inline LruCacheOptions& setReadOptimized( bool readOptimized );
 
-		LruCache( const LruCache& ) = delete;
-		LruCache( LruCache&& ) = delete;
+		/**
+		 * @brief Enable or disable slab node storage
+		 * @param slabStorage True to keep entries in a preallocated slab of nodes
+		 * @return Reference to this options object for chaining
+		 * @details The slab holds sizeLimit() entries up front (it grows in chunks when unlimited),
+		 *          and evicted nodes are reused by the next insert, so a full cache under churn makes
+		 *          no heap allocations for its own storage. Allocations made by TKey or TValue
+		 *          themselves are not affected.
+		 */
+		inline LruCacheOptions& setSlabStorage( bool slabStorage );
 
-		//----------------------------------------------
-		// Assignment operations
-		//----------------------------------------------
+		/**
+		 * @brief Enable or disable a dedicated maintenance thread
+		 * @param maintenanceThread True to give the cache its own MaintenanceScheduler
+		 * @return Reference to this options object for chaining
+		 * @details Every backgroundCleanupInterval() (1 second when 0), the thread drains buffered
+		 *          reads, expires entries and evicts down to the limits an insert could not enforce
+		 *          because of pinned entries. Operations then never run cleanup inline, and an idle
+		 *          cache still sheds expired entries. Ignored when a maintenanceScheduler() is set.
+		 */
+		inline LruCacheOptions& setMaintenanceThread( bool maintenanceThread );
 
-		LruCache& operator=( const LruCache& ) = delete;
-		LruCache& operator=( LruCache&& ) = delete;
+		/**
+		 * @brief Run the cache's maintenance on a shared scheduler
+		 * @param scheduler Scheduler shared by several caches, e.g. MaintenanceScheduler::shared() (nullptr = none)
+		 * @return Reference to this options object for chaining
+		 * @details Same maintenance as setMaintenanceThread(), with one thread serving many caches.
+		 * @warning The scheduler must outlive the cache
+		 */
+		inline LruCacheOptions& setMaintenanceScheduler( MaintenanceScheduler* scheduler );
 
-		//----------------------------------------------
-		// Destruction
-		//----------------------------------------------
+		/**
+		 * @brief Set the number of expired entries removed per background cleanup cycle
+		 * @param cleanupBudget Entries per cycle (at least 1)
+		 * @return Reference to this options object for chaining
+		 * @details Bounds the cleanup work an operation may pay for. Raise it when entries expire
+		 *          faster than the budget per backgroundCleanupInterval(), or use adaptive cleanup.
+		 */
+		inline LruCacheOptions& setCleanupBudget( std::size_t cleanupBudget );
 
-		// Default destructor
-		~LruCache() = default;
+		/**
+		 * @brief Enable or disable adaptive background cleanup
+		 * @param adaptiveCleanup True to scale the per-cycle budget with the expiration backlog
+		 * @return Reference to this options object for chaining
+		 * @details A cycle that used its whole budget doubles it, a cycle that used less than a
+		 *          quarter halves it, never below cleanupBudget(). Each cycle stops once it has
+		 *          run for cleanupTimeBudget(), so request latency stays bounded when the backlog is large.
+		 */
+		inline LruCacheOptions& setAdaptiveCleanup( bool adaptiveCleanup );
 
-		//----------------------------------------------
-		// Cache operations
-		//----------------------------------------------
+		/**
+		 * @brief Set the time an adaptive background cleanup cycle may take
+		 * @param cleanupTimeBudget Time budget per cycle, checked between batches of entries
+		 * @return Reference to this options object for chaining
+		 */
+		inline LruCacheOptions& setCleanupTimeBudget( std::chrono::microseconds cleanupTimeBudget );
 
 		/**
-		 * @brief Get a cache entry, creating it with factory function if not found
-		 * @param key The cache key
-		 * @param factory Function to create the value if not cached
-		 * @param configure Optional function to configure cache entry
-		 * @return Pointer to the cached value (never null; throws on factory failure)
+		 * @brief Reload hot entries before they expire
+		 * @param refreshAfter Time since the value was stored after which a get() hit schedules a reload (0 = disabled)
+		 * @return Reference to this options object for chaining
+		 * @details The hit returns the current value at once, and the reload runs the factory of that
+		 *          get() on the refreshExecutor(), then replaces the entry (RemovalCause::Replaced).
+		 *          One reload runs per entry at a time; if it fails, the current value is kept and
+		 *          the next hit tries again. find() never triggers a reload.
+		 * @warning The factory is copied and runs after get() returned: it must be copyable and must
+		 *          not capture references to the caller's locals. Non-copyable factories never refresh.
+		 *          A reload may replace the entry right after a hit, so read refreshed entries through
+		 *          getPinned() rather than get() pointers.
 		 */
-		inline TValue* get( const TKey& key, FactoryFunction factory, ConfigFunction configure = nullptr );
+		inline LruCacheOptions& setRefreshAfter( std::chrono::milliseconds refreshAfter );
 
-		//----------------------------------------------
-		// Lookup operations
-		//----------------------------------------------
+		/**
+		 * @brief Keep serving expired entries while they are reloaded
+		 * @param staleWhileRevalidate Window after expiration during which get() returns the stale value (0 = disabled)
+		 * @return Reference to this options object for chaining
+		 * @details A get() on an entry expired for less than the window returns the old value and
+		 *          schedules a reload as with setRefreshAfter(), so a slow or failing backend does not
+		 *          stall requests. Stale entries are not renewed by the hit, are not returned by find(),
+		 *          and are removed once the window has passed too.
+		 */
+		inline LruCacheOptions& setStaleWhileRevalidate( std::chrono::milliseconds staleWhileRevalidate );
 
 		/**
-		 * @brief Find a cached value without creating it
-		 * @param key The cache key
-		 * @return Pointer to the cached value if found and not expired, nullptr otherwise
+		 * @brief Set the default time to live of entries, counted from when their value was stored
+		 * @param absoluteExpiration Absolute expiration, used by the Absolute and SlidingAndAbsolute modes
+		 * @return Reference to this options object for chaining
+		 * @details A ConfigFunction may override it per entry through CacheEntry::absoluteExpiration.
 		 */
-		inline TValue* find( const TKey& key );
+		inline LruCacheOptions& setAbsoluteExpiration( std::chrono::milliseconds absoluteExpiration );
 
-		//----------------------------------------------
-		// Modification operations
-		//----------------------------------------------
+		/**
+		 * @brief Set the default expiration mode of entries
+		 * @param expirationMode Sliding (default), Absolute or SlidingAndAbsolute
+		 * @return Reference to this options object for chaining
+		 * @details In Absolute mode a hit reads the entry's timestamps but never writes them, so
+		 *          hot keys hit from many cores do not bounce the entry's cache line between them.
+		 *          SlidingAndAbsolute expires entries at the earlier of the two deadlines, and hits
+		 *          renew the sliding one. A ConfigFunction may override it per entry through
+		 *          CacheEntry::expirationMode.
+		 */
+		inline LruCacheOptions& setExpirationMode( ExpirationMode expirationMode );
 
 		/**
-		 * @brief Remove an entry from the cache
-		 * @param key The cache key to remove
-		 * @return True if entry was removed, false if not found
+		 * @brief Remember keys the factory found no value for
+		 * @param negativeExpiration Time to live of tombstones, counted from the failed load (0 = disabled)
+		 * @return Reference to this options object for chaining
+		 * @details When an OptionalEntryFactory returns std::nullopt, get() stores a tombstone for
+		 *          the key: until it expires, get() returns nullptr for that key without calling the
+		 *          factory again. Tombstones hold no value, live apart from the entries and count
+		 *          neither towards the size nor the memory limit.
 		 */
-		inline bool remove( const TKey& key );
+		inline LruCacheOptions& setNegativeExpiration( std::chrono::milliseconds negativeExpiration );
 
 		/**
-		 * @brief Clear all cache entries
+		 * @brief Bound the number of tombstones kept
+		 * @param negativeSizeLimit Maximum number of tombstones (0 = unlimited)
+		 * @return Reference to this options object for chaining
+		 * @details Past the limit, the oldest tombstone is dropped to make room for the new one.
 		 */
-		inline void clear();
+		inline LruCacheOptions& setNegativeSizeLimit( std::size_t negativeSizeLimit );
 
 		/**
-		 * @brief Get current cache size
-		 * @return Number of entries in cache
+		 * @brief Keep evicted values compressed in a second tier
+		 * @param secondTierMemoryLimit Maximum sum of compressed value sizes, in bytes (0 = disabled)
+		 * @return Reference to this options object for chaining
+		 * @details Values evicted for size are serialized with SnapshotSerializer<TValue> and
+		 *          compressed by secondTierCodec() once the lock is released. A lookup missing the
+		 *          entries but finding the key there (get(), getMany(), getAsync(), find() and
+		 *          findMany()) decompresses the value and promotes it back, with its expiration
+		 *          state, instead of calling the factory. Past the budget, the oldest compressed
+		 *          values are dropped; expired ones are purged by cleanup. The value type must
+		 *          have a serializer.
 		 */
-		inline std::size_t size() const;
+		inline LruCacheOptions& setSecondTierMemoryLimit( std::size_t secondTierMemoryLimit );
 
-		//----------------------------------------------
-		// State inspection
-		//----------------------------------------------
+		/**
+		 * @brief Skip small values when filling the second tier
+		 * @param secondTierMinimumSize Serialized size, in bytes, below which evicted values are dropped
+		 * @return Reference to this options object for chaining
+		 * @details Small values compress poorly and are usually cheap to load again.
+		 */
+		inline LruCacheOptions& setSecondTierMinimumSize( std::size_t secondTierMinimumSize );
 
 		/**
-		 * @brief Check if cache is empty
-		 * @return True if cache contains no entries
+		 * @brief Set the codec compressing the values of the second tier
+		 * @param codec Pair of compression functions, called without the cache lock held
+		 * @return Reference to this options object for chaining
 		 */
-		inline bool isEmpty() const;
+		inline LruCacheOptions& setSecondTierCodec( CompressionCodec codec );
 
 		/**
-		 * @brief Manually trigger cleanup of expired entries
+		 * @brief Set the executor running background reloads
+		 * @param executor Callable handing each reload task to a thread pool or event loop (empty = a new thread per reload)
+		 * @return Reference to this options object for chaining
+		 * @details The executor is called without the cache lock held, and may run the task inline.
+		 * @warning Every task must run: the cache destructor waits for pending reloads
 		 */
-		inline void cleanupExpired();
+		inline LruCacheOptions& setRefreshExecutor( Executor executor );
+
+		/**
+		 * @brief Set the executor running the loads of getAsync() and getFuture() misses
+		 * @param executor Callable handing each load task to a thread pool or event loop (empty = a new thread per load)
+		 * @return Reference to this options object for chaining
+		 * @details The executor is called without the cache lock held, and may run the task inline.
+		 *          The factory blocks the thread running the task, never the awaiting coroutine.
+		 * @warning Every task must run: its waiters are only resumed once it did, and the cache
+		 *          destructor waits for pending loads
+		 */
+		inline LruCacheOptions& setLoadExecutor( Executor executor );
 
 	private:
+		/** Maximum number of entries allowed in cache (0 = unlimited) */
+		std::size_t m_sizeLimit{ 0 };
+
+		/** Maximum sum of entry sizes allowed in cache (0 = unlimited) */
+		std::size_t m_memoryLimit{ 0 };
+
+		/** Default time after last access before entries expire */
+		std::chrono::milliseconds m_slidingExpiration{ std::chrono::minutes{ 60 } };
+
+		/*
+		 * Background cleanup design:
+		 * - When enabled (interval > 0), cache tracks last cleanup time
+		 * - During get/find operations, checks if cleanup interval has elapsed
+		 * - If elapsed, performs incremental cleanup of expired entries
+		 * - Amortizes cleanup cost across normal operations without requiring separate thread
+		 * - Ideal for write-heavy scenarios with unique keys (logging, batch processing)
+		 * - For very low-activity caches, still requires occasional manual cleanupExpired() calls
+		 * - With a maintenance thread or scheduler, the interval is the maintenance period instead
+		 *   and operations no longer clean up inline
+		 */
+		std::chrono::milliseconds m_backgroundCleanupInterval{ std::chrono::milliseconds{ 0 } };
+
+		/** Serve hits under a shared lock with buffered recency updates */
+		bool m_readOptimized{ false };
+
+		/** Keep entries in a preallocated slab of recycled nodes */
+		bool m_slabStorage{ false };
+
+		/** Run maintenance on a thread owned by the cache */
+		bool m_maintenanceThread{ false };
+
+		/** Shared scheduler running maintenance (takes precedence over m_maintenanceThread) */
+		MaintenanceScheduler* m_maintenanceScheduler{ nullptr };
+
+		/** Expired entries removed per background cleanup cycle (starting point when adaptive) */
+		std::size_t m_cleanupBudget{ 10 };
+
+		/** Scale the cleanup budget with the expiration backlog */
+		bool m_adaptiveCleanup{ false };
+
+		/** Time an adaptive background cleanup cycle may take */
+		std::chrono::microseconds m_cleanupTimeBudget{ 20 };
+
+		/** Value age after which a hit schedules a background reload (0 = disabled) */
+		std::chrono::milliseconds m_refreshAfter{ 0 };
+
+		/** Window after expiration during which get() serves the stale value while reloading */
+		std::chrono::milliseconds m_staleWhileRevalidate{ 0 };
+
+		/** Default time to live from when the value was stored (Absolute and SlidingAndAbsolute modes) */
+		std::chrono::milliseconds m_absoluteExpiration{ std::chrono::minutes{ 60 } };
+
+		/** Default deadline(s) entries expire at */
+		ExpirationMode m_expirationMode{ ExpirationMode::Sliding };
+
+		/** Time to live of tombstones for keys without a value (0 = negative caching disabled) */
+		std::chrono::milliseconds m_negativeExpiration{ 0 };
+
+		/** Maximum number of tombstones (0 = unlimited) */
+		std::size_t m_negativeSizeLimit{ 0 };
+
+		/** Maximum sum of compressed value sizes in the second tier (0 = second tier disabled) */
+		std::size_t m_secondTierMemoryLimit{ 0 };
+
+		/** Serialized size below which evicted values are not kept in the second tier */
+		std::size_t m_secondTierMinimumSize{ 0 };
+
+		/** Compresses the values of the second tier */
+		CompressionCodec m_secondTierCodec;
+
+		/** Runs background reloads (empty = a new thread per reload) */
+		Executor m_refreshExecutor;
+
+		/** Runs the loads of asynchronous misses (empty = a new thread per load) */
+		Executor m_loadExecutor;
+	};
+
+	//=====================================================================
+	// TimerWheel class
+	//=====================================================================
+
+	/**
+	 * @brief Hierarchical timing wheel indexing cache entries by expiration time
+	 * @details Five levels of 64 buckets with spans of 2^20 ns (~1 ms) up to 2^44 ns (~4.9 h).
+	 *          Entries are linked intrusively through CacheEntry, so scheduling and unscheduling
+	 *          are O(1). Sliding expiration renewals are not tracked eagerly: an entry found in
+	 *          an elapsed bucket that was touched since is simply rescheduled. Absolute deadlines
+	 *          never move, so such entries are scheduled once. Advancing the wheel
+	 *          therefore visits expired and renewed entries only, never the whole cache.
+	 *          A grace period keeps entries that long past their expiration before handing them out.
+	 *          Not thread-safe; LruCache only uses it under its exclusive lock.
+	 */
+	class TimerWheel final
+	{
+	public:
 		//----------------------------------------------
-		// Background cleanup
+		// Construction
 		//----------------------------------------------
 
 		/**
-		 * @brief Maximum number of expired entries to clean up per opportunistic cleanup cycle
-		 * @details Limits cleanup work per operation to prevent blocking normal cache access.
-		 *          This ensures cleanup cost remains bounded and amortized across operations.
+		 * @brief Construct an empty wheel
+		 * @param now Current time
+		 * @param grace Time entries stay scheduled after their expiration
 		 */
-		static constexpr size_t MAX_CLEANUP_PER_CYCLE = 10;
+		inline explicit TimerWheel( std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now(), std::chrono::milliseconds grace = std::chrono::milliseconds{ 0 } ) noexcept;
+
+		//----------------------------------------------
+		// Scheduling
+		//----------------------------------------------
 
 		/**
-		 * @brief Check if background cleanup should run and perform it if needed
-		 * @details Called during normal operations to amortize cleanup cost
+		 * @brief Add an entry, keyed by its expiration deadline (see CacheEntry::isExpired) + grace period
+		 * @param entry Entry that is not scheduled yet
 		 */
-		inline void checkAndPerformBackgroundCleanup();
+		inline void schedule( CacheEntry* entry ) noexcept;
 
-		//----------------------------------------------
-		// Internal data structures
-		//----------------------------------------------
+		/**
+		 * @brief Remove an entry (no-op if it is not scheduled)
+		 * @param entry Entry to remove
+		 */
+		inline void unschedule( CacheEntry* entry ) noexcept;
 
-		/** @brief Internal cache item containing value and metadata */
-		struct CachedItem
-		{
-			/** @brief The cached value */
-			TValue value;
+		/**
+		 * @brief Advance the wheel and hand out entries that have expired
+		 * @param now Current time
+		 * @param budget Maximum number of expired entries to hand out
+		 * @param onExpired Called with each expired entry, already unscheduled
+		 * @return Number of expired entries handed out
+		 * @details When the budget runs out the wheel keeps its previous time, so the next call
+		 *          resumes where this one stopped. With an unlimited budget every entry expired
+		 *          at now is handed out.
+		 */
+		template <typename OnExpired>
+		inline std::size_t advance( std::chrono::steady_clock::time_point now, std::size_t budget, OnExpired&& onExpired );
 
-			/** @brief Cache entry metadata and LRU information */
-			CacheEntry metadata;
+		/**
+		 * @brief Drop every entry without visiting it
+		 * @param now Current time
+		 */
+		inline void clear( std::chrono::steady_clock::time_point now ) noexcept;
 
-			/** @brief Construct cache item with value and metadata */
-			CachedItem( TValue val, CacheEntry meta );
-		};
+	private:
+		//----------------------------------------------
+		// Constants
+		//----------------------------------------------
 
-		mutable std::mutex m_mutex;
-		std::unordered_map<TKey, CachedItem> m_cache;
-		LruCacheOptions m_options;
+		/** @brief Number of wheel levels */
+		static constexpr std::size_t LEVELS = 5;
 
-		/** @brief Head of the LRU doubly-linked list (most recently used) */
-		CacheEntry* m_lruHead;
+		/** @brief log2 of the number of buckets per level */
+		static constexpr unsigned BUCKET_BITS = 6;
 
-		/** @brief Tail of the LRU doubly-linked list (least recently used) */
-		CacheEntry* m_lruTail;
+		/** @brief Number of buckets per level */
+		static constexpr std::size_t BUCKETS = std::size_t{ 1 } << BUCKET_BITS;
 
-		/** @brief Last time background cleanup was performed */
-		std::chrono::steady_clock::time_point m_lastCleanupTime;
+		/** @brief log2 of the bucket span in nanoseconds, per level */
+		static constexpr std::array<unsigned, LEVELS> SPAN_SHIFTS{ 20, 26, 32, 38, 44 };
 
 		//----------------------------------------------
-		// LRU list management
+		// Private helper methods
 		//----------------------------------------------
 
 		/**
-		 * @brief Add entry to head of LRU list (most recently used)
-		 * @param entry Entry to add to LRU list head
+		 * @brief Convert a time point to wheel nanoseconds
+		 * @param time Time point
+		 * @return Nanoseconds since the steady clock epoch
+		 */
+		[[nodiscard]] static inline std::int64_t toNanos( std::chrono::steady_clock::time_point time ) noexcept;
+
+		/**
+		 * @brief Link an entry into the bucket matching its expiration time
+		 * @param entry Entry to link
+		 * @param reference Wheel time used to choose the level
+		 */
+		inline void link( CacheEntry* entry, std::int64_t reference ) noexcept;
+
+		/** @brief Bucket list heads, per level */
+		std::array<std::array<CacheEntry*, BUCKETS>, LEVELS> m_buckets{};
+
+		/** @brief Time up to which the wheel has been advanced */
+		std::chrono::steady_clock::time_point m_time;
+
+		/** @brief Time entries stay scheduled after their expiration */
+		std::chrono::milliseconds m_grace;
+	};
+
+	//=====================================================================
+	// Index policies
+	//=====================================================================
+
+	/** @brief Key index backed by std::unordered_map (default) */
+	struct NodeIndex final
+	{
+		/** @brief Map type used as the key index */
+		template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+		using Map = std::unordered_map<TKey, TValue, Hash, KeyEqual, Allocator>;
+	};
+
+	/**
+	 * @brief Open-addressing key index backed by FlatHashMap
+	 * @details Lookups probe 16 control bytes at a time and only touch an entry on a 7-bit hash
+	 *          match, which mostly avoids pointer chasing on misses. Entries keep stable addresses.
+	 */
+	struct FlatIndex final
+	{
+		/** @brief Map type used as the key index */
+		template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+		using Map = FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>;
+	};
+
+	//=====================================================================
+	// Heterogeneous lookup
+	//=====================================================================
+
+	/**
+	 * @brief Transparent hash for std::string keys
+	 * @details Hashes std::string, std::string_view and C strings identically, so together with
+	 *          std::equal_to<> it lets a cache keyed by std::string be queried without building a
+	 *          temporary std::string.
+	 */
+	struct TransparentStringHash final
+	{
+		/** @brief Marks the hash as accepting any string-like type */
+		using is_transparent = void;
+
+		/**
+		 * @brief Hash a string-like value
+		 * @param value String to hash
+		 * @return Same hash as std::hash<std::string> for equal contents
+		 */
+		[[nodiscard]] inline std::size_t operator()( std::string_view value ) const noexcept;
+	};
+
+	//=====================================================================
+	// Removal notifications
+	//=====================================================================
+
+	/** @brief Reason an entry left the cache, reported to the removal listener */
+	enum class RemovalCause : std::uint8_t
+	{
+		/** @brief Evicted to keep the cache within its size or memory limit */
+		Size,
+
+		/** @brief Dropped after its sliding expiration elapsed */
+		Expired,
+
+		/** @brief Removed by remove() or removeMany() */
+		Explicit,
+
+		/** @brief Overwritten by a new value for the same key */
+		Replaced,
+
+		/** @brief Dropped by clear() */
+		Cleared
+	};
+
+	//=====================================================================
+	// LruCache class
+	//=====================================================================
+
+	/**
+	 * @brief Thread-safe memory cache with size limits and expiration policies
+	 * @tparam TKey Key type for cache entries
+	 * @tparam TValue Value type for cached objects
+	 * @tparam Hash Hash function object for keys
+	 * @tparam KeyEqual Equality comparison function object for keys
+	 * @tparam Index Key index policy (NodeIndex or FlatIndex)
+	 * @tparam Policy Eviction policy (LruPolicy, SlruPolicy, ClockPolicy or WTinyLfuPolicy)
+	 * @tparam Clock Time source for expiration (SteadyClock, CoarseClock or ManualClock)
+	 * @tparam Stats Statistics collector (NoStats or StripedStats)
+	 */
+	template <typename TKey, typename TValue, typename Hash = std::hash<TKey>, typename KeyEqual = std::equal_to<TKey>, typename Index = NodeIndex, typename Policy = LruPolicy, typename Clock = SteadyClock, typename Stats = NoStats>
+	class LruCache final
+	{
+		/** @brief Caller waiting for an asynchronous load (defined with the internal data structures) */
+		struct AsyncWaiter;
+
+	public:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		/** @brief Type-erased factory, accepted by get() like any other EntryFactory */
+		using FactoryFunction = std::function<TValue()>;
+
+		/** @brief Type-erased configure function, accepted by get() like any other EntryConfigurator */
+		using ConfigFunction = std::function<void( CacheEntry& )>;
+
+		/** @brief Function type for measuring the size of a cache entry (typically in bytes) */
+		using SizeFunction = std::function<std::size_t( const TKey&, const TValue& )>;
+
+		/** @brief Function type creating the values of several missing keys at once, one value per key in order */
+		using BatchFactoryFunction = std::function<std::vector<TValue>( std::span<const TKey> )>;
+
+		/** @brief Entry that left the cache, handed to the removal listener */
+		struct RemovalNotification
+		{
+			/** @brief Key of the removed entry */
+			TKey key;
+
+			/** @brief Value of the removed entry, moved out of the cache */
+			TValue value;
+
+			/** @brief Why the entry was removed */
+			RemovalCause cause;
+		};
+
+		/**
+		 * @brief Function receiving the entries removed by one cache operation, in removal order
+		 * @details Called after the cache lock is released, so it may run teardown code of any
+		 *          cost and may call back into the cache. Values may be moved out of the batch.
+		 *          Never called for a TValue that is not move-constructible.
+		 */
+		using RemovalListener = std::function<void( std::span<RemovalNotification> )>;
+
+		//----------------------------------------------
+		// Value handle
+		//----------------------------------------------
+
+		/**
+		 * @brief Reference to a cached value that pins its entry while held
+		 * @details Returned by getPinned() and findPinned(). Eviction skips pinned entries, and
+		 *          remove(), clear() or expiration only detach a pinned entry from the cache: its
+		 *          value is destroyed when the last handle is dropped. Copying a handle adds a pin.
+		 *          Handles are not synchronized with each other's value accesses; the value itself
+		 *          must be safe for the concurrent use made of it.
+		 * @warning A handle must not outlive the cache it came from
+		 */
+		class ValueHandle final
+		{
+		public:
+			//----------------------------------------------
+			// Construction
+			//----------------------------------------------
+
+			/** @brief Construct an empty handle */
+			ValueHandle() noexcept = default;
+
+			/**
+			 * @brief Copy a handle, pinning the entry once more
+			 * @param other Handle to copy
+			 */
+			inline ValueHandle( const ValueHandle& other ) noexcept;
+
+			/**
+			 * @brief Take over the pin of another handle
+			 * @param other Handle left empty
+			 */
+			inline ValueHandle( ValueHandle&& other ) noexcept;
+
+			//----------------------------------------------
+			// Assignment operations
+			//----------------------------------------------
+
+			inline ValueHandle& operator=( const ValueHandle& other ) noexcept;
+			inline ValueHandle& operator=( ValueHandle&& other ) noexcept;
+
+			//----------------------------------------------
+			// Destruction
+			//----------------------------------------------
+
+			/** @brief Unpin the entry, destroying it if it was removed from the cache meanwhile */
+			inline ~ValueHandle();
+
+			//----------------------------------------------
+			// Accessors
+			//----------------------------------------------
+
+			/**
+			 * @brief Get the pinned value
+			 * @return Pointer to the value, or nullptr for an empty handle
+			 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+			 */
+			[[nodiscard]] inline TValue* get() const noexcept;
+
+			[[nodiscard]] inline TValue& operator*() const noexcept;
+			[[nodiscard]] inline TValue* operator->() const noexcept;
+
+			/**
+			 * @brief Check whether the handle pins a value
+			 * @return True unless the handle is empty
+			 */
+			[[nodiscard]] inline explicit operator bool() const noexcept;
+
+			//----------------------------------------------
+			// Modification operations
+			//----------------------------------------------
+
+			/** @brief Unpin the entry and leave the handle empty */
+			inline void reset() noexcept;
+
+		private:
+			friend class LruCache;
+
+			/**
+			 * @brief Adopt a pin taken under the cache lock
+			 * @param cache Cache owning the entry
+			 * @param value Pinned value
+			 * @param entry Metadata of the pinned entry
+			 */
+			inline ValueHandle( LruCache* cache, TValue* value, CacheEntry* entry ) noexcept;
+
+			/** @brief Cache owning the entry */
+			LruCache* m_cache{ nullptr };
+
+			/** @brief Pinned value */
+			TValue* m_value{ nullptr };
+
+			/** @brief Metadata holding the pin count */
+			CacheEntry* m_entry{ nullptr };
+		};
+
+		//----------------------------------------------
+		// Awaitable lookup
+		//----------------------------------------------
+
+		/**
+		 * @brief Awaitable returned by getAsync(), completing with a handle pinning the value
+		 * @details A hit was resolved by getAsync() itself: the awaitable is ready and co_await does
+		 *          not suspend. On a miss, co_await suspends the coroutine until the key's load has
+		 *          completed, then resumes it on the thread that completed the load, once the cache
+		 *          lock is released.
+		 * @warning Neither the awaitable nor a coroutine suspended on it may outlive the cache
+		 */
+		class GetAwaitable final
+		{
+		public:
+			//----------------------------------------------
+			// Copy and move operations
+			//----------------------------------------------
+
+			GetAwaitable( const GetAwaitable& ) = delete;
+			GetAwaitable( GetAwaitable&& ) noexcept = default;
+
+			//----------------------------------------------
+			// Assignment operations
+			//----------------------------------------------
+
+			GetAwaitable& operator=( const GetAwaitable& ) = delete;
+			GetAwaitable& operator=( GetAwaitable&& ) noexcept = default;
+
+			//----------------------------------------------
+			// Destruction
+			//----------------------------------------------
+
+			/** @brief Destroy the awaitable, releasing its pin if the value was not taken */
+			~GetAwaitable() = default;
+
+			//----------------------------------------------
+			// Awaitable interface
+			//----------------------------------------------
+
+			/**
+			 * @brief Check whether the value is available without suspending
+			 * @return True on a cache hit
+			 */
+			[[nodiscard]] inline bool await_ready() const noexcept;
+
+			/**
+			 * @brief Wait for the key's load, starting it if no get() or getAsync() is running one
+			 * @param continuation Coroutine resumed once the load completed
+			 * @return False if the key was cached meanwhile, in which case the coroutine is not suspended
+			 */
+			inline bool await_suspend( std::coroutine_handle<> continuation );
+
+			/**
+			 * @brief Take the result
+			 * @return Handle pinning the cached value (never empty)
+			 * @throws Whatever the factory of the load threw
+			 */
+			inline ValueHandle await_resume();
+
+		private:
+			friend class LruCache;
+
+			/**
+			 * @brief Construct an awaitable for a hit
+			 * @param cache Cache owning the entry
+			 * @param value Handle pinning the cached value
+			 */
+			inline GetAwaitable( LruCache& cache, ValueHandle value ) noexcept;
+
+			/**
+			 * @brief Construct an awaitable for a miss
+			 * @param cache Cache to load into
+			 * @param waiter Waiter registered with the load once awaited
+			 */
+			inline GetAwaitable( LruCache& cache, std::unique_ptr<AsyncWaiter> waiter ) noexcept;
+
+			/** @brief Cache the value comes from */
+			LruCache* m_cache;
+
+			/** @brief Value found by a hit */
+			ValueHandle m_value;
+
+			/** @brief State shared with the load on a miss, nullptr on a hit */
+			std::unique_ptr<AsyncWaiter> m_waiter;
+		};
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct memory cache with specified options
+		 * @param options Configuration options for cache behavior
+		 * @throws std::invalid_argument if the second tier is enabled and TValue has no SnapshotSerializer
+		 */
+		inline explicit LruCache( const LruCacheOptions& options = {} );
+
+		/**
+		 * @brief Construct memory cache with specified options, entry sizer and removal listener
+		 * @param options Configuration options for cache behavior
+		 * @param sizer Function computing CacheEntry::size for new entries (a ConfigFunction may still override it)
+		 * @param listener Optional function notified of every entry leaving the cache, whatever the cause
+		 * @details Removed keys and values are collected while the lock is held and handed to the
+		 *          listener as one batch once the operation releases it, so their destructors never
+		 *          run inside the critical section. A pinned entry is reported when its last handle is
+		 *          dropped. Operations running on different threads may call the listener concurrently.
+		 * @throws std::invalid_argument if the second tier is enabled and TValue has no SnapshotSerializer
+		 * @warning The listener must not throw
+		 */
+		inline LruCache( const LruCacheOptions& options, SizeFunction sizer, RemovalListener listener = nullptr );
+
+		//----------------------------------------------
+		// Copy and move operations
+		//----------------------------------------------
+
+		LruCache( const LruCache& ) = delete;
+		LruCache( LruCache&& ) = delete;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		LruCache& operator=( const LruCache& ) = delete;
+		LruCache& operator=( LruCache&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		/** @brief Destroy the cache, after waiting for the background reloads and asynchronous loads still pending */
+		inline ~LruCache();
+
+		//----------------------------------------------
+		// Cache operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Get a cache entry, creating it with factory function if not found
+		 * @param key The cache key
+		 * @param factory Callable creating the value if not cached
+		 * @param configure Optional callable configuring the new cache entry (nullptr to skip)
+		 * @return Pointer to the cached value, or nullptr if an OptionalEntryFactory found none (throws on factory failure)
+		 * @details The factory and configure functions run without holding the cache lock, so a slow
+		 *          load never blocks access to other keys. Concurrent calls for the same missing key
+		 *          wait for the single in-flight load instead of running duplicate factories; if that
+		 *          factory throws, every waiter receives the same exception.
+		 *          Both callables are taken by reference and called directly, so a hit never copies
+		 *          them and a miss can inline them; they may be move-only.
+		 *          A factory returning std::optional<TValue> may report that the key has no value:
+		 *          every waiter then gets nullptr, and with setNegativeExpiration() the answer is
+		 *          cached as a tombstone, counted as a hit while it lasts.
+		 * @warning A factory must not call get() for its own key, as it would wait on itself
+		 */
+		template <EntryLoader<TValue> Factory, EntryConfigurator Configure = std::nullptr_t>
+		inline TValue* get( const TKey& key, Factory&& factory, Configure&& configure = nullptr );
+
+		/**
+		 * @brief Get a cache entry by a key of another type, creating it if not found
+		 * @param key Key comparable to TKey (e.g. std::string_view for std::string keys)
+		 * @param factory Callable creating the value if not cached
+		 * @param configure Optional callable configuring the new cache entry (nullptr to skip)
+		 * @return Pointer to the cached value, or nullptr if an OptionalEntryFactory found none (throws on factory failure)
+		 * @details Only available when Hash and KeyEqual are transparent. A TKey is constructed from
+		 *          key only on a miss, to be inserted; hits never build one.
+		 */
+		template <typename K, EntryLoader<TValue> Factory, EntryConfigurator Configure = std::nullptr_t>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		inline TValue* get( const K& key, Factory&& factory, Configure&& configure = nullptr );
+
+		/**
+		 * @brief Get a cache entry like get(), pinned by the returned handle
+		 * @param key The cache key
+		 * @param factory Callable creating the value if not cached
+		 * @param configure Optional callable configuring the new cache entry (nullptr to skip)
+		 * @return Handle pinning the cached value, empty if an OptionalEntryFactory found none (throws on factory failure)
+		 * @details The pin is taken before the cache lock is released, so the value stays valid
+		 *          for as long as the handle is held, whatever other threads insert or remove.
+		 */
+		template <EntryLoader<TValue> Factory, EntryConfigurator Configure = std::nullptr_t>
+		[[nodiscard]] inline ValueHandle getPinned( const TKey& key, Factory&& factory, Configure&& configure = nullptr );
+
+		/**
+		 * @brief Get a cache entry by a key of another type, pinned by the returned handle
+		 * @param key Key comparable to TKey
+		 * @param factory Callable creating the value if not cached
+		 * @param configure Optional callable configuring the new cache entry (nullptr to skip)
+		 * @return Handle pinning the cached value, empty if an OptionalEntryFactory found none (throws on factory failure)
+		 * @note Only available when Hash and KeyEqual are transparent
+		 */
+		template <typename K, EntryLoader<TValue> Factory, EntryConfigurator Configure = std::nullptr_t>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		[[nodiscard]] inline ValueHandle getPinned( const K& key, Factory&& factory, Configure&& configure = nullptr );
+
+		/**
+		 * @brief Get several cache entries, creating the missing ones with a single factory call
+		 * @param keys The cache keys (duplicates are allowed)
+		 * @param results Receives one value pointer per key; must hold at least keys.size() elements
+		 * @param factory Function creating the values of the missing keys, called once with each missing key once
+		 * @param configure Optional function to configure each new cache entry
+		 * @return Number of values created by the factory
+		 * @details Hits are resolved under one lock acquisition, the missing keys are loaded together
+		 *          without holding the lock and then inserted under a second one. Keys already being
+		 *          loaded by another thread are waited for, and concurrent get() calls for the keys
+		 *          of this batch wait for it. A result is nullptr only if the batch itself evicted
+		 *          the entry, which requires more missing keys than the size limit, or if the key
+		 *          has a tombstone left by negative caching, in which case it is not loaded.
+		 * @warning A factory must not call get() for the keys it is loading, as it would wait on itself
+		 */
+		inline std::size_t getMany( std::span<const TKey> keys, std::span<TValue*> results, BatchFactoryFunction factory, ConfigFunction configure = nullptr );
+
+		/**
+		 * @brief Get several cache entries by keys of another type, creating the missing ones with a single factory call
+		 * @param keys Contiguous range of keys comparable to TKey
+		 * @param results Receives one value pointer per key; must hold at least keys.size() elements
+		 * @param factory Function creating the values of the missing keys, called once with each missing key once
+		 * @param configure Optional function to configure each new cache entry
+		 * @return Number of values created by the factory
+		 * @details Only available when Hash and KeyEqual are transparent. TKey values are constructed
+		 *          for the missing keys only, as they are handed to the factory and inserted.
+		 */
+		template <std::ranges::contiguous_range Keys>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		inline std::size_t getMany( const Keys& keys, std::span<TValue*> results, BatchFactoryFunction factory, ConfigFunction configure = nullptr );
+
+		//----------------------------------------------
+		// Asynchronous operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Get a cache entry without blocking the caller, loading it on the load executor if not found
+		 * @param key The cache key
+		 * @param factory Callable creating the value if not cached, copied to run on the loadExecutor()
+		 * @return Awaitable completing with a handle pinning the value, empty only for a key with a
+		 *         tombstone or waiting on a get() whose OptionalEntryFactory found none (rethrows on factory failure)
+		 * @details A hit is served before getAsync() returns and makes no allocation: co_await then
+		 *          completes synchronously. On a miss, co_await suspends the coroutine. The first
+		 *          caller of a missing key queues its factory on the executor; every caller awaiting
+		 *          that key, and every get() for it, waits for that single load, and a getAsync() for
+		 *          a key a get() is loading waits for the get(). Waiters are resumed in turn on the
+		 *          thread that completed the load, after the value was inserted and the lock released.
+		 * @warning The factory runs after getAsync() returned: it must not capture references to
+		 *          locals that may be gone by then
+		 */
+		template <EntryFactory<TValue> Factory>
+			requires std::copy_constructible<std::remove_cvref_t<Factory>>
+		[[nodiscard]] inline GetAwaitable getAsync( const TKey& key, Factory&& factory );
+
+		/**
+		 * @brief Get a cache entry like getAsync(), for callers that are not coroutines
+		 * @param key The cache key
+		 * @param factory Callable creating the value if not cached, copied to run on the loadExecutor()
+		 * @return Future receiving the handle pinning the value, or the exception of the factory
+		 * @details A hit returns a future that is already ready.
+		 */
+		template <EntryFactory<TValue> Factory>
+			requires std::copy_constructible<std::remove_cvref_t<Factory>>
+		[[nodiscard]] inline std::future<ValueHandle> getFuture( const TKey& key, Factory&& factory );
+
+		//----------------------------------------------
+		// Lookup operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Find a cached value without creating it
+		 * @param key The cache key
+		 * @return Pointer to the cached value if found and not expired, nullptr otherwise
+		 * @note In read-optimized mode, hits and misses only take a shared lock
+		 */
+		inline TValue* find( const TKey& key );
+
+		/**
+		 * @brief Find a cached value by a key of another type
+		 * @param key Key comparable to TKey (e.g. std::string_view for std::string keys)
+		 * @return Pointer to the cached value if found and not expired, nullptr otherwise
+		 * @note Only available when Hash and KeyEqual are transparent
+		 */
+		template <typename K>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		inline TValue* find( const K& key );
+
+		/**
+		 * @brief Find a cached value like find(), pinned by the returned handle
+		 * @param key The cache key
+		 * @return Handle pinning the cached value, or an empty handle if not found or expired
+		 */
+		[[nodiscard]] inline ValueHandle findPinned( const TKey& key );
+
+		/**
+		 * @brief Find a cached value by a key of another type, pinned by the returned handle
+		 * @param key Key comparable to TKey
+		 * @return Handle pinning the cached value, or an empty handle if not found or expired
+		 * @note Only available when Hash and KeyEqual are transparent
+		 */
+		template <typename K>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		[[nodiscard]] inline ValueHandle findPinned( const K& key );
+
+		/**
+		 * @brief Find several cached values under a single lock acquisition
+		 * @param keys The cache keys
+		 * @param results Receives one value pointer per key (nullptr when missing or expired); must hold at least keys.size() elements
+		 * @return Number of keys found
+		 * @details The clock is read and background cleanup is checked once for the whole batch. With
+		 *          FlatIndex the keys are hashed and their index groups prefetched a few keys ahead of
+		 *          the lookups, so the cache misses of consecutive keys overlap.
+		 */
+		inline std::size_t findMany( std::span<const TKey> keys, std::span<TValue*> results );
+
+		/**
+		 * @brief Find several cached values by keys of another type under a single lock acquisition
+		 * @param keys Contiguous range of keys comparable to TKey
+		 * @param results Receives one value pointer per key (nullptr when missing or expired); must hold at least keys.size() elements
+		 * @return Number of keys found
+		 * @note Only available when Hash and KeyEqual are transparent
+		 */
+		template <std::ranges::contiguous_range Keys>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		inline std::size_t findMany( const Keys& keys, std::span<TValue*> results );
+
+		//----------------------------------------------
+		// Modification operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Store a value for a key, replacing the current one
+		 * @param key The cache key
+		 * @param value Value to store, or argument the value is constructed from
+		 * @param configure Optional callable configuring the entry (nullptr to skip)
+		 * @return Pointer to the cached value
+		 * @details Like insertOrAssign(), with the entry configured like a new one by get().
+		 */
+		template <typename V, EntryConfigurator Configure = std::nullptr_t>
+			requires std::constructible_from<TValue, V>
+		inline TValue* set( const TKey& key, V&& value, Configure&& configure = nullptr );
+
+		/**
+		 * @brief Insert a value for a key, or assign it to the value already cached
+		 * @param key The cache key
+		 * @param value Value to store, or argument the value is constructed from
+		 * @return Pointer to the cached value, and true if the key had no live entry
+		 * @details A missing key gets a new entry constructed in place from value. A cached value
+		 *          is assigned in place: the entry keeps its node and its policy state, is marked as
+		 *          recently used and restarts its expiration. The replaced value is reported to the
+		 *          removal listener with RemovalCause::Replaced (RemovalCause::Expired if it had
+		 *          expired). An entry pinned by a ValueHandle, or a TValue that cannot be assigned
+		 *          without throwing once constructed, is replaced by a new entry instead. A write
+		 *          waits for a load of the same key in flight, so that the load never overwrites
+		 *          it, and discards the result of a background reload in flight.
+		 * @warning A factory must not write its own key, as it would wait on itself
+		 */
+		template <typename V>
+			requires std::constructible_from<TValue, V>
+		inline std::pair<TValue*, bool> insertOrAssign( const TKey& key, V&& value );
+
+		/**
+		 * @brief Insert a value constructed in place from arguments, unless the key is cached
+		 * @param key The cache key
+		 * @param args Arguments TValue is constructed from
+		 * @return Pointer to the cached value, and true if it was inserted
+		 * @details The value is constructed directly in its entry, so TValue may be neither copyable
+		 *          nor movable. A live entry is left untouched, recency included; an expired one is
+		 *          replaced. With a SizeFunction the entry is sized once constructed, then the
+		 *          limits are enforced without evicting it.
+		 */
+		template <typename... Args>
+			requires std::constructible_from<TValue, Args...>
+		inline std::pair<TValue*, bool> emplace( const TKey& key, Args&&... args );
+
+		/**
+		 * @brief Remove an entry from the cache
+		 * @param key The cache key to remove
+		 * @return True if entry was removed, false if not found
+		 * @details Also forgets a tombstone left for the key by negative caching.
+		 */
+		inline bool remove( const TKey& key );
+
+		/**
+		 * @brief Remove an entry by a key of another type
+		 * @param key Key comparable to TKey
+		 * @return True if entry was removed, false if not found
+		 * @note Only available when Hash and KeyEqual are transparent
+		 */
+		template <typename K>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		inline bool remove( const K& key );
+
+		/**
+		 * @brief Remove several entries under a single lock acquisition
+		 * @param keys The cache keys to remove
+		 * @return Number of entries removed
+		 */
+		inline std::size_t removeMany( std::span<const TKey> keys );
+
+		/**
+		 * @brief Remove several entries by keys of another type under a single lock acquisition
+		 * @param keys Contiguous range of keys comparable to TKey
+		 * @return Number of entries removed
+		 * @note Only available when Hash and KeyEqual are transparent
+		 */
+		template <std::ranges::contiguous_range Keys>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		inline std::size_t removeMany( const Keys& keys );
+
+		/**
+		 * @brief Clear all cache entries and tombstones
+		 */
+		inline void clear();
+
+		/**
+		 * @brief Get current cache size
+		 * @return Number of entries in cache
+		 */
+		inline std::size_t size() const;
+
+		/**
+		 * @brief Get current memory usage
+		 * @return Sum of CacheEntry::size over all entries in cache
+		 */
+		inline std::size_t memoryUsage() const;
+
+		/**
+		 * @brief Get the number of keys remembered as having no value
+		 * @return Number of tombstones, expired ones included until they are purged
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t tombstoneCount() const;
+
+		/**
+		 * @brief Get the number of evicted values kept compressed in the second tier
+		 * @return Number of compressed values, not counted by size()
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t secondTierSize() const;
+
+		/**
+		 * @brief Get the memory held by the second tier
+		 * @return Sum of the compressed value sizes, in bytes
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t secondTierMemoryUsage() const;
+
+		//----------------------------------------------
+		// State inspection
+		//----------------------------------------------
+
+		/**
+		 * @brief Check if cache is empty
+		 * @return True if cache contains no entries
+		 */
+		inline bool isEmpty() const;
+
+		/**
+		 * @brief Get the runtime statistics
+		 * @return Counters since construction (all zero with NoStats)
+		 * @details Reads the collector without taking the cache lock, so it never delays cache
+		 *          operations; operations running concurrently may be partially counted.
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline CacheStats stats() const noexcept;
+
+		/**
+		 * @brief Manually trigger cleanup of expired entries and tombstones
+		 */
+		inline void cleanupExpired();
+
+		//----------------------------------------------
+		// Snapshots
+		//----------------------------------------------
+
+		/**
+		 * @brief Write the live entries to a binary snapshot, least recently used first
+		 * @tparam KeySerializer Serializer for keys (see SnapshotCodec)
+		 * @tparam ValueSerializer Serializer for values (see SnapshotCodec)
+		 * @param out Stream to write to, opened in binary mode
+		 * @return Number of entries written
+		 * @details Each entry is stored with its remaining expiration, age, expiration settings and
+		 *          size. Entries in Absolute mode are never touched by hits, so they are written in
+		 *          insertion order among the others. Holds a shared lock while writing: modifications wait, read-optimized lookups do not.
+		 * @throws std::runtime_error if the stream fails
+		 * @throws std::length_error if a serialized key or value exceeds 4 GiB
+		 */
+		template <typename KeySerializer = SnapshotSerializer<TKey>, typename ValueSerializer = SnapshotSerializer<TValue>>
+			requires SnapshotCodec<KeySerializer, TKey> && SnapshotCodec<ValueSerializer, TValue>
+		inline std::size_t saveSnapshot( std::ostream& out );
+
+		/**
+		 * @brief Write the live entries to a snapshot file
+		 * @param path File to create or replace
+		 * @return Number of entries written
+		 * @details Writes to path with a ".tmp" suffix and renames it once complete, so an
+		 *          interrupted save never leaves a truncated snapshot behind.
+		 * @throws std::runtime_error if the file cannot be written
+		 */
+		template <typename KeySerializer = SnapshotSerializer<TKey>, typename ValueSerializer = SnapshotSerializer<TValue>>
+			requires SnapshotCodec<KeySerializer, TKey> && SnapshotCodec<ValueSerializer, TValue>
+		inline std::size_t saveSnapshot( const std::filesystem::path& path );
+
+		/**
+		 * @brief Insert the entries of a snapshot written by saveSnapshot()
+		 * @tparam KeySerializer Serializer for keys (see SnapshotCodec)
+		 * @tparam ValueSerializer Serializer for values (see SnapshotCodec)
+		 * @param in Stream to read from, opened in binary mode
+		 * @param threads Number of threads decoding keys and values (1 decodes on the calling thread)
+		 * @return Number of entries inserted
+		 * @details Records are streamed in chunks of SNAPSHOT_LOAD_CHUNK, decoded outside the cache
+		 *          lock, then inserted in file order under a single lock acquisition per chunk, so the
+		 *          most recently used entry of the snapshot is the most recent one in the cache.
+		 *          Expiration resumes with the time that was left when the snapshot was written.
+		 *          The oldest records the size limit would evict straight away are skipped without
+		 *          being decoded, and keys already cached or being loaded by a factory keep their
+		 *          current or loaded value. Extra threads pay off when decoding is costly (parsing,
+		 *          decompression), not for plain copies.
+		 * @throws std::runtime_error if the stream is not a snapshot or is truncated or corrupt
+		 */
+		template <typename KeySerializer = SnapshotSerializer<TKey>, typename ValueSerializer = SnapshotSerializer<TValue>>
+			requires SnapshotCodec<KeySerializer, TKey> && SnapshotCodec<ValueSerializer, TValue>
+		inline std::size_t loadSnapshot( std::istream& in, std::size_t threads = 1 );
+
+		/**
+		 * @brief Insert the entries of a snapshot file
+		 * @param path File written by saveSnapshot()
+		 * @param threads Number of threads decoding keys and values (1 decodes on the calling thread)
+		 * @return Number of entries inserted
+		 * @throws std::runtime_error if the file cannot be read or is not a valid snapshot
+		 */
+		template <typename KeySerializer = SnapshotSerializer<TKey>, typename ValueSerializer = SnapshotSerializer<TValue>>
+			requires SnapshotCodec<KeySerializer, TKey> && SnapshotCodec<ValueSerializer, TValue>
+		inline std::size_t loadSnapshot( const std::filesystem::path& path, std::size_t threads = 1 );
+
+	private:
+		struct CachedItem;
+
+		//----------------------------------------------
+		// Operations by lookup key
+		//----------------------------------------------
+
+		/*
+		 * The public operations forward here with K = TKey, or with the caller's key type when
+		 * Hash and KeyEqual are transparent. A TKey is only constructed to insert a new entry.
+		 */
+
+		/** @brief get() for a lookup key of type K, pinning the returned item when pin is set */
+		template <typename K, typename Factory, typename Configure>
+		inline CachedItem* getImpl( const K& key, Factory& factory, Configure& configure, bool pin );
+
+		/** @brief getMany() for a lookup key of type K */
+		template <typename K>
+		inline std::size_t getManyImpl( std::span<const K> keys, std::span<TValue*> results, BatchFactoryFunction factory, ConfigFunction configure );
+
+		/** @brief find() for a lookup key of type K, pinning the returned item when pin is set */
+		template <typename K>
+		inline CachedItem* findImpl( const K& key, bool pin );
+
+		/** @brief findMany() for a lookup key of type K */
+		template <typename K>
+		inline std::size_t findManyImpl( std::span<const K> keys, std::span<TValue*> results );
+
+		/** @brief remove() for a lookup key of type K */
+		template <typename K>
+		inline bool removeImpl( const K& key );
+
+		/**
+		 * @brief set(), insertOrAssign() and emplace(): store a value constructed from args
+		 * @param key The cache key
+		 * @param replace True to replace a live entry, false to leave it untouched
+		 * @param configure Callable configuring the entry
+		 * @param args Arguments TValue is constructed or assigned from
+		 * @return Cached item, and true if the key had no live entry
+		 */
+		template <typename Configure, typename... Args>
+		inline std::pair<CachedItem*, bool> storeImpl( const TKey& key, bool replace, Configure& configure, Args&&... args );
+
+		/** @brief removeMany() for a lookup key of type K */
+		template <typename K>
+		inline std::size_t removeManyImpl( std::span<const K> keys );
+
+		//----------------------------------------------
+		// Background cleanup
+		//----------------------------------------------
+
+		/** @brief Upper bound of the adaptive cleanup budget */
+		static constexpr std::size_t MAX_ADAPTIVE_CLEANUP_BUDGET = 65536;
+
+		/** @brief Number of entries an adaptive cleanup cycle expires between two checks of its time budget */
+		static constexpr std::size_t ADAPTIVE_CLEANUP_CHUNK = 16;
+
+		/** @brief Maintenance period used when backgroundCleanupInterval() is 0 */
+		static constexpr std::chrono::milliseconds DEFAULT_MAINTENANCE_INTERVAL{ 1000 };
+
+		/** @brief Maximum number of entries expired per lock acquisition by the maintenance task */
+		static constexpr std::size_t MAINTENANCE_BATCH = 256;
+
+		/**
+		 * @brief Check if the background cleanup interval has elapsed
+		 * @param now Current time, read once by the calling operation
+		 * @return True if the next exclusive operation should run a cleanup cycle
+		 * @note Only reads cache state, so a shared lock is sufficient
+		 */
+		inline bool isBackgroundCleanupDue( std::chrono::steady_clock::time_point now ) const;
+
+		/**
+		 * @brief Check if background cleanup should run and perform it if needed
+		 * @param now Current time, read once by the calling operation
+		 * @details Called during normal operations to amortize cleanup cost
+		 */
+		inline void checkAndPerformBackgroundCleanup( std::chrono::steady_clock::time_point now );
+
+		/**
+		 * @brief Run one adaptive cleanup cycle and adjust the budget of the next one
+		 * @param now Current time, read once by the calling operation
+		 * @return Number of expired entries removed
+		 */
+		inline std::size_t performAdaptiveCleanup( std::chrono::steady_clock::time_point now );
+
+		/**
+		 * @brief Maintenance task run by the scheduler: drain reads, expire entries and enforce the limits
+		 * @details Expires in batches of MAINTENANCE_BATCH, releasing the lock in between so request
+		 *          threads are never held up by a long cleanup.
+		 */
+		inline void performMaintenance();
+
+		//----------------------------------------------
+		// Snapshot loading
+		//----------------------------------------------
+
+		/** @brief Number of snapshot records decoded and inserted per lock acquisition */
+		static constexpr std::size_t SNAPSHOT_LOAD_CHUNK = 16384;
+
+		/** @brief Minimum number of records per decoding thread */
+		static constexpr std::size_t SNAPSHOT_RECORDS_PER_THREAD = 1024;
+
+		/** @brief Stream buffer size used by the file overloads */
+		static constexpr std::size_t SNAPSHOT_FILE_BUFFER = 1 << 20;
+
+		//----------------------------------------------
+		// Internal data structures
+		//----------------------------------------------
+
+		/** @brief Internal cache item containing value and metadata */
+		struct CachedItem
+		{
+			/** @brief The cached value */
+			TValue value;
+
+			/** @brief Cache entry metadata and LRU information */
+			CacheEntry metadata;
+
+			/** @brief Construct cache item with metadata and a value constructed in place from args */
+			template <typename... Args>
+			explicit CachedItem( CacheEntry meta, Args&&... args );
+		};
+
+		/**
+		 * @brief State shared between the thread running a factory and threads waiting on it
+		 * @details Lives on the loading thread's stack (in a per-batch vector for getMany()); the
+		 *          loader does not return before every waiter has observed the outcome, so single
+		 *          loads make no heap allocation.
+		 */
+		struct PendingLoad
+		{
+			/** @brief Key being loaded (the loader's argument) */
+			const TKey* key;
+
+			/** @brief Number of threads waiting on this load */
+			std::size_t waiterCount{ 0 };
+
+			/** @brief True once the value was inserted or the factory failed */
+			bool completed{ false };
+
+			/** @brief Exception thrown by the factory, rethrown in every waiter */
+			std::exception_ptr error;
+
+			/** @brief True if the factory found no value for the key */
+			bool absent{ false };
+
+			/** @brief Callers of getAsync() and getFuture() to resume once the load completed */
+			std::vector<AsyncWaiter*> asyncWaiters;
+
+			/** @brief Construct the state of a load of the key at loadKey, not completed and without waiters */
+			explicit PendingLoad( const TKey* loadKey ) noexcept;
+		};
+
+		/** @brief In-flight loads by key */
+		using PendingLoadMap = typename Index::template Map<TKey, PendingLoad*, Hash, KeyEqual, std::allocator<std::pair<const TKey, PendingLoad*>>>;
+
+		/** @brief Value a miss took out of the second tier, restored without the lock held */
+		struct Promotion
+		{
+			/** @brief Key of the value */
+			const TKey* key{ nullptr };
+
+			/** @brief Compressed value */
+			std::vector<std::byte> block;
+
+			/** @brief Expiration state and size of the evicted entry */
+			CacheEntry metadata;
+
+			/** @brief Restored value, empty until restored or if restoring failed */
+			std::optional<TValue> value;
+
+			/** @brief Construct an empty promotion of the key at promotedKey */
+			explicit Promotion( const TKey* promotedKey = nullptr ) noexcept;
+		};
+
+		/**
+		 * @brief Caller of getAsync() or getFuture() waiting for a key to be loaded
+		 * @details Registered with the key's PendingLoad, whether a get(), a getMany() or an
+		 *          asynchronous load runs it. Owned by the awaitable, or by itself for getFuture().
+		 */
+		struct AsyncWaiter
+		{
+			/** @brief Key awaited */
+			TKey key;
+
+			/** @brief Copy of the caller's factory, run if the waiter has to start a load */
+			FactoryFunction factory;
+
+			/** @brief Handle pinning the loaded value, set when the load succeeded */
+			ValueHandle value;
+
+			/** @brief Exception thrown by the factory of the load */
+			std::exception_ptr error;
+
+			/** @brief Coroutine suspended in getAsync(), empty for getFuture() */
+			std::coroutine_handle<> continuation;
+
+			/** @brief Promise of a getFuture() caller */
+			std::optional<std::promise<ValueHandle>> promise;
+
+			/** @brief Construct a waiter for awaitedKey, loading it with loadFactory if it has to start the load */
+			AsyncWaiter( const TKey& awaitedKey, FactoryFunction loadFactory );
+		};
+
+		/** @brief Load started by a getAsync() or getFuture() miss, run on the load executor */
+		struct AsyncLoad
+		{
+			/** @brief Key to load */
+			TKey key;
+
+			/** @brief Copy of the factory of the waiter that started the load */
+			FactoryFunction factory;
+
+			/** @brief Single-flight state, waited on like the loads of get() */
+			PendingLoad pending;
+
+			/** @brief Compressed value taken from the second tier, restored instead of calling the factory */
+			std::optional<Promotion> promotion;
+
+			/** @brief Construct the load of loadKey by loadFactory, its pending state pointing at the copied key */
+			AsyncLoad( const TKey& loadKey, FactoryFunction loadFactory );
+		};
+
+		/** @brief Reload queued by a get() hit, run on the refresh executor */
+		struct PendingRefresh
+		{
+			/** @brief Key to reload */
+			TKey key;
+
+			/** @brief Entry being reloaded, only compared to tell whether it is still cached */
+			const CacheEntry* entry;
+
+			/** @brief Copy of the factory of the get() that triggered the reload */
+			FactoryFunction load;
+
+			/** @brief Copy of the configurator of that get() */
+			ConfigFunction configure;
+		};
+
+		/** @brief Allocator placing hash map nodes in the slab pool when slab storage is enabled */
+		using EntryAllocator = SlabAllocator<std::pair<const TKey, CachedItem>>;
+
+		/** @brief Hash map type holding cached items */
+		using EntryMap = typename Index::template Map<TKey, CachedItem, Hash, KeyEqual, EntryAllocator>;
+
+		/** @brief Pinned entry removed from m_cache, kept alive until its last handle is dropped */
+		struct RetiredEntry
+		{
+			/** @brief Extracted entry */
+			typename EntryMap::node_type node;
+
+			/** @brief Why it was removed, reported once it is destroyed */
+			RemovalCause cause;
+		};
+
+		/**
+		 * @brief Key remembered as having no value
+		 * @details Tombstones all live for negativeExpiration(), so the list linking them in
+		 *          creation order is also ordered by deadline, and purging only visits expired ones.
+		 */
+		struct Tombstone
+		{
+			/** @brief Last instant the tombstone is valid */
+			std::chrono::steady_clock::time_point deadline;
+
+			/** @brief Older neighbour in creation order */
+			Tombstone* prev{ nullptr };
+
+			/** @brief Newer neighbour in creation order */
+			Tombstone* next{ nullptr };
+
+			/** @brief Key owned by the tombstone map, used to erase the tombstone when purged */
+			const TKey* key{ nullptr };
+		};
+
+		/** @brief Hash map type holding tombstones, apart from the entries so they cost no CachedItem */
+		using TombstoneMap = typename Index::template Map<TKey, Tombstone, Hash, KeyEqual, std::allocator<std::pair<const TKey, Tombstone>>>;
+
+		/**
+		 * @brief Evicted value kept compressed in the second tier
+		 * @details Linked in the order values were stored, so the oldest is dropped first when the
+		 *          budget is exceeded.
+		 */
+		struct DemotedValue
+		{
+			/** @brief Serialized value, compressed by the second tier codec */
+			std::vector<std::byte> block;
+
+			/** @brief Expiration state and size of the evicted entry, restored on promotion */
+			CacheEntry metadata;
+
+			/** @brief Older neighbour in storage order */
+			DemotedValue* prev{ nullptr };
+
+			/** @brief Newer neighbour in storage order */
+			DemotedValue* next{ nullptr };
+
+			/** @brief Key owned by the second tier map, used to erase the oldest value */
+			const TKey* key{ nullptr };
+		};
+
+		/** @brief Hash map type holding the second tier, apart from the entries */
+		using SecondTierMap = typename Index::template Map<TKey, DemotedValue, Hash, KeyEqual, std::allocator<std::pair<const TKey, DemotedValue>>>;
+
+		/** @brief Value evicted under the lock, compressed and stored once the lock is released */
+		struct Demotion
+		{
+			/** @brief Key of the evicted entry */
+			TKey key;
+
+			/** @brief Expiration state and size of the evicted entry */
+			CacheEntry metadata;
+
+			/** @brief Serialized value */
+			std::vector<std::byte> bytes;
+
+			/** @brief Compressed value, empty until compressed or if compression failed */
+			std::vector<std::byte> block;
+
+			/** @brief Set under the lock when the key is written or removed while the value is compressed */
+			bool cancelled{ false };
+		};
+
+		/** @brief True if TValue has a SnapshotSerializer, which the second tier requires */
+		static constexpr bool SECOND_TIER_SUPPORTED = SnapshotCodec<SnapshotSerializer<TValue>, TValue>;
+
+		/** @brief Bit set in CacheEntry::pinCount once a pinned entry was removed from m_cache */
+		static constexpr std::uint32_t PIN_RETIRED = 0x80000000u;
+
+		/** @brief Number of keys hashed and prefetched ahead of the lookup in batch operations */
+		static constexpr std::size_t BATCH_PREFETCH_DISTANCE = 8;
+
+		/** @brief Number of recorded hits a read buffer stripe holds before it must be drained */
+		static constexpr std::uint32_t READ_BUFFER_CAPACITY = 32;
+
+		/** @brief Maximum number of read buffer stripes */
+		static constexpr std::size_t MAX_READ_BUFFER_STRIPES = 64;
+
+		/** @brief Hit recorded under a shared lock */
+		struct ReadRecord
+		{
+			/** @brief Entry that was hit */
+			std::atomic<CacheEntry*> entry{ nullptr };
+
+			/** @brief Time of the hit, as steady_clock ticks */
+			std::atomic<std::chrono::steady_clock::rep> accessTime{ 0 };
+		};
+
+		/** @brief Stripe of hits recorded under a shared lock, waiting to be applied to the LRU list */
+		struct alignas( 64 ) ReadBuffer
+		{
+			/** @brief Number of slots claimed since the last drain (may exceed capacity) */
+			std::atomic<std::uint32_t> writeCount{ 0 };
+
+			/** @brief Hits recorded since the last drain */
+			std::array<ReadRecord, READ_BUFFER_CAPACITY> records{};
+		};
+
+		/**
+		 * @brief Cache lock: a plain mutex by default, a shared mutex in read-optimized mode
+		 * @details Keeps the cheaper std::mutex on the default path while exposing the
+		 *          SharedLockable interface used by the read-optimized path
+		 */
+		class CacheMutex
+		{
+		public:
+			/**
+			 * @brief Construct the cache lock
+			 * @param shared True to back the lock with a std::shared_mutex
+			 */
+			inline explicit CacheMutex( bool shared ) noexcept;
+
+			/** @brief Acquire exclusive ownership */
+			inline void lock();
+
+			/** @brief Release exclusive ownership */
+			inline void unlock();
+
+			/** @brief Acquire shared ownership (exclusive ownership when not shared) */
+			inline void lock_shared();
+
+			/** @brief Release shared ownership */
+			inline void unlock_shared();
+
+		private:
+			std::mutex m_exclusive;
+			std::shared_mutex m_shared;
+			bool m_isShared;
+		};
+
+		/**
+		 * @brief Exclusive hold of the cache lock delivering the removals collected meanwhile
+		 * @details Waitable by m_loadSignal like a std::unique_lock. On destruction the pending
+		 *          removals are taken while the lock is still held, then the lock is released before
+		 *          the listener is called. Evicted values are compressed into the second tier,
+		 *          queued reloads and asynchronous loads submitted and completed asynchronous
+		 *          waiters resumed the same way. Work left pending across a
+		 *          wait may thus be delivered by whichever operation releases the lock next.
+		 */
+		class ExclusiveLock
+		{
+		public:
+			/**
+			 * @brief Acquire the cache lock exclusively
+			 * @param cache Cache whose lock is acquired
+			 */
+			inline explicit ExclusiveLock( LruCache& cache );
+
+			ExclusiveLock( const ExclusiveLock& ) = delete;
+			ExclusiveLock& operator=( const ExclusiveLock& ) = delete;
+
+			/** @brief Release the lock, then notify the listener and run the work queued meanwhile */
+			inline ~ExclusiveLock();
+
+			/** @brief Reacquire the lock */
+			inline void lock();
+
+			/** @brief Release the lock, keeping collected removals pending */
+			inline void unlock();
+
+		private:
+			LruCache& m_cache;
+			std::unique_lock<CacheMutex> m_lock;
+		};
+
+		mutable CacheMutex m_mutex;
+
+		/** @brief Node pool backing m_cache (only allocated with slab storage, must outlive m_cache) */
+		std::unique_ptr<SlabPool> m_slabPool;
+
+		EntryMap m_cache;
+
+		/** @brief Pinned entries removed from m_cache, destroyed by the release of their last handle */
+		std::vector<RetiredEntry> m_retired;
+
+		LruCacheOptions m_options;
+
+		/** @brief Loads currently running outside the lock (one per loading thread, or one per key of a getMany() batch) */
+		PendingLoadMap m_pendingLoads;
+
+		/** @brief Signalled under m_mutex when a load finishes and when the last waiter of a load leaves */
+		std::condition_variable_any m_loadSignal;
+
+		/** @brief Eviction policy ordering the entries */
+		Policy m_policy;
+
+		/** @brief Last time background cleanup was performed */
+		std::chrono::steady_clock::time_point m_lastCleanupTime;
+
+		/** @brief Entries the next adaptive cleanup cycle may remove */
+		std::size_t m_cleanupBudget;
+
+		/** @brief Entries indexed by expiration time, so cleanup only visits expired entries */
+		TimerWheel m_expiryWheel;
+
+		/** @brief Optional function computing entry sizes */
+		SizeFunction m_sizer;
+
+		/** @brief Optional function notified of removed entries */
+		RemovalListener m_removalListener;
+
+		/** @brief Removals collected under the lock, waiting for it to be released (only filled with a listener) */
+		std::vector<RemovalNotification> m_removals;
+
+		/** @brief Reloads queued under the lock, submitted to the executor once it is released */
+		std::vector<PendingRefresh> m_refreshQueue;
+
+		/** @brief Asynchronous loads started under the lock, submitted to the load executor once it is released */
+		std::vector<std::shared_ptr<AsyncLoad>> m_asyncLoadQueue;
+
+		/** @brief Asynchronous waiters whose load completed, resumed once the lock is released */
+		std::vector<AsyncWaiter*> m_asyncResumptions;
+
+		/** @brief Reloads and asynchronous loads queued or running; the destructor waits for none to be left */
+		std::size_t m_backgroundTasks;
+
+		/** @brief Sum of CacheEntry::size over all entries in m_cache */
+		std::size_t m_memoryUsage;
+
+		/** @brief Keys the factory found no value for (only filled with negative caching) */
+		TombstoneMap m_tombstones;
+
+		/** @brief Oldest tombstone, the next one to expire */
+		Tombstone* m_oldestTombstone;
+
+		/** @brief Newest tombstone */
+		Tombstone* m_newestTombstone;
+
+		/** @brief Compressed copies of evicted values (only filled with a second tier) */
+		SecondTierMap m_secondTier;
+
+		/** @brief Oldest compressed value, the next one dropped when the budget is exceeded */
+		DemotedValue* m_oldestDemoted;
+
+		/** @brief Newest compressed value */
+		DemotedValue* m_newestDemoted;
+
+		/** @brief Sum of the compressed value sizes in m_secondTier */
+		std::size_t m_secondTierMemoryUsage;
+
+		/** @brief Compressed values indexed by expiration time, so cleanup only visits expired ones */
+		TimerWheel m_secondTierWheel;
+
+		/** @brief Values evicted under the lock, compressed into the second tier once it is released */
+		std::vector<Demotion> m_demotions;
+
+		/** @brief Batches of demotions being compressed without the lock, cancelled by writes and removals of their keys */
+		std::vector<std::vector<Demotion>*> m_demotionBatches;
+
+		/** @brief Striped read buffers (only allocated in read-optimized mode) */
+		std::unique_ptr<ReadBuffer[]> m_readBuffers;
+
+		/** @brief Mask applied to the thread hash to select a read buffer stripe */
+		std::size_t m_readBufferMask;
+
+		/** @brief Runtime statistics, recorded without the cache lock being required */
+		Stats m_stats;
+
+		/** @brief Scheduler owned by the cache with a dedicated maintenance thread */
+		std::unique_ptr<MaintenanceScheduler> m_ownScheduler;
+
+		/** @brief Scheduled maintenance task, declared last so it is unscheduled before anything it uses is destroyed */
+		MaintenanceScheduler::Registration m_maintenance;
+
+		//----------------------------------------------
+		// Eviction
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the callable the eviction policy uses to hash an entry's key
+		 * @return Callable mapping a CacheEntry* to the hash of its key
+		 */
+		[[nodiscard]] inline auto entryHasher() const noexcept;
+
+		/**
+		 * @brief Evict policy victims until new entries fit the configured limits
+		 * @param incomingSize Size of the entry about to be inserted
+		 * @param incomingCount Number of entries about to be inserted (0 to only enforce the limits)
+		 * @details An entry larger than the whole memory budget still gets inserted once every
+		 *          other entry has been evicted.
+		 */
+		inline void evictUntilFits( std::size_t incomingSize, std::size_t incomingCount = 1 );
+
+		/**
+		 * @brief Remove an entry from the eviction policy, update accounting and erase it
+		 * @param it Iterator to the entry to erase
+		 * @param cause Reason reported to the removal listener
+		 * @return Iterator following the erased entry
+		 */
+		inline typename EntryMap::iterator eraseEntry( typename EntryMap::iterator it, RemovalCause cause );
+
+		/**
+		 * @brief Erase the entry owning the given metadata
+		 * @param entry Metadata of an entry stored in m_cache
+		 * @param cause Reason reported to the removal listener
+		 */
+		inline void eraseEntry( CacheEntry* entry, RemovalCause cause );
+
+		/**
+		 * @brief Insert an entry, evicting others first to make room for it
+		 * @param key Key, not present in the cache
+		 * @param value Value to store
+		 * @param metadata Entry metadata, with both timestamps set
+		 * @return Inserted item
+		 */
+		inline CachedItem& insertEntry( const TKey& key, TValue&& value, CacheEntry&& metadata );
+
+		/**
+		 * @brief Insert an entry constructed in place, sized and configured once constructed
+		 * @param key Key of the entry, which must not be cached
+		 * @param now Time the value is stored at
+		 * @param configure Callable configuring the entry
+		 * @param args Arguments TValue is constructed from
+		 * @return Inserted item
+		 * @details The limits are enforced after insertion, with the new entry pinned.
+		 */
+		template <typename Configure, typename... Args>
+		inline CachedItem& emplaceEntry( const TKey& key, std::chrono::steady_clock::time_point now, Configure& configure, Args&&... args );
+
+		/**
+		 * @brief Replace the value of a cached, unpinned entry in place
+		 * @param it Entry to update
+		 * @param cause Cause reported with the replaced value
+		 * @param now Time the value is stored at
+		 * @param configure Callable configuring the entry
+		 * @param value Value to assign, or argument a value is constructed from before assignment
+		 * @details The entry keeps its node and policy state and is marked as recently used. Its
+		 *          expiration settings and size are reset as for a new entry.
+		 */
+		template <typename Configure, typename V>
+		inline void assignEntry( typename EntryMap::iterator it, RemovalCause cause, std::chrono::steady_clock::time_point now, Configure& configure, V&& value );
+
+		/**
+		 * @brief Link an entry just added to m_cache into the policy, the timer wheel and the accounting
+		 * @param item Item just inserted
+		 */
+		inline void linkEntry( typename EntryMap::value_type& item );
+
+		/**
+		 * @brief Enforce the limits without evicting an entry
+		 * @param item Entry to keep, pinned meanwhile
+		 */
+		inline void evictAround( CachedItem& item );
+
+		/**
+		 * @brief Create the metadata of a new entry with the configured expiration defaults
+		 * @return Metadata to stamp, configure and insert
+		 */
+		[[nodiscard]] inline CacheEntry newEntryMetadata() const;
+
+		//----------------------------------------------
+		// Pinning
+		//----------------------------------------------
+
+		/**
+		 * @brief Check whether value handles pin an entry
+		 * @param entry Entry stored in m_cache
+		 * @return True if at least one handle pins it
+		 */
+		[[nodiscard]] static inline bool isPinned( CacheEntry& entry ) noexcept;
+
+		/**
+		 * @brief Pin an item for a handle about to be returned, if requested
+		 * @param item Item found or inserted under the cache lock
+		 * @param pin True to pin it
+		 * @return item
+		 */
+		static inline CachedItem* acquire( CachedItem& item, bool pin ) noexcept;
+
+		/**
+		 * @brief Take an entry out of m_cache, keeping it alive in m_retired while it is pinned
+		 * @param it Iterator to an entry already removed from the policy, the wheel and the accounting
+		 * @param cause Reason reported to the removal listener
+		 * @return Iterator following the entry
+		 */
+		inline typename EntryMap::iterator detachEntry( typename EntryMap::iterator it, RemovalCause cause );
+
+		/**
+		 * @brief Drop one pin of an entry, destroying it if it was its last pin and it left the cache
+		 * @param entry Metadata of the pinned entry
+		 */
+		inline void unpin( CacheEntry* entry ) noexcept;
+
+		//----------------------------------------------
+		// Batch lookup
+		//----------------------------------------------
+
+		/**
+		 * @brief Look up every key of a batch, pipelining hashing and prefetching when the index supports it
+		 * @param keys The cache keys
+		 * @param visit Called with each key's position and its EntryMap iterator (end() when missing), in order
+		 * @note Must be called with m_mutex held exclusively; visit may erase the entry it is given
+		 */
+		template <typename K, typename Visit>
+		inline void lookupBatch( std::span<const K> keys, Visit&& visit );
+
+		//----------------------------------------------
+		// Read-optimized path
+		//----------------------------------------------
+
+		/**
+		 * @brief Try to serve a lookup under a shared lock
+		 * @param key The cache key
+		 * @param now Current time, read once by the calling operation
+		 * @param pin True to pin the item found before the shared lock is released
+		 * @param result Set to the cached item on a hit, nullptr on a miss
+		 * @return True if the lookup was handled, false if it must be retried on the exclusive path
+		 *         (read-optimized mode disabled, entry possibly expired, read buffer full or cleanup due)
+		 */
+		template <typename K>
+		inline bool tryFindShared( const K& key, std::chrono::steady_clock::time_point now, bool pin, CachedItem*& result );
+
+		/**
+		 * @brief Record a hit in the calling thread's read buffer stripe
+		 * @param entry Entry that was hit
+		 * @param now Time of the hit
+		 * @return True if recorded, false if the stripe is full and must be drained first
+		 * @note Must be called with m_mutex held in shared mode
+		 */
+		inline bool recordRead( CacheEntry* entry, std::chrono::steady_clock::time_point now ) noexcept;
+
+		/**
+		 * @brief Apply buffered hits to the LRU list and sliding expiration timestamps
+		 * @note Must be called with m_mutex held exclusively, before any entry is erased
+		 */
+		inline void drainReadBuffers() noexcept;
+
+		//----------------------------------------------
+		// Single-flight loading
+		//----------------------------------------------
+
+		/**
+		 * @brief Find the in-flight load for a key
+		 * @param key The key to look up
+		 * @return Pending load state, or nullptr if the key is not being loaded
+		 * @note Must be called with m_mutex held
+		 */
+		template <typename K>
+		[[nodiscard]] inline PendingLoad* findPendingLoad( const K& key ) const;
+
+		/**
+		 * @brief Register a load so that other lookups of its key wait for it
+		 * @param pending Load of a key with no load in flight, alive until completePendingLoads()
+		 * @note Must be called with m_mutex held exclusively
+		 */
+		inline void addPendingLoad( PendingLoad& pending );
+
+		/**
+		 * @brief Unregister loads, leaving their states untouched
+		 * @param loads Loads registered by addPendingLoad()
+		 * @note Must be called with m_mutex held exclusively
+		 */
+		inline void forgetPendingLoads( std::span<PendingLoad> loads ) noexcept;
+
+		/**
+		 * @brief Publish the outcome of in-flight loads, wake their waiters and wait for them to leave
+		 * @param lock Lock holding m_mutex
+		 * @param loads The pending load states (one for get(), one per loaded key for getMany())
+		 * @param error Exception thrown by the factory, or nullptr on success
+		 */
+		inline void completePendingLoads( ExclusiveLock& lock, std::span<PendingLoad> loads, std::exception_ptr error );
+
+		//----------------------------------------------
+		// Negative caching
+		//----------------------------------------------
+
+		/**
+		 * @brief Check if a key is remembered as having no value
+		 * @param key The key to look up
+		 * @param now Current time
+		 * @return True if a live tombstone exists for the key; an expired one is erased
+		 * @note Must be called with m_mutex held exclusively
+		 */
+		template <typename K>
+		[[nodiscard]] inline bool isKnownAbsent( const K& key, std::chrono::steady_clock::time_point now );
+
+		/**
+		 * @brief Remember that a key has no value, if negative caching is enabled
+		 * @param key The key the factory found no value for
+		 * @note Must be called with m_mutex held exclusively, while the key is not cached
+		 */
+		inline void addTombstone( const TKey& key );
+
+		/**
+		 * @brief Forget the tombstone of a key, if any
+		 * @param key The key now cached or removed
+		 * @note Must be called with m_mutex held exclusively
+		 */
+		template <typename K>
+		inline void forgetTombstone( const K& key );
+
+		/**
+		 * @brief Unlink and erase a tombstone
+		 * @param it Position of the tombstone in m_tombstones
+		 */
+		inline void eraseTombstone( typename TombstoneMap::iterator it );
+
+		/**
+		 * @brief Erase the expired tombstones, oldest first
+		 * @param now Current time
+		 * @note Must be called with m_mutex held exclusively
+		 */
+		inline void purgeTombstones( std::chrono::steady_clock::time_point now );
+
+		//----------------------------------------------
+		// Second tier
+		//----------------------------------------------
+
+		/**
+		 * @brief Serialize an entry about to be evicted for the second tier, if it is enabled
+		 * @param item Entry evicted for size
+		 * @details Values below secondTierMinimumSize() and values whose serializer throws are dropped.
+		 * @note Must be called with m_mutex held exclusively
+		 */
+		inline void demoteEntry( const typename EntryMap::value_type& item );
+
+		/**
+		 * @brief Compress evicted values, then store them in the second tier
+		 * @param demotions Values taken from m_demotions, registered in m_demotionBatches
+		 * @details Called without the lock held; it is taken once the values are compressed. Values
+		 *          already expired, and values cancelled meanwhile by a write or a removal of their
+		 *          key, are dropped.
+		 */
+		inline void storeDemotions( std::vector<Demotion>& demotions );
+
+		/**
+		 * @brief Take the compressed value of a key out of the second tier
+		 * @param key The key to look up
+		 * @param now Current time
+		 * @param promotion Receives the compressed value and the state of the evicted entry
+		 * @return True if a live value was found
+		 * @note Must be called with m_mutex held exclusively
+		 */
+		template <typename K>
+		[[nodiscard]] inline bool takeDemoted( const K& key, std::chrono::steady_clock::time_point now, Promotion& promotion );
+
+		/**
+		 * @brief Decompress and deserialize a value taken from the second tier
+		 * @param promotion Value taken by takeDemoted(), whose value is set on success
+		 * @param now Time of the access promoting it
+		 * @return True if restored, false if the codec or the serializer threw
+		 */
+		inline bool restoreDemoted( Promotion& promotion, std::chrono::steady_clock::time_point now ) const;
+
+		/**
+		 * @brief Promote the compressed value of a key without releasing the lock
+		 * @param key The key missing from the cache
+		 * @param now Current time
+		 * @return Inserted item, or nullptr if the second tier holds no restorable value for the key
+		 * @details For find() and findMany(), which have no load to share the miss with.
+		 * @note Must be called with m_mutex held exclusively
+		 */
+		template <typename K>
+		inline CachedItem* promoteLocked( const K& key, std::chrono::steady_clock::time_point now );
+
+		/**
+		 * @brief Drop the compressed value of a key, if any, and cancel one being compressed
+		 * @param key The key now cached, removed or known absent
+		 * @note Must be called with m_mutex held exclusively
+		 */
+		template <typename K>
+		inline void forgetDemoted( const K& key );
+
+		/**
+		 * @brief Erase the expired compressed values
+		 * @param now Current time
+		 * @note Must be called with m_mutex held exclusively
+		 */
+		inline void purgeDemoted( std::chrono::steady_clock::time_point now );
+
+		/**
+		 * @brief Copy the expiration state and size of an entry into unlinked metadata
+		 * @param entry Metadata to copy
+		 * @return Metadata with the same timestamps, expiration settings and size
+		 */
+		[[nodiscard]] static inline CacheEntry expirationState( const CacheEntry& entry ) noexcept;
+
+		/**
+		 * @brief Unlink and erase a compressed value
+		 * @param it Position of the value in m_secondTier
+		 */
+		inline void eraseDemoted( typename SecondTierMap::iterator it );
+
+		//----------------------------------------------
+		// Refresh-ahead
+		//----------------------------------------------
+
+		/**
+		 * @brief Check if a hit on a live entry should schedule a reload
+		 * @param entry Entry that was hit
+		 * @param now Current time, read once by the calling operation
+		 * @return True if refreshAfter() has elapsed since the value was stored and no reload is pending
+		 */
+		[[nodiscard]] inline bool isRefreshDue( const CacheEntry& entry, std::chrono::steady_clock::time_point now ) const noexcept;
+
+		/**
+		 * @brief Check if an expired entry is still within the stale-serve window
+		 * @param entry Expired entry
+		 * @param now Current time, read once by the calling operation
+		 * @return True if get() may serve it while it is reloaded
+		 */
+		[[nodiscard]] inline bool isServableStale( const CacheEntry& entry, std::chrono::steady_clock::time_point now ) const noexcept;
+
+		/**
+		 * @brief Mark an entry as refreshing and queue its reload, submitted once the lock is released
+		 * @param it Entry to reload
+		 * @param factory Factory of the get() that hit the entry, copied into the reload
+		 * @param configure Configurator of that get(), copied into the reload
+		 * @return False if the callables cannot be copied, in which case nothing is queued
+		 */
+		template <typename Factory, typename Configure>
+		inline bool queueRefresh( typename EntryMap::iterator it, Factory& factory, Configure& configure );
+
+		/**
+		 * @brief Hand a queued reload to the executor (called without the lock)
+		 * @param refresh Reload to run
+		 */
+		inline void submitRefresh( PendingRefresh refresh ) noexcept;
+
+		/**
+		 * @brief Run a reload: call the factory, then replace the entry if it is still cached
+		 * @param refresh Reload to run
+		 */
+		inline void runRefresh( PendingRefresh& refresh ) noexcept;
+
+		/**
+		 * @brief Install the outcome of a reload and release its slot
+		 * @param key Key of the reloaded entry
+		 * @param entry Entry the reload was scheduled for, replaced only if still cached
+		 * @param value New value, or nullopt if the reload failed or was rejected
+		 * @param metadata Metadata of the new entry
+		 */
+		inline void completeRefresh( const TKey& key, const CacheEntry* entry, std::optional<TValue> value, CacheEntry metadata ) noexcept;
+
+		/**
+		 * @brief Serve a lookup hit like get(): renew a live entry, or serve a stale one while it is reloaded
+		 * @param it Entry found for the key
+		 * @param now Current time, read once by the calling operation
+		 * @param factory Factory of the lookup, copied into a reload if one is due
+		 * @param configure Configurator of the lookup
+		 * @param pin True to pin the item returned
+		 * @return The item, or nullptr if the entry had expired, in which case it was erased
+		 */
+		template <typename Factory, typename Configure>
+		inline CachedItem* serveCached( typename EntryMap::iterator it, std::chrono::steady_clock::time_point now, Factory& factory, Configure& configure, bool pin );
+
+		//----------------------------------------------
+		// Asynchronous loading
+		//----------------------------------------------
+
+		/**
+		 * @brief Serve a getAsync() or getFuture() hit
+		 * @param key The cache key
+		 * @param factory Factory of the caller, copied into a reload if one is due
+		 * @return Pinned item, or nullptr on a miss
+		 */
+		template <typename Factory>
+		inline CachedItem* findAsync( const TKey& key, Factory& factory );
+
+		/**
+		 * @brief Register a waiter with the load of its key, starting one if none is in flight
+		 * @param waiter Waiter of a getAsync() or getFuture() miss
+		 * @return False if the key was cached meanwhile, in which case the waiter's value is set instead
+		 * @warning Once it returned true, the waiter may have been resumed and destroyed already
+		 */
+		inline bool awaitLoad( AsyncWaiter& waiter );
+
+		/**
+		 * @brief Queue a load for the waiter's key, submitted once the lock is released
+		 * @param waiter First waiter of the load
+		 * @param now Current time, to tell whether a value kept in the second tier is still live
+		 * @note Must be called with m_mutex held exclusively, when no load of the key is in flight
+		 */
+		inline void startAsyncLoad( AsyncWaiter& waiter, std::chrono::steady_clock::time_point now );
+
+		/**
+		 * @brief Hand a queued asynchronous load to the executor (called without the lock)
+		 * @param load Load to run
+		 */
+		inline void submitAsyncLoad( std::shared_ptr<AsyncLoad> load ) noexcept;
+
+		/**
+		 * @brief Run an asynchronous load: restore or load the value, insert it and complete the waiters
+		 * @param load Load to run
 		 */
-		inline void addToLruHead( CacheEntry* entry ) noexcept;
+		inline void runAsyncLoad( AsyncLoad& load ) noexcept;
 
 		/**
-		 * @brief Remove entry from LRU list
-		 * @param entry Entry to remove from LRU list
+		 * @brief Insert the outcome of an asynchronous load, complete its waiters and release its slot
+		 * @param load Completed load
+		 * @param value Loaded value, or nullopt if the load failed
+		 * @param metadata Metadata of the new entry
+		 * @param error Exception thrown by the factory, or nullptr on success
 		 */
-		inline void removeFromLru( CacheEntry* entry ) noexcept;
+		inline void completeAsyncLoad( AsyncLoad& load, std::optional<TValue> value, CacheEntry metadata, std::exception_ptr error ) noexcept;
 
 		/**
-		 * @brief Move entry to head of LRU list (mark as most recently used)
-		 * @param entry Entry to move to LRU list head
+		 * @brief Hand the outcome of a completed load to its asynchronous waiters
+		 * @param pending Load removed from m_pendingLoads, holding its outcome
+		 * @details Waiters are queued for resumption once the lock is released. A waiter whose key
+		 *          is no longer cached (evicted by the getMany() batch that loaded it) loads it again.
+		 * @note Must be called with m_mutex held exclusively
 		 */
-		inline void moveToLruHead( CacheEntry* entry ) noexcept;
+		inline void settleAsyncWaiters( PendingLoad& pending );
 
 		/**
-		 * @brief Evict least recently used entry in O(1) time
+		 * @brief Resume a completed waiter: its coroutine, or the promise of getFuture()
+		 * @param waiter Waiter whose value or error is set, destroyed here for getFuture()
 		 */
-		inline void evictLeastRecentlyUsed();
+		static inline void resumeWaiter( AsyncWaiter* waiter ) noexcept;
 	};
 } // namespace nfx::cache
 
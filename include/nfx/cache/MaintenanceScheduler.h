@@ -0,0 +1,246 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file MaintenanceScheduler.h
+ * @brief Background thread running periodic cache maintenance
+ * @details Caches register their expiration and capacity upkeep here instead of running it
+ *          inline in get()/find(). One scheduler, and therefore one thread, can serve any
+ *          number of caches.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// MaintenanceScheduler class
+	//=====================================================================
+
+	/**
+	 * @brief Single background thread running registered tasks at fixed intervals
+	 * @details Tasks run one at a time, outside the scheduler's own lock, and a task is next due
+	 *          one interval after its previous run finished, so a slow run never piles up.
+	 *          Destroying the scheduler requests its std::jthread to stop and joins it.
+	 * @warning Every Registration must be released before its scheduler is destroyed
+	 */
+	class MaintenanceScheduler final
+	{
+	public:
+		//----------------------------------------------
+		// Registration
+		//----------------------------------------------
+
+		/**
+		 * @brief Handle keeping a task scheduled until it is reset or destroyed
+		 * @details Releasing the handle waits for a run of the task in progress on another thread,
+		 *          so whatever the task refers to may be destroyed right after.
+		 */
+		class Registration final
+		{
+		public:
+			//----------------------------------------------
+			// Construction
+			//----------------------------------------------
+
+			/** @brief Construct an empty registration */
+			Registration() noexcept = default;
+
+			Registration( const Registration& ) = delete;
+
+			/**
+			 * @brief Take over another registration
+			 * @param other Registration left empty
+			 */
+			inline Registration( Registration&& other ) noexcept;
+
+			//----------------------------------------------
+			// Assignment operations
+			//----------------------------------------------
+
+			Registration& operator=( const Registration& ) = delete;
+			inline Registration& operator=( Registration&& other ) noexcept;
+
+			//----------------------------------------------
+			// Destruction
+			//----------------------------------------------
+
+			/** @brief Unschedule the task */
+			inline ~Registration();
+
+			//----------------------------------------------
+			// State inspection
+			//----------------------------------------------
+
+			/**
+			 * @brief Check whether a task is scheduled through this handle
+			 * @return True unless the registration is empty
+			 */
+			[[nodiscard]] inline explicit operator bool() const noexcept;
+
+			//----------------------------------------------
+			// Modification operations
+			//----------------------------------------------
+
+			/** @brief Unschedule the task and leave the registration empty */
+			inline void reset() noexcept;
+
+		private:
+			friend class MaintenanceScheduler;
+
+			/**
+			 * @brief Adopt a task just scheduled
+			 * @param scheduler Scheduler running the task
+			 * @param id Task identifier
+			 */
+			inline Registration( MaintenanceScheduler* scheduler, std::uint64_t id ) noexcept;
+
+			/** @brief Scheduler running the task */
+			MaintenanceScheduler* m_scheduler{ nullptr };
+
+			/** @brief Task identifier */
+			std::uint64_t m_id{ 0 };
+		};
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/** @brief Start the maintenance thread */
+		inline MaintenanceScheduler();
+
+		MaintenanceScheduler( const MaintenanceScheduler& ) = delete;
+		MaintenanceScheduler( MaintenanceScheduler&& ) = delete;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		MaintenanceScheduler& operator=( const MaintenanceScheduler& ) = delete;
+		MaintenanceScheduler& operator=( MaintenanceScheduler&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		/** @brief Stop and join the maintenance thread */
+		~MaintenanceScheduler() = default;
+
+		//----------------------------------------------
+		// Scheduling
+		//----------------------------------------------
+
+		/**
+		 * @brief Run a task periodically on the maintenance thread
+		 * @param interval Time between the end of a run and the start of the next (first run one interval from now)
+		 * @param task Function to run; must not throw
+		 * @return Registration keeping the task scheduled
+		 */
+		[[nodiscard]] inline Registration schedule( std::chrono::milliseconds interval, std::function<void()> task );
+
+		/**
+		 * @brief Get the number of scheduled tasks
+		 * @return Number of live registrations
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t taskCount() const;
+
+		/**
+		 * @brief Get the process-wide scheduler, starting it on first use
+		 * @return Scheduler shared by every cache opting into it
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] static inline MaintenanceScheduler& shared();
+
+	private:
+		//----------------------------------------------
+		// Internal data structures
+		//----------------------------------------------
+
+		/** @brief Scheduled task */
+		struct Task
+		{
+			/** @brief Identifier held by the task's registration */
+			std::uint64_t id;
+
+			/** @brief Delay between runs */
+			std::chrono::milliseconds interval;
+
+			/** @brief Time of the next run */
+			std::chrono::steady_clock::time_point due;
+
+			/** @brief Function to run */
+			std::function<void()> run;
+		};
+
+		//----------------------------------------------
+		// Private helper methods
+		//----------------------------------------------
+
+		/**
+		 * @brief Remove a task, waiting for its run in progress on the maintenance thread
+		 * @param id Task identifier
+		 */
+		inline void unschedule( std::uint64_t id ) noexcept;
+
+		/**
+		 * @brief Maintenance thread body
+		 * @param stop Stop token of the std::jthread
+		 */
+		inline void run( std::stop_token stop );
+
+		mutable std::mutex m_mutex;
+
+		/** @brief Signalled when the task set changes and when a run finishes */
+		std::condition_variable_any m_signal;
+
+		/** @brief Scheduled tasks (heap-allocated so a running task keeps its address) */
+		std::vector<std::unique_ptr<Task>> m_tasks;
+
+		/** @brief Identifier given to the next scheduled task */
+		std::uint64_t m_nextId{ 1 };
+
+		/** @brief Identifier of the task running on the maintenance thread (0 when idle) */
+		std::uint64_t m_runningId{ 0 };
+
+		/** @brief True when tasks were added since the thread computed its next wake-up */
+		bool m_changed{ false };
+
+		/** @brief Maintenance thread, declared last so it stops before the state it uses is destroyed */
+		std::jthread m_thread;
+	};
+} // namespace nfx::cache
+
+#include "nfx/detail/cache/MaintenanceScheduler.inl"
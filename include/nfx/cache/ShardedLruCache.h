@@ -0,0 +1,511 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file ShardedLruCache.h
+ * @brief Thread-safe sharded LRU cache for low lock contention
+ * @details Partitions keys across independent LruCache shards, each with its own
+ *          mutex, hash map and intrusive LRU list
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "nfx/cache/LruCache.h"
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// ShardedLruCache class
+	//=====================================================================
+
+	/**
+	 * @brief Thread-safe LRU cache partitioned into independently locked shards
+	 * @tparam TKey Key type for cache entries
+	 * @tparam TValue Value type for cached objects
+	 * @tparam Hash Hash function object for keys (also used for shard selection)
+	 * @tparam KeyEqual Equality comparison function object for keys
+	 * @tparam Index Key index policy of each shard (NodeIndex or FlatIndex)
+	 * @tparam Policy Eviction policy of each shard (LruPolicy, SlruPolicy, ClockPolicy or WTinyLfuPolicy)
+	 * @tparam Clock Time source of each shard (SteadyClock, CoarseClock or ManualClock)
+	 * @tparam Stats Statistics collector of each shard (NoStats or StripedStats)
+	 * @details Each key is mapped to exactly one shard, so LRU ordering and eviction are
+	 *          per shard. The configured size limit is split across shards so that the
+	 *          per-shard limits sum to sizeLimit().
+	 */
+	template <typename TKey, typename TValue, typename Hash = std::hash<TKey>, typename KeyEqual = std::equal_to<TKey>, typename Index = NodeIndex, typename Policy = LruPolicy, typename Clock = SteadyClock, typename Stats = NoStats>
+	class ShardedLruCache final
+	{
+	public:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		/** @brief Cache type used for each shard */
+		using ShardType = LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>;
+
+		/** @brief Function type for creating cache values when not found */
+		using FactoryFunction = typename ShardType::FactoryFunction;
+
+		/** @brief Function type for configuring cache entry metadata */
+		using ConfigFunction = typename ShardType::ConfigFunction;
+
+		/** @brief Function type for measuring the size of a cache entry */
+		using SizeFunction = typename ShardType::SizeFunction;
+
+		/** @brief Function type creating the values of several missing keys at once */
+		using BatchFactoryFunction = typename ShardType::BatchFactoryFunction;
+
+		/** @brief Handle pinning a cached value in its shard */
+		using ValueHandle = typename ShardType::ValueHandle;
+
+		/** @brief Awaitable returned by getAsync() */
+		using GetAwaitable = typename ShardType::GetAwaitable;
+
+		/** @brief Entry that left the cache, handed to the removal listener */
+		using RemovalNotification = typename ShardType::RemovalNotification;
+
+		/** @brief Function receiving the entries removed by one shard operation */
+		using RemovalListener = typename ShardType::RemovalListener;
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct sharded cache with specified options
+		 * @param options Configuration options applied to every shard (size, memory and second tier limits are split across shards)
+		 * @param shardCount Number of shards, rounded up to a power of two (0 = based on hardware concurrency)
+		 * @param sizer Optional function computing entry sizes, shared by every shard
+		 * @param listener Optional removal listener, shared by every shard (shards may call it concurrently)
+		 * @note The shard count is reduced when needed so that every shard gets non-zero limits.
+		 *       With LruCacheOptions::setMaintenanceThread(), one thread maintains every shard.
+		 */
+		inline explicit ShardedLruCache( const LruCacheOptions& options = {}, std::size_t shardCount = 0, SizeFunction sizer = nullptr, RemovalListener listener = nullptr );
+
+		//----------------------------------------------
+		// Copy and move operations
+		//----------------------------------------------
+
+		ShardedLruCache( const ShardedLruCache& ) = delete;
+		ShardedLruCache( ShardedLruCache&& ) = delete;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		ShardedLruCache& operator=( const ShardedLruCache& ) = delete;
+		ShardedLruCache& operator=( ShardedLruCache&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		// Default destructor
+		~ShardedLruCache() = default;
+
+		//----------------------------------------------
+		// Cache operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Get a cache entry, creating it with factory function if not found
+		 * @param key The cache key
+		 * @param factory Callable creating the value if not cached
+		 * @param configure Optional callable configuring the new cache entry (nullptr to skip)
+		 * @return Pointer to the cached value, or nullptr if an OptionalEntryFactory found none (throws on factory failure)
+		 */
+		template <EntryLoader<TValue> Factory, EntryConfigurator Configure = std::nullptr_t>
+		inline TValue* get( const TKey& key, Factory&& factory, Configure&& configure = nullptr );
+
+		/**
+		 * @brief Get a cache entry by a key of another type, creating it if not found
+		 * @param key Key comparable to TKey (e.g. std::string_view for std::string keys)
+		 * @param factory Callable creating the value if not cached
+		 * @param configure Optional callable configuring the new cache entry (nullptr to skip)
+		 * @return Pointer to the cached value, or nullptr if an OptionalEntryFactory found none (throws on factory failure)
+		 * @note Only available when Hash and KeyEqual are transparent
+		 */
+		template <typename K, EntryLoader<TValue> Factory, EntryConfigurator Configure = std::nullptr_t>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		inline TValue* get( const K& key, Factory&& factory, Configure&& configure = nullptr );
+
+		/**
+		 * @brief Get a cache entry like get(), pinned by the returned handle
+		 * @param key The cache key
+		 * @param factory Callable creating the value if not cached
+		 * @param configure Optional callable configuring the new cache entry (nullptr to skip)
+		 * @return Handle pinning the cached value, empty if an OptionalEntryFactory found none (throws on factory failure)
+		 */
+		template <EntryLoader<TValue> Factory, EntryConfigurator Configure = std::nullptr_t>
+		[[nodiscard]] inline ValueHandle getPinned( const TKey& key, Factory&& factory, Configure&& configure = nullptr );
+
+		/**
+		 * @brief Get a cache entry by a key of another type, pinned by the returned handle
+		 * @param key Key comparable to TKey
+		 * @param factory Callable creating the value if not cached
+		 * @param configure Optional callable configuring the new cache entry (nullptr to skip)
+		 * @return Handle pinning the cached value, empty if an OptionalEntryFactory found none (throws on factory failure)
+		 * @note Only available when Hash and KeyEqual are transparent
+		 */
+		template <typename K, EntryLoader<TValue> Factory, EntryConfigurator Configure = std::nullptr_t>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		[[nodiscard]] inline ValueHandle getPinned( const K& key, Factory&& factory, Configure&& configure = nullptr );
+
+		/**
+		 * @brief Get several cache entries, creating the missing ones in bulk
+		 * @param keys The cache keys
+		 * @param results Receives one value pointer per key; must hold at least keys.size() elements
+		 * @param factory Function creating the values of the missing keys, called once per shard holding missing keys
+		 * @param configure Optional function to configure each new cache entry
+		 * @return Number of values created by the factory
+		 * @details Keys are grouped by shard and each group is handed to the shard's getMany()
+		 */
+		inline std::size_t getMany( std::span<const TKey> keys, std::span<TValue*> results, BatchFactoryFunction factory, ConfigFunction configure = nullptr );
+
+		/**
+		 * @brief Get several cache entries by keys of another type, creating the missing ones in bulk
+		 * @param keys Contiguous range of keys comparable to TKey
+		 * @param results Receives one value pointer per key; must hold at least keys.size() elements
+		 * @param factory Function creating the values of the missing keys, called once per shard holding missing keys
+		 * @param configure Optional function to configure each new cache entry
+		 * @return Number of values created by the factory
+		 * @note Only available when Hash and KeyEqual are transparent
+		 */
+		template <std::ranges::contiguous_range Keys>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		inline std::size_t getMany( const Keys& keys, std::span<TValue*> results, BatchFactoryFunction factory, ConfigFunction configure = nullptr );
+
+		//----------------------------------------------
+		// Asynchronous operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Get a cache entry without blocking the caller, loading it on the load executor if not found
+		 * @param key The cache key
+		 * @param factory Callable creating the value if not cached, copied to run on the loadExecutor()
+		 * @return Awaitable completing with a handle pinning the value (never empty; rethrows on factory failure)
+		 */
+		template <EntryFactory<TValue> Factory>
+			requires std::copy_constructible<std::remove_cvref_t<Factory>>
+		[[nodiscard]] inline GetAwaitable getAsync( const TKey& key, Factory&& factory );
+
+		/**
+		 * @brief Get a cache entry like getAsync(), for callers that are not coroutines
+		 * @param key The cache key
+		 * @param factory Callable creating the value if not cached, copied to run on the loadExecutor()
+		 * @return Future receiving the handle pinning the value, or the exception of the factory
+		 */
+		template <EntryFactory<TValue> Factory>
+			requires std::copy_constructible<std::remove_cvref_t<Factory>>
+		[[nodiscard]] inline std::future<ValueHandle> getFuture( const TKey& key, Factory&& factory );
+
+		//----------------------------------------------
+		// Lookup operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Find a cached value without creating it
+		 * @param key The cache key
+		 * @return Pointer to the cached value if found and not expired, nullptr otherwise
+		 */
+		inline TValue* find( const TKey& key );
+
+		/**
+		 * @brief Find a cached value by a key of another type
+		 * @param key Key comparable to TKey
+		 * @return Pointer to the cached value if found and not expired, nullptr otherwise
+		 * @note Only available when Hash and KeyEqual are transparent
+		 */
+		template <typename K>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		inline TValue* find( const K& key );
+
+		/**
+		 * @brief Find a cached value like find(), pinned by the returned handle
+		 * @param key The cache key
+		 * @return Handle pinning the cached value, or an empty handle if not found or expired
+		 */
+		[[nodiscard]] inline ValueHandle findPinned( const TKey& key );
+
+		/**
+		 * @brief Find a cached value by a key of another type, pinned by the returned handle
+		 * @param key Key comparable to TKey
+		 * @return Handle pinning the cached value, or an empty handle if not found or expired
+		 * @note Only available when Hash and KeyEqual are transparent
+		 */
+		template <typename K>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		[[nodiscard]] inline ValueHandle findPinned( const K& key );
+
+		/**
+		 * @brief Find several cached values, locking each involved shard once
+		 * @param keys The cache keys
+		 * @param results Receives one value pointer per key (nullptr when missing or expired); must hold at least keys.size() elements
+		 * @return Number of keys found
+		 */
+		inline std::size_t findMany( std::span<const TKey> keys, std::span<TValue*> results );
+
+		/**
+		 * @brief Find several cached values by keys of another type, locking each involved shard once
+		 * @param keys Contiguous range of keys comparable to TKey
+		 * @param results Receives one value pointer per key (nullptr when missing or expired); must hold at least keys.size() elements
+		 * @return Number of keys found
+		 * @note Only available when Hash and KeyEqual are transparent
+		 */
+		template <std::ranges::contiguous_range Keys>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		inline std::size_t findMany( const Keys& keys, std::span<TValue*> results );
+
+		//----------------------------------------------
+		// Modification operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Store a value for a key, replacing the current one
+		 * @param key The cache key
+		 * @param value Value to store, or argument the value is constructed from
+		 * @param configure Optional callable configuring the entry (nullptr to skip)
+		 * @return Pointer to the cached value
+		 */
+		template <typename V, EntryConfigurator Configure = std::nullptr_t>
+			requires std::constructible_from<TValue, V>
+		inline TValue* set( const TKey& key, V&& value, Configure&& configure = nullptr );
+
+		/**
+		 * @brief Insert a value for a key, or assign it to the value already cached
+		 * @param key The cache key
+		 * @param value Value to store, or argument the value is constructed from
+		 * @return Pointer to the cached value, and true if the key had no live entry
+		 */
+		template <typename V>
+			requires std::constructible_from<TValue, V>
+		inline std::pair<TValue*, bool> insertOrAssign( const TKey& key, V&& value );
+
+		/**
+		 * @brief Insert a value constructed in place from arguments, unless the key is cached
+		 * @param key The cache key
+		 * @param args Arguments TValue is constructed from
+		 * @return Pointer to the cached value, and true if it was inserted
+		 */
+		template <typename... Args>
+			requires std::constructible_from<TValue, Args...>
+		inline std::pair<TValue*, bool> emplace( const TKey& key, Args&&... args );
+
+		/**
+		 * @brief Remove an entry from the cache
+		 * @param key The cache key to remove
+		 * @return True if entry was removed, false if not found
+		 */
+		inline bool remove( const TKey& key );
+
+		/**
+		 * @brief Remove an entry by a key of another type
+		 * @param key Key comparable to TKey
+		 * @return True if entry was removed, false if not found
+		 * @note Only available when Hash and KeyEqual are transparent
+		 */
+		template <typename K>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		inline bool remove( const K& key );
+
+		/**
+		 * @brief Remove several entries, locking each involved shard once
+		 * @param keys The cache keys to remove
+		 * @return Number of entries removed
+		 */
+		inline std::size_t removeMany( std::span<const TKey> keys );
+
+		/**
+		 * @brief Remove several entries by keys of another type, locking each involved shard once
+		 * @param keys Contiguous range of keys comparable to TKey
+		 * @return Number of entries removed
+		 * @note Only available when Hash and KeyEqual are transparent
+		 */
+		template <std::ranges::contiguous_range Keys>
+			requires TransparentKeyLookup<Hash, KeyEqual>
+		inline std::size_t removeMany( const Keys& keys );
+
+		/**
+		 * @brief Clear all cache entries in every shard
+		 */
+		inline void clear();
+
+		/**
+		 * @brief Get current cache size
+		 * @return Number of entries across all shards
+		 * @note Shards are locked one at a time, so the result is not an atomic snapshot
+		 */
+		inline std::size_t size() const;
+
+		/**
+		 * @brief Get current memory usage
+		 * @return Sum of CacheEntry::size over all shards
+		 * @note Shards are locked one at a time, so the result is not an atomic snapshot
+		 */
+		inline std::size_t memoryUsage() const;
+
+		/**
+		 * @brief Get the number of keys remembered as having no value
+		 * @return Number of tombstones across all shards
+		 * @note Shards are locked one at a time, so the result is not an atomic snapshot
+		 */
+		[[nodiscard]] inline std::size_t tombstoneCount() const;
+
+		/**
+		 * @brief Get the number of evicted values kept compressed in the second tier
+		 * @return Number of compressed values across all shards
+		 * @note Shards are locked one at a time, so the result is not an atomic snapshot
+		 */
+		[[nodiscard]] inline std::size_t secondTierSize() const;
+
+		/**
+		 * @brief Get the memory held by the second tier
+		 * @return Sum of the compressed value sizes across all shards, in bytes
+		 * @note Shards are locked one at a time, so the result is not an atomic snapshot
+		 */
+		[[nodiscard]] inline std::size_t secondTierMemoryUsage() const;
+
+		//----------------------------------------------
+		// State inspection
+		//----------------------------------------------
+
+		/**
+		 * @brief Check if cache is empty
+		 * @return True if no shard contains entries
+		 */
+		inline bool isEmpty() const;
+
+		/**
+		 * @brief Get the runtime statistics summed over every shard
+		 * @return Counters since construction (all zero with NoStats)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline CacheStats stats() const noexcept;
+
+		/**
+		 * @brief Manually trigger cleanup of expired entries in every shard
+		 */
+		inline void cleanupExpired();
+
+		/**
+		 * @brief Get the number of shards
+		 * @return Shard count (always a power of two)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t shardCount() const noexcept;
+
+		/**
+		 * @brief Get the maximum number of cache entries allowed across all shards
+		 * @return Sum of per-shard size limits (0 = unlimited)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t sizeLimit() const noexcept;
+
+		/**
+		 * @brief Get the maximum total entry size allowed across all shards
+		 * @return Sum of per-shard memory limits (0 = unlimited)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t memoryLimit() const noexcept;
+
+	private:
+		//----------------------------------------------
+		// Batch operations by lookup key
+		//----------------------------------------------
+
+		/** @brief getMany() for lookup keys of type K */
+		template <typename K>
+		inline std::size_t getManyImpl( std::span<const K> keys, std::span<TValue*> results, BatchFactoryFunction factory, ConfigFunction configure );
+
+		/** @brief findMany() for lookup keys of type K */
+		template <typename K>
+		inline std::size_t findManyImpl( std::span<const K> keys, std::span<TValue*> results );
+
+		/** @brief removeMany() for lookup keys of type K */
+		template <typename K>
+		inline std::size_t removeManyImpl( std::span<const K> keys );
+
+		//----------------------------------------------
+		// Shard selection
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the index of the shard responsible for a key
+		 * @param key The cache key, or a key comparable to it with transparent Hash and KeyEqual
+		 * @return Position of the owning shard in m_shards
+		 */
+		template <typename K>
+		inline std::size_t shardIndexFor( const K& key ) const;
+
+		/**
+		 * @brief Get the shard responsible for a key
+		 * @param key The cache key, or a key comparable to it with transparent Hash and KeyEqual
+		 * @return Reference to the owning shard
+		 */
+		template <typename K>
+		inline ShardType& shardFor( const K& key ) const;
+
+		/**
+		 * @brief Split a batch of keys by owning shard
+		 * @param keys The cache keys
+		 * @param apply Called once per involved shard with the shard, its keys and their positions in keys
+		 */
+		template <typename K, typename Apply>
+		inline void forEachShardBatch( std::span<const K> keys, Apply&& apply ) const;
+
+		//----------------------------------------------
+		// Internal data structures
+		//----------------------------------------------
+
+		/** @brief Maintenance thread shared by every shard when a dedicated one was requested (must outlive m_shards) */
+		std::unique_ptr<MaintenanceScheduler> m_scheduler;
+
+		/** @brief Independently locked shards (heap-allocated to keep shard mutexes apart) */
+		std::vector<std::unique_ptr<ShardType>> m_shards;
+
+		/** @brief Hash function used for shard selection */
+		Hash m_hasher;
+
+		/** @brief Mask applied to the mixed hash to select a shard */
+		std::size_t m_shardMask;
+
+		/** @brief Total size limit across all shards (0 = unlimited) */
+		std::size_t m_sizeLimit;
+
+		/** @brief Total memory limit across all shards (0 = unlimited) */
+		std::size_t m_memoryLimit;
+	};
+} // namespace nfx::cache
+
+#include "nfx/detail/cache/ShardedLruCache.inl"
@@ -0,0 +1,265 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file SlabAllocator.h
+ * @brief Fixed-size block pool and allocator for recycling container nodes
+ * @details Used by LruCache to keep hash map nodes in preallocated slabs, so that
+ *          evicting an entry and inserting a new one reuses the same memory block
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// SlabPool class
+	//=====================================================================
+
+	/**
+	 * @brief Pool of equally sized memory blocks carved from large slabs
+	 * @details The block shape (size and alignment) is fixed by the first accepted allocation;
+	 *          requests of any other shape are refused so callers can fall back to the heap.
+	 *          Freed blocks go to an intrusive free list and are handed out again before the
+	 *          pool grows. The pool is not thread-safe; LruCache only uses it under its lock.
+	 */
+	class SlabPool final
+	{
+	public:
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct an empty pool
+		 * @param initialCapacity Number of blocks in the first slab (0 = grow on demand)
+		 * @param minBlockSize Smallest request size accepted as the pool's block shape
+		 */
+		inline explicit SlabPool( std::size_t initialCapacity, std::size_t minBlockSize = 1 ) noexcept;
+
+		//----------------------------------------------
+		// Copy and move operations
+		//----------------------------------------------
+
+		SlabPool( const SlabPool& ) = delete;
+		SlabPool( SlabPool&& ) = delete;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		SlabPool& operator=( const SlabPool& ) = delete;
+		SlabPool& operator=( SlabPool&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		/** @brief Release every slab (all blocks must have been returned) */
+		inline ~SlabPool();
+
+		//----------------------------------------------
+		// Block management
+		//----------------------------------------------
+
+		/**
+		 * @brief Allocate one block
+		 * @param bytes Requested size
+		 * @param alignment Requested alignment
+		 * @return Pointer to a block, or nullptr if the request does not match the pool's block shape
+		 */
+		[[nodiscard]] inline void* allocate( std::size_t bytes, std::size_t alignment );
+
+		/**
+		 * @brief Return a block to the pool
+		 * @param ptr Block previously returned by allocate()
+		 * @param bytes Size passed to allocate()
+		 * @param alignment Alignment passed to allocate()
+		 * @return True if the block belongs to the pool, false if the caller must free it itself
+		 */
+		inline bool deallocate( void* ptr, std::size_t bytes, std::size_t alignment ) noexcept;
+
+		//----------------------------------------------
+		// State inspection
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the total number of blocks carved from slabs so far
+		 * @return Number of blocks (in use and free)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t capacity() const noexcept;
+
+		/**
+		 * @brief Get the number of blocks currently handed out
+		 * @return Number of blocks in use
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t inUse() const noexcept;
+
+	private:
+		//----------------------------------------------
+		// Internal data structures
+		//----------------------------------------------
+
+		/** @brief Free block header, stored in the block itself */
+		struct FreeBlock
+		{
+			/** @brief Next free block */
+			FreeBlock* next;
+		};
+
+		/**
+		 * @brief Check if a request matches the pool's block shape
+		 * @param bytes Requested size
+		 * @param alignment Requested alignment
+		 * @return True if the pool serves this request
+		 */
+		[[nodiscard]] inline bool accepts( std::size_t bytes, std::size_t alignment ) const noexcept;
+
+		/**
+		 * @brief Allocate a new slab and push its blocks onto the free list
+		 * @param blocks Number of blocks in the new slab
+		 */
+		inline void grow( std::size_t blocks );
+
+		/** @brief Slabs owned by the pool */
+		std::vector<std::byte*> m_slabs;
+
+		/** @brief Head of the free block list */
+		FreeBlock* m_freeList;
+
+		/** @brief Blocks in the first slab */
+		std::size_t m_initialCapacity;
+
+		/** @brief Smallest request size accepted as the block shape */
+		std::size_t m_minBlockSize;
+
+		/** @brief Requested size served by the pool (0 until the first accepted allocation) */
+		std::size_t m_blockSize;
+
+		/** @brief Alignment served by the pool */
+		std::size_t m_blockAlignment;
+
+		/** @brief Distance between consecutive blocks in a slab */
+		std::size_t m_blockStride;
+
+		/** @brief Total number of blocks carved from slabs */
+		std::size_t m_capacity;
+
+		/** @brief Number of blocks handed out */
+		std::size_t m_inUse;
+	};
+
+	//=====================================================================
+	// SlabAllocator class
+	//=====================================================================
+
+	/**
+	 * @brief Standard allocator serving single-object allocations from a SlabPool
+	 * @tparam T Value type
+	 * @details Single-object requests matching the pool's block shape (container nodes) come from
+	 *          the pool; everything else (bucket arrays, other node types) and every request made
+	 *          without a pool goes to the heap through std::allocator.
+	 */
+	template <typename T>
+	class SlabAllocator
+	{
+	public:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		/** @brief Allocated value type */
+		using value_type = T;
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct allocator bound to a pool
+		 * @param pool Pool to allocate nodes from (nullptr = heap only)
+		 */
+		inline SlabAllocator( SlabPool* pool = nullptr ) noexcept;
+
+		/**
+		 * @brief Rebinding constructor sharing the other allocator's pool
+		 * @param other Allocator for another value type
+		 */
+		template <typename U>
+		inline SlabAllocator( const SlabAllocator<U>& other ) noexcept;
+
+		//----------------------------------------------
+		// Allocation
+		//----------------------------------------------
+
+		/**
+		 * @brief Allocate storage for n objects
+		 * @param n Number of objects
+		 * @return Pointer to uninitialized storage
+		 */
+		[[nodiscard]] inline T* allocate( std::size_t n );
+
+		/**
+		 * @brief Release storage obtained from allocate()
+		 * @param ptr Storage to release
+		 * @param n Number of objects passed to allocate()
+		 */
+		inline void deallocate( T* ptr, std::size_t n ) noexcept;
+
+		//----------------------------------------------
+		// Accessors
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the pool backing this allocator
+		 * @return Pool pointer (nullptr = heap only)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline SlabPool* pool() const noexcept;
+
+		//----------------------------------------------
+		// Comparison
+		//----------------------------------------------
+
+		/**
+		 * @brief Allocators are equal when they share the same pool
+		 * @param other Allocator to compare with
+		 * @return True if memory from one can be released by the other
+		 */
+		template <typename U>
+		[[nodiscard]] inline bool operator==( const SlabAllocator<U>& other ) const noexcept;
+
+	private:
+		/** @brief Pool serving node allocations (nullptr = heap only) */
+		SlabPool* m_pool;
+	};
+} // namespace nfx::cache
+
+#include "nfx/detail/cache/SlabAllocator.inl"
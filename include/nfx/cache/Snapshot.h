@@ -0,0 +1,182 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file Snapshot.h
+ * @brief Binary snapshot format and key/value serializers for cache warm restarts
+ * @details A snapshot starts with a fixed header (magic, format version, record count) followed by
+ *          one record per entry, least recently used first. Each record holds the remaining and
+ *          sliding expiration, the entry size and the serialized key and value, prefixed by their
+ *          byte counts so a reader can skip a record without decoding it. Integers are stored in
+ *          native byte order: snapshots are meant to be reloaded on the machine that wrote them.
+ */
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// SnapshotSerializer struct
+	//=====================================================================
+
+	/**
+	 * @brief Conversion of a key or value type to and from snapshot bytes
+	 * @tparam T Type to convert
+	 * @details Provided for trivially copyable types (object representation) and std::string.
+	 *          Specialize it for other types, or pass any type with the same two static
+	 *          functions to saveSnapshot() and loadSnapshot().
+	 */
+	template <typename T>
+	struct SnapshotSerializer;
+
+	/** @brief Serializer for trivially copyable types, writing the object representation */
+	template <typename T>
+		requires std::is_trivially_copyable_v<T>
+	struct SnapshotSerializer<T>
+	{
+		/**
+		 * @brief Append the bytes of a value
+		 * @param out Buffer to append to
+		 * @param value Value to write
+		 */
+		static inline void write( std::vector<std::byte>& out, const T& value );
+
+		/**
+		 * @brief Rebuild a value from its bytes
+		 * @param bytes Bytes written by write()
+		 * @return Decoded value
+		 * @throws std::runtime_error if bytes does not hold exactly sizeof(T) bytes
+		 */
+		[[nodiscard]] static inline T read( std::span<const std::byte> bytes );
+	};
+
+	/** @brief Serializer for std::string, writing the characters without terminator */
+	template <>
+	struct SnapshotSerializer<std::string>
+	{
+		/**
+		 * @brief Append the characters of a string
+		 * @param out Buffer to append to
+		 * @param value String to write
+		 */
+		static inline void write( std::vector<std::byte>& out, const std::string& value );
+
+		/**
+		 * @brief Rebuild a string from its characters
+		 * @param bytes Bytes written by write()
+		 * @return Decoded string
+		 */
+		[[nodiscard]] static inline std::string read( std::span<const std::byte> bytes );
+	};
+
+	/**
+	 * @brief Serializer usable for type T in a snapshot
+	 * @details Static write( std::vector<std::byte>&, const T& ) appending the encoding, and static
+	 *          read( std::span<const std::byte> ) decoding it. read() may run concurrently on
+	 *          several threads when a snapshot is loaded in parallel.
+	 */
+	template <typename Serializer, typename T>
+	concept SnapshotCodec = requires( std::vector<std::byte>& out, const T& value, std::span<const std::byte> bytes ) {
+		Serializer::write( out, value );
+		{ Serializer::read( bytes ) } -> std::convertible_to<T>;
+	};
+
+	//=====================================================================
+	// Snapshot format
+	//=====================================================================
+
+	/** @brief File header of a snapshot */
+	struct SnapshotHeader final
+	{
+		/** @brief Identifies the file as a cache snapshot */
+		static constexpr std::array<char, 8> MAGIC{ 'N', 'F', 'X', 'L', 'R', 'U', 'C', 'S' };
+
+		/** @brief Current format version */
+		static constexpr std::uint32_t VERSION = 2;
+
+		/** @brief Number of records following the header */
+		std::uint64_t count{ 0 };
+
+		/**
+		 * @brief Write the header
+		 * @param out Stream to write to
+		 */
+		inline void write( std::ostream& out ) const;
+
+		/**
+		 * @brief Read and validate a header
+		 * @param in Stream to read from
+		 * @return Header read
+		 * @throws std::runtime_error if the stream does not start with a snapshot header of this version
+		 */
+		[[nodiscard]] static inline SnapshotHeader read( std::istream& in );
+	};
+
+	/** @brief Fixed-size prefix of a snapshot record, followed by keyBytes then valueBytes bytes */
+	struct SnapshotRecord final
+	{
+		/** @brief Time left before the entry expires when the snapshot was written, in nanoseconds */
+		std::int64_t remaining;
+
+		/** @brief Sliding expiration of the entry, in milliseconds */
+		std::int64_t slidingExpiration;
+
+		/** @brief Time since the entry's value was stored when the snapshot was written, in nanoseconds */
+		std::int64_t age;
+
+		/** @brief Absolute expiration of the entry, in milliseconds */
+		std::int64_t absoluteExpiration;
+
+		/** @brief Size of the entry for memory accounting */
+		std::uint64_t size;
+
+		/** @brief Length of the serialized key */
+		std::uint32_t keyBytes;
+
+		/** @brief Length of the serialized value */
+		std::uint32_t valueBytes;
+
+		/** @brief ExpirationMode of the entry */
+		std::uint8_t expirationMode;
+
+		/** @brief Padding, written as zeros */
+		std::array<std::uint8_t, 7> reserved;
+	};
+
+	static_assert( sizeof( SnapshotRecord ) == 56 && std::is_trivially_copyable_v<SnapshotRecord>, "SnapshotRecord is written as raw bytes" );
+} // namespace nfx::cache
+
+#include "nfx/detail/cache/Snapshot.inl"
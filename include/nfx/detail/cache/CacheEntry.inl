@@ -0,0 +1,123 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file CacheEntry.inl
+ * @brief Implementation of CacheEntry methods
+ */
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// CacheEntry
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline CacheEntry::CacheEntry( std::chrono::milliseconds expiration )
+		: lastAccessed{ std::chrono::steady_clock::now() },
+		  writeTime{ lastAccessed },
+		  slidingExpiration{ expiration }
+	{
+	}
+
+	//----------------------------------------------
+	// Expiration checking
+	//----------------------------------------------
+
+	inline bool CacheEntry::isExpired() const noexcept
+	{
+		return isExpired( std::chrono::steady_clock::now() );
+	}
+
+	inline bool CacheEntry::isExpired( std::chrono::steady_clock::time_point now ) const noexcept
+	{
+		switch ( expirationMode )
+		{
+			case ExpirationMode::Absolute:
+			{
+				return ( now - writeTime ) > absoluteExpiration;
+			}
+			case ExpirationMode::SlidingAndAbsolute:
+			{
+				return ( now - lastAccessed ) > slidingExpiration || ( now - writeTime ) > absoluteExpiration;
+			}
+			default:
+			{
+				return ( now - lastAccessed ) > slidingExpiration;
+			}
+		}
+	}
+
+	//----------------------------------------------
+	// Access management
+	//----------------------------------------------
+
+	void inline CacheEntry::touch() noexcept
+	{
+		touch( std::chrono::steady_clock::now() );
+	}
+
+	void inline CacheEntry::touch( std::chrono::steady_clock::time_point now ) noexcept
+	{
+		// Read-only hits: the absolute deadline does not depend on accesses
+		if ( expirationMode != ExpirationMode::Absolute )
+		{
+			lastAccessed = now;
+		}
+	}
+
+	void inline CacheEntry::resetTimestamps( std::chrono::steady_clock::time_point now ) noexcept
+	{
+		lastAccessed = now;
+		writeTime = now;
+	}
+
+	//=====================================================================
+	// Entry callables
+	//=====================================================================
+
+	template <EntryConfigurator Configure>
+	inline void configureEntry( Configure& configure, CacheEntry& entry )
+	{
+		if constexpr ( std::same_as<std::remove_cvref_t<Configure>, std::nullptr_t> )
+		{
+			return;
+		}
+		else if constexpr ( std::is_constructible_v<bool, Configure&> )
+		{
+			// std::function and function pointers may be empty
+			if ( static_cast<bool>( configure ) )
+			{
+				configure( entry );
+			}
+		}
+		else
+		{
+			configure( entry );
+		}
+	}
+} // namespace nfx::cache
@@ -0,0 +1,174 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file CacheStats.inl
+ * @brief Implementation of cache statistics collectors
+ */
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <thread>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// CacheStats
+	//=====================================================================
+
+	//----------------------------------------------
+	// Derived values
+	//----------------------------------------------
+
+	inline double CacheStats::hitRatio() const noexcept
+	{
+		const std::uint64_t lookups{ hits + misses };
+
+		return lookups == 0 ? 0.0 : static_cast<double>( hits ) / static_cast<double>( lookups );
+	}
+
+	inline std::chrono::nanoseconds CacheStats::averageLoadTime() const noexcept
+	{
+		return loads == 0 ? std::chrono::nanoseconds{ 0 } : totalLoadTime / static_cast<std::int64_t>( loads );
+	}
+
+	//----------------------------------------------
+	// Aggregation
+	//----------------------------------------------
+
+	inline CacheStats& CacheStats::operator+=( const CacheStats& other ) noexcept
+	{
+		hits += other.hits;
+		misses += other.misses;
+		inserts += other.inserts;
+		evictions += other.evictions;
+		expirations += other.expirations;
+		loads += other.loads;
+		loadFailures += other.loadFailures;
+		totalLoadTime += other.totalLoadTime;
+
+		return *this;
+	}
+
+	//=====================================================================
+	// StripedStats
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline StripedStats::StripedStats()
+	{
+		const std::size_t stripes{ std::min( std::bit_ceil( std::max<std::size_t>( std::thread::hardware_concurrency(), 1 ) ), MAX_STRIPES ) };
+
+		m_stripes = std::make_unique<Stripe[]>( stripes );
+		m_mask = stripes - 1;
+	}
+
+	//----------------------------------------------
+	// Recording
+	//----------------------------------------------
+
+	inline void StripedStats::recordHits( std::uint64_t count ) noexcept
+	{
+		local().hits.fetch_add( count, std::memory_order_relaxed );
+	}
+
+	inline void StripedStats::recordMisses( std::uint64_t count ) noexcept
+	{
+		local().misses.fetch_add( count, std::memory_order_relaxed );
+	}
+
+	inline void StripedStats::recordInserts( std::uint64_t count ) noexcept
+	{
+		local().inserts.fetch_add( count, std::memory_order_relaxed );
+	}
+
+	inline void StripedStats::recordEvictions( std::uint64_t count ) noexcept
+	{
+		local().evictions.fetch_add( count, std::memory_order_relaxed );
+	}
+
+	inline void StripedStats::recordExpirations( std::uint64_t count ) noexcept
+	{
+		local().expirations.fetch_add( count, std::memory_order_relaxed );
+	}
+
+	inline std::chrono::steady_clock::time_point StripedStats::loadStart() const noexcept
+	{
+		return std::chrono::steady_clock::now();
+	}
+
+	inline void StripedStats::recordLoad( std::chrono::steady_clock::time_point start, bool failed ) noexcept
+	{
+		Stripe& stripe{ local() };
+		const auto elapsed{ std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start ) };
+
+		stripe.loads.fetch_add( 1, std::memory_order_relaxed );
+		stripe.loadNanos.fetch_add( elapsed.count(), std::memory_order_relaxed );
+		if ( failed )
+		{
+			stripe.loadFailures.fetch_add( 1, std::memory_order_relaxed );
+		}
+	}
+
+	//----------------------------------------------
+	// Snapshot
+	//----------------------------------------------
+
+	inline CacheStats StripedStats::snapshot() const noexcept
+	{
+		CacheStats stats;
+
+		for ( std::size_t i{ 0 }; i <= m_mask; ++i )
+		{
+			const Stripe& stripe{ m_stripes[i] };
+
+			stats.hits += stripe.hits.load( std::memory_order_relaxed );
+			stats.misses += stripe.misses.load( std::memory_order_relaxed );
+			stats.inserts += stripe.inserts.load( std::memory_order_relaxed );
+			stats.evictions += stripe.evictions.load( std::memory_order_relaxed );
+			stats.expirations += stripe.expirations.load( std::memory_order_relaxed );
+			stats.loads += stripe.loads.load( std::memory_order_relaxed );
+			stats.loadFailures += stripe.loadFailures.load( std::memory_order_relaxed );
+			stats.totalLoadTime += std::chrono::nanoseconds{ stripe.loadNanos.load( std::memory_order_relaxed ) };
+		}
+
+		return stats;
+	}
+
+	//----------------------------------------------
+	// Stripes
+	//----------------------------------------------
+
+	inline StripedStats::Stripe& StripedStats::local() noexcept
+	{
+		thread_local const std::size_t threadHash{ std::hash<std::thread::id>{}( std::this_thread::get_id() ) };
+
+		return m_stripes[static_cast<std::size_t>( ( static_cast<std::uint64_t>( threadHash ) * 0x9E3779B97F4A7C15ull ) >> 32 ) & m_mask];
+	}
+} // namespace nfx::cache
@@ -0,0 +1,133 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file Clock.inl
+ * @brief Implementation of cache time sources
+ */
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// SteadyClock
+	//=====================================================================
+
+	//----------------------------------------------
+	// Time access
+	//----------------------------------------------
+
+	inline SteadyClock::time_point SteadyClock::now() noexcept
+	{
+		return std::chrono::steady_clock::now();
+	}
+
+	//=====================================================================
+	// CoarseClock
+	//=====================================================================
+
+	//----------------------------------------------
+	// Time access
+	//----------------------------------------------
+
+	template <std::size_t ResolutionMs>
+	inline typename CoarseClock<ResolutionMs>::time_point CoarseClock<ResolutionMs>::now() noexcept
+	{
+		return time_point{ std::chrono::steady_clock::duration{ ticker().m_time.load( std::memory_order_relaxed ) } };
+	}
+
+	template <std::size_t ResolutionMs>
+	constexpr std::chrono::milliseconds CoarseClock<ResolutionMs>::resolution() noexcept
+	{
+		return std::chrono::milliseconds{ ResolutionMs };
+	}
+
+	//----------------------------------------------
+	// Private helper methods
+	//----------------------------------------------
+
+	template <std::size_t ResolutionMs>
+	inline typename CoarseClock<ResolutionMs>::Ticker& CoarseClock<ResolutionMs>::ticker()
+	{
+		static Ticker instance;
+
+		return instance;
+	}
+
+	//----------------------------------------------
+	// Ticker
+	//----------------------------------------------
+
+	template <std::size_t ResolutionMs>
+	inline CoarseClock<ResolutionMs>::Ticker::Ticker()
+		: m_time{ std::chrono::steady_clock::now().time_since_epoch().count() },
+		  m_stop{ false }
+	{
+		m_thread = std::thread{ [this]() {
+			std::unique_lock<std::mutex> lock{ m_mutex };
+			while ( !m_stopSignal.wait_for( lock, resolution(), [this]() { return m_stop; } ) )
+			{
+				m_time.store( std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed );
+			}
+		} };
+	}
+
+	template <std::size_t ResolutionMs>
+	inline CoarseClock<ResolutionMs>::Ticker::~Ticker()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			m_stop = true;
+		}
+
+		m_stopSignal.notify_one();
+		m_thread.join();
+	}
+
+	//=====================================================================
+	// ManualClock
+	//=====================================================================
+
+	//----------------------------------------------
+	// Time access
+	//----------------------------------------------
+
+	inline ManualClock::time_point ManualClock::now() noexcept
+	{
+		return time_point{ std::chrono::steady_clock::duration{ s_time.load( std::memory_order_relaxed ) } };
+	}
+
+	//----------------------------------------------
+	// Time control
+	//----------------------------------------------
+
+	inline void ManualClock::advance( std::chrono::steady_clock::duration duration ) noexcept
+	{
+		s_time.fetch_add( duration.count(), std::memory_order_relaxed );
+	}
+
+	inline void ManualClock::set( time_point time ) noexcept
+	{
+		s_time.store( time.time_since_epoch().count(), std::memory_order_relaxed );
+	}
+} // namespace nfx::cache
@@ -0,0 +1,754 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file CompactLruCache.inl
+ * @brief Implementation of CompactLruCache template methods
+ * @details Chunked slot storage, linear-probing key index with backward-shift deletion,
+ *          per-class recency lists and epoch rebasing of 32-bit timestamps
+ */
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <optional>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// CompactLruCache
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::CompactLruCache( const LruCacheOptions& options )
+		: m_options{ options },
+		  m_chunkBits{ MAX_CHUNK_BITS },
+		  m_slotCount{ 0 },
+		  m_freeSlot{ CompactEntry::NIL },
+		  m_bucketShift{ 0 },
+		  m_growthLeft{ 0 },
+		  m_size{ 0 },
+		  m_epoch{ Clock::now() },
+		  m_lastCleanupTime{ m_epoch }
+	{
+		// Small caches get small chunks so they do not pay for thousands of unused slots
+		if ( m_options.sizeLimit() > 0 )
+		{
+			m_chunkBits = std::min( MAX_CHUNK_BITS, static_cast<unsigned>( std::bit_width( m_options.sizeLimit() - 1 ) ) );
+		}
+
+		reserveBuckets( m_options.sizeLimit() );
+		[[maybe_unused]] const std::uint8_t defaultClass{ classFor( m_options.slidingExpiration() ) };
+	}
+
+	//----------------------------------------------
+	// Destruction
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::~CompactLruCache()
+	{
+		destroyAll();
+	}
+
+	//----------------------------------------------
+	// Cache operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	template <EntryFactory<TValue> Factory, EntryConfigurator Configure>
+	inline TValue* CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::get( const TKey& key, Factory&& factory, Configure&& configure )
+	{
+		auto now{ Clock::now() };
+		const std::uint32_t hash{ hashOf( key ) };
+
+		std::unique_lock<std::mutex> lock{ m_mutex };
+
+		// Check for background cleanup opportunity
+		checkAndPerformBackgroundCleanup( now );
+
+		while ( true )
+		{
+			const std::uint32_t nowTicks{ ticksAt( now ) };
+			const std::size_t bucket{ findBucket( key, hash ) };
+			if ( bucket != m_buckets.size() )
+			{
+				const std::uint32_t index{ m_buckets[bucket].slot };
+				if ( !isExpired( index, nowTicks ) )
+				{
+					touch( index, nowTicks );
+
+					return &slotAt( index ).value;
+				}
+
+				eraseAt( bucket ); // Clean expired
+			}
+
+			PendingLoad* pending{ findPendingLoad( key ) };
+			if ( pending == nullptr )
+			{
+				break;
+			}
+
+			// Another thread is already loading this key: wait for it instead of running a duplicate factory
+			++pending->waiterCount;
+			m_loadSignal.wait( lock, [pending]() { return pending->completed; } );
+
+			std::exception_ptr error{ pending->error };
+			if ( --pending->waiterCount == 0 )
+			{
+				m_loadSignal.notify_all(); // Let the loader return and release its state
+			}
+
+			now = Clock::now(); // The wait may have been long
+
+			if ( error )
+			{
+				std::rethrow_exception( error );
+			}
+		}
+
+		PendingLoad pending{ &key };
+		m_pendingLoads.push_back( &pending );
+
+		// Run user code without holding the lock so other keys stay accessible
+		lock.unlock();
+
+		std::optional<TValue> value;
+		CacheEntry metadata{ m_options.slidingExpiration() };
+
+		try
+		{
+			value.emplace( factory() );
+
+			configureEntry( configure, metadata );
+		}
+		catch ( ... )
+		{
+			lock.lock();
+			completePendingLoad( lock, pending, std::current_exception() );
+
+			throw;
+		}
+
+		lock.lock();
+
+		TValue* result{ nullptr };
+		try
+		{
+			evictUntilFits();
+
+			// Stamp with the insertion time so class lists stay ordered by last access
+			const std::uint32_t index{ insert( key, hash, std::move( *value ), classFor( metadata.slidingExpiration ), ticksAt( Clock::now() ) ) };
+			result = &slotAt( index ).value;
+		}
+		catch ( ... )
+		{
+			completePendingLoad( lock, pending, std::current_exception() );
+
+			throw;
+		}
+
+		completePendingLoad( lock, pending, nullptr );
+
+		return result;
+	}
+
+	//----------------------------------------------
+	// Lookup operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline TValue* CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::find( const TKey& key )
+	{
+		const auto now{ Clock::now() };
+		const std::uint32_t hash{ hashOf( key ) };
+
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		// Check for background cleanup opportunity
+		checkAndPerformBackgroundCleanup( now );
+
+		const std::size_t bucket{ findBucket( key, hash ) };
+		if ( bucket == m_buckets.size() )
+		{
+			return nullptr;
+		}
+
+		const std::uint32_t nowTicks{ ticksAt( now ) };
+		const std::uint32_t index{ m_buckets[bucket].slot };
+		if ( isExpired( index, nowTicks ) )
+		{
+			eraseAt( bucket );
+
+			return nullptr;
+		}
+
+		touch( index, nowTicks );
+
+		return &slotAt( index ).value;
+	}
+
+	//----------------------------------------------
+	// Modification operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline bool CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::remove( const TKey& key )
+	{
+		const std::uint32_t hash{ hashOf( key ) };
+
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		const std::size_t bucket{ findBucket( key, hash ) };
+		if ( bucket == m_buckets.size() )
+		{
+			return false;
+		}
+
+		eraseAt( bucket );
+
+		return true;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::clear()
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		destroyAll();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline std::size_t CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::size() const
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		return m_size;
+	}
+
+	//----------------------------------------------
+	// State inspection
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline bool CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::isEmpty() const
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		return m_size == 0;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline std::size_t CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::expirationClassCount() const
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		return m_classes.size();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::cleanupExpired()
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		expire( ticksAt( Clock::now() ), std::numeric_limits<std::size_t>::max() );
+	}
+
+	//----------------------------------------------
+	// Slot storage
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline typename CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::Slot& CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::slotAt( std::uint32_t index ) const noexcept
+	{
+		return m_chunks[index >> m_chunkBits][index & ( ( std::uint32_t{ 1 } << m_chunkBits ) - 1 )];
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline std::uint32_t CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::acquireSlot()
+	{
+		if ( m_freeSlot != CompactEntry::NIL )
+		{
+			const std::uint32_t index{ m_freeSlot };
+			m_freeSlot = slotAt( index ).metadata.next;
+
+			return index;
+		}
+
+		if ( ( m_slotCount >> m_chunkBits ) == m_chunks.size() )
+		{
+			m_chunks.push_back( std::make_unique<Slot[]>( std::size_t{ 1 } << m_chunkBits ) );
+		}
+
+		return m_slotCount++;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::releaseSlot( std::uint32_t index ) noexcept
+	{
+		Slot& slot{ slotAt( index ) };
+		std::destroy_at( &slot.value );
+		std::destroy_at( &slot.key );
+
+		slot.metadata.next = m_freeSlot;
+		m_freeSlot = index;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::destroyAll() noexcept
+	{
+		// Every live entry is linked in exactly one class list
+		for ( ExpirationClass& expirationClass : m_classes )
+		{
+			for ( std::uint32_t index{ expirationClass.head }; index != CompactEntry::NIL; )
+			{
+				Slot& slot{ slotAt( index ) };
+				index = slot.metadata.next;
+
+				std::destroy_at( &slot.value );
+				std::destroy_at( &slot.key );
+			}
+
+			expirationClass.head = CompactEntry::NIL;
+			expirationClass.tail = CompactEntry::NIL;
+		}
+
+		std::fill( m_buckets.begin(), m_buckets.end(), Bucket{ CompactEntry::NIL, 0 } );
+		m_growthLeft = m_buckets.size() / 4 * 3;
+		m_slotCount = 0;
+		m_freeSlot = CompactEntry::NIL;
+		m_size = 0;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline std::uint32_t CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::insert( const TKey& key, std::uint32_t hash, TValue&& value, std::uint8_t expirationClass, std::uint32_t nowTicks )
+	{
+		if ( m_growthLeft == 0 )
+		{
+			reserveBuckets( m_buckets.size() );
+		}
+
+		const std::uint32_t index{ acquireSlot() };
+		Slot& slot{ slotAt( index ) };
+
+		try
+		{
+			std::construct_at( &slot.key, key );
+		}
+		catch ( ... )
+		{
+			slot.metadata.next = m_freeSlot;
+			m_freeSlot = index;
+
+			throw;
+		}
+
+		try
+		{
+			std::construct_at( &slot.value, std::move( value ) );
+		}
+		catch ( ... )
+		{
+			std::destroy_at( &slot.key );
+			slot.metadata.next = m_freeSlot;
+			m_freeSlot = index;
+
+			throw;
+		}
+
+		slot.metadata.lastAccessed = nowTicks;
+		slot.metadata.expirationClass = expirationClass;
+		linkFront( index );
+		insertBucket( index, hash );
+		++m_size;
+
+		return index;
+	}
+
+	//----------------------------------------------
+	// Key index
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline std::uint32_t CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::hashOf( const TKey& key ) const
+	{
+		// Fibonacci mixing spreads identity hashes such as std::hash<int> over the top bits
+		return static_cast<std::uint32_t>( ( static_cast<std::uint64_t>( m_hasher( key ) ) * 0x9E3779B97F4A7C15ull ) >> 32 );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline std::size_t CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::findBucket( const TKey& key, std::uint32_t hash ) const
+	{
+		const std::size_t mask{ m_buckets.size() - 1 };
+
+		// The load factor cap guarantees an empty bucket ends every probe run
+		for ( std::size_t bucket{ hash >> m_bucketShift };; bucket = ( bucket + 1 ) & mask )
+		{
+			const Bucket& candidate{ m_buckets[bucket] };
+			if ( candidate.slot == CompactEntry::NIL )
+			{
+				return m_buckets.size();
+			}
+
+			if ( candidate.hash == hash && m_keyEqual( slotAt( candidate.slot ).key, key ) )
+			{
+				return bucket;
+			}
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::insertBucket( std::uint32_t slot, std::uint32_t hash ) noexcept
+	{
+		const std::size_t mask{ m_buckets.size() - 1 };
+
+		std::size_t bucket{ hash >> m_bucketShift };
+		while ( m_buckets[bucket].slot != CompactEntry::NIL )
+		{
+			bucket = ( bucket + 1 ) & mask;
+		}
+
+		m_buckets[bucket] = Bucket{ slot, hash };
+		--m_growthLeft;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::eraseBucket( std::size_t bucket ) noexcept
+	{
+		const std::size_t mask{ m_buckets.size() - 1 };
+
+		// Backward-shift deletion: no tombstones, so probe runs never lengthen over time
+		std::size_t hole{ bucket };
+		for ( std::size_t next{ ( bucket + 1 ) & mask }; m_buckets[next].slot != CompactEntry::NIL; next = ( next + 1 ) & mask )
+		{
+			// An entry may fill the hole only if the hole lies between its home bucket and its position
+			const std::size_t home{ m_buckets[next].hash >> m_bucketShift };
+			if ( ( ( next - home ) & mask ) >= ( ( next - hole ) & mask ) )
+			{
+				m_buckets[hole] = m_buckets[next];
+				hole = next;
+			}
+		}
+
+		m_buckets[hole].slot = CompactEntry::NIL;
+		++m_growthLeft;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::reserveBuckets( std::size_t count )
+	{
+		const std::size_t capacity{ std::bit_ceil( std::max( MIN_BUCKETS, count / 3 * 4 + 4 ) ) };
+		if ( capacity <= m_buckets.size() )
+		{
+			return;
+		}
+
+		std::vector<Bucket> buckets( capacity, Bucket{ CompactEntry::NIL, 0 } );
+		buckets.swap( m_buckets );
+		m_bucketShift = 32 - static_cast<unsigned>( std::countr_zero( capacity ) );
+		m_growthLeft = capacity / 4 * 3 - m_size;
+
+		// Stored hashes are enough to rehash: no key is touched
+		const std::size_t mask{ capacity - 1 };
+		for ( const Bucket& bucket : buckets )
+		{
+			if ( bucket.slot != CompactEntry::NIL )
+			{
+				std::size_t target{ bucket.hash >> m_bucketShift };
+				while ( m_buckets[target].slot != CompactEntry::NIL )
+				{
+					target = ( target + 1 ) & mask;
+				}
+
+				m_buckets[target] = bucket;
+			}
+		}
+	}
+
+	//----------------------------------------------
+	// Recency and expiration
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline std::uint32_t CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::ticksAt( std::chrono::steady_clock::time_point now ) noexcept
+	{
+		if ( now <= m_epoch )
+		{
+			return 0;
+		}
+
+		std::int64_t elapsed{ std::chrono::duration_cast<std::chrono::milliseconds>( now - m_epoch ).count() };
+		if ( elapsed >= REBASE_THRESHOLD )
+		{
+			// Move the epoch so that now sits just past the longest expiration: timestamps falling
+			// before the new epoch belong to entries expired in every class and are clamped to 0
+			const std::int64_t shift{ elapsed - ( MAX_EXPIRATION.count() + 1 ) };
+			m_epoch += std::chrono::milliseconds{ shift };
+			elapsed -= shift;
+
+			for ( const ExpirationClass& expirationClass : m_classes )
+			{
+				for ( std::uint32_t index{ expirationClass.head }; index != CompactEntry::NIL; )
+				{
+					CompactEntry& metadata{ slotAt( index ).metadata };
+					metadata.lastAccessed = metadata.lastAccessed > shift ? static_cast<std::uint32_t>( metadata.lastAccessed - shift ) : 0;
+					index = metadata.next;
+				}
+			}
+		}
+
+		return static_cast<std::uint32_t>( elapsed );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline std::uint8_t CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::classFor( std::chrono::milliseconds expiration )
+	{
+		const auto duration{ static_cast<std::uint32_t>( std::clamp( expiration, std::chrono::milliseconds{ 0 }, MAX_EXPIRATION ).count() ) };
+
+		for ( std::size_t i{ 0 }; i < m_classes.size(); ++i )
+		{
+			if ( m_classes[i].duration == duration )
+			{
+				return static_cast<std::uint8_t>( i );
+			}
+		}
+
+		if ( m_classes.size() < MAX_EXPIRATION_CLASSES )
+		{
+			m_classes.push_back( ExpirationClass{ duration } );
+
+			return static_cast<std::uint8_t>( m_classes.size() - 1 );
+		}
+
+		// Table full: use the longest class that expires no later than requested, else the shortest class
+		std::size_t best{ 0 };
+		for ( std::size_t i{ 1 }; i < m_classes.size(); ++i )
+		{
+			const std::uint32_t candidate{ m_classes[i].duration };
+			const std::uint32_t current{ m_classes[best].duration };
+			const bool candidateFits{ candidate <= duration };
+
+			if ( candidateFits != ( current <= duration ) ? candidateFits : ( candidateFits ? candidate > current : candidate < current ) )
+			{
+				best = i;
+			}
+		}
+
+		return static_cast<std::uint8_t>( best );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline bool CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::isExpired( std::uint32_t index, std::uint32_t nowTicks ) const noexcept
+	{
+		const CompactEntry& metadata{ slotAt( index ).metadata };
+
+		// Operations read the clock before taking the lock, so a timestamp may be slightly ahead of now
+		return nowTicks > metadata.lastAccessed && nowTicks - metadata.lastAccessed > m_classes[metadata.expirationClass].duration;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::linkFront( std::uint32_t index ) noexcept
+	{
+		CompactEntry& metadata{ slotAt( index ).metadata };
+		ExpirationClass& expirationClass{ m_classes[metadata.expirationClass] };
+
+		metadata.prev = CompactEntry::NIL;
+		metadata.next = expirationClass.head;
+
+		if ( expirationClass.head != CompactEntry::NIL )
+		{
+			slotAt( expirationClass.head ).metadata.prev = index;
+		}
+		else
+		{
+			expirationClass.tail = index;
+		}
+
+		expirationClass.head = index;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::unlink( std::uint32_t index ) noexcept
+	{
+		CompactEntry& metadata{ slotAt( index ).metadata };
+		ExpirationClass& expirationClass{ m_classes[metadata.expirationClass] };
+
+		if ( metadata.prev != CompactEntry::NIL )
+		{
+			slotAt( metadata.prev ).metadata.next = metadata.next;
+		}
+		else
+		{
+			expirationClass.head = metadata.next;
+		}
+
+		if ( metadata.next != CompactEntry::NIL )
+		{
+			slotAt( metadata.next ).metadata.prev = metadata.prev;
+		}
+		else
+		{
+			expirationClass.tail = metadata.prev;
+		}
+
+		metadata.prev = CompactEntry::NIL;
+		metadata.next = CompactEntry::NIL;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::touch( std::uint32_t index, std::uint32_t nowTicks ) noexcept
+	{
+		CompactEntry& metadata{ slotAt( index ).metadata };
+		metadata.lastAccessed = std::max( metadata.lastAccessed, nowTicks );
+
+		if ( m_classes[metadata.expirationClass].head != index )
+		{
+			unlink( index );
+			linkFront( index );
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::eraseAt( std::size_t bucket ) noexcept
+	{
+		const std::uint32_t index{ m_buckets[bucket].slot };
+
+		eraseBucket( bucket );
+		unlink( index );
+		releaseSlot( index );
+		--m_size;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::eraseSlot( std::uint32_t index )
+	{
+		const TKey& key{ slotAt( index ).key };
+
+		eraseAt( findBucket( key, hashOf( key ) ) );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::evictUntilFits()
+	{
+		const std::size_t sizeLimit{ m_options.sizeLimit() };
+
+		while ( sizeLimit > 0 && m_size >= sizeLimit )
+		{
+			// Each class list is ordered by last access, so the cache-wide LRU entry is the oldest tail
+			std::uint32_t victim{ CompactEntry::NIL };
+			for ( const ExpirationClass& expirationClass : m_classes )
+			{
+				if ( expirationClass.tail != CompactEntry::NIL &&
+					 ( victim == CompactEntry::NIL || slotAt( expirationClass.tail ).metadata.lastAccessed < slotAt( victim ).metadata.lastAccessed ) )
+				{
+					victim = expirationClass.tail;
+				}
+			}
+
+			if ( victim == CompactEntry::NIL )
+			{
+				return;
+			}
+
+			eraseSlot( victim );
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::expire( std::uint32_t nowTicks, std::size_t budget )
+	{
+		std::size_t removed{ 0 };
+
+		// Expired entries of a class are always at its tail
+		for ( const ExpirationClass& expirationClass : m_classes )
+		{
+			while ( removed < budget && expirationClass.tail != CompactEntry::NIL && isExpired( expirationClass.tail, nowTicks ) )
+			{
+				eraseSlot( expirationClass.tail );
+				++removed;
+			}
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::checkAndPerformBackgroundCleanup( std::chrono::steady_clock::time_point now )
+	{
+		// Skip if background cleanup is disabled
+		if ( m_options.backgroundCleanupInterval().count() <= 0 )
+		{
+			return;
+		}
+
+		if ( now - m_lastCleanupTime >= m_options.backgroundCleanupInterval() )
+		{
+			m_lastCleanupTime = now;
+
+			// Perform incremental cleanup of expired entries
+			expire( ticksAt( now ), m_options.cleanupBudget() );
+		}
+	}
+
+	//----------------------------------------------
+	// Single-flight loading
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::PendingLoad::PendingLoad( const TKey* loadKey ) noexcept
+		: key{ loadKey }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline typename CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::PendingLoad* CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::findPendingLoad( const TKey& key ) const
+	{
+		for ( PendingLoad* pending : m_pendingLoads )
+		{
+			if ( m_keyEqual( *pending->key, key ) )
+			{
+				return pending;
+			}
+		}
+
+		return nullptr;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Clock>
+	inline void CompactLruCache<TKey, TValue, Hash, KeyEqual, Clock>::completePendingLoad( std::unique_lock<std::mutex>& lock, PendingLoad& pending, std::exception_ptr error )
+	{
+		pending.error = std::move( error );
+		pending.completed = true;
+		m_pendingLoads.erase( std::find( m_pendingLoads.begin(), m_pendingLoads.end(), &pending ) );
+
+		m_loadSignal.notify_all();
+
+		// The state lives on this thread's stack: keep it alive until every waiter has read it
+		m_loadSignal.wait( lock, [&pending]() { return pending.waiterCount == 0; } );
+	}
+} // namespace nfx::cache
@@ -0,0 +1,263 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file Compression.inl
+ * @brief Implementation of the built-in LZ codec
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// LzCodec
+	//=====================================================================
+
+	//----------------------------------------------
+	// Compression
+	//----------------------------------------------
+
+	inline void LzCodec::compress( std::span<const std::byte> input, std::vector<std::byte>& output )
+	{
+		// Uncompressed length, so decompress() can allocate once and validate the block
+		for ( std::size_t length{ input.size() }; ; length >>= 7 )
+		{
+			if ( length < 0x80 )
+			{
+				output.push_back( static_cast<std::byte>( length ) );
+				break;
+			}
+
+			output.push_back( static_cast<std::byte>( ( length & 0x7F ) | 0x80 ) );
+		}
+
+		output.reserve( output.size() + input.size() / 2 + 16 );
+
+		const std::byte* data{ input.data() };
+		const std::size_t size{ input.size() };
+
+		// Last position + 1 seen for each hash, so zero means empty
+		std::array<std::uint32_t, std::size_t{ 1 } << HASH_BITS> recent{};
+
+		std::size_t anchor{ 0 };
+		std::size_t position{ 0 };
+
+		auto emit = [&]( std::size_t matchOffset, std::size_t matchLength ) {
+			const std::size_t literals{ position - anchor };
+			const std::size_t matchCode{ matchLength > 0 ? matchLength - MIN_MATCH : 0 };
+
+			output.push_back( static_cast<std::byte>( ( std::min<std::size_t>( literals, 15 ) << 4 ) | std::min<std::size_t>( matchCode, 15 ) ) );
+			if ( literals >= 15 )
+			{
+				writeExtraLength( output, literals - 15 );
+			}
+
+			output.insert( output.end(), data + anchor, data + position );
+
+			if ( matchLength > 0 )
+			{
+				output.push_back( static_cast<std::byte>( matchOffset & 0xFF ) );
+				output.push_back( static_cast<std::byte>( matchOffset >> 8 ) );
+
+				if ( matchCode >= 15 )
+				{
+					writeExtraLength( output, matchCode - 15 );
+				}
+			}
+		};
+
+		while ( size >= MIN_MATCH && position <= size - MIN_MATCH )
+		{
+			const std::uint32_t hash{ hashAt( data + position ) };
+			const std::size_t candidate{ recent[hash] };
+			recent[hash] = static_cast<std::uint32_t>( position + 1 );
+
+			if ( candidate == 0 || position - ( candidate - 1 ) > MAX_OFFSET || std::memcmp( data + candidate - 1, data + position, MIN_MATCH ) != 0 )
+			{
+				++position;
+
+				continue;
+			}
+
+			const std::size_t matchStart{ candidate - 1 };
+			std::size_t length{ MIN_MATCH };
+			while ( position + length < size && data[matchStart + length] == data[position + length] )
+			{
+				++length;
+			}
+
+			emit( position - matchStart, length );
+			position += length;
+			anchor = position;
+		}
+
+		position = size;
+		emit( 0, 0 );
+	}
+
+	inline void LzCodec::decompress( std::span<const std::byte> input, std::vector<std::byte>& output )
+	{
+		std::size_t position{ 0 };
+		std::size_t expected{ 0 };
+
+		for ( unsigned shift{ 0 }; ; shift += 7 )
+		{
+			if ( position == input.size() || shift > 63 )
+			{
+				throw std::runtime_error{ "Corrupt compressed block" };
+			}
+
+			const auto byte{ static_cast<std::uint8_t>( input[position++] ) };
+			expected |= static_cast<std::size_t>( byte & 0x7F ) << shift;
+
+			if ( ( byte & 0x80 ) == 0 )
+			{
+				break;
+			}
+		}
+
+		// No block byte expands to more than 255 bytes: a longer claimed length is corrupt
+		if ( expected / 255 > input.size() )
+		{
+			throw std::runtime_error{ "Corrupt compressed block" };
+		}
+
+		const std::size_t start{ output.size() };
+		output.reserve( start + expected );
+
+		while ( position < input.size() )
+		{
+			const auto token{ static_cast<std::uint8_t>( input[position++] ) };
+
+			std::size_t literals{ static_cast<std::size_t>( token >> 4 ) };
+			if ( literals == 15 )
+			{
+				literals += readExtraLength( input, position );
+			}
+
+			if ( literals > input.size() - position || literals > expected - ( output.size() - start ) )
+			{
+				throw std::runtime_error{ "Corrupt compressed block" };
+			}
+
+			output.insert( output.end(), input.begin() + static_cast<std::ptrdiff_t>( position ), input.begin() + static_cast<std::ptrdiff_t>( position + literals ) );
+			position += literals;
+
+			if ( position == input.size() )
+			{
+				break; // The last sequence has no match
+			}
+
+			if ( input.size() - position < 2 )
+			{
+				throw std::runtime_error{ "Corrupt compressed block" };
+			}
+
+			const std::size_t offset{ static_cast<std::size_t>( input[position] ) | ( static_cast<std::size_t>( input[position + 1] ) << 8 ) };
+			position += 2;
+
+			std::size_t length{ static_cast<std::size_t>( token & 0x0F ) };
+			if ( length == 15 )
+			{
+				length += readExtraLength( input, position );
+			}
+			length += MIN_MATCH;
+
+			const std::size_t produced{ output.size() - start };
+			if ( offset == 0 || offset > produced || length > expected - produced )
+			{
+				throw std::runtime_error{ "Corrupt compressed block" };
+			}
+
+			const std::size_t to{ output.size() };
+			output.resize( to + length );
+			std::byte* bytes{ output.data() };
+
+			if ( offset >= length )
+			{
+				std::memcpy( bytes + to, bytes + to - offset, length );
+			}
+			else
+			{
+				// Overlapping match repeating the last offset bytes: copied forward byte by byte
+				for ( std::size_t i{ to }; i < to + length; ++i )
+				{
+					bytes[i] = bytes[i - offset];
+				}
+			}
+		}
+
+		if ( output.size() - start != expected )
+		{
+			throw std::runtime_error{ "Corrupt compressed block" };
+		}
+	}
+
+	//----------------------------------------------
+	// Helpers
+	//----------------------------------------------
+
+	inline void LzCodec::writeExtraLength( std::vector<std::byte>& output, std::size_t length )
+	{
+		for ( ; length >= 255; length -= 255 )
+		{
+			output.push_back( std::byte{ 255 } );
+		}
+
+		output.push_back( static_cast<std::byte>( length ) );
+	}
+
+	inline std::size_t LzCodec::readExtraLength( std::span<const std::byte> input, std::size_t& position )
+	{
+		std::size_t length{ 0 };
+
+		while ( true )
+		{
+			if ( position == input.size() )
+			{
+				throw std::runtime_error{ "Corrupt compressed block" };
+			}
+
+			const auto byte{ static_cast<std::uint8_t>( input[position++] ) };
+			length += byte;
+
+			if ( byte != 255 )
+			{
+				return length;
+			}
+		}
+	}
+
+	inline std::uint32_t LzCodec::hashAt( const std::byte* data ) noexcept
+	{
+		std::uint32_t word;
+		std::memcpy( &word, data, sizeof( word ) );
+
+		return ( word * 2654435761u ) >> ( 32 - HASH_BITS );
+	}
+} // namespace nfx::cache
@@ -0,0 +1,603 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file EvictionPolicy.inl
+ * @brief Implementation of eviction policies and their building blocks
+ * @details Intrusive list operations, count-min sketch and LRU, SLRU, CLOCK and W-TinyLFU policies
+ */
+
+#include <algorithm>
+#include <bit>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// PolicyList
+	//=====================================================================
+
+	//----------------------------------------------
+	// Modification operations
+	//----------------------------------------------
+
+	inline void PolicyList::pushFront( CacheEntry* entry ) noexcept
+	{
+		entry->lruNext = m_head;
+		entry->lruPrev = nullptr;
+
+		if ( m_head != nullptr )
+		{
+			m_head->lruPrev = entry;
+		}
+		else
+		{
+			m_tail = entry;
+		}
+
+		m_head = entry;
+		++m_size;
+	}
+
+	inline void PolicyList::remove( CacheEntry* entry ) noexcept
+	{
+		if ( entry->lruPrev != nullptr )
+		{
+			entry->lruPrev->lruNext = entry->lruNext;
+		}
+		else
+		{
+			m_head = entry->lruNext;
+		}
+
+		if ( entry->lruNext != nullptr )
+		{
+			entry->lruNext->lruPrev = entry->lruPrev;
+		}
+		else
+		{
+			m_tail = entry->lruPrev;
+		}
+
+		entry->lruNext = nullptr;
+		entry->lruPrev = nullptr;
+		--m_size;
+	}
+
+	inline void PolicyList::moveToFront( CacheEntry* entry ) noexcept
+	{
+		if ( entry == m_head )
+		{
+			return; // Already most recent
+		}
+
+		remove( entry );
+		pushFront( entry );
+	}
+
+	inline void PolicyList::clear() noexcept
+	{
+		m_head = nullptr;
+		m_tail = nullptr;
+		m_size = 0;
+	}
+
+	//----------------------------------------------
+	// State inspection
+	//----------------------------------------------
+
+	inline CacheEntry* PolicyList::front() const noexcept
+	{
+		return m_head;
+	}
+
+	inline CacheEntry* PolicyList::back() const noexcept
+	{
+		return m_tail;
+	}
+
+	inline std::size_t PolicyList::size() const noexcept
+	{
+		return m_size;
+	}
+
+	//=====================================================================
+	// FrequencySketch
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline FrequencySketch::FrequencySketch( std::size_t capacity )
+	{
+		ensureCapacity( capacity );
+	}
+
+	//----------------------------------------------
+	// Operations
+	//----------------------------------------------
+
+	inline void FrequencySketch::ensureCapacity( std::size_t capacity )
+	{
+		const std::size_t width{ std::bit_ceil( std::max<std::size_t>( capacity, 16 ) ) * COLUMNS_PER_ENTRY };
+		if ( width <= m_width )
+		{
+			return;
+		}
+
+		m_counters.assign( DEPTH * width, 0 );
+		m_width = width;
+		m_additions = 0;
+	}
+
+	inline void FrequencySketch::increment( std::size_t hash ) noexcept
+	{
+		for ( std::size_t row{ 0 }; row < DEPTH; ++row )
+		{
+			std::uint8_t& counter{ m_counters[indexOf( hash, row )] };
+			if ( counter < MAX_COUNT )
+			{
+				++counter;
+			}
+		}
+
+		if ( ++m_additions >= SAMPLE_FACTOR * ( m_width / COLUMNS_PER_ENTRY ) )
+		{
+			age();
+		}
+	}
+
+	inline std::uint8_t FrequencySketch::frequency( std::size_t hash ) const noexcept
+	{
+		std::uint8_t estimate{ MAX_COUNT };
+		for ( std::size_t row{ 0 }; row < DEPTH; ++row )
+		{
+			estimate = std::min( estimate, m_counters[indexOf( hash, row )] );
+		}
+
+		return estimate;
+	}
+
+	inline void FrequencySketch::clear() noexcept
+	{
+		std::fill( m_counters.begin(), m_counters.end(), std::uint8_t{ 0 } );
+		m_additions = 0;
+	}
+
+	//----------------------------------------------
+	// Private helper methods
+	//----------------------------------------------
+
+	inline std::size_t FrequencySketch::indexOf( std::size_t hash, std::size_t row ) const noexcept
+	{
+		std::uint64_t mixed{ ( static_cast<std::uint64_t>( hash ) + row ) * SEEDS[row] };
+		mixed ^= mixed >> 32;
+
+		return row * m_width + ( static_cast<std::size_t>( mixed ) & ( m_width - 1 ) );
+	}
+
+	inline void FrequencySketch::age() noexcept
+	{
+		for ( auto& counter : m_counters )
+		{
+			counter >>= 1;
+		}
+
+		m_additions /= 2;
+	}
+
+	//=====================================================================
+	// LruPolicy
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline LruPolicy::LruPolicy( std::size_t ) noexcept
+	{
+	}
+
+	//----------------------------------------------
+	// Policy operations
+	//----------------------------------------------
+
+	template <typename EntryHash>
+	inline void LruPolicy::onInsert( CacheEntry* entry, const EntryHash& ) noexcept
+	{
+		m_list.pushFront( entry );
+	}
+
+	template <typename EntryHash>
+	inline void LruPolicy::onAccess( CacheEntry* entry, const EntryHash& ) noexcept
+	{
+		m_list.moveToFront( entry );
+	}
+
+	inline void LruPolicy::onRemove( CacheEntry* entry ) noexcept
+	{
+		m_list.remove( entry );
+	}
+
+	inline void LruPolicy::onSkip( CacheEntry* entry ) noexcept
+	{
+		m_list.moveToFront( entry );
+	}
+
+	template <typename EntryHash>
+	inline CacheEntry* LruPolicy::victim( const EntryHash& ) noexcept
+	{
+		return m_list.back();
+	}
+
+	inline void LruPolicy::clear() noexcept
+	{
+		m_list.clear();
+	}
+
+	//=====================================================================
+	// SlruPolicy
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline SlruPolicy::SlruPolicy( std::size_t capacity ) noexcept
+		: m_capacity{ capacity }
+	{
+	}
+
+	//----------------------------------------------
+	// Policy operations
+	//----------------------------------------------
+
+	template <typename EntryHash>
+	inline void SlruPolicy::onInsert( CacheEntry* entry, const EntryHash& ) noexcept
+	{
+		entry->policyState = PROBATION;
+		m_probation.pushFront( entry );
+	}
+
+	template <typename EntryHash>
+	inline void SlruPolicy::onAccess( CacheEntry* entry, const EntryHash& ) noexcept
+	{
+		if ( entry->policyState == PROTECTED )
+		{
+			m_protected.moveToFront( entry );
+
+			return;
+		}
+
+		// Second access: promote out of probation
+		m_probation.remove( entry );
+		entry->policyState = PROTECTED;
+		m_protected.pushFront( entry );
+
+		demoteProtectedOverflow();
+	}
+
+	inline void SlruPolicy::onRemove( CacheEntry* entry ) noexcept
+	{
+		( entry->policyState == PROTECTED ? m_protected : m_probation ).remove( entry );
+	}
+
+	inline void SlruPolicy::onSkip( CacheEntry* entry ) noexcept
+	{
+		// Segments are the only history kept: a skipped probation entry joins protected so that
+		// victims are also looked for there once probation holds nothing but pinned entries
+		( entry->policyState == PROTECTED ? m_protected : m_probation ).remove( entry );
+		entry->policyState = PROTECTED;
+		m_protected.pushFront( entry );
+
+		demoteProtectedOverflow();
+	}
+
+	template <typename EntryHash>
+	inline CacheEntry* SlruPolicy::victim( const EntryHash& ) noexcept
+	{
+		return m_probation.back() != nullptr ? m_probation.back() : m_protected.back();
+	}
+
+	inline void SlruPolicy::clear() noexcept
+	{
+		m_probation.clear();
+		m_protected.clear();
+	}
+
+	//----------------------------------------------
+	// Private helper methods
+	//----------------------------------------------
+
+	inline void SlruPolicy::demoteProtectedOverflow() noexcept
+	{
+		const std::size_t capacity{ m_capacity > 0 ? m_capacity : m_probation.size() + m_protected.size() };
+		const std::size_t protectedLimit{ std::max<std::size_t>( capacity * PROTECTED_PERCENT / 100, 1 ) };
+
+		while ( m_protected.size() > protectedLimit )
+		{
+			CacheEntry* demoted{ m_protected.back() };
+			m_protected.remove( demoted );
+			demoted->policyState = PROBATION;
+			m_probation.pushFront( demoted );
+		}
+	}
+
+	//=====================================================================
+	// ClockPolicy
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline ClockPolicy::ClockPolicy( std::size_t ) noexcept
+		: m_hand{ nullptr }
+	{
+	}
+
+	//----------------------------------------------
+	// Policy operations
+	//----------------------------------------------
+
+	template <typename EntryHash>
+	inline void ClockPolicy::onInsert( CacheEntry* entry, const EntryHash& ) noexcept
+	{
+		entry->policyState = 0;
+
+		if ( m_hand == nullptr )
+		{
+			entry->lruPrev = entry;
+			entry->lruNext = entry;
+			m_hand = entry;
+
+			return;
+		}
+
+		// Insert just behind the hand so a new entry is examined last
+		entry->lruPrev = m_hand->lruPrev;
+		entry->lruNext = m_hand;
+		m_hand->lruPrev->lruNext = entry;
+		m_hand->lruPrev = entry;
+	}
+
+	template <typename EntryHash>
+	inline void ClockPolicy::onAccess( CacheEntry* entry, const EntryHash& ) noexcept
+	{
+		entry->policyState = 1;
+	}
+
+	inline void ClockPolicy::onRemove( CacheEntry* entry ) noexcept
+	{
+		if ( entry->lruNext == entry )
+		{
+			m_hand = nullptr;
+		}
+		else
+		{
+			if ( m_hand == entry )
+			{
+				m_hand = entry->lruNext;
+			}
+
+			entry->lruPrev->lruNext = entry->lruNext;
+			entry->lruNext->lruPrev = entry->lruPrev;
+		}
+
+		entry->lruNext = nullptr;
+		entry->lruPrev = nullptr;
+	}
+
+	inline void ClockPolicy::onSkip( CacheEntry* entry ) noexcept
+	{
+		// Past the entry without a reference bit: it is examined again after a full sweep
+		if ( m_hand == entry )
+		{
+			m_hand = entry->lruNext;
+		}
+	}
+
+	template <typename EntryHash>
+	inline CacheEntry* ClockPolicy::victim( const EntryHash& ) noexcept
+	{
+		if ( m_hand == nullptr )
+		{
+			return nullptr;
+		}
+
+		// Give referenced entries a second chance; terminates after at most one full sweep
+		while ( m_hand->policyState != 0 )
+		{
+			m_hand->policyState = 0;
+			m_hand = m_hand->lruNext;
+		}
+
+		return m_hand;
+	}
+
+	inline void ClockPolicy::clear() noexcept
+	{
+		m_hand = nullptr;
+	}
+
+	//=====================================================================
+	// WTinyLfuPolicy
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline WTinyLfuPolicy::WTinyLfuPolicy( std::size_t capacity )
+		: m_capacity{ capacity },
+		  m_sketch{ capacity }
+	{
+	}
+
+	//----------------------------------------------
+	// Policy operations
+	//----------------------------------------------
+
+	template <typename EntryHash>
+	inline void WTinyLfuPolicy::onInsert( CacheEntry* entry, const EntryHash& hashOf )
+	{
+		if ( m_capacity == 0 )
+		{
+			m_sketch.ensureCapacity( effectiveCapacity() + 1 );
+		}
+
+		m_sketch.increment( hashOf( entry ) );
+
+		entry->policyState = WINDOW;
+		m_window.pushFront( entry );
+	}
+
+	template <typename EntryHash>
+	inline void WTinyLfuPolicy::onAccess( CacheEntry* entry, const EntryHash& hashOf ) noexcept
+	{
+		m_sketch.increment( hashOf( entry ) );
+
+		switch ( entry->policyState )
+		{
+			case WINDOW:
+			{
+				m_window.moveToFront( entry );
+				break;
+			}
+			case PROBATION:
+			{
+				m_probation.remove( entry );
+				entry->policyState = PROTECTED;
+				m_protected.pushFront( entry );
+				demoteProtectedOverflow();
+				break;
+			}
+			default:
+			{
+				m_protected.moveToFront( entry );
+				break;
+			}
+		}
+	}
+
+	inline void WTinyLfuPolicy::onRemove( CacheEntry* entry ) noexcept
+	{
+		switch ( entry->policyState )
+		{
+			case WINDOW:
+			{
+				m_window.remove( entry );
+				break;
+			}
+			case PROBATION:
+			{
+				m_probation.remove( entry );
+				break;
+			}
+			default:
+			{
+				m_protected.remove( entry );
+				break;
+			}
+		}
+	}
+
+	inline void WTinyLfuPolicy::onSkip( CacheEntry* entry ) noexcept
+	{
+		// Relinked like a hit, but the sketch is left alone: the entry keeps its estimated frequency
+		if ( entry->policyState == WINDOW )
+		{
+			m_window.moveToFront( entry );
+
+			return;
+		}
+
+		( entry->policyState == PROBATION ? m_probation : m_protected ).remove( entry );
+		entry->policyState = PROTECTED;
+		m_protected.pushFront( entry );
+
+		demoteProtectedOverflow();
+	}
+
+	template <typename EntryHash>
+	inline CacheEntry* WTinyLfuPolicy::victim( const EntryHash& hashOf ) noexcept
+	{
+		// Entries leaving the window become admission candidates at the front of probation
+		const std::size_t windowLimit{ std::max<std::size_t>( effectiveCapacity() * WINDOW_PERCENT / 100, 1 ) };
+		while ( m_window.size() > windowLimit )
+		{
+			CacheEntry* candidate{ m_window.back() };
+			m_window.remove( candidate );
+			candidate->policyState = PROBATION;
+			m_probation.pushFront( candidate );
+		}
+
+		if ( m_probation.size() == 0 )
+		{
+			return m_protected.back() != nullptr ? m_protected.back() : m_window.back();
+		}
+
+		// Admission duel: the newest probation entry must be more popular than the oldest to stay
+		CacheEntry* candidate{ m_probation.front() };
+		CacheEntry* victim{ m_probation.back() };
+		if ( candidate == victim )
+		{
+			return victim;
+		}
+
+		return m_sketch.frequency( hashOf( candidate ) ) > m_sketch.frequency( hashOf( victim ) ) ? victim : candidate;
+	}
+
+	inline void WTinyLfuPolicy::clear() noexcept
+	{
+		m_window.clear();
+		m_probation.clear();
+		m_protected.clear();
+		m_sketch.clear();
+	}
+
+	//----------------------------------------------
+	// Private helper methods
+	//----------------------------------------------
+
+	inline std::size_t WTinyLfuPolicy::effectiveCapacity() const noexcept
+	{
+		return m_capacity > 0 ? m_capacity : m_window.size() + m_probation.size() + m_protected.size();
+	}
+
+	inline void WTinyLfuPolicy::demoteProtectedOverflow() noexcept
+	{
+		const std::size_t capacity{ effectiveCapacity() };
+		const std::size_t windowLimit{ std::max<std::size_t>( capacity * WINDOW_PERCENT / 100, 1 ) };
+		const std::size_t protectedLimit{ std::max<std::size_t>( ( capacity > windowLimit ? capacity - windowLimit : 0 ) * PROTECTED_PERCENT / 100, 1 ) };
+
+		while ( m_protected.size() > protectedLimit )
+		{
+			CacheEntry* demoted{ m_protected.back() };
+			m_protected.remove( demoted );
+			demoted->policyState = PROBATION;
+			m_probation.pushFront( demoted );
+		}
+	}
+} // namespace nfx::cache
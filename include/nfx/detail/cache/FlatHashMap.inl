@@ -0,0 +1,520 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file FlatHashMap.inl
+ * @brief Implementation of FlatHashGroup probing and FlatHashMap template methods
+ * @details Group-aligned quadratic probing over 16-slot control groups, tombstone handling
+ *          and pointer-only rehashing
+ */
+
+#include <algorithm>
+#include <bit>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// FlatHashGroup
+	//=====================================================================
+
+	//----------------------------------------------
+	// Probing
+	//----------------------------------------------
+
+	inline std::uint32_t FlatHashGroup::match( const std::int8_t* ctrl, std::int8_t h2 ) noexcept
+	{
+#if defined( NFX_LRUCACHE_HAS_SSE2 )
+		const __m128i group{ _mm_loadu_si128( reinterpret_cast<const __m128i*>( ctrl ) ) };
+
+		return static_cast<std::uint32_t>( _mm_movemask_epi8( _mm_cmpeq_epi8( group, _mm_set1_epi8( h2 ) ) ) );
+#else
+		return matchScalar( ctrl, h2 );
+#endif
+	}
+
+	inline std::uint32_t FlatHashGroup::matchEmpty( const std::int8_t* ctrl ) noexcept
+	{
+#if defined( NFX_LRUCACHE_HAS_SSE2 )
+		const __m128i group{ _mm_loadu_si128( reinterpret_cast<const __m128i*>( ctrl ) ) };
+
+		return static_cast<std::uint32_t>( _mm_movemask_epi8( _mm_cmpeq_epi8( group, _mm_set1_epi8( EMPTY ) ) ) );
+#else
+		return matchEmptyScalar( ctrl );
+#endif
+	}
+
+	inline std::uint32_t FlatHashGroup::matchEmptyOrDeleted( const std::int8_t* ctrl ) noexcept
+	{
+#if defined( NFX_LRUCACHE_HAS_SSE2 )
+		// Full slots hold a 7-bit fragment, so free slots are exactly those with the sign bit set
+		const __m128i group{ _mm_loadu_si128( reinterpret_cast<const __m128i*>( ctrl ) ) };
+
+		return static_cast<std::uint32_t>( _mm_movemask_epi8( group ) );
+#else
+		return matchEmptyOrDeletedScalar( ctrl );
+#endif
+	}
+
+	inline std::uint32_t FlatHashGroup::matchScalar( const std::int8_t* ctrl, std::int8_t h2 ) noexcept
+	{
+		std::uint32_t mask{ 0 };
+		for ( std::size_t i{ 0 }; i < WIDTH; ++i )
+		{
+			mask |= static_cast<std::uint32_t>( ctrl[i] == h2 ) << i;
+		}
+
+		return mask;
+	}
+
+	inline std::uint32_t FlatHashGroup::matchEmptyScalar( const std::int8_t* ctrl ) noexcept
+	{
+		return matchScalar( ctrl, EMPTY );
+	}
+
+	inline std::uint32_t FlatHashGroup::matchEmptyOrDeletedScalar( const std::int8_t* ctrl ) noexcept
+	{
+		std::uint32_t mask{ 0 };
+		for ( std::size_t i{ 0 }; i < WIDTH; ++i )
+		{
+			mask |= static_cast<std::uint32_t>( ctrl[i] < 0 ) << i;
+		}
+
+		return mask;
+	}
+
+	//=====================================================================
+	// FlatHashMap
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::FlatHashMap(
+		size_type capacity, const Hash& hash, const KeyEqual& equal, const Allocator& allocator )
+		: m_ctrl{ CtrlAllocator{ allocator } },
+		  m_slots{ SlotAllocator{ allocator } },
+		  m_size{ 0 },
+		  m_growthLeft{ 0 },
+		  m_hasher{ hash },
+		  m_keyEqual{ equal },
+		  m_nodeAllocator{ allocator }
+	{
+		reserve( capacity );
+	}
+
+	//----------------------------------------------
+	// Destruction
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::~FlatHashMap()
+	{
+		clear();
+	}
+
+	//----------------------------------------------
+	// Iteration
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::iterator FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::begin() noexcept
+	{
+		iterator it{ m_ctrl.data(), m_slots.data(), m_ctrl.data() + m_ctrl.size() };
+		it.skipFreeSlots();
+
+		return it;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::const_iterator FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::begin() const noexcept
+	{
+		const_iterator it{ m_ctrl.data(), m_slots.data(), m_ctrl.data() + m_ctrl.size() };
+		it.skipFreeSlots();
+
+		return it;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::iterator FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::end() noexcept
+	{
+		const std::int8_t* ctrlEnd{ m_ctrl.data() + m_ctrl.size() };
+
+		return iterator{ ctrlEnd, m_slots.data() + m_slots.size(), ctrlEnd };
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::const_iterator FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::end() const noexcept
+	{
+		const std::int8_t* ctrlEnd{ m_ctrl.data() + m_ctrl.size() };
+
+		return const_iterator{ ctrlEnd, m_slots.data() + m_slots.size(), ctrlEnd };
+	}
+
+	//----------------------------------------------
+	// Lookup operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::iterator FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::find( const TKey& key )
+	{
+		const size_type slot{ findSlot( key, hashOf( key ) ) };
+
+		return iterator{ m_ctrl.data() + slot, m_slots.data() + slot, m_ctrl.data() + m_ctrl.size() };
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::const_iterator FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::find( const TKey& key ) const
+	{
+		const size_type slot{ findSlot( key, hashOf( key ) ) };
+
+		return const_iterator{ m_ctrl.data() + slot, m_slots.data() + slot, m_ctrl.data() + m_ctrl.size() };
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	template <typename K>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::iterator FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::find( const K& key )
+	{
+		const size_type slot{ findSlot( key, hashOf( key ) ) };
+
+		return iterator{ m_ctrl.data() + slot, m_slots.data() + slot, m_ctrl.data() + m_ctrl.size() };
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	template <typename K>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::const_iterator FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::find( const K& key ) const
+	{
+		const size_type slot{ findSlot( key, hashOf( key ) ) };
+
+		return const_iterator{ m_ctrl.data() + slot, m_slots.data() + slot, m_ctrl.data() + m_ctrl.size() };
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	template <typename K>
+		requires LookupKeyFor<K, TKey, Hash, KeyEqual>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::iterator FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::find( const K& key, std::uint64_t hash )
+	{
+		const size_type slot{ findSlot( key, hash ) };
+
+		return iterator{ m_ctrl.data() + slot, m_slots.data() + slot, m_ctrl.data() + m_ctrl.size() };
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	template <typename K>
+		requires LookupKeyFor<K, TKey, Hash, KeyEqual>
+	inline std::uint64_t FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::hash_code( const K& key ) const
+	{
+		return hashOf( key );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline void FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::prefetch( [[maybe_unused]] std::uint64_t hash ) const noexcept
+	{
+#if defined( __GNUC__ )
+		const size_type capacity{ m_ctrl.size() };
+		if ( capacity == 0 )
+		{
+			return;
+		}
+
+		const size_type base{ ( static_cast<size_type>( hash >> 7 ) & ( capacity / FlatHashGroup::WIDTH - 1 ) ) * FlatHashGroup::WIDTH };
+		__builtin_prefetch( m_ctrl.data() + base );
+		__builtin_prefetch( m_slots.data() + base );
+#endif
+	}
+
+	//----------------------------------------------
+	// Modification operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	template <typename... Args>
+	inline std::pair<typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::iterator, bool> FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::try_emplace( const TKey& key, Args&&... args )
+	{
+		const std::uint64_t hash{ hashOf( key ) };
+
+		const size_type existing{ findSlot( key, hash ) };
+		if ( existing != m_ctrl.size() )
+		{
+			return { iterator{ m_ctrl.data() + existing, m_slots.data() + existing, m_ctrl.data() + m_ctrl.size() }, false };
+		}
+
+		size_type slot{ m_ctrl.empty() ? 0 : findFreeSlot( hash ) };
+		if ( m_ctrl.empty() || ( m_growthLeft == 0 && m_ctrl[slot] == FlatHashGroup::EMPTY ) )
+		{
+			// Out of room: drop tombstones if they are what fills the table, grow otherwise
+			const size_type capacity{ m_ctrl.size() };
+			rehash( m_size < capacity / 2 && capacity > 0 ? capacity : capacityFor( m_size + 1 ) );
+			slot = findFreeSlot( hash );
+		}
+
+		value_type* node{ NodeTraits::allocate( m_nodeAllocator, 1 ) };
+		try
+		{
+			NodeTraits::construct( m_nodeAllocator, node, std::piecewise_construct, std::forward_as_tuple( key ), std::forward_as_tuple( std::forward<Args>( args )... ) );
+		}
+		catch ( ... )
+		{
+			NodeTraits::deallocate( m_nodeAllocator, node, 1 );
+
+			throw;
+		}
+
+		if ( m_ctrl[slot] == FlatHashGroup::EMPTY )
+		{
+			--m_growthLeft;
+		}
+
+		m_ctrl[slot] = static_cast<std::int8_t>( hash & 0x7F );
+		m_slots[slot] = node;
+		++m_size;
+
+		return { iterator{ m_ctrl.data() + slot, m_slots.data() + slot, m_ctrl.data() + m_ctrl.size() }, true };
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::iterator FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::erase( const_iterator pos )
+	{
+		const auto slot{ static_cast<size_type>( pos.m_ctrl - m_ctrl.data() ) };
+
+		destroyNode( releaseSlot( slot ) );
+
+		iterator next{ m_ctrl.data() + slot + 1, m_slots.data() + slot + 1, m_ctrl.data() + m_ctrl.size() };
+		next.skipFreeSlots();
+
+		return next;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::node_type FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::extract( const_iterator pos )
+	{
+		const auto slot{ static_cast<size_type>( pos.m_ctrl - m_ctrl.data() ) };
+
+		return node_type{ releaseSlot( slot ), m_nodeAllocator };
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline void FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::clear() noexcept
+	{
+		for ( size_type i{ 0 }; i < m_ctrl.size(); ++i )
+		{
+			if ( m_ctrl[i] >= 0 )
+			{
+				destroyNode( m_slots[i] );
+			}
+		}
+
+		std::fill( m_ctrl.begin(), m_ctrl.end(), FlatHashGroup::EMPTY );
+		std::fill( m_slots.begin(), m_slots.end(), nullptr );
+		m_size = 0;
+		m_growthLeft = m_ctrl.size() - m_ctrl.size() / 8;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline void FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::reserve( size_type count )
+	{
+		if ( count == 0 )
+		{
+			return;
+		}
+
+		const size_type capacity{ capacityFor( count ) };
+		if ( capacity > m_ctrl.size() )
+		{
+			rehash( capacity );
+		}
+	}
+
+	//----------------------------------------------
+	// State inspection
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::size_type FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::size() const noexcept
+	{
+		return m_size;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline bool FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::size_type FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::capacity() const noexcept
+	{
+		return m_ctrl.size();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::hasher FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::hash_function() const
+	{
+		return m_hasher;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::key_equal FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::key_eq() const
+	{
+		return m_keyEqual;
+	}
+
+	//----------------------------------------------
+	// Probing helpers
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	template <typename K>
+	inline std::uint64_t FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::hashOf( const K& key ) const
+	{
+		// std::hash is the identity for integers: spread every input bit over the whole word
+		std::uint64_t hash{ static_cast<std::uint64_t>( m_hasher( key ) ) * 0x9E3779B97F4A7C15ull };
+
+		return hash ^ ( hash >> 32 );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	template <typename K>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::size_type FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::findSlot( const K& key, std::uint64_t hash ) const
+	{
+		const size_type capacity{ m_ctrl.size() };
+		if ( capacity == 0 )
+		{
+			return 0;
+		}
+
+		const size_type groupMask{ capacity / FlatHashGroup::WIDTH - 1 };
+		const auto h2{ static_cast<std::int8_t>( hash & 0x7F ) };
+		size_type group{ static_cast<size_type>( hash >> 7 ) & groupMask };
+
+		for ( size_type step{ 1 };; ++step )
+		{
+			const size_type base{ group * FlatHashGroup::WIDTH };
+			const std::int8_t* ctrl{ m_ctrl.data() + base };
+
+#if defined( __GNUC__ )
+			// The slot pointers do not depend on the control bytes: overlap both cache misses
+			__builtin_prefetch( m_slots.data() + base );
+#endif
+
+			for ( std::uint32_t matches{ FlatHashGroup::match( ctrl, h2 ) }; matches != 0; matches &= matches - 1 )
+			{
+				const size_type slot{ base + static_cast<size_type>( std::countr_zero( matches ) ) };
+				if ( m_keyEqual( m_slots[slot]->first, key ) )
+				{
+					return slot;
+				}
+			}
+
+			if ( FlatHashGroup::matchEmpty( ctrl ) != 0 || step > groupMask )
+			{
+				return capacity;
+			}
+
+			group = ( group + step ) & groupMask;
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::size_type FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::findFreeSlot( std::uint64_t hash ) const noexcept
+	{
+		const size_type groupMask{ m_ctrl.size() / FlatHashGroup::WIDTH - 1 };
+		size_type group{ static_cast<size_type>( hash >> 7 ) & groupMask };
+
+		// The load factor guarantees a free slot somewhere on the probe sequence
+		for ( size_type step{ 1 };; ++step )
+		{
+			const size_type base{ group * FlatHashGroup::WIDTH };
+			const std::uint32_t free{ FlatHashGroup::matchEmptyOrDeleted( m_ctrl.data() + base ) };
+			if ( free != 0 )
+			{
+				return base + static_cast<size_type>( std::countr_zero( free ) );
+			}
+
+			group = ( group + step ) & groupMask;
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline void FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::rehash( size_type newCapacity )
+	{
+		std::vector<std::int8_t, CtrlAllocator> oldCtrl( newCapacity, FlatHashGroup::EMPTY, m_ctrl.get_allocator() );
+		std::vector<value_type*, SlotAllocator> oldSlots( newCapacity, nullptr, m_slots.get_allocator() );
+		m_ctrl.swap( oldCtrl );
+		m_slots.swap( oldSlots );
+		m_growthLeft = newCapacity - newCapacity / 8 - m_size;
+
+		for ( size_type i{ 0 }; i < oldCtrl.size(); ++i )
+		{
+			if ( oldCtrl[i] >= 0 )
+			{
+				const size_type slot{ findFreeSlot( hashOf( oldSlots[i]->first ) ) };
+				m_ctrl[slot] = oldCtrl[i];
+				m_slots[slot] = oldSlots[i];
+			}
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::size_type FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::capacityFor( size_type count ) noexcept
+	{
+		// Maximum load factor 7/8
+		const size_type required{ count + ( count + 6 ) / 7 };
+
+		return std::max( std::bit_ceil( required ), FlatHashGroup::WIDTH );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline typename FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::value_type* FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::releaseSlot( size_type slot ) noexcept
+	{
+		value_type* node{ m_slots[slot] };
+		m_slots[slot] = nullptr;
+		--m_size;
+
+		// A probe reaching a group that still has an empty slot stops there, so the slot can be
+		// reused freely; otherwise a tombstone keeps later probe chains intact
+		const size_type groupStart{ slot & ~( FlatHashGroup::WIDTH - 1 ) };
+		if ( FlatHashGroup::matchEmpty( m_ctrl.data() + groupStart ) != 0 )
+		{
+			m_ctrl[slot] = FlatHashGroup::EMPTY;
+			++m_growthLeft;
+		}
+		else
+		{
+			m_ctrl[slot] = FlatHashGroup::DELETED;
+		}
+
+		return node;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Allocator>
+	inline void FlatHashMap<TKey, TValue, Hash, KeyEqual, Allocator>::destroyNode( value_type* node ) noexcept
+	{
+		NodeTraits::destroy( m_nodeAllocator, node );
+		NodeTraits::deallocate( m_nodeAllocator, node, 1 );
+	}
+} // namespace nfx::cache
@@ -29,6 +29,13 @@
  *          with LRU eviction and configurable expiration policies
  */
 
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
 namespace nfx::cache
 {
 	//=====================================================================
@@ -68,333 +75,3536 @@ namespace nfx::cache
 		return m_backgroundCleanupInterval;
 	}
 
-	//=====================================================================
-	// CacheEntry
-	//=====================================================================
+	inline std::size_t LruCacheOptions::memoryLimit() const
+	{
+		return m_memoryLimit;
+	}
 
-	//----------------------------------------------
-	// Construction
-	//----------------------------------------------
+	inline bool LruCacheOptions::readOptimized() const
+	{
+		return m_readOptimized;
+	}
 
-	inline CacheEntry::CacheEntry( std::chrono::milliseconds expiration )
-		: lastAccessed{ std::chrono::steady_clock::now() },
-		  slidingExpiration{ expiration }
+	inline bool LruCacheOptions::slabStorage() const
 	{
+		return m_slabStorage;
 	}
 
-	//----------------------------------------------
-	// Expiration checking
-	//----------------------------------------------
+	inline bool LruCacheOptions::maintenanceThread() const
+	{
+		return m_maintenanceThread;
+	}
 
-	inline bool CacheEntry::isExpired() const noexcept
+	inline MaintenanceScheduler* LruCacheOptions::maintenanceScheduler() const
 	{
-		auto now{ std::chrono::steady_clock::now() };
-		return ( now - lastAccessed ) > slidingExpiration;
+		return m_maintenanceScheduler;
 	}
 
-	//----------------------------------------------
-	// Access management
-	//----------------------------------------------
+	inline std::size_t LruCacheOptions::cleanupBudget() const
+	{
+		return m_cleanupBudget;
+	}
 
-	void inline CacheEntry::touch() noexcept
+	inline bool LruCacheOptions::adaptiveCleanup() const
 	{
-		lastAccessed = std::chrono::steady_clock::now();
+		return m_adaptiveCleanup;
 	}
 
-	//=====================================================================
-	// LruCache
-	//=====================================================================
+	inline std::chrono::microseconds LruCacheOptions::cleanupTimeBudget() const
+	{
+		return m_cleanupTimeBudget;
+	}
 
-	//----------------------------------------------
-	// Construction
-	//----------------------------------------------
+	inline std::chrono::milliseconds LruCacheOptions::refreshAfter() const
+	{
+		return m_refreshAfter;
+	}
 
-	template <typename TKey, typename TValue>
-	inline LruCache<TKey, TValue>::LruCache( const LruCacheOptions& options )
-		: m_options{ options },
-		  m_lruHead{ nullptr },
-		  m_lruTail{ nullptr },
-		  m_lastCleanupTime{ std::chrono::steady_clock::now() }
+	inline std::chrono::milliseconds LruCacheOptions::staleWhileRevalidate() const
 	{
-		if ( m_options.sizeLimit() > 0 )
-		{
-			m_cache.reserve( m_options.sizeLimit() );
-		}
+		return m_staleWhileRevalidate;
+	}
+
+	inline std::chrono::milliseconds LruCacheOptions::absoluteExpiration() const
+	{
+		return m_absoluteExpiration;
+	}
+
+	inline ExpirationMode LruCacheOptions::expirationMode() const
+	{
+		return m_expirationMode;
+	}
+
+	inline std::chrono::milliseconds LruCacheOptions::negativeExpiration() const
+	{
+		return m_negativeExpiration;
+	}
+
+	inline std::size_t LruCacheOptions::negativeSizeLimit() const
+	{
+		return m_negativeSizeLimit;
+	}
+
+	inline std::size_t LruCacheOptions::secondTierMemoryLimit() const
+	{
+		return m_secondTierMemoryLimit;
+	}
+
+	inline std::size_t LruCacheOptions::secondTierMinimumSize() const
+	{
+		return m_secondTierMinimumSize;
+	}
+
+	inline const CompressionCodec& LruCacheOptions::secondTierCodec() const
+	{
+		return m_secondTierCodec;
+	}
+
+	inline const LruCacheOptions::Executor& LruCacheOptions::refreshExecutor() const
+	{
+		return m_refreshExecutor;
+	}
+
+	inline const LruCacheOptions::Executor& LruCacheOptions::loadExecutor() const
+	{
+		return m_loadExecutor;
 	}
 
 	//----------------------------------------------
-	// Cache operations
+	// Configuration
 	//----------------------------------------------
 
-	template <typename TKey, typename TValue>
-	inline TValue* LruCache<TKey, TValue>::get( const TKey& key, FactoryFunction factory, ConfigFunction configure )
+	inline LruCacheOptions& LruCacheOptions::setSizeLimit( std::size_t sizeLimit )
 	{
-		std::lock_guard<std::mutex> lock{ m_mutex };
+		m_sizeLimit = sizeLimit;
 
-		// Check for background cleanup opportunity
-		checkAndPerformBackgroundCleanup();
+		return *this;
+	}
 
-		auto it = m_cache.find( key );
-		if ( it != m_cache.end() )
-		{
-			if ( !it->second.metadata.isExpired() )
-			{
-				it->second.metadata.touch();		   // Reset expiration
-				moveToLruHead( &it->second.metadata ); // Mark as recent
+	inline LruCacheOptions& LruCacheOptions::setSlidingExpiration( std::chrono::milliseconds slidingExpiration )
+	{
+		m_slidingExpiration = slidingExpiration;
 
-				return &it->second.value;
-			}
-			else
-			{
-				removeFromLru( &it->second.metadata ); // Clean expired
+		return *this;
+	}
 
-				m_cache.erase( it );
-			}
-		}
+	inline LruCacheOptions& LruCacheOptions::setBackgroundCleanupInterval( std::chrono::milliseconds backgroundCleanupInterval )
+	{
+		m_backgroundCleanupInterval = backgroundCleanupInterval;
 
-		TValue value{ factory() };
-		CacheEntry metadata{ m_options.slidingExpiration() };
+		return *this;
+	}
 
-		if ( configure )
-		{
-			configure( metadata );
-		}
+	inline LruCacheOptions& LruCacheOptions::setMemoryLimit( std::size_t memoryLimit )
+	{
+		m_memoryLimit = memoryLimit;
 
-		if ( m_options.sizeLimit() > 0 && m_cache.size() >= m_options.sizeLimit() )
-		{
-			evictLeastRecentlyUsed();
-		}
+		return *this;
+	}
 
-		auto [insert_it, inserted]{ m_cache.try_emplace( key, std::move( value ), std::move( metadata ) ) };
-		insert_it->second.metadata.keyPtr = &insert_it->first;
-		addToLruHead( &insert_it->second.metadata );
+	inline LruCacheOptions& LruCacheOptions::setReadOptimized( bool readOptimized )
+	{
+		m_readOptimized = readOptimized;
 
-		return &insert_it->second.value;
+		return *this;
 	}
 
-	//----------------------------------------------
-	// Lookup operations
-	//----------------------------------------------
+	inline LruCacheOptions& LruCacheOptions::setSlabStorage( bool slabStorage )
+	{
+		m_slabStorage = slabStorage;
+
+		return *this;
+	}
 
-	template <typename TKey, typename TValue>
-	inline TValue* LruCache<TKey, TValue>::find( const TKey& key )
+	inline LruCacheOptions& LruCacheOptions::setMaintenanceThread( bool maintenanceThread )
 	{
-		std::lock_guard<std::mutex> lock{ m_mutex };
+		m_maintenanceThread = maintenanceThread;
 
-		// Check for background cleanup opportunity
-		checkAndPerformBackgroundCleanup();
+		return *this;
+	}
 
-		auto it{ m_cache.find( key ) };
-		if ( it != m_cache.end() && !it->second.metadata.isExpired() )
-		{
-			it->second.metadata.touch();
-			moveToLruHead( &it->second.metadata );
+	inline LruCacheOptions& LruCacheOptions::setMaintenanceScheduler( MaintenanceScheduler* scheduler )
+	{
+		m_maintenanceScheduler = scheduler;
 
-			return &it->second.value;
-		}
+		return *this;
+	}
 
-		if ( it != m_cache.end() )
-		{
-			removeFromLru( &it->second.metadata );
+	inline LruCacheOptions& LruCacheOptions::setCleanupBudget( std::size_t cleanupBudget )
+	{
+		m_cleanupBudget = std::max<std::size_t>( cleanupBudget, 1 );
 
-			m_cache.erase( it );
-		}
+		return *this;
+	}
 
-		return nullptr;
+	inline LruCacheOptions& LruCacheOptions::setAdaptiveCleanup( bool adaptiveCleanup )
+	{
+		m_adaptiveCleanup = adaptiveCleanup;
+
+		return *this;
 	}
 
-	//----------------------------------------------
-	// Modification operations
-	//----------------------------------------------
+	inline LruCacheOptions& LruCacheOptions::setCleanupTimeBudget( std::chrono::microseconds cleanupTimeBudget )
+	{
+		m_cleanupTimeBudget = cleanupTimeBudget;
+
+		return *this;
+	}
 
-	template <typename TKey, typename TValue>
-	inline bool LruCache<TKey, TValue>::remove( const TKey& key )
+	inline LruCacheOptions& LruCacheOptions::setRefreshAfter( std::chrono::milliseconds refreshAfter )
 	{
-		std::lock_guard<std::mutex> lock{ m_mutex };
+		m_refreshAfter = refreshAfter;
 
-		auto it = m_cache.find( key );
-		if ( it != m_cache.end() )
-		{
-			removeFromLru( &it->second.metadata );
-			m_cache.erase( it );
-			return true;
-		}
+		return *this;
+	}
 
-		return false;
+	inline LruCacheOptions& LruCacheOptions::setStaleWhileRevalidate( std::chrono::milliseconds staleWhileRevalidate )
+	{
+		m_staleWhileRevalidate = staleWhileRevalidate;
+
+		return *this;
 	}
 
-	template <typename TKey, typename TValue>
-	inline void LruCache<TKey, TValue>::clear()
+	inline LruCacheOptions& LruCacheOptions::setAbsoluteExpiration( std::chrono::milliseconds absoluteExpiration )
 	{
-		std::lock_guard<std::mutex> lock{ m_mutex };
-		m_cache.clear();
-		m_lruHead = nullptr;
-		m_lruTail = nullptr;
+		m_absoluteExpiration = absoluteExpiration;
+
+		return *this;
 	}
 
-	template <typename TKey, typename TValue>
-	inline std::size_t LruCache<TKey, TValue>::size() const
+	inline LruCacheOptions& LruCacheOptions::setExpirationMode( ExpirationMode expirationMode )
 	{
-		std::lock_guard<std::mutex> lock{ m_mutex };
+		m_expirationMode = expirationMode;
 
-		return m_cache.size();
+		return *this;
 	}
 
-	//----------------------------------------------
-	// State inspection
-	//----------------------------------------------
+	inline LruCacheOptions& LruCacheOptions::setNegativeExpiration( std::chrono::milliseconds negativeExpiration )
+	{
+		m_negativeExpiration = negativeExpiration;
 
-	template <typename TKey, typename TValue>
-	inline bool LruCache<TKey, TValue>::isEmpty() const
+		return *this;
+	}
+
+	inline LruCacheOptions& LruCacheOptions::setNegativeSizeLimit( std::size_t negativeSizeLimit )
 	{
-		std::lock_guard<std::mutex> lock{ m_mutex };
+		m_negativeSizeLimit = negativeSizeLimit;
 
-		return m_cache.empty();
+		return *this;
 	}
 
-	template <typename TKey, typename TValue>
-	inline void LruCache<TKey, TValue>::cleanupExpired()
+	inline LruCacheOptions& LruCacheOptions::setSecondTierMemoryLimit( std::size_t secondTierMemoryLimit )
 	{
-		std::lock_guard<std::mutex> lock{ m_mutex };
+		m_secondTierMemoryLimit = secondTierMemoryLimit;
 
-		auto it = m_cache.begin();
-		while ( it != m_cache.end() )
-		{
-			if ( it->second.metadata.isExpired() )
-			{
-				removeFromLru( &it->second.metadata );
-				it = m_cache.erase( it );
-			}
-			else
-			{
-				++it;
-			}
-		}
+		return *this;
+	}
+
+	inline LruCacheOptions& LruCacheOptions::setSecondTierMinimumSize( std::size_t secondTierMinimumSize )
+	{
+		m_secondTierMinimumSize = secondTierMinimumSize;
+
+		return *this;
+	}
+
+	inline LruCacheOptions& LruCacheOptions::setSecondTierCodec( CompressionCodec codec )
+	{
+		m_secondTierCodec = std::move( codec );
+
+		return *this;
+	}
+
+	inline LruCacheOptions& LruCacheOptions::setRefreshExecutor( Executor executor )
+	{
+		m_refreshExecutor = std::move( executor );
+
+		return *this;
+	}
+
+	inline LruCacheOptions& LruCacheOptions::setLoadExecutor( Executor executor )
+	{
+		m_loadExecutor = std::move( executor );
+
+		return *this;
 	}
 
+	//=====================================================================
+	// TimerWheel
+	//=====================================================================
+
 	//----------------------------------------------
-	// Internal data structures
+	// Construction
 	//----------------------------------------------
 
-	template <typename TKey, typename TValue>
-	LruCache<TKey, TValue>::CachedItem::CachedItem( TValue val, CacheEntry meta )
-		: value{ std::move( val ) },
-		  metadata{ std::move( meta ) }
+	inline TimerWheel::TimerWheel( std::chrono::steady_clock::time_point now, std::chrono::milliseconds grace ) noexcept
+		: m_time{ now },
+		  m_grace{ grace }
 	{
 	}
 
 	//----------------------------------------------
-	// LRU list management
+	// Scheduling
 	//----------------------------------------------
 
-	template <typename TKey, typename TValue>
-	inline void LruCache<TKey, TValue>::addToLruHead( CacheEntry* entry ) noexcept
+	inline void TimerWheel::schedule( CacheEntry* entry ) noexcept
 	{
-		entry->lruNext = m_lruHead;
-		entry->lruPrev = nullptr;
+		link( entry, toNanos( m_time ) );
+	}
 
-		if ( m_lruHead != nullptr )
+	inline void TimerWheel::unschedule( CacheEntry* entry ) noexcept
+	{
+		if ( entry->expiryPrevNext == nullptr )
 		{
-			m_lruHead->lruPrev = entry;
+			return;
 		}
-		else
+
+		*entry->expiryPrevNext = entry->expiryNext;
+		if ( entry->expiryNext != nullptr )
 		{
-			m_lruTail = entry;
+			entry->expiryNext->expiryPrevNext = entry->expiryPrevNext;
 		}
 
-		m_lruHead = entry;
+		entry->expiryNext = nullptr;
+		entry->expiryPrevNext = nullptr;
 	}
 
-	template <typename TKey, typename TValue>
-	inline void LruCache<TKey, TValue>::removeFromLru( CacheEntry* entry ) noexcept
+	template <typename OnExpired>
+	inline std::size_t TimerWheel::advance( std::chrono::steady_clock::time_point now, std::size_t budget, OnExpired&& onExpired )
 	{
-		if ( entry->lruPrev != nullptr )
+		const std::int64_t previous{ toNanos( m_time ) };
+		const std::int64_t current{ std::max( toNanos( now ), previous ) };
+		std::size_t expired{ 0 };
+
+		for ( std::size_t level{ 0 }; level < LEVELS; ++level )
 		{
-			entry->lruPrev->lruNext = entry->lruNext;
+			// Visit every bucket whose span elapsed since the last advance, plus the one holding now
+			const std::uint64_t first{ static_cast<std::uint64_t>( previous ) >> SPAN_SHIFTS[level] };
+			const std::uint64_t last{ static_cast<std::uint64_t>( current ) >> SPAN_SHIFTS[level] };
+			const std::uint64_t count{ std::min<std::uint64_t>( last - first + 1, BUCKETS ) };
+
+			for ( std::uint64_t i{ 0 }; i < count; ++i )
+			{
+				CacheEntry* entry{ m_buckets[level][( first + i ) & ( BUCKETS - 1 )] };
+				while ( entry != nullptr )
+				{
+					CacheEntry* next{ entry->expiryNext };
+
+					if ( entry->isExpired( now - m_grace ) )
+					{
+						if ( expired == budget )
+						{
+							return expired;
+						}
+
+						unschedule( entry );
+						onExpired( entry );
+						++expired;
+					}
+					else
+					{
+						// Renewed since it was scheduled, or due later within this bucket: cascade it
+						unschedule( entry );
+						link( entry, current );
+					}
+
+					entry = next;
+				}
+			}
 		}
-		else
+
+		m_time = now;
+
+		return expired;
+	}
+
+	inline void TimerWheel::clear( std::chrono::steady_clock::time_point now ) noexcept
+	{
+		for ( auto& level : m_buckets )
+		{
+			level.fill( nullptr );
+		}
+
+		m_time = now;
+	}
+
+	//----------------------------------------------
+	// Private helper methods
+	//----------------------------------------------
+
+	inline std::int64_t TimerWheel::toNanos( std::chrono::steady_clock::time_point time ) noexcept
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>( time.time_since_epoch() ).count();
+	}
+
+	inline void TimerWheel::link( CacheEntry* entry, std::int64_t reference ) noexcept
+	{
+		// Farthest deadline the coarsest level can hold; later entries are parked there and cascaded
+		constexpr std::int64_t maxDelay{ ( std::int64_t{ 1 } << ( SPAN_SHIFTS[LEVELS - 1] + BUCKET_BITS ) ) - ( std::int64_t{ 1 } << SPAN_SHIFTS[LEVELS - 1] ) };
+		constexpr auto maxExpiration{ std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::nanoseconds{ maxDelay } ) };
+
+		const auto deadlineAfter{ [this, maxExpiration]( std::chrono::steady_clock::time_point start, std::chrono::milliseconds expiration ) {
+			return toNanos( start ) + std::chrono::duration_cast<std::chrono::nanoseconds>( std::min( expiration + m_grace, maxExpiration ) ).count();
+		} };
+
+		std::int64_t expiry{ 0 };
+		switch ( entry->expirationMode )
 		{
-			m_lruHead = entry->lruNext;
+			case ExpirationMode::Absolute:
+			{
+				expiry = deadlineAfter( entry->writeTime, entry->absoluteExpiration );
+				break;
+			}
+			case ExpirationMode::SlidingAndAbsolute:
+			{
+				expiry = std::min( deadlineAfter( entry->lastAccessed, entry->slidingExpiration ), deadlineAfter( entry->writeTime, entry->absoluteExpiration ) );
+				break;
+			}
+			default:
+			{
+				expiry = deadlineAfter( entry->lastAccessed, entry->slidingExpiration );
+				break;
+			}
 		}
 
-		if ( entry->lruNext != nullptr )
+		const std::int64_t deadline{ std::min( expiry, reference + maxDelay ) };
+
+		std::size_t level{ 0 };
+		std::int64_t position{ reference };
+		if ( deadline > reference )
 		{
-			entry->lruNext->lruPrev = entry->lruPrev;
+			const std::int64_t delay{ deadline - reference };
+			while ( level + 1 < LEVELS && delay >= ( std::int64_t{ 1 } << ( SPAN_SHIFTS[level] + BUCKET_BITS ) ) )
+			{
+				++level;
+			}
+
+			position = deadline;
 		}
-		else
+
+		CacheEntry*& head{ m_buckets[level][( static_cast<std::uint64_t>( position ) >> SPAN_SHIFTS[level] ) & ( BUCKETS - 1 )] };
+
+		entry->expiryNext = head;
+		if ( head != nullptr )
 		{
-			m_lruTail = entry->lruPrev;
+			head->expiryPrevNext = &entry->expiryNext;
 		}
 
-		entry->lruNext = nullptr;
-		entry->lruPrev = nullptr;
+		entry->expiryPrevNext = &head;
+		head = entry;
 	}
 
-	template <typename TKey, typename TValue>
-	inline void LruCache<TKey, TValue>::moveToLruHead( CacheEntry* entry ) noexcept
+	//=====================================================================
+	// TransparentStringHash
+	//=====================================================================
+
+	inline std::size_t TransparentStringHash::operator()( std::string_view value ) const noexcept
 	{
-		if ( entry == m_lruHead )
-		{
-			return;
-		}
+		return std::hash<std::string_view>{}( value );
+	}
+
+	//=====================================================================
+	// LruCache
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
 
-		removeFromLru( entry );
-		addToLruHead( entry );
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::LruCache( const LruCacheOptions& options )
+		: LruCache{ options, nullptr }
+	{
 	}
 
-	template <typename TKey, typename TValue>
-	inline void LruCache<TKey, TValue>::evictLeastRecentlyUsed()
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::LruCache( const LruCacheOptions& options, SizeFunction sizer, RemovalListener listener )
+		: m_mutex{ options.readOptimized() },
+		  m_slabPool{ options.slabStorage()
+						  ? std::make_unique<SlabPool>( options.sizeLimit(), sizeof( typename EntryMap::value_type ) )
+						  : nullptr },
+		  m_cache{ 0, Hash{}, KeyEqual{}, EntryAllocator{ m_slabPool.get() } },
+		  m_options{ options },
+		  m_policy{ options.sizeLimit() },
+		  m_lastCleanupTime{ Clock::now() },
+		  m_cleanupBudget{ options.cleanupBudget() },
+		  m_expiryWheel{ m_lastCleanupTime, options.staleWhileRevalidate() },
+		  m_sizer{ std::move( sizer ) },
+		  m_removalListener{ std::move( listener ) },
+		  m_backgroundTasks{ 0 },
+		  m_memoryUsage{ 0 },
+		  m_oldestTombstone{ nullptr },
+		  m_newestTombstone{ nullptr },
+		  m_oldestDemoted{ nullptr },
+		  m_newestDemoted{ nullptr },
+		  m_secondTierMemoryUsage{ 0 },
+		  m_secondTierWheel{ m_lastCleanupTime },
+		  m_readBufferMask{ 0 }
 	{
-		if ( m_lruTail == nullptr )
+		if ( m_options.secondTierMemoryLimit() > 0 && !SECOND_TIER_SUPPORTED )
 		{
-			return;
+			throw std::invalid_argument{ "Second tier requires a SnapshotSerializer for the value type" };
+		}
+
+		if ( m_options.sizeLimit() > 0 )
+		{
+			m_cache.reserve( m_options.sizeLimit() );
+		}
+
+		if ( m_options.readOptimized() )
+		{
+			const std::size_t stripes{ std::min( std::bit_ceil( std::max<std::size_t>( std::thread::hardware_concurrency(), 1 ) ), MAX_READ_BUFFER_STRIPES ) };
+
+			m_readBuffers = std::make_unique<ReadBuffer[]>( stripes );
+			m_readBufferMask = stripes - 1;
+		}
+
+		MaintenanceScheduler* scheduler{ m_options.maintenanceScheduler() };
+		if ( scheduler == nullptr && m_options.maintenanceThread() )
+		{
+			m_ownScheduler = std::make_unique<MaintenanceScheduler>();
+			scheduler = m_ownScheduler.get();
 		}
 
-		const TKey* keyPtr{ static_cast<const TKey*>( m_lruTail->keyPtr ) };
-		if ( keyPtr != nullptr )
+		if ( scheduler != nullptr )
 		{
-			removeFromLru( m_lruTail );
-			m_cache.erase( *keyPtr );
+			const auto interval{ m_options.backgroundCleanupInterval().count() > 0 ? m_options.backgroundCleanupInterval() : DEFAULT_MAINTENANCE_INTERVAL };
+
+			m_maintenance = scheduler->schedule( interval, [this]() { performMaintenance(); } );
 		}
 	}
 
 	//----------------------------------------------
-	// Background cleanup implementation
+	// Destruction
 	//----------------------------------------------
 
-	template <typename TKey, typename TValue>
-	inline void LruCache<TKey, TValue>::checkAndPerformBackgroundCleanup()
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::~LruCache()
 	{
-		// Skip if background cleanup is disabled
-		if ( m_options.backgroundCleanupInterval().count() <= 0 )
-		{
-			return;
-		}
+		// Pending reloads and asynchronous loads hold a pointer to this cache
+		std::unique_lock<CacheMutex> lock{ m_mutex };
+		m_loadSignal.wait( lock, [this]() { return m_backgroundTasks == 0; } );
+	}
 
-		auto now = std::chrono::steady_clock::now();
-		auto timeSinceLastCleanup = now - m_lastCleanupTime;
+	//----------------------------------------------
+	// Cache operations
+	//----------------------------------------------
 
-		if ( timeSinceLastCleanup >= m_options.backgroundCleanupInterval() )
-		{
-			m_lastCleanupTime = now;
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <EntryLoader<TValue> Factory, EntryConfigurator Configure>
+	inline TValue* LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::get( const TKey& key, Factory&& factory, Configure&& configure )
+	{
+		CachedItem* item{ getImpl( key, factory, configure, false ) };
 
-			// Perform incremental cleanup of expired entries
-			size_t cleanedCount = 0;
+		return item != nullptr ? &item->value : nullptr;
+	}
 
-			auto it = m_cache.begin();
-			while ( it != m_cache.end() && cleanedCount < MAX_CLEANUP_PER_CYCLE )
-			{
-				if ( it->second.metadata.isExpired() )
-				{
-					removeFromLru( &it->second.metadata );
-					it = m_cache.erase( it );
-					++cleanedCount;
-				}
-				else
-				{
-					++it;
-				}
-			}
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K, EntryLoader<TValue> Factory, EntryConfigurator Configure>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline TValue* LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::get( const K& key, Factory&& factory, Configure&& configure )
+	{
+		CachedItem* item{ getImpl( key, factory, configure, false ) };
+
+		return item != nullptr ? &item->value : nullptr;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <EntryLoader<TValue> Factory, EntryConfigurator Configure>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getPinned( const TKey& key, Factory&& factory, Configure&& configure )
+	{
+		CachedItem* item{ getImpl( key, factory, configure, true ) };
+
+		return item != nullptr ? ValueHandle{ this, &item->value, &item->metadata } : ValueHandle{};
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K, EntryLoader<TValue> Factory, EntryConfigurator Configure>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getPinned( const K& key, Factory&& factory, Configure&& configure )
+	{
+		CachedItem* item{ getImpl( key, factory, configure, true ) };
+
+		return item != nullptr ? ValueHandle{ this, &item->value, &item->metadata } : ValueHandle{};
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getMany( std::span<const TKey> keys, std::span<TValue*> results, BatchFactoryFunction factory, ConfigFunction configure )
+	{
+		return getManyImpl( keys, results, std::move( factory ), std::move( configure ) );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <std::ranges::contiguous_range Keys>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getMany( const Keys& keys, std::span<TValue*> results, BatchFactoryFunction factory, ConfigFunction configure )
+	{
+		return getManyImpl( std::span<const std::ranges::range_value_t<Keys>>{ keys }, results, std::move( factory ), std::move( configure ) );
+	}
+
+	//----------------------------------------------
+	// Asynchronous operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <EntryFactory<TValue> Factory>
+		requires std::copy_constructible<std::remove_cvref_t<Factory>>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::GetAwaitable LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getAsync( const TKey& key, Factory&& factory )
+	{
+		if ( CachedItem* item{ findAsync( key, factory ) } )
+		{
+			return GetAwaitable{ *this, ValueHandle{ this, &item->value, &item->metadata } };
+		}
+
+		// Registered with the load only once awaited, when the coroutine handle is known
+		return GetAwaitable{ *this, std::make_unique<AsyncWaiter>( key, FactoryFunction{ std::forward<Factory>( factory ) } ) };
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <EntryFactory<TValue> Factory>
+		requires std::copy_constructible<std::remove_cvref_t<Factory>>
+	inline std::future<typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle> LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getFuture( const TKey& key, Factory&& factory )
+	{
+		if ( CachedItem* item{ findAsync( key, factory ) } )
+		{
+			std::promise<ValueHandle> promise;
+			promise.set_value( ValueHandle{ this, &item->value, &item->metadata } );
+
+			return promise.get_future();
+		}
+
+		auto waiter{ std::make_unique<AsyncWaiter>( key, FactoryFunction{ std::forward<Factory>( factory ) } ) };
+		std::future<ValueHandle> future{ waiter->promise.emplace().get_future() };
+
+		if ( awaitLoad( *waiter ) )
+		{
+			waiter.release(); // Owned by the load from now on, and possibly already resumed and destroyed
+		}
+		else
+		{
+			resumeWaiter( waiter.release() );
+		}
+
+		return future;
+	}
+
+	//----------------------------------------------
+	// Lookup operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline TValue* LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::find( const TKey& key )
+	{
+		CachedItem* item{ findImpl( key, false ) };
+
+		return item != nullptr ? &item->value : nullptr;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline TValue* LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::find( const K& key )
+	{
+		CachedItem* item{ findImpl( key, false ) };
+
+		return item != nullptr ? &item->value : nullptr;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::findPinned( const TKey& key )
+	{
+		CachedItem* item{ findImpl( key, true ) };
+
+		return item != nullptr ? ValueHandle{ this, &item->value, &item->metadata } : ValueHandle{};
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::findPinned( const K& key )
+	{
+		CachedItem* item{ findImpl( key, true ) };
+
+		return item != nullptr ? ValueHandle{ this, &item->value, &item->metadata } : ValueHandle{};
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::findMany( std::span<const TKey> keys, std::span<TValue*> results )
+	{
+		return findManyImpl( keys, results );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <std::ranges::contiguous_range Keys>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::findMany( const Keys& keys, std::span<TValue*> results )
+	{
+		return findManyImpl( std::span<const std::ranges::range_value_t<Keys>>{ keys }, results );
+	}
+
+	//----------------------------------------------
+	// Modification operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename V, EntryConfigurator Configure>
+		requires std::constructible_from<TValue, V>
+	inline TValue* LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::set( const TKey& key, V&& value, Configure&& configure )
+	{
+		return &storeImpl( key, true, configure, std::forward<V>( value ) ).first->value;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename V>
+		requires std::constructible_from<TValue, V>
+	inline std::pair<TValue*, bool> LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::insertOrAssign( const TKey& key, V&& value )
+	{
+		std::nullptr_t configure{ nullptr };
+		auto [item, inserted]{ storeImpl( key, true, configure, std::forward<V>( value ) ) };
+
+		return { &item->value, inserted };
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename... Args>
+		requires std::constructible_from<TValue, Args...>
+	inline std::pair<TValue*, bool> LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::emplace( const TKey& key, Args&&... args )
+	{
+		std::nullptr_t configure{ nullptr };
+		auto [item, inserted]{ storeImpl( key, false, configure, std::forward<Args>( args )... ) };
+
+		return { &item->value, inserted };
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::remove( const TKey& key )
+	{
+		return removeImpl( key );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::remove( const K& key )
+	{
+		return removeImpl( key );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::removeMany( std::span<const TKey> keys )
+	{
+		return removeManyImpl( keys );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <std::ranges::contiguous_range Keys>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::removeMany( const Keys& keys )
+	{
+		return removeManyImpl( std::span<const std::ranges::range_value_t<Keys>>{ keys } );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::clear()
+	{
+		ExclusiveLock lock{ *this };
+		drainReadBuffers();
+
+		// Pinned entries outlive the clear until their handles are dropped; with a listener every
+		// entry is detached one by one so it can be reported
+		for ( auto it{ m_cache.begin() }; it != m_cache.end(); )
+		{
+			it = m_removalListener || isPinned( it->second.metadata ) ? detachEntry( it, RemovalCause::Cleared ) : std::next( it );
+		}
+
+		const auto now{ Clock::now() };
+
+		m_cache.clear();
+		m_policy.clear();
+		m_expiryWheel.clear( now );
+		m_memoryUsage = 0;
+
+		m_tombstones.clear();
+		m_oldestTombstone = nullptr;
+		m_newestTombstone = nullptr;
+
+		m_secondTier.clear();
+		m_oldestDemoted = nullptr;
+		m_newestDemoted = nullptr;
+		m_secondTierMemoryUsage = 0;
+		m_secondTierWheel.clear( now );
+		m_demotions.clear();
+		for ( std::vector<Demotion>* batch : m_demotionBatches )
+		{
+			for ( Demotion& demotion : *batch )
+			{
+				demotion.cancelled = true;
+			}
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::size() const
+	{
+		std::shared_lock<CacheMutex> lock{ m_mutex };
+
+		return m_cache.size();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::memoryUsage() const
+	{
+		std::shared_lock<CacheMutex> lock{ m_mutex };
+
+		return m_memoryUsage;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::tombstoneCount() const
+	{
+		std::shared_lock<CacheMutex> lock{ m_mutex };
+
+		return m_tombstones.size();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::secondTierSize() const
+	{
+		std::shared_lock<CacheMutex> lock{ m_mutex };
+
+		return m_secondTier.size();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::secondTierMemoryUsage() const
+	{
+		std::shared_lock<CacheMutex> lock{ m_mutex };
+
+		return m_secondTierMemoryUsage;
+	}
+
+	//----------------------------------------------
+	// State inspection
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::isEmpty() const
+	{
+		std::shared_lock<CacheMutex> lock{ m_mutex };
+
+		return m_cache.empty();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline CacheStats LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::stats() const noexcept
+	{
+		return m_stats.snapshot();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::cleanupExpired()
+	{
+		ExclusiveLock lock{ *this };
+		drainReadBuffers();
+
+		const auto now{ Clock::now() };
+		m_stats.recordExpirations( m_expiryWheel.advance( now, std::numeric_limits<std::size_t>::max(), [this]( CacheEntry* entry ) { eraseEntry( entry, RemovalCause::Expired ); } ) );
+		purgeTombstones( now );
+		purgeDemoted( now );
+	}
+
+	//----------------------------------------------
+	// Snapshots
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename KeySerializer, typename ValueSerializer>
+		requires SnapshotCodec<KeySerializer, TKey> && SnapshotCodec<ValueSerializer, TValue>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::saveSnapshot( std::ostream& out )
+	{
+		{
+			// Apply the recorded hits so lastAccessed reflects every read
+			ExclusiveLock lock{ *this };
+			drainReadBuffers();
+		}
+
+		std::shared_lock<CacheMutex> lock{ m_mutex };
+		const auto now{ Clock::now() };
+
+		std::vector<const typename EntryMap::value_type*> entries;
+		entries.reserve( m_cache.size() );
+		for ( const auto& entry : m_cache )
+		{
+			if ( !entry.second.metadata.isExpired( now ) )
+			{
+				entries.push_back( &entry );
+			}
+		}
+
+		// Least recently used first, whatever order the policy keeps, so that inserting the
+		// records in file order rebuilds the recency order
+		std::ranges::sort( entries, {}, []( const auto* entry ) { return entry->second.metadata.lastAccessed; } );
+
+		SnapshotHeader{ entries.size() }.write( out );
+
+		std::vector<std::byte> buffer;
+		for ( const auto* entry : entries )
+		{
+			const CacheEntry& metadata{ entry->second.metadata };
+
+			buffer.clear();
+			KeySerializer::write( buffer, entry->first );
+			const std::size_t keyBytes{ buffer.size() };
+			ValueSerializer::write( buffer, entry->second.value );
+			const std::size_t valueBytes{ buffer.size() - keyBytes };
+
+			if ( keyBytes > std::numeric_limits<std::uint32_t>::max() || valueBytes > std::numeric_limits<std::uint32_t>::max() )
+			{
+				throw std::length_error{ "Serialized snapshot key or value exceeds 4 GiB" };
+			}
+
+			const SnapshotRecord record{
+				std::chrono::duration_cast<std::chrono::nanoseconds>( metadata.lastAccessed + metadata.slidingExpiration - now ).count(),
+				metadata.slidingExpiration.count(),
+				std::chrono::duration_cast<std::chrono::nanoseconds>( now - metadata.writeTime ).count(),
+				metadata.absoluteExpiration.count(),
+				metadata.size,
+				static_cast<std::uint32_t>( keyBytes ),
+				static_cast<std::uint32_t>( valueBytes ),
+				static_cast<std::uint8_t>( metadata.expirationMode ),
+				{} };
+
+			out.write( reinterpret_cast<const char*>( &record ), sizeof( record ) );
+			out.write( reinterpret_cast<const char*>( buffer.data() ), static_cast<std::streamsize>( buffer.size() ) );
+		}
+
+		out.flush();
+		if ( !out )
+		{
+			throw std::runtime_error{ "Failed to write cache snapshot" };
+		}
+
+		return entries.size();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename KeySerializer, typename ValueSerializer>
+		requires SnapshotCodec<KeySerializer, TKey> && SnapshotCodec<ValueSerializer, TValue>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::saveSnapshot( const std::filesystem::path& path )
+	{
+		std::filesystem::path temporary{ path };
+		temporary += ".tmp";
+
+		std::size_t written{ 0 };
+		{
+			std::vector<char> buffer( SNAPSHOT_FILE_BUFFER );
+			std::ofstream file;
+			file.rdbuf()->pubsetbuf( buffer.data(), static_cast<std::streamsize>( buffer.size() ) );
+			file.open( temporary, std::ios::binary | std::ios::trunc );
+			if ( !file )
+			{
+				throw std::runtime_error{ "Cannot create cache snapshot file" };
+			}
+
+			try
+			{
+				written = saveSnapshot<KeySerializer, ValueSerializer>( file );
+				file.close();
+				if ( !file )
+				{
+					throw std::runtime_error{ "Failed to write cache snapshot" };
+				}
+			}
+			catch ( ... )
+			{
+				file.close();
+				std::error_code ignored;
+				std::filesystem::remove( temporary, ignored );
+
+				throw;
+			}
+		}
+
+		std::filesystem::rename( temporary, path );
+
+		return written;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename KeySerializer, typename ValueSerializer>
+		requires SnapshotCodec<KeySerializer, TKey> && SnapshotCodec<ValueSerializer, TValue>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::loadSnapshot( std::istream& in, std::size_t threads )
+	{
+		const SnapshotHeader header{ SnapshotHeader::read( in ) };
+		const std::size_t sizeLimit{ m_options.sizeLimit() };
+
+		// Counts and lengths come from the file: they are checked against the bytes left when the stream can tell
+		std::uint64_t available{ std::numeric_limits<std::uint64_t>::max() };
+		if ( const auto start{ in.tellg() }; start != std::istream::pos_type( -1 ) && in.seekg( 0, std::ios::end ) )
+		{
+			available = static_cast<std::uint64_t>( in.tellg() - start );
+			in.seekg( start );
+		}
+		in.clear();
+
+		const auto readRecord{ [&in, &available]( SnapshotRecord& record ) {
+			in.read( reinterpret_cast<char*>( &record ), sizeof( record ) );
+			if ( !in || available < sizeof( record ) )
+			{
+				throw std::runtime_error{ "Truncated cache snapshot" };
+			}
+
+			available -= sizeof( record );
+			const std::uint64_t length{ std::uint64_t{ record.keyBytes } + record.valueBytes };
+			if ( length > available )
+			{
+				throw std::runtime_error{ "Truncated cache snapshot" };
+			}
+
+			available -= length;
+		} };
+
+		// The oldest records would be evicted by the newer ones as soon as they are inserted
+		const std::uint64_t skipped{ sizeLimit > 0 && header.count > sizeLimit ? header.count - sizeLimit : 0 };
+		for ( std::uint64_t i{ 0 }; i < skipped; ++i )
+		{
+			SnapshotRecord record;
+			readRecord( record );
+			in.ignore( static_cast<std::streamsize>( record.keyBytes ) + record.valueBytes );
+		}
+
+		std::uint64_t remaining{ header.count - skipped };
+		{
+			// Bounded by the records the stream can hold, or a chunk when its size is unknown
+			const std::uint64_t expected{ std::min<std::uint64_t>( remaining, available == std::numeric_limits<std::uint64_t>::max() ? SNAPSHOT_LOAD_CHUNK : available / sizeof( SnapshotRecord ) ) };
+
+			ExclusiveLock lock{ *this };
+			m_cache.reserve( m_cache.size() + static_cast<std::size_t>( expected ) );
+		}
+
+		// Expirations resume from a single point in time, which keeps the saved recency order
+		const auto loadTime{ Clock::now() };
+
+		std::vector<SnapshotRecord> records;
+		std::vector<std::size_t> offsets;
+		std::vector<std::byte> bytes;
+		std::vector<std::optional<TKey>> keys;
+		std::vector<std::optional<TValue>> values;
+		std::size_t inserted{ 0 };
+
+		const auto decode{ [&]( std::size_t begin, std::size_t end ) {
+			for ( std::size_t i{ begin }; i < end; ++i )
+			{
+				const std::span<const std::byte> record{ bytes.data() + offsets[i], records[i].keyBytes + std::size_t{ records[i].valueBytes } };
+
+				keys[i].emplace( KeySerializer::read( record.first( records[i].keyBytes ) ) );
+				values[i].emplace( ValueSerializer::read( record.subspan( records[i].keyBytes ) ) );
+			}
+		} };
+
+		while ( remaining > 0 )
+		{
+			const std::size_t count{ static_cast<std::size_t>( std::min<std::uint64_t>( remaining, SNAPSHOT_LOAD_CHUNK ) ) };
+			remaining -= count;
+
+			records.resize( count );
+			offsets.resize( count );
+			bytes.clear();
+			for ( std::size_t i{ 0 }; i < count; ++i )
+			{
+				readRecord( records[i] );
+				if ( records[i].expirationMode > static_cast<std::uint8_t>( ExpirationMode::SlidingAndAbsolute ) )
+				{
+					throw std::runtime_error{ "Corrupt cache snapshot record" };
+				}
+
+				// Grown as the bytes arrive, so a corrupt length in a stream of unknown size fails as truncated
+				offsets[i] = bytes.size();
+				std::size_t length{ std::size_t{ records[i].keyBytes } + records[i].valueBytes };
+				while ( length > 0 )
+				{
+					const std::size_t step{ std::min( length, SNAPSHOT_FILE_BUFFER ) };
+					bytes.resize( bytes.size() + step );
+					in.read( reinterpret_cast<char*>( bytes.data() + bytes.size() - step ), static_cast<std::streamsize>( step ) );
+					if ( !in )
+					{
+						throw std::runtime_error{ "Truncated cache snapshot" };
+					}
+
+					length -= step;
+				}
+			}
+
+			keys.clear();
+			keys.resize( count );
+			values.clear();
+			values.resize( count );
+
+			// User decoding code runs without the lock, split across threads for large chunks
+			const std::size_t workers{ std::clamp<std::size_t>( count / SNAPSHOT_RECORDS_PER_THREAD, 1, std::max<std::size_t>( threads, 1 ) ) };
+			if ( workers == 1 )
+			{
+				decode( 0, count );
+			}
+			else
+			{
+				std::vector<std::exception_ptr> errors( workers );
+				{
+					std::vector<std::jthread> pool;
+					pool.reserve( workers - 1 );
+					for ( std::size_t w{ 1 }; w < workers; ++w )
+					{
+						pool.emplace_back( [&, w] {
+							try
+							{
+								decode( count * w / workers, count * ( w + 1 ) / workers );
+							}
+							catch ( ... )
+							{
+								errors[w] = std::current_exception();
+							}
+						} );
+					}
+
+					try
+					{
+						decode( 0, count / workers );
+					}
+					catch ( ... )
+					{
+						errors[0] = std::current_exception();
+					}
+				}
+
+				for ( const std::exception_ptr& error : errors )
+				{
+					if ( error )
+					{
+						std::rethrow_exception( error );
+					}
+				}
+			}
+
+			ExclusiveLock lock{ *this };
+			drainReadBuffers();
+
+			for ( std::size_t i{ 0 }; i < count; ++i )
+			{
+				// A key being loaded gets the newer value from its factory
+				if ( m_cache.find( *keys[i] ) != m_cache.end() || findPendingLoad( *keys[i] ) != nullptr )
+				{
+					continue;
+				}
+
+				CacheEntry metadata{ std::chrono::milliseconds{ records[i].slidingExpiration } };
+				metadata.absoluteExpiration = std::chrono::milliseconds{ records[i].absoluteExpiration };
+				metadata.expirationMode = static_cast<ExpirationMode>( records[i].expirationMode );
+				metadata.size = static_cast<std::size_t>( records[i].size );
+				metadata.lastAccessed = loadTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::nanoseconds{ records[i].remaining } ) - metadata.slidingExpiration;
+				metadata.writeTime = loadTime - std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::nanoseconds{ records[i].age } );
+				insertEntry( *keys[i], std::move( *values[i] ), std::move( metadata ) );
+				++inserted;
+			}
+		}
+
+		return inserted;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename KeySerializer, typename ValueSerializer>
+		requires SnapshotCodec<KeySerializer, TKey> && SnapshotCodec<ValueSerializer, TValue>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::loadSnapshot( const std::filesystem::path& path, std::size_t threads )
+	{
+		std::vector<char> buffer( SNAPSHOT_FILE_BUFFER );
+		std::ifstream file;
+		file.rdbuf()->pubsetbuf( buffer.data(), static_cast<std::streamsize>( buffer.size() ) );
+		file.open( path, std::ios::binary );
+		if ( !file )
+		{
+			throw std::runtime_error{ "Cannot open cache snapshot file" };
+		}
+
+		return loadSnapshot<KeySerializer, ValueSerializer>( file, threads );
+	}
+
+	//----------------------------------------------
+	// Operations by lookup key
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K, typename Factory, typename Configure>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CachedItem* LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getImpl( const K& key, Factory& factory, Configure& configure, bool pin )
+	{
+		// Single clock read shared by the lookup, expiration check, renewal and cleanup check
+		auto now{ Clock::now() };
+
+		CachedItem* sharedHit{ nullptr };
+		if ( tryFindShared( key, now, pin, sharedHit ) && sharedHit != nullptr )
+		{
+			m_stats.recordHits( 1 );
+
+			return sharedHit;
+		}
+
+		ExclusiveLock lock{ *this };
+		drainReadBuffers();
+
+		// Check for background cleanup opportunity
+		checkAndPerformBackgroundCleanup( now );
+
+		// Entries found after waiting for another thread's load belong to the same miss
+		bool missed{ false };
+
+		while ( true )
+		{
+			auto it = m_cache.find( key );
+			if ( it != m_cache.end() )
+			{
+				if ( CachedItem* item{ serveCached( it, now, factory, configure, pin ) } )
+				{
+					if ( !missed )
+					{
+						m_stats.recordHits( 1 );
+					}
+
+					return item;
+				}
+			}
+			else if ( isKnownAbsent( key, now ) )
+			{
+				if ( !missed )
+				{
+					m_stats.recordHits( 1 );
+				}
+
+				return nullptr;
+			}
+
+			if ( !missed )
+			{
+				m_stats.recordMisses( 1 );
+				missed = true;
+			}
+
+			PendingLoad* pending{ findPendingLoad( key ) };
+			if ( pending == nullptr )
+			{
+				break;
+			}
+
+			// Another thread is already loading this key: wait for it instead of running a duplicate factory
+			++pending->waiterCount;
+			m_loadSignal.wait( lock, [pending]() { return pending->completed; } );
+
+			std::exception_ptr error{ pending->error };
+			const bool absent{ pending->absent };
+			if ( --pending->waiterCount == 0 )
+			{
+				m_loadSignal.notify_all(); // Let the loader return and release its state
+			}
+
+			drainReadBuffers();
+			now = Clock::now(); // The wait may have been long
+
+			if ( error )
+			{
+				std::rethrow_exception( error );
+			}
+
+			if ( absent )
+			{
+				return nullptr;
+			}
+
+			// Loop to pick up the loaded entry (or load again if it was evicted in the meantime)
+		}
+
+		// Heterogeneous lookups build the key only now that it is going to be inserted
+		std::optional<TKey> ownedKey;
+		const TKey* loadKey{ nullptr };
+		if constexpr ( std::is_same_v<K, TKey> )
+		{
+			loadKey = &key;
+		}
+		else
+		{
+			loadKey = &ownedKey.emplace( key );
+		}
+
+		PendingLoad pending{ loadKey };
+		addPendingLoad( pending );
+
+		// A value kept in the second tier is promoted instead of being loaded again
+		Promotion promotion{ loadKey };
+		const bool promoting{ takeDemoted( key, now, promotion ) };
+
+		// Run user code without holding the lock so other keys stay accessible
+		lock.unlock();
+
+		if ( promoting && restoreDemoted( promotion, Clock::now() ) )
+		{
+			lock.lock();
+			drainReadBuffers();
+
+			CachedItem* result{ acquire( insertEntry( *loadKey, std::move( *promotion.value ), std::move( promotion.metadata ) ), pin ) };
+			completePendingLoads( lock, { &pending, 1 }, nullptr );
+
+			return result;
+		}
+
+		std::optional<TValue> value;
+		CacheEntry metadata{ newEntryMetadata() };
+		const auto loadStart{ m_stats.loadStart() };
+
+		bool loaded{ false };
+
+		try
+		{
+			if constexpr ( OptionalEntryFactory<Factory, TValue> )
+			{
+				if ( auto result{ factory() } )
+				{
+					value.emplace( std::move( *result ) );
+				}
+			}
+			else
+			{
+				value.emplace( factory() );
+			}
+
+			loaded = true;
+			m_stats.recordLoad( loadStart, false );
+
+			if ( value )
+			{
+				metadata.resetTimestamps( Clock::now() ); // Expiration starts once the value exists, not when loading began
+
+				if ( m_sizer )
+				{
+					metadata.size = m_sizer( *loadKey, *value );
+				}
+
+				configureEntry( configure, metadata );
+			}
+		}
+		catch ( ... )
+		{
+			if ( !loaded )
+			{
+				m_stats.recordLoad( loadStart, true );
+			}
+
+			lock.lock();
+			drainReadBuffers();
+			completePendingLoads( lock, { &pending, 1 }, std::current_exception() );
+
+			throw;
+		}
+
+		lock.lock();
+		drainReadBuffers();
+
+		if constexpr ( OptionalEntryFactory<Factory, TValue> )
+		{
+			if ( !value )
+			{
+				addTombstone( *loadKey );
+				forgetDemoted( *loadKey ); // A value on its way to the second tier is stale now
+				pending.absent = true;
+				completePendingLoads( lock, { &pending, 1 }, nullptr );
+
+				return nullptr;
+			}
+		}
+
+		// Pinned before completePendingLoads() releases the lock to wait for the waiters
+		CachedItem* result{ acquire( insertEntry( *loadKey, std::move( *value ), std::move( metadata ) ), pin ) };
+		completePendingLoads( lock, { &pending, 1 }, nullptr );
+
+		return result;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getManyImpl( std::span<const K> keys, std::span<TValue*> results, BatchFactoryFunction factory, ConfigFunction configure )
+	{
+		auto now{ Clock::now() };
+
+		ExclusiveLock lock{ *this };
+		drainReadBuffers();
+
+		// Check for background cleanup opportunity
+		checkAndPerformBackgroundCleanup( now );
+
+		std::vector<std::size_t> missing;
+		bool scanned{ false };
+
+		while ( true )
+		{
+			missing.clear();
+			PendingLoad* inFlight{ nullptr };
+
+			lookupBatch( keys, [&]( std::size_t i, typename EntryMap::iterator it ) {
+				results[i] = nullptr;
+
+				if ( it != m_cache.end() )
+				{
+					if ( !it->second.metadata.isExpired( now ) )
+					{
+						it->second.metadata.touch( now );
+						m_policy.onAccess( &it->second.metadata, entryHasher() );
+						results[i] = &it->second.value;
+
+						return;
+					}
+
+					eraseEntry( it, RemovalCause::Expired );
+					m_stats.recordExpirations( 1 );
+				}
+				else if ( isKnownAbsent( keys[i], now ) )
+				{
+					return; // Known to have no value: a hit, left null
+				}
+
+				missing.push_back( i );
+				if ( inFlight == nullptr )
+				{
+					inFlight = findPendingLoad( keys[i] );
+				}
+			} );
+
+			// Rescans after waiting for other loads resolve the same lookups again
+			if ( !scanned )
+			{
+				m_stats.recordHits( keys.size() - missing.size() );
+				m_stats.recordMisses( missing.size() );
+				scanned = true;
+			}
+
+			if ( inFlight == nullptr )
+			{
+				break;
+			}
+
+			// Another thread is already loading one of the keys: wait for it, then scan the batch again
+			++inFlight->waiterCount;
+			m_loadSignal.wait( lock, [inFlight]() { return inFlight->completed; } );
+
+			std::exception_ptr error{ inFlight->error };
+			if ( --inFlight->waiterCount == 0 )
+			{
+				m_loadSignal.notify_all(); // Let the loader return and release its state
+			}
+
+			drainReadBuffers();
+			now = Clock::now(); // The wait may have been long
+
+			if ( error )
+			{
+				std::rethrow_exception( error );
+			}
+		}
+
+		if ( missing.empty() )
+		{
+			return 0;
+		}
+
+		// Register one load per distinct missing key; the reservations keep the key and load addresses stable
+		std::vector<TKey> loadKeys;
+		std::vector<PendingLoad> loads;
+		loadKeys.reserve( missing.size() );
+		loads.reserve( missing.size() );
+
+		try
+		{
+			for ( const std::size_t i : missing )
+			{
+				if ( findPendingLoad( keys[i] ) == nullptr )
+				{
+					loadKeys.emplace_back( keys[i] );
+					loads.push_back( PendingLoad{ &loadKeys.back() } );
+					addPendingLoad( loads.back() );
+				}
+			}
+		}
+		catch ( ... )
+		{
+			forgetPendingLoads( loads );
+
+			throw;
+		}
+
+		// Keys kept in the second tier are promoted instead of being passed to the factory
+		std::vector<Promotion> promotions;
+		if ( !m_secondTier.empty() )
+		{
+			for ( const TKey& key : loadKeys )
+			{
+				Promotion promotion{ &key };
+				if ( takeDemoted( key, now, promotion ) )
+				{
+					promotions.push_back( std::move( promotion ) );
+				}
+			}
+		}
+
+		// Run user code without holding the lock so other keys stay accessible
+		lock.unlock();
+
+		std::span<const TKey> factoryKeys{ loadKeys };
+		std::vector<TKey> reloadKeys;
+		std::vector<TValue> values;
+		std::vector<CacheEntry> metadata;
+		const auto loadStart{ m_stats.loadStart() };
+		bool loaded{ false };
+
+		try
+		{
+			if ( !promotions.empty() )
+			{
+				const auto restored{ Clock::now() };
+				auto promotion{ promotions.begin() };
+
+				// Promotions follow the order of loadKeys; the keys not restored go to the factory
+				for ( const TKey& key : loadKeys )
+				{
+					if ( promotion != promotions.end() && promotion->key == &key && restoreDemoted( *promotion++, restored ) )
+					{
+						continue;
+					}
+
+					reloadKeys.push_back( key );
+				}
+
+				factoryKeys = reloadKeys;
+			}
+
+			if ( !factoryKeys.empty() )
+			{
+				values = factory( factoryKeys );
+				m_stats.recordLoad( loadStart, false );
+			}
+			loaded = true;
+
+			if ( values.size() != factoryKeys.size() )
+			{
+				throw std::length_error{ "Batch factory must return one value per key" };
+			}
+
+			// Expiration starts once the values exist, not when loading began
+			const auto loadedAt{ Clock::now() };
+
+			metadata.reserve( values.size() );
+			for ( std::size_t j{ 0 }; j < values.size(); ++j )
+			{
+				CacheEntry& entry{ metadata.emplace_back( newEntryMetadata() ) };
+				entry.resetTimestamps( loadedAt );
+
+				if ( m_sizer )
+				{
+					entry.size = m_sizer( factoryKeys[j], values[j] );
+				}
+
+				if ( configure )
+				{
+					configure( entry );
+				}
+			}
+		}
+		catch ( ... )
+		{
+			if ( !loaded )
+			{
+				m_stats.recordLoad( loadStart, true );
+			}
+
+			lock.lock();
+			drainReadBuffers();
+			completePendingLoads( lock, loads, std::current_exception() );
+
+			throw;
+		}
+
+		lock.lock();
+		drainReadBuffers();
+
+		try
+		{
+			for ( std::size_t j{ 0 }; j < values.size(); ++j )
+			{
+				insertEntry( factoryKeys[j], std::move( values[j] ), std::move( metadata[j] ) );
+			}
+
+			for ( Promotion& promotion : promotions )
+			{
+				if ( promotion.value )
+				{
+					insertEntry( *promotion.key, std::move( *promotion.value ), std::move( promotion.metadata ) );
+				}
+			}
+		}
+		catch ( ... )
+		{
+			completePendingLoads( lock, loads, std::current_exception() );
+
+			throw;
+		}
+
+		// Resolve every missing position, duplicates included, while the lock is still held
+		for ( const std::size_t i : missing )
+		{
+			auto it{ m_cache.find( keys[i] ) };
+			results[i] = it != m_cache.end() ? &it->second.value : nullptr;
+		}
+
+		completePendingLoads( lock, loads, nullptr );
+
+		return factoryKeys.size();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CachedItem* LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::findImpl( const K& key, bool pin )
+	{
+		const auto now{ Clock::now() };
+
+		CachedItem* sharedResult{ nullptr };
+		if ( tryFindShared( key, now, pin, sharedResult ) )
+		{
+			if ( sharedResult != nullptr )
+			{
+				m_stats.recordHits( 1 );
+			}
+			else
+			{
+				m_stats.recordMisses( 1 );
+			}
+
+			return sharedResult;
+		}
+
+		ExclusiveLock lock{ *this };
+		drainReadBuffers();
+
+		// Check for background cleanup opportunity
+		checkAndPerformBackgroundCleanup( now );
+
+		auto it{ m_cache.find( key ) };
+		if ( it != m_cache.end() && !it->second.metadata.isExpired( now ) )
+		{
+			it->second.metadata.touch( now );
+			m_policy.onAccess( &it->second.metadata, entryHasher() );
+			m_stats.recordHits( 1 );
+
+			return acquire( it->second, pin );
+		}
+
+		// Stale entries are kept for get() to serve while they are reloaded
+		if ( it != m_cache.end() && !isServableStale( it->second.metadata, now ) )
+		{
+			eraseEntry( it, RemovalCause::Expired );
+			m_stats.recordExpirations( 1 );
+			it = m_cache.end();
+		}
+
+		m_stats.recordMisses( 1 );
+
+		if ( it == m_cache.end() && findPendingLoad( key ) == nullptr )
+		{
+			if ( CachedItem* promoted{ promoteLocked( key, now ) } )
+			{
+				return acquire( *promoted, pin );
+			}
+		}
+
+		return nullptr;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::findManyImpl( std::span<const K> keys, std::span<TValue*> results )
+	{
+		const auto now{ Clock::now() };
+
+		ExclusiveLock lock{ *this };
+		drainReadBuffers();
+
+		// Check for background cleanup opportunity
+		checkAndPerformBackgroundCleanup( now );
+
+		std::size_t hits{ 0 };
+		std::vector<std::size_t> missing;
+		lookupBatch( keys, [&]( std::size_t i, typename EntryMap::iterator it ) {
+			results[i] = nullptr;
+
+			if ( it != m_cache.end() && it->second.metadata.isExpired( now ) )
+			{
+				// Stale entries are kept for get() to serve while they are reloaded, as in find()
+				if ( isServableStale( it->second.metadata, now ) )
+				{
+					return;
+				}
+
+				eraseEntry( it, RemovalCause::Expired );
+				m_stats.recordExpirations( 1 );
+				it = m_cache.end();
+			}
+
+			if ( it == m_cache.end() )
+			{
+				if ( !m_secondTier.empty() )
+				{
+					missing.push_back( i );
+				}
+
+				return;
+			}
+
+			it->second.metadata.touch( now );
+			m_policy.onAccess( &it->second.metadata, entryHasher() );
+			results[i] = &it->second.value;
+			++hits;
+		} );
+
+		m_stats.recordHits( hits );
+		m_stats.recordMisses( keys.size() - hits );
+
+		// Promoted after the batch lookup, as inserting would invalidate its prefetched positions
+		std::size_t promoted{ 0 };
+		for ( const std::size_t i : missing )
+		{
+			if ( findPendingLoad( keys[i] ) != nullptr )
+			{
+				continue;
+			}
+
+			auto it{ m_cache.find( keys[i] ) };
+			if ( it != m_cache.end() )
+			{
+				results[i] = &it->second.value; // A duplicate key promoted earlier in the batch
+				++promoted;
+			}
+			else if ( CachedItem* item{ promoteLocked( keys[i], now ) } )
+			{
+				results[i] = &item->value;
+				++promoted;
+			}
+		}
+
+		return hits + promoted;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename Configure, typename... Args>
+	inline std::pair<typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CachedItem*, bool> LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::storeImpl( const TKey& key, bool replace, Configure& configure, Args&&... args )
+	{
+		auto now{ Clock::now() };
+
+		ExclusiveLock lock{ *this };
+		drainReadBuffers();
+
+		// Check for background cleanup opportunity
+		checkAndPerformBackgroundCleanup( now );
+
+		// Writes are ordered after the load of the key in flight, which would otherwise overwrite them
+		while ( PendingLoad* pending{ findPendingLoad( key ) } )
+		{
+			++pending->waiterCount;
+			m_loadSignal.wait( lock, [pending]() { return pending->completed; } );
+
+			if ( --pending->waiterCount == 0 )
+			{
+				m_loadSignal.notify_all(); // Let the loader return and release its state
+			}
+
+			drainReadBuffers();
+			now = Clock::now();
+		}
+
+		auto it{ m_cache.find( key ) };
+		if ( it != m_cache.end() )
+		{
+			const bool expired{ it->second.metadata.isExpired( now ) };
+			if ( !expired && !replace )
+			{
+				return { &it->second, false };
+			}
+
+			if ( expired )
+			{
+				m_stats.recordExpirations( 1 );
+			}
+
+			const RemovalCause cause{ expired ? RemovalCause::Expired : RemovalCause::Replaced };
+
+			// Assigning keeps the node; handles read pinned values without the lock, so those get a new one
+			if constexpr ( sizeof...( Args ) == 1 && std::is_nothrow_move_assignable_v<TValue> && std::is_move_constructible_v<TValue> )
+			{
+				if ( !isPinned( it->second.metadata ) )
+				{
+					assignEntry( it, cause, now, configure, std::forward<Args>( args )... );
+
+					return { &it->second, expired };
+				}
+			}
+
+			eraseEntry( it, cause );
+
+			return { &emplaceEntry( key, now, configure, std::forward<Args>( args )... ), expired };
+		}
+
+		return { &emplaceEntry( key, now, configure, std::forward<Args>( args )... ), true };
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::removeImpl( const K& key )
+	{
+		ExclusiveLock lock{ *this };
+		drainReadBuffers();
+
+		auto it = m_cache.find( key );
+		if ( it != m_cache.end() )
+		{
+			eraseEntry( it, RemovalCause::Explicit );
+			return true;
+		}
+
+		// A key is either cached or has a tombstone or a compressed value, never several
+		forgetTombstone( key );
+		forgetDemoted( key );
+
+		return false;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::removeManyImpl( std::span<const K> keys )
+	{
+		ExclusiveLock lock{ *this };
+		drainReadBuffers();
+
+		std::size_t removed{ 0 };
+		lookupBatch( keys, [&]( std::size_t i, typename EntryMap::iterator it ) {
+			if ( it != m_cache.end() )
+			{
+				eraseEntry( it, RemovalCause::Explicit );
+				++removed;
+			}
+			else
+			{
+				forgetTombstone( keys[i] );
+				forgetDemoted( keys[i] );
+			}
+		} );
+
+		return removed;
+	}
+
+	//----------------------------------------------
+	// Value handle
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle::ValueHandle( LruCache* cache, TValue* value, CacheEntry* entry ) noexcept
+		: m_cache{ cache },
+		  m_value{ value },
+		  m_entry{ entry }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle::ValueHandle( const ValueHandle& other ) noexcept
+		: m_cache{ other.m_cache },
+		  m_value{ other.m_value },
+		  m_entry{ other.m_entry }
+	{
+		if ( m_entry != nullptr )
+		{
+			std::atomic_ref<std::uint32_t>{ m_entry->pinCount }.fetch_add( 1, std::memory_order_relaxed );
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle::ValueHandle( ValueHandle&& other ) noexcept
+		: m_cache{ std::exchange( other.m_cache, nullptr ) },
+		  m_value{ std::exchange( other.m_value, nullptr ) },
+		  m_entry{ std::exchange( other.m_entry, nullptr ) }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle& LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle::operator=( const ValueHandle& other ) noexcept
+	{
+		if ( this != &other )
+		{
+			*this = ValueHandle{ other };
+		}
+
+		return *this;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle& LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle::operator=( ValueHandle&& other ) noexcept
+	{
+		if ( this != &other )
+		{
+			reset();
+			m_cache = std::exchange( other.m_cache, nullptr );
+			m_value = std::exchange( other.m_value, nullptr );
+			m_entry = std::exchange( other.m_entry, nullptr );
+		}
+
+		return *this;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle::~ValueHandle()
+	{
+		reset();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline TValue* LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle::get() const noexcept
+	{
+		return m_value;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline TValue& LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle::operator*() const noexcept
+	{
+		return *m_value;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline TValue* LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle::operator->() const noexcept
+	{
+		return m_value;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle::operator bool() const noexcept
+	{
+		return m_value != nullptr;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle::reset() noexcept
+	{
+		if ( m_entry != nullptr )
+		{
+			m_cache->unpin( std::exchange( m_entry, nullptr ) );
+			m_cache = nullptr;
+			m_value = nullptr;
+		}
+	}
+
+	//----------------------------------------------
+	// Awaitable lookup
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::GetAwaitable::GetAwaitable( LruCache& cache, ValueHandle value ) noexcept
+		: m_cache{ &cache },
+		  m_value{ std::move( value ) }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::GetAwaitable::GetAwaitable( LruCache& cache, std::unique_ptr<AsyncWaiter> waiter ) noexcept
+		: m_cache{ &cache },
+		  m_waiter{ std::move( waiter ) }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::GetAwaitable::await_ready() const noexcept
+	{
+		return m_waiter == nullptr;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::GetAwaitable::await_suspend( std::coroutine_handle<> continuation )
+	{
+		m_waiter->continuation = continuation;
+
+		// The coroutine may be resumed on another thread before this returns: touch nothing after
+		return m_cache->awaitLoad( *m_waiter );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::GetAwaitable::await_resume()
+	{
+		if ( m_waiter == nullptr )
+		{
+			return std::move( m_value );
+		}
+
+		if ( m_waiter->error )
+		{
+			std::rethrow_exception( m_waiter->error );
+		}
+
+		return std::move( m_waiter->value );
+	}
+
+	//----------------------------------------------
+	// Internal data structures
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename... Args>
+	LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CachedItem::CachedItem( CacheEntry meta, Args&&... args )
+		: value( std::forward<Args>( args )... ), // Parentheses, as emplace() arguments are constructor arguments
+		  metadata{ std::move( meta ) }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::PendingLoad::PendingLoad( const TKey* loadKey ) noexcept
+		: key{ loadKey }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::AsyncWaiter::AsyncWaiter( const TKey& awaitedKey, FactoryFunction loadFactory )
+		: key{ awaitedKey },
+		  factory{ std::move( loadFactory ) }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::AsyncLoad::AsyncLoad( const TKey& loadKey, FactoryFunction loadFactory )
+		: key{ loadKey },
+		  factory{ std::move( loadFactory ) },
+		  pending{ &key }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::Promotion::Promotion( const TKey* promotedKey ) noexcept
+		: key{ promotedKey }
+	{
+	}
+
+	//----------------------------------------------
+	// Cache lock
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CacheMutex::CacheMutex( bool shared ) noexcept
+		: m_isShared{ shared }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CacheMutex::lock()
+	{
+		m_isShared ? m_shared.lock() : m_exclusive.lock();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CacheMutex::unlock()
+	{
+		m_isShared ? m_shared.unlock() : m_exclusive.unlock();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CacheMutex::lock_shared()
+	{
+		m_isShared ? m_shared.lock_shared() : m_exclusive.lock();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CacheMutex::unlock_shared()
+	{
+		m_isShared ? m_shared.unlock_shared() : m_exclusive.unlock();
+	}
+
+	//----------------------------------------------
+	// Exclusive lock
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ExclusiveLock::ExclusiveLock( LruCache& cache )
+		: m_cache{ cache },
+		  m_lock{ cache.m_mutex }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ExclusiveLock::~ExclusiveLock()
+	{
+		if ( !m_lock.owns_lock() ||
+			 ( m_cache.m_removals.empty() && m_cache.m_demotions.empty() && m_cache.m_refreshQueue.empty() && m_cache.m_asyncLoadQueue.empty() && m_cache.m_asyncResumptions.empty() ) )
+		{
+			return;
+		}
+
+		std::vector<RemovalNotification> removals;
+		removals.swap( m_cache.m_removals );
+		std::vector<Demotion> demotions;
+		demotions.swap( m_cache.m_demotions );
+		if ( !demotions.empty() )
+		{
+			m_cache.m_demotionBatches.push_back( &demotions );
+		}
+		std::vector<PendingRefresh> refreshes;
+		refreshes.swap( m_cache.m_refreshQueue );
+		std::vector<std::shared_ptr<AsyncLoad>> loads;
+		loads.swap( m_cache.m_asyncLoadQueue );
+		std::vector<AsyncWaiter*> resumptions;
+		resumptions.swap( m_cache.m_asyncResumptions );
+		m_lock.unlock();
+
+		if ( !removals.empty() )
+		{
+			m_cache.m_removalListener( removals );
+		}
+
+		if ( !demotions.empty() )
+		{
+			m_cache.storeDemotions( demotions );
+		}
+
+		// Only get() and getAsync() queue loads, and they need a movable TValue
+		if constexpr ( std::is_move_constructible_v<TValue> )
+		{
+			for ( PendingRefresh& refresh : refreshes )
+			{
+				m_cache.submitRefresh( std::move( refresh ) );
+			}
+
+			for ( std::shared_ptr<AsyncLoad>& load : loads )
+			{
+				m_cache.submitAsyncLoad( std::move( load ) );
+			}
+		}
+
+		// Last, as a resumed coroutine may run for long or destroy what it was waiting on
+		for ( AsyncWaiter* waiter : resumptions )
+		{
+			resumeWaiter( waiter );
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ExclusiveLock::lock()
+	{
+		m_lock.lock();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ExclusiveLock::unlock()
+	{
+		m_lock.unlock();
+	}
+
+	//----------------------------------------------
+	// Eviction
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline auto LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::entryHasher() const noexcept
+	{
+		return [this]( const CacheEntry* entry ) { return m_cache.hash_function()( *static_cast<const TKey*>( entry->keyPtr ) ); };
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::evictUntilFits( std::size_t incomingSize, std::size_t incomingCount )
+	{
+		const std::size_t sizeLimit{ m_options.sizeLimit() };
+		const std::size_t memoryLimit{ m_options.memoryLimit() };
+		std::size_t skipped{ 0 };
+
+		while ( !m_cache.empty() &&
+				( ( sizeLimit > 0 && m_cache.size() + incomingCount > sizeLimit ) ||
+					( memoryLimit > 0 && m_memoryUsage + incomingSize > memoryLimit ) ) )
+		{
+			CacheEntry* victim{ m_policy.victim( entryHasher() ) };
+			if ( victim == nullptr || victim->keyPtr == nullptr )
+			{
+				return;
+			}
+
+			if ( isPinned( *victim ) )
+			{
+				// Pinned entries stay cached: move past them, and exceed the limits rather than
+				// wait once every entry has been skipped
+				if ( ++skipped > m_cache.size() )
+				{
+					return;
+				}
+
+				m_policy.onSkip( victim );
+
+				continue;
+			}
+
+			auto it{ m_cache.find( *static_cast<const TKey*>( victim->keyPtr ) ) };
+			demoteEntry( *it );
+			eraseEntry( it, RemovalCause::Size );
+			m_stats.recordEvictions( 1 );
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::EntryMap::iterator LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::eraseEntry( typename EntryMap::iterator it, RemovalCause cause )
+	{
+		m_policy.onRemove( &it->second.metadata );
+		m_expiryWheel.unschedule( &it->second.metadata );
+		m_memoryUsage -= it->second.metadata.size;
+
+		return detachEntry( it, cause );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::eraseEntry( CacheEntry* entry, RemovalCause cause )
+	{
+		eraseEntry( m_cache.find( *static_cast<const TKey*>( entry->keyPtr ) ), cause );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CachedItem& LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::insertEntry( const TKey& key, TValue&& value, CacheEntry&& metadata )
+	{
+		evictUntilFits( metadata.size );
+
+		auto [it, inserted]{ m_cache.try_emplace( key, std::move( metadata ), std::move( value ) ) };
+		if ( !inserted )
+		{
+			// Cached meanwhile by another path: the value being inserted is newer, and the node must not be linked twice
+			eraseEntry( it, RemovalCause::Replaced );
+			it = m_cache.try_emplace( key, std::move( metadata ), std::move( value ) ).first;
+		}
+
+		linkEntry( *it );
+
+		return it->second;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename Configure, typename... Args>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CachedItem& LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::emplaceEntry( const TKey& key, std::chrono::steady_clock::time_point now, Configure& configure, Args&&... args )
+	{
+		CacheEntry metadata{ newEntryMetadata() };
+		metadata.resetTimestamps( now );
+
+		auto [it, inserted]{ m_cache.try_emplace( key, std::move( metadata ), std::forward<Args>( args )... ) };
+		CachedItem& item{ it->second };
+
+		try
+		{
+			if ( m_sizer )
+			{
+				item.metadata.size = m_sizer( it->first, item.value );
+			}
+
+			configureEntry( configure, item.metadata );
+		}
+		catch ( ... )
+		{
+			m_cache.erase( it );
+
+			throw;
+		}
+
+		linkEntry( *it );
+		evictAround( item );
+
+		return item;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename Configure, typename V>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::assignEntry( typename EntryMap::iterator it, RemovalCause cause, std::chrono::steady_clock::time_point now, Configure& configure, V&& value )
+	{
+		CachedItem& item{ it->second };
+
+		// Anything that may throw runs before the current value is given up
+		if constexpr ( std::is_nothrow_assignable_v<TValue&, V&&> )
+		{
+			if ( m_removalListener )
+			{
+				m_removals.push_back( RemovalNotification{ it->first, std::move( item.value ), cause } );
+			}
+
+			item.value = std::forward<V>( value );
+		}
+		else
+		{
+			TValue replacement( std::forward<V>( value ) );
+			if ( m_removalListener )
+			{
+				m_removals.push_back( RemovalNotification{ it->first, std::move( item.value ), cause } );
+			}
+
+			item.value = std::move( replacement );
+		}
+
+		CacheEntry fresh{ newEntryMetadata() };
+		fresh.resetTimestamps( now );
+		if ( m_sizer )
+		{
+			fresh.size = m_sizer( it->first, item.value );
+		}
+
+		configureEntry( configure, fresh );
+
+		CacheEntry& metadata{ item.metadata };
+		m_memoryUsage = m_memoryUsage - metadata.size + fresh.size;
+		metadata.slidingExpiration = fresh.slidingExpiration;
+		metadata.absoluteExpiration = fresh.absoluteExpiration;
+		metadata.expirationMode = fresh.expirationMode;
+		metadata.size = fresh.size;
+		metadata.lastAccessed = fresh.lastAccessed;
+		metadata.writeTime = fresh.writeTime;
+		metadata.refreshing = false; // A reload in flight would overwrite the new value: its result is dropped
+
+		// The deadline may have moved earlier, which the wheel would only notice once it passed
+		m_expiryWheel.unschedule( &metadata );
+		m_expiryWheel.schedule( &metadata );
+		m_policy.onAccess( &metadata, entryHasher() );
+		m_stats.recordInserts( 1 );
+
+		evictAround( item );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::linkEntry( typename EntryMap::value_type& item )
+	{
+		item.second.metadata.keyPtr = &item.first;
+		forgetTombstone( item.first );
+		forgetDemoted( item.first );
+		m_policy.onInsert( &item.second.metadata, entryHasher() );
+		m_expiryWheel.schedule( &item.second.metadata );
+		m_memoryUsage += item.second.metadata.size;
+		m_stats.recordInserts( 1 );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::evictAround( CachedItem& item )
+	{
+		// Only ever pinned under the exclusive lock here, so no handle can observe this pin
+		std::atomic_ref<std::uint32_t> pins{ item.metadata.pinCount };
+		pins.fetch_add( 1, std::memory_order_relaxed );
+		evictUntilFits( 0, 0 );
+		pins.fetch_sub( 1, std::memory_order_relaxed );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline CacheEntry LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::newEntryMetadata() const
+	{
+		CacheEntry metadata{ m_options.slidingExpiration() };
+		metadata.absoluteExpiration = m_options.absoluteExpiration();
+		metadata.expirationMode = m_options.expirationMode();
+
+		return metadata;
+	}
+
+	//----------------------------------------------
+	// Pinning
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::isPinned( CacheEntry& entry ) noexcept
+	{
+		return std::atomic_ref<std::uint32_t>{ entry.pinCount }.load( std::memory_order_acquire ) != 0;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CachedItem* LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::acquire( CachedItem& item, bool pin ) noexcept
+	{
+		if ( pin )
+		{
+			// Entries are only removed under the exclusive lock, so a pin taken under any lock is safe
+			std::atomic_ref<std::uint32_t>{ item.metadata.pinCount }.fetch_add( 1, std::memory_order_relaxed );
+		}
+
+		return &item;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::EntryMap::iterator LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::detachEntry( typename EntryMap::iterator it, RemovalCause cause )
+	{
+		// Marking the entry retired and reading its pins is one step, so a handle released
+		// concurrently either sees the mark and destroys it, or dropped its pin before
+		if ( std::atomic_ref<std::uint32_t>{ it->second.metadata.pinCount }.fetch_or( PIN_RETIRED, std::memory_order_acq_rel ) == 0 )
+		{
+			if constexpr ( std::is_move_constructible_v<TValue> )
+			{
+				if ( m_removalListener )
+				{
+					// Only the moved-from value is destroyed under the lock
+					m_removals.push_back( RemovalNotification{ it->first, std::move( it->second.value ), cause } );
+				}
+			}
+
+			return m_cache.erase( it );
+		}
+
+		auto next{ std::next( it ) };
+		m_retired.push_back( RetiredEntry{ m_cache.extract( it ), cause } );
+
+		return next;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::unpin( CacheEntry* entry ) noexcept
+	{
+		if ( std::atomic_ref<std::uint32_t>{ entry->pinCount }.fetch_sub( 1, std::memory_order_acq_rel ) != ( PIN_RETIRED | 1 ) )
+		{
+			return;
+		}
+
+		// Last pin of an entry that already left the cache
+		ExclusiveLock lock{ *this };
+
+		auto retired{ std::find_if( m_retired.begin(), m_retired.end(), [entry]( const RetiredEntry& retired ) { return &retired.node.mapped().metadata == entry; } ) };
+		if constexpr ( std::is_move_constructible_v<TValue> )
+		{
+			if ( m_removalListener )
+			{
+				m_removals.push_back( RemovalNotification{ std::move( retired->node.key() ), std::move( retired->node.mapped().value ), retired->cause } );
+			}
+		}
+
+		m_retired.erase( retired );
+	}
+
+	//----------------------------------------------
+	// Batch lookup
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K, typename Visit>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::lookupBatch( std::span<const K> keys, Visit&& visit )
+	{
+		if constexpr ( requires( EntryMap& map, const K& key, std::uint64_t hash ) { map.prefetch( map.hash_code( key ) ); map.find( key, hash ); } )
+		{
+			// Hash and prefetch each key BATCH_PREFETCH_DISTANCE lookups before it is probed. Erasing
+			// never moves FlatHashMap slots, so the prefetched groups stay valid while visiting.
+			std::array<std::uint64_t, BATCH_PREFETCH_DISTANCE> hashes;
+			const std::size_t count{ keys.size() };
+
+			for ( std::size_t i{ 0 }; i < count + BATCH_PREFETCH_DISTANCE; ++i )
+			{
+				if ( i >= BATCH_PREFETCH_DISTANCE )
+				{
+					const std::size_t ready{ i - BATCH_PREFETCH_DISTANCE };
+					visit( ready, m_cache.find( keys[ready], hashes[ready % BATCH_PREFETCH_DISTANCE] ) );
+				}
+
+				if ( i < count )
+				{
+					hashes[i % BATCH_PREFETCH_DISTANCE] = m_cache.hash_code( keys[i] );
+					m_cache.prefetch( hashes[i % BATCH_PREFETCH_DISTANCE] );
+				}
+			}
+		}
+		else
+		{
+			for ( std::size_t i{ 0 }; i < keys.size(); ++i )
+			{
+				visit( i, m_cache.find( keys[i] ) );
+			}
+		}
+	}
+
+	//----------------------------------------------
+	// Read-optimized path
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::tryFindShared( const K& key, std::chrono::steady_clock::time_point now, bool pin, CachedItem*& result )
+	{
+		if ( !m_readBuffers )
+		{
+			return false;
+		}
+
+		std::shared_lock<CacheMutex> lock{ m_mutex };
+
+		if ( isBackgroundCleanupDue( now ) )
+		{
+			return false;
+		}
+
+		auto it{ m_cache.find( key ) };
+		if ( it == m_cache.end() )
+		{
+			// A value kept in the second tier is promoted on the exclusive path
+			if ( !m_secondTier.empty() )
+			{
+				return false;
+			}
+
+			result = nullptr;
+
+			return true;
+		}
+
+		// A stale (not yet drained) timestamp can only make the entry look older, so an entry that
+		// looks expired is re-checked on the exclusive path after draining
+		if ( it->second.metadata.isExpired( now ) || isRefreshDue( it->second.metadata, now ) || !recordRead( &it->second.metadata, now ) )
+		{
+			return false;
+		}
+
+		result = acquire( it->second, pin );
+
+		return true;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::recordRead( CacheEntry* entry, std::chrono::steady_clock::time_point now ) noexcept
+	{
+		thread_local const std::size_t threadHash{ std::hash<std::thread::id>{}( std::this_thread::get_id() ) };
+		const std::size_t stripe{ static_cast<std::size_t>( ( static_cast<std::uint64_t>( threadHash ) * 0x9E3779B97F4A7C15ull ) >> 32 ) & m_readBufferMask };
+
+		ReadBuffer& buffer{ m_readBuffers[stripe] };
+		const std::uint32_t slot{ buffer.writeCount.fetch_add( 1, std::memory_order_relaxed ) };
+		if ( slot >= READ_BUFFER_CAPACITY )
+		{
+			return false;
+		}
+
+		// Published to the draining thread by the shared/exclusive lock handoff
+		buffer.records[slot].accessTime.store( now.time_since_epoch().count(), std::memory_order_relaxed );
+		buffer.records[slot].entry.store( entry, std::memory_order_relaxed );
+
+		return true;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::drainReadBuffers() noexcept
+	{
+		if ( !m_readBuffers )
+		{
+			return;
+		}
+
+		for ( std::size_t stripe{ 0 }; stripe <= m_readBufferMask; ++stripe )
+		{
+			ReadBuffer& buffer{ m_readBuffers[stripe] };
+			const std::uint32_t count{ std::min( buffer.writeCount.load( std::memory_order_relaxed ), READ_BUFFER_CAPACITY ) };
+			if ( count == 0 )
+			{
+				continue;
+			}
+
+			// Replay in recording order so the most recent hit ends up at the LRU head
+			for ( std::uint32_t i{ 0 }; i < count; ++i )
+			{
+				ReadRecord& record{ buffer.records[i] };
+				CacheEntry* entry{ record.entry.exchange( nullptr, std::memory_order_relaxed ) };
+				if ( entry != nullptr )
+				{
+					const std::chrono::steady_clock::time_point accessTime{ std::chrono::steady_clock::duration{ record.accessTime.load( std::memory_order_relaxed ) } };
+
+					if ( entry->expirationMode != ExpirationMode::Absolute )
+					{
+						entry->lastAccessed = std::max( entry->lastAccessed, accessTime );
+					}
+
+					m_policy.onAccess( entry, entryHasher() );
+				}
+			}
+
+			buffer.writeCount.store( 0, std::memory_order_relaxed );
+		}
+	}
+
+	//----------------------------------------------
+	// Single-flight loading
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::PendingLoad* LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::findPendingLoad( const K& key ) const
+	{
+		if ( m_pendingLoads.empty() )
+		{
+			return nullptr;
+		}
+
+		auto it{ m_pendingLoads.find( key ) };
+
+		return it != m_pendingLoads.end() ? it->second : nullptr;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::addPendingLoad( PendingLoad& pending )
+	{
+		m_pendingLoads.try_emplace( *pending.key, &pending );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::forgetPendingLoads( std::span<PendingLoad> loads ) noexcept
+	{
+		for ( const PendingLoad& pending : loads )
+		{
+			// A load that failed to register must not unregister the load of its key
+			auto it{ m_pendingLoads.find( *pending.key ) };
+			if ( it != m_pendingLoads.end() && it->second == &pending )
+			{
+				m_pendingLoads.erase( it );
+			}
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::completePendingLoads( ExclusiveLock& lock, std::span<PendingLoad> loads, std::exception_ptr error )
+	{
+		for ( PendingLoad& pending : loads )
+		{
+			pending.error = error;
+			pending.completed = true;
+		}
+
+		forgetPendingLoads( loads );
+
+		for ( PendingLoad& pending : loads )
+		{
+			settleAsyncWaiters( pending );
+		}
+
+		m_loadSignal.notify_all();
+
+		// The states are owned by the loading thread: keep them alive until every waiter has read them
+		m_loadSignal.wait( lock, [loads]() { return std::all_of( loads.begin(), loads.end(), []( const PendingLoad& pending ) { return pending.waiterCount == 0; } ); } );
+	}
+
+	//----------------------------------------------
+	// Negative caching
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::isKnownAbsent( const K& key, std::chrono::steady_clock::time_point now )
+	{
+		if ( m_tombstones.empty() )
+		{
+			return false;
+		}
+
+		auto it{ m_tombstones.find( key ) };
+		if ( it == m_tombstones.end() )
+		{
+			return false;
+		}
+
+		if ( now <= it->second.deadline )
+		{
+			return true;
+		}
+
+		eraseTombstone( it );
+
+		return false;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::addTombstone( const TKey& key )
+	{
+		const auto negativeExpiration{ m_options.negativeExpiration() };
+		if ( negativeExpiration.count() <= 0 )
+		{
+			return;
+		}
+
+		const auto now{ Clock::now() };
+		purgeTombstones( now );
+
+		// A tombstone left by a previous miss is moved to the back with its new deadline
+		forgetTombstone( key );
+
+		const std::size_t limit{ m_options.negativeSizeLimit() };
+		while ( limit > 0 && m_tombstones.size() >= limit )
+		{
+			eraseTombstone( m_tombstones.find( *m_oldestTombstone->key ) );
+		}
+
+		auto it{ m_tombstones.try_emplace( key, Tombstone{ now + negativeExpiration, m_newestTombstone } ).first };
+		it->second.key = &it->first;
+
+		if ( m_newestTombstone != nullptr )
+		{
+			m_newestTombstone->next = &it->second;
+		}
+		else
+		{
+			m_oldestTombstone = &it->second;
+		}
+
+		m_newestTombstone = &it->second;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::forgetTombstone( const K& key )
+	{
+		if ( m_tombstones.empty() )
+		{
+			return;
+		}
+
+		auto it{ m_tombstones.find( key ) };
+		if ( it != m_tombstones.end() )
+		{
+			eraseTombstone( it );
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::eraseTombstone( typename TombstoneMap::iterator it )
+	{
+		Tombstone& tombstone{ it->second };
+
+		if ( tombstone.prev != nullptr )
+		{
+			tombstone.prev->next = tombstone.next;
+		}
+		else
+		{
+			m_oldestTombstone = tombstone.next;
+		}
+
+		if ( tombstone.next != nullptr )
+		{
+			tombstone.next->prev = tombstone.prev;
+		}
+		else
+		{
+			m_newestTombstone = tombstone.prev;
+		}
+
+		m_tombstones.erase( it );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::purgeTombstones( std::chrono::steady_clock::time_point now )
+	{
+		while ( m_oldestTombstone != nullptr && m_oldestTombstone->deadline < now )
+		{
+			eraseTombstone( m_tombstones.find( *m_oldestTombstone->key ) );
+		}
+	}
+
+	//----------------------------------------------
+	// Second tier
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::demoteEntry( const typename EntryMap::value_type& item )
+	{
+		if constexpr ( SECOND_TIER_SUPPORTED )
+		{
+			if ( m_options.secondTierMemoryLimit() == 0 )
+			{
+				return;
+			}
+
+			// Serialized under the lock as the value is destroyed or handed to the listener next;
+			// compression, the costly part, waits for the lock to be released
+			std::vector<std::byte> bytes;
+			try
+			{
+				SnapshotSerializer<TValue>::write( bytes, item.second.value );
+			}
+			catch ( ... )
+			{
+				return;
+			}
+
+			if ( bytes.size() < m_options.secondTierMinimumSize() )
+			{
+				return;
+			}
+
+			m_demotions.push_back( Demotion{ item.first, expirationState( item.second.metadata ), std::move( bytes ), {} } );
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::storeDemotions( std::vector<Demotion>& demotions )
+	{
+		// Values evicted after expiring are not worth compressing; one clock read covers the batch
+		const auto now{ Clock::now() };
+		const CompressionCodec& codec{ m_options.secondTierCodec() };
+
+		for ( Demotion& demotion : demotions )
+		{
+			if ( !demotion.metadata.isExpired( now ) )
+			{
+				try
+				{
+					codec.compress( demotion.bytes, demotion.block );
+					demotion.block.shrink_to_fit();
+				}
+				catch ( ... )
+				{
+					demotion.block.clear();
+				}
+			}
+
+			demotion.bytes = {};
+		}
+
+		std::unique_lock<CacheMutex> lock{ m_mutex };
+		std::erase( m_demotionBatches, &demotions );
+
+		const std::size_t limit{ m_options.secondTierMemoryLimit() };
+
+		try
+		{
+			for ( Demotion& demotion : demotions )
+			{
+				if ( demotion.cancelled || demotion.block.empty() || demotion.block.size() > limit )
+				{
+					continue;
+				}
+
+				while ( m_secondTierMemoryUsage + demotion.block.size() > limit )
+				{
+					eraseDemoted( m_secondTier.find( *m_oldestDemoted->key ) );
+				}
+
+				auto [it, inserted]{ m_secondTier.try_emplace( std::move( demotion.key ), DemotedValue{ std::move( demotion.block ), demotion.metadata, m_newestDemoted } ) };
+				if ( !inserted )
+				{
+					continue; // Already stored by a batch that ran ahead of this one
+				}
+
+				it->second.key = &it->first;
+				it->second.metadata.keyPtr = &it->first;
+				m_secondTierMemoryUsage += it->second.block.size();
+				m_secondTierWheel.schedule( &it->second.metadata );
+
+				if ( m_newestDemoted != nullptr )
+				{
+					m_newestDemoted->next = &it->second;
+				}
+				else
+				{
+					m_oldestDemoted = &it->second;
+				}
+
+				m_newestDemoted = &it->second;
+			}
+		}
+		catch ( ... )
+		{
+			// Out of memory: the values left are dropped like those over budget
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::takeDemoted( const K& key, std::chrono::steady_clock::time_point now, Promotion& promotion )
+	{
+		if ( m_secondTier.empty() )
+		{
+			return false;
+		}
+
+		auto it{ m_secondTier.find( key ) };
+		if ( it == m_secondTier.end() )
+		{
+			return false;
+		}
+
+		const bool live{ !it->second.metadata.isExpired( now ) };
+		if ( live )
+		{
+			// Accounted before the block is moved out, leaving nothing for eraseDemoted() to subtract
+			m_secondTierMemoryUsage -= it->second.block.size();
+			promotion.block = std::move( it->second.block );
+			promotion.metadata = expirationState( it->second.metadata );
+		}
+
+		eraseDemoted( it );
+
+		return live;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::restoreDemoted( Promotion& promotion, std::chrono::steady_clock::time_point now ) const
+	{
+		if constexpr ( SECOND_TIER_SUPPORTED )
+		{
+			try
+			{
+				std::vector<std::byte> bytes;
+				m_options.secondTierCodec().decompress( promotion.block, bytes );
+				promotion.value.emplace( SnapshotSerializer<TValue>::read( bytes ) );
+				promotion.metadata.touch( now );
+
+				return true;
+			}
+			catch ( ... )
+			{
+				// A value that cannot be restored is loaded again
+			}
+		}
+
+		return false;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CachedItem* LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::promoteLocked( const K& key, std::chrono::steady_clock::time_point now )
+	{
+		if constexpr ( SECOND_TIER_SUPPORTED )
+		{
+			Promotion promotion;
+			if ( m_secondTier.empty() || !takeDemoted( key, now, promotion ) || !restoreDemoted( promotion, now ) )
+			{
+				return nullptr;
+			}
+
+			if constexpr ( std::is_same_v<K, TKey> )
+			{
+				return &insertEntry( key, std::move( *promotion.value ), std::move( promotion.metadata ) );
+			}
+			else
+			{
+				return &insertEntry( TKey{ key }, std::move( *promotion.value ), std::move( promotion.metadata ) );
+			}
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::forgetDemoted( const K& key )
+	{
+		if ( !m_demotions.empty() )
+		{
+			std::erase_if( m_demotions, [this, &key]( const Demotion& demotion ) { return m_cache.key_eq()( demotion.key, key ); } );
+		}
+
+		// Only the keys and flags of batches being compressed are touched, which their owners leave alone until they relock
+		for ( std::vector<Demotion>* batch : m_demotionBatches )
+		{
+			for ( Demotion& demotion : *batch )
+			{
+				if ( m_cache.key_eq()( demotion.key, key ) )
+				{
+					demotion.cancelled = true;
+				}
+			}
+		}
+
+		if ( m_secondTier.empty() )
+		{
+			return;
+		}
+
+		auto it{ m_secondTier.find( key ) };
+		if ( it != m_secondTier.end() )
+		{
+			eraseDemoted( it );
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::eraseDemoted( typename SecondTierMap::iterator it )
+	{
+		DemotedValue& demoted{ it->second };
+
+		if ( demoted.prev != nullptr )
+		{
+			demoted.prev->next = demoted.next;
+		}
+		else
+		{
+			m_oldestDemoted = demoted.next;
+		}
+
+		if ( demoted.next != nullptr )
+		{
+			demoted.next->prev = demoted.prev;
+		}
+		else
+		{
+			m_newestDemoted = demoted.prev;
+		}
+
+		m_secondTierWheel.unschedule( &demoted.metadata );
+		m_secondTierMemoryUsage -= demoted.block.size();
+		m_secondTier.erase( it );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::purgeDemoted( std::chrono::steady_clock::time_point now )
+	{
+		if ( m_secondTier.empty() )
+		{
+			return;
+		}
+
+		m_secondTierWheel.advance( now, std::numeric_limits<std::size_t>::max(), [this]( CacheEntry* entry ) {
+			eraseDemoted( m_secondTier.find( *static_cast<const TKey*>( entry->keyPtr ) ) );
+		} );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline CacheEntry LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::expirationState( const CacheEntry& entry ) noexcept
+	{
+		CacheEntry state;
+		state.lastAccessed = entry.lastAccessed;
+		state.writeTime = entry.writeTime;
+		state.slidingExpiration = entry.slidingExpiration;
+		state.absoluteExpiration = entry.absoluteExpiration;
+		state.size = entry.size;
+		state.expirationMode = entry.expirationMode;
+
+		return state;
+	}
+
+	//----------------------------------------------
+	// Background cleanup implementation
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::isBackgroundCleanupDue( std::chrono::steady_clock::time_point now ) const
+	{
+		// The maintenance task owns cleanup: request threads never run it
+		if ( m_maintenance || m_options.backgroundCleanupInterval().count() <= 0 )
+		{
+			return false;
+		}
+
+		return now - m_lastCleanupTime >= m_options.backgroundCleanupInterval();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::checkAndPerformBackgroundCleanup( std::chrono::steady_clock::time_point now )
+	{
+		// Skip if background cleanup is disabled or left to the maintenance task
+		if ( m_maintenance || m_options.backgroundCleanupInterval().count() <= 0 )
+		{
+			return;
+		}
+
+		auto timeSinceLastCleanup = now - m_lastCleanupTime;
+
+		if ( timeSinceLastCleanup >= m_options.backgroundCleanupInterval() )
+		{
+			m_lastCleanupTime = now;
+
+			// Perform incremental cleanup of expired entries
+			if ( m_options.adaptiveCleanup() )
+			{
+				m_stats.recordExpirations( performAdaptiveCleanup( now ) );
+			}
+			else
+			{
+				m_stats.recordExpirations( m_expiryWheel.advance( now, m_options.cleanupBudget(), [this]( CacheEntry* entry ) { eraseEntry( entry, RemovalCause::Expired ); } ) );
+			}
+
+			purgeTombstones( now );
+			purgeDemoted( now );
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::performAdaptiveCleanup( std::chrono::steady_clock::time_point now )
+	{
+		// Measured on the real clock whatever Clock is: the budget is about request latency
+		const auto deadline{ std::chrono::steady_clock::now() + m_options.cleanupTimeBudget() };
+		std::size_t expired{ 0 };
+		bool drained{ false };
+		bool outOfTime{ false };
+
+		while ( expired < m_cleanupBudget )
+		{
+			const std::size_t chunk{ std::min( ADAPTIVE_CLEANUP_CHUNK, m_cleanupBudget - expired ) };
+			const std::size_t removed{ m_expiryWheel.advance( now, chunk, [this]( CacheEntry* entry ) { eraseEntry( entry, RemovalCause::Expired ); } ) };
+			expired += removed;
+
+			if ( removed < chunk )
+			{
+				drained = true;
+				break;
+			}
+
+			if ( std::chrono::steady_clock::now() >= deadline )
+			{
+				outOfTime = true;
+				break;
+			}
+		}
+
+		const std::size_t minimum{ m_options.cleanupBudget() };
+		if ( outOfTime )
+		{
+			// Settle on what fits in the time budget
+			m_cleanupBudget = std::max( expired, minimum );
+		}
+		else if ( !drained )
+		{
+			// Backlog left after a full budget: expired entries pile up faster than they are removed
+			m_cleanupBudget = std::min( m_cleanupBudget * 2, std::max( MAX_ADAPTIVE_CLEANUP_BUDGET, minimum ) );
+		}
+		else if ( expired < m_cleanupBudget / 4 )
+		{
+			m_cleanupBudget = std::max( m_cleanupBudget / 2, minimum );
+		}
+
+		return expired;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::performMaintenance()
+	{
+		const auto now{ Clock::now() };
+
+		while ( true )
+		{
+			ExclusiveLock lock{ *this };
+			drainReadBuffers();
+
+			const std::size_t expired{ m_expiryWheel.advance( now, MAINTENANCE_BATCH, [this]( CacheEntry* entry ) { eraseEntry( entry, RemovalCause::Expired ); } ) };
+			m_stats.recordExpirations( expired );
+
+			if ( expired < MAINTENANCE_BATCH )
+			{
+				// Pinned entries may have kept the cache over its limits since their handles were dropped
+				evictUntilFits( 0, 0 );
+				purgeTombstones( now );
+				purgeDemoted( now );
+				m_lastCleanupTime = now;
+
+				return;
+			}
+		}
+	}
+
+	//----------------------------------------------
+	// Refresh-ahead
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::isRefreshDue( const CacheEntry& entry, std::chrono::steady_clock::time_point now ) const noexcept
+	{
+		const auto refreshAfter{ m_options.refreshAfter() };
+
+		return refreshAfter.count() > 0 && !entry.refreshing && now - entry.writeTime >= refreshAfter;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::isServableStale( const CacheEntry& entry, std::chrono::steady_clock::time_point now ) const noexcept
+	{
+		const auto window{ m_options.staleWhileRevalidate() };
+
+		return window.count() > 0 && !entry.isExpired( now - window );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename Factory, typename Configure>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::queueRefresh( typename EntryMap::iterator it, Factory& factory, Configure& configure )
+	{
+		using FactoryType = std::remove_cvref_t<Factory>;
+		using ConfigureType = std::remove_cvref_t<Configure>;
+
+		// A background reload has no way to report a key gone from the source: entries loaded by
+		// an OptionalEntryFactory are reloaded in the foreground once expired
+		if constexpr ( !OptionalEntryFactory<Factory, TValue> && std::copy_constructible<FactoryType> && std::copy_constructible<ConfigureType> )
+		{
+			m_refreshQueue.push_back( PendingRefresh{
+				it->first,
+				&it->second.metadata,
+				[load = FactoryType{ factory }]() mutable -> TValue { return TValue( load() ); },
+				ConfigFunction{ configure } } );
+
+			it->second.metadata.refreshing = true;
+			++m_backgroundTasks;
+
+			return true;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::submitRefresh( PendingRefresh refresh ) noexcept
+	{
+		const CacheEntry* entry{ refresh.entry };
+		std::optional<TKey> key;
+
+		try
+		{
+			key.emplace( refresh.key );
+
+			std::function<void()> task{ [this, refresh = std::move( refresh )]() mutable { runRefresh( refresh ); } };
+
+			if ( m_options.refreshExecutor() )
+			{
+				m_options.refreshExecutor()( std::move( task ) );
+			}
+			else
+			{
+				std::thread{ std::move( task ) }.detach();
+			}
+		}
+		catch ( ... )
+		{
+			// Rejected by the executor: the reload will not run, so a later hit may try again
+			if ( key )
+			{
+				completeRefresh( *key, entry, std::nullopt, CacheEntry{} );
+			}
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::runRefresh( PendingRefresh& refresh ) noexcept
+	{
+		std::optional<TValue> value;
+		CacheEntry metadata{ newEntryMetadata() };
+		const auto loadStart{ m_stats.loadStart() };
+
+		try
+		{
+			value.emplace( refresh.load() );
+			m_stats.recordLoad( loadStart, false );
+			metadata.resetTimestamps( Clock::now() );
+
+			if ( m_sizer )
+			{
+				metadata.size = m_sizer( refresh.key, *value );
+			}
+
+			configureEntry( refresh.configure, metadata );
+		}
+		catch ( ... )
+		{
+			// The current value stays cached (and served while stale) until a later reload succeeds
+			if ( !value )
+			{
+				m_stats.recordLoad( loadStart, true );
+			}
+
+			value.reset();
+		}
+
+		completeRefresh( refresh.key, refresh.entry, std::move( value ), std::move( metadata ) );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::completeRefresh( const TKey& key, const CacheEntry* entry, std::optional<TValue> value, CacheEntry metadata ) noexcept
+	{
+		{
+			ExclusiveLock lock{ *this };
+			drainReadBuffers();
+
+			// Only the entry the reload was scheduled for is replaced: if it was removed meanwhile,
+			// the reloaded value is dropped
+			auto it{ m_cache.find( key ) };
+			if ( it != m_cache.end() && &it->second.metadata == entry && entry->refreshing )
+			{
+				it->second.metadata.refreshing = false;
+
+				if ( value )
+				{
+					eraseEntry( it, RemovalCause::Replaced );
+					insertEntry( key, std::move( *value ), std::move( metadata ) );
+				}
+			}
+		}
+
+		// Released last, after the removal listener ran, as the destructor may be waiting for it
+		std::lock_guard<CacheMutex> lock{ m_mutex };
+		if ( --m_backgroundTasks == 0 )
+		{
+			m_loadSignal.notify_all();
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename Factory, typename Configure>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CachedItem* LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::serveCached( typename EntryMap::iterator it, std::chrono::steady_clock::time_point now, Factory& factory, Configure& configure, bool pin )
+	{
+		CacheEntry& metadata{ it->second.metadata };
+
+		if ( !metadata.isExpired( now ) )
+		{
+			metadata.touch( now ); // Reset expiration
+			m_policy.onAccess( &metadata, entryHasher() ); // Mark as recent
+
+			if ( isRefreshDue( metadata, now ) )
+			{
+				queueRefresh( it, factory, configure );
+			}
+
+			return acquire( it->second, pin );
+		}
+
+		// Serve the stale value, not renewed, while it is reloaded in the background
+		if ( isServableStale( metadata, now ) && ( metadata.refreshing || queueRefresh( it, factory, configure ) ) )
+		{
+			m_policy.onAccess( &metadata, entryHasher() );
+
+			return acquire( it->second, pin );
+		}
+
+		eraseEntry( it, RemovalCause::Expired ); // Clean expired
+		m_stats.recordExpirations( 1 );
+
+		return nullptr;
+	}
+
+	//----------------------------------------------
+	// Asynchronous loading
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename Factory>
+	inline typename LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::CachedItem* LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::findAsync( const TKey& key, Factory& factory )
+	{
+		const auto now{ Clock::now() };
+
+		CachedItem* sharedHit{ nullptr };
+		if ( tryFindShared( key, now, true, sharedHit ) && sharedHit != nullptr )
+		{
+			m_stats.recordHits( 1 );
+
+			return sharedHit;
+		}
+
+		ExclusiveLock lock{ *this };
+		drainReadBuffers();
+		checkAndPerformBackgroundCleanup( now );
+
+		auto it{ m_cache.find( key ) };
+		if ( it == m_cache.end() )
+		{
+			return nullptr; // The miss is counted once awaited
+		}
+
+		std::nullptr_t configure{ nullptr };
+		CachedItem* item{ serveCached( it, now, factory, configure, true ) };
+		if ( item != nullptr )
+		{
+			m_stats.recordHits( 1 );
+		}
+
+		return item;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline bool LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::awaitLoad( AsyncWaiter& waiter )
+	{
+		const auto now{ Clock::now() };
+
+		ExclusiveLock lock{ *this };
+		drainReadBuffers();
+
+		// A load may have completed between getAsync() and co_await
+		auto it{ m_cache.find( waiter.key ) };
+		if ( it != m_cache.end() )
+		{
+			std::nullptr_t configure{ nullptr };
+			if ( CachedItem* item{ serveCached( it, now, waiter.factory, configure, true ) } )
+			{
+				m_stats.recordHits( 1 );
+				waiter.value = ValueHandle{ this, &item->value, &item->metadata };
+
+				return false;
+			}
+		}
+		else if ( isKnownAbsent( waiter.key, now ) )
+		{
+			m_stats.recordHits( 1 ); // Completes with an empty handle
+
+			return false;
+		}
+
+		m_stats.recordMisses( 1 );
+
+		if ( PendingLoad* pending{ findPendingLoad( waiter.key ) } )
+		{
+			pending->asyncWaiters.push_back( &waiter );
+		}
+		else
+		{
+			startAsyncLoad( waiter, now );
+		}
+
+		// The lock is released, and the load possibly submitted and completed, after this point
+		return true;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::startAsyncLoad( AsyncWaiter& waiter, std::chrono::steady_clock::time_point now )
+	{
+		auto load{ std::make_shared<AsyncLoad>( waiter.key, waiter.factory ) };
+		load->pending.asyncWaiters.push_back( &waiter );
+
+		Promotion promotion{ &load->key };
+		if ( takeDemoted( load->key, now, promotion ) )
+		{
+			load->promotion.emplace( std::move( promotion ) );
+		}
+
+		m_asyncLoadQueue.reserve( m_asyncLoadQueue.size() + 1 );
+		addPendingLoad( load->pending );
+		m_asyncLoadQueue.push_back( std::move( load ) );
+		++m_backgroundTasks;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::submitAsyncLoad( std::shared_ptr<AsyncLoad> load ) noexcept
+	{
+		AsyncLoad& pending{ *load };
+
+		try
+		{
+			std::function<void()> task{ [this, load]() { runAsyncLoad( *load ); } };
+
+			if ( m_options.loadExecutor() )
+			{
+				m_options.loadExecutor()( std::move( task ) );
+			}
+			else
+			{
+				std::thread{ std::move( task ) }.detach();
+			}
+		}
+		catch ( ... )
+		{
+			// Rejected by the executor: the load will not run, so its waiters get the error
+			completeAsyncLoad( pending, std::nullopt, CacheEntry{}, std::current_exception() );
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::runAsyncLoad( AsyncLoad& load ) noexcept
+	{
+		// A value taken from the second tier when the load started is restored instead of loaded
+		if ( load.promotion && restoreDemoted( *load.promotion, Clock::now() ) )
+		{
+			completeAsyncLoad( load, std::move( load.promotion->value ), std::move( load.promotion->metadata ), nullptr );
+
+			return;
+		}
+
+		std::optional<TValue> value;
+		CacheEntry metadata{ newEntryMetadata() };
+		std::exception_ptr error;
+		const auto loadStart{ m_stats.loadStart() };
+
+		try
+		{
+			value.emplace( load.factory() );
+			m_stats.recordLoad( loadStart, false );
+			metadata.resetTimestamps( Clock::now() ); // Expiration starts once the value exists, not when loading began
+
+			if ( m_sizer )
+			{
+				metadata.size = m_sizer( load.key, *value );
+			}
+		}
+		catch ( ... )
+		{
+			if ( !value )
+			{
+				m_stats.recordLoad( loadStart, true );
+			}
+
+			value.reset();
+			error = std::current_exception();
+		}
+
+		completeAsyncLoad( load, std::move( value ), std::move( metadata ), error );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::completeAsyncLoad( AsyncLoad& load, std::optional<TValue> value, CacheEntry metadata, std::exception_ptr error ) noexcept
+	{
+		{
+			ExclusiveLock lock{ *this };
+			drainReadBuffers();
+
+			if ( value )
+			{
+				insertEntry( load.key, std::move( *value ), std::move( metadata ) );
+			}
+
+			// Waits for the get() calls blocked on this load, then resumes the asynchronous waiters
+			completePendingLoads( lock, { &load.pending, 1 }, error );
+		}
+
+		// Released last, after the waiters were resumed, as the destructor may be waiting for it
+		std::lock_guard<CacheMutex> lock{ m_mutex };
+		if ( --m_backgroundTasks == 0 )
+		{
+			m_loadSignal.notify_all();
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::settleAsyncWaiters( PendingLoad& pending )
+	{
+		for ( AsyncWaiter* waiter : pending.asyncWaiters )
+		{
+			if ( pending.error )
+			{
+				waiter->error = pending.error;
+			}
+			else if ( !pending.absent ) // Waiters of a key without a value get an empty handle
+			{
+				auto it{ m_cache.find( waiter->key ) };
+				if ( it == m_cache.end() )
+				{
+					// Evicted by the batch that loaded it: load it again rather than resume empty-handed
+					if ( PendingLoad* retry{ findPendingLoad( waiter->key ) } )
+					{
+						retry->asyncWaiters.push_back( waiter );
+					}
+					else
+					{
+						startAsyncLoad( *waiter, Clock::now() );
+					}
+
+					continue;
+				}
+
+				waiter->value = ValueHandle{ this, &acquire( it->second, true )->value, &it->second.metadata };
+			}
+
+			m_asyncResumptions.push_back( waiter );
+		}
+
+		pending.asyncWaiters.clear();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void LruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::resumeWaiter( AsyncWaiter* waiter ) noexcept
+	{
+		if ( waiter->continuation )
+		{
+			// The awaitable owns the waiter, and may be destroyed by the time resume() returns
+			waiter->continuation.resume();
+
+			return;
+		}
+
+		std::unique_ptr<AsyncWaiter> owned{ waiter };
+		if ( owned->error )
+		{
+			owned->promise->set_exception( owned->error );
+		}
+		else
+		{
+			owned->promise->set_value( std::move( owned->value ) );
 		}
 	}
 } // namespace nfx::cache
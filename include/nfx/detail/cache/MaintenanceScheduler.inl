@@ -0,0 +1,213 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file MaintenanceScheduler.inl
+ * @brief Implementation of the background maintenance scheduler
+ */
+
+#include <algorithm>
+#include <utility>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// MaintenanceScheduler::Registration
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline MaintenanceScheduler::Registration::Registration( MaintenanceScheduler* scheduler, std::uint64_t id ) noexcept
+		: m_scheduler{ scheduler },
+		  m_id{ id }
+	{
+	}
+
+	inline MaintenanceScheduler::Registration::Registration( Registration&& other ) noexcept
+		: m_scheduler{ std::exchange( other.m_scheduler, nullptr ) },
+		  m_id{ std::exchange( other.m_id, 0 ) }
+	{
+	}
+
+	//----------------------------------------------
+	// Assignment operations
+	//----------------------------------------------
+
+	inline MaintenanceScheduler::Registration& MaintenanceScheduler::Registration::operator=( Registration&& other ) noexcept
+	{
+		if ( this != &other )
+		{
+			reset();
+			m_scheduler = std::exchange( other.m_scheduler, nullptr );
+			m_id = std::exchange( other.m_id, 0 );
+		}
+
+		return *this;
+	}
+
+	//----------------------------------------------
+	// Destruction
+	//----------------------------------------------
+
+	inline MaintenanceScheduler::Registration::~Registration()
+	{
+		reset();
+	}
+
+	//----------------------------------------------
+	// State inspection
+	//----------------------------------------------
+
+	inline MaintenanceScheduler::Registration::operator bool() const noexcept
+	{
+		return m_scheduler != nullptr;
+	}
+
+	//----------------------------------------------
+	// Modification operations
+	//----------------------------------------------
+
+	inline void MaintenanceScheduler::Registration::reset() noexcept
+	{
+		if ( m_scheduler != nullptr )
+		{
+			std::exchange( m_scheduler, nullptr )->unschedule( std::exchange( m_id, 0 ) );
+		}
+	}
+
+	//=====================================================================
+	// MaintenanceScheduler
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline MaintenanceScheduler::MaintenanceScheduler()
+		: m_thread{ [this]( std::stop_token stop ) { run( stop ); } }
+	{
+	}
+
+	//----------------------------------------------
+	// Scheduling
+	//----------------------------------------------
+
+	inline MaintenanceScheduler::Registration MaintenanceScheduler::schedule( std::chrono::milliseconds interval, std::function<void()> task )
+	{
+		std::uint64_t id{ 0 };
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+
+			id = m_nextId++;
+			m_tasks.push_back( std::make_unique<Task>( Task{ id, interval, std::chrono::steady_clock::now() + interval, std::move( task ) } ) );
+			m_changed = true;
+		}
+
+		m_signal.notify_all();
+
+		return Registration{ this, id };
+	}
+
+	inline std::size_t MaintenanceScheduler::taskCount() const
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		return m_tasks.size();
+	}
+
+	inline MaintenanceScheduler& MaintenanceScheduler::shared()
+	{
+		static MaintenanceScheduler instance;
+
+		return instance;
+	}
+
+	//----------------------------------------------
+	// Private helper methods
+	//----------------------------------------------
+
+	inline void MaintenanceScheduler::unschedule( std::uint64_t id ) noexcept
+	{
+		std::unique_lock<std::mutex> lock{ m_mutex };
+
+		// A task releasing its own registration (e.g. destroying its cache) must not wait on itself
+		if ( std::this_thread::get_id() != m_thread.get_id() )
+		{
+			m_signal.wait( lock, [this, id]() { return m_runningId != id; } );
+		}
+
+		std::erase_if( m_tasks, [id]( const std::unique_ptr<Task>& task ) { return task->id == id; } );
+	}
+
+	inline void MaintenanceScheduler::run( std::stop_token stop )
+	{
+		std::unique_lock<std::mutex> lock{ m_mutex };
+
+		while ( !stop.stop_requested() )
+		{
+			m_changed = false;
+
+			auto next{ std::min_element( m_tasks.begin(), m_tasks.end(), []( const std::unique_ptr<Task>& a, const std::unique_ptr<Task>& b ) { return a->due < b->due; } ) };
+			if ( next == m_tasks.end() )
+			{
+				m_signal.wait( lock, stop, [this]() { return m_changed; } );
+
+				continue;
+			}
+
+			// Copied: the task may be unscheduled while the lock is released by the wait
+			const auto due{ ( *next )->due };
+			if ( due > std::chrono::steady_clock::now() )
+			{
+				// Woken early when a task is added, as it may be due sooner
+				m_signal.wait_until( lock, stop, due, [this]() { return m_changed; } );
+
+				continue;
+			}
+
+			// Other threads cannot unschedule the task while it runs, so it keeps its address without the lock
+			Task* task{ next->get() };
+			const std::uint64_t id{ task->id };
+			m_runningId = id;
+			lock.unlock();
+
+			task->run();
+
+			lock.lock();
+			m_runningId = 0;
+
+			// Looked up again: the run may have released its own registration
+			auto ran{ std::find_if( m_tasks.begin(), m_tasks.end(), [id]( const std::unique_ptr<Task>& candidate ) { return candidate->id == id; } ) };
+			if ( ran != m_tasks.end() )
+			{
+				( *ran )->due = std::chrono::steady_clock::now() + ( *ran )->interval;
+			}
+
+			m_signal.notify_all();
+		}
+	}
+} // namespace nfx::cache
@@ -0,0 +1,513 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file ShardedLruCache.inl
+ * @brief Implementation of ShardedLruCache template methods
+ * @details Shard selection and forwarding of cache operations to the owning shard
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <thread>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// ShardedLruCache
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ShardedLruCache( const LruCacheOptions& options, std::size_t shardCount, SizeFunction sizer, RemovalListener listener )
+		: m_hasher{},
+		  m_shardMask{ 0 },
+		  m_sizeLimit{ options.sizeLimit() },
+		  m_memoryLimit{ options.memoryLimit() }
+	{
+		if ( shardCount == 0 )
+		{
+			shardCount = std::max<std::size_t>( std::thread::hardware_concurrency(), 1 );
+		}
+
+		shardCount = std::bit_ceil( shardCount );
+
+		// A shard with a zero limit would be unlimited, so never create more shards than the limits allow
+		if ( m_sizeLimit > 0 && shardCount > m_sizeLimit )
+		{
+			shardCount = std::bit_floor( m_sizeLimit );
+		}
+
+		if ( m_memoryLimit > 0 && shardCount > m_memoryLimit )
+		{
+			shardCount = std::bit_floor( m_memoryLimit );
+		}
+
+		m_shardMask = shardCount - 1;
+		m_shards.reserve( shardCount );
+
+		// One maintenance thread for the whole cache rather than one per shard
+		LruCacheOptions sharedOptions{ options };
+		if ( options.maintenanceThread() && options.maintenanceScheduler() == nullptr )
+		{
+			m_scheduler = std::make_unique<MaintenanceScheduler>();
+			sharedOptions.setMaintenanceScheduler( m_scheduler.get() );
+		}
+
+		for ( std::size_t i{ 0 }; i < shardCount; ++i )
+		{
+			// Spread the remainder over the first shards so per-shard limits sum to the total
+			const std::size_t shardSizeLimit{ m_sizeLimit / shardCount + ( i < m_sizeLimit % shardCount ? 1 : 0 ) };
+			const std::size_t shardMemoryLimit{ m_memoryLimit / shardCount + ( i < m_memoryLimit % shardCount ? 1 : 0 ) };
+
+			// Tombstone and second tier limits round up to one per shard, as zero would disable them
+			const std::size_t negativeSizeLimit{ options.negativeSizeLimit() };
+			const std::size_t shardNegativeSizeLimit{ negativeSizeLimit > 0 ? std::max<std::size_t>( 1, negativeSizeLimit / shardCount + ( i < negativeSizeLimit % shardCount ? 1 : 0 ) ) : 0 };
+			const std::size_t secondTierLimit{ options.secondTierMemoryLimit() };
+			const std::size_t shardSecondTierLimit{ secondTierLimit > 0 ? std::max<std::size_t>( 1, secondTierLimit / shardCount + ( i < secondTierLimit % shardCount ? 1 : 0 ) ) : 0 };
+
+			LruCacheOptions shardOptions{ sharedOptions };
+			shardOptions.setSizeLimit( shardSizeLimit ).setMemoryLimit( shardMemoryLimit ).setNegativeSizeLimit( shardNegativeSizeLimit ).setSecondTierMemoryLimit( shardSecondTierLimit );
+
+			m_shards.push_back( std::make_unique<ShardType>( shardOptions, sizer, listener ) );
+		}
+	}
+
+	//----------------------------------------------
+	// Cache operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <EntryLoader<TValue> Factory, EntryConfigurator Configure>
+	inline TValue* ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::get( const TKey& key, Factory&& factory, Configure&& configure )
+	{
+		return shardFor( key ).get( key, std::forward<Factory>( factory ), std::forward<Configure>( configure ) );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K, EntryLoader<TValue> Factory, EntryConfigurator Configure>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline TValue* ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::get( const K& key, Factory&& factory, Configure&& configure )
+	{
+		return shardFor( key ).get( key, std::forward<Factory>( factory ), std::forward<Configure>( configure ) );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <EntryLoader<TValue> Factory, EntryConfigurator Configure>
+	inline typename ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getPinned( const TKey& key, Factory&& factory, Configure&& configure )
+	{
+		return shardFor( key ).getPinned( key, std::forward<Factory>( factory ), std::forward<Configure>( configure ) );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K, EntryLoader<TValue> Factory, EntryConfigurator Configure>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline typename ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getPinned( const K& key, Factory&& factory, Configure&& configure )
+	{
+		return shardFor( key ).getPinned( key, std::forward<Factory>( factory ), std::forward<Configure>( configure ) );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getMany( std::span<const TKey> keys, std::span<TValue*> results, BatchFactoryFunction factory, ConfigFunction configure )
+	{
+		return getManyImpl( keys, results, std::move( factory ), std::move( configure ) );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <std::ranges::contiguous_range Keys>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getMany( const Keys& keys, std::span<TValue*> results, BatchFactoryFunction factory, ConfigFunction configure )
+	{
+		return getManyImpl( std::span<const std::ranges::range_value_t<Keys>>{ keys }, results, std::move( factory ), std::move( configure ) );
+	}
+
+	//----------------------------------------------
+	// Asynchronous operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <EntryFactory<TValue> Factory>
+		requires std::copy_constructible<std::remove_cvref_t<Factory>>
+	inline typename ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::GetAwaitable ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getAsync( const TKey& key, Factory&& factory )
+	{
+		return shardFor( key ).getAsync( key, std::forward<Factory>( factory ) );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <EntryFactory<TValue> Factory>
+		requires std::copy_constructible<std::remove_cvref_t<Factory>>
+	inline std::future<typename ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle> ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getFuture( const TKey& key, Factory&& factory )
+	{
+		return shardFor( key ).getFuture( key, std::forward<Factory>( factory ) );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::getManyImpl( std::span<const K> keys, std::span<TValue*> results, BatchFactoryFunction factory, ConfigFunction configure )
+	{
+		std::size_t loaded{ 0 };
+		std::vector<TValue*> shardResults;
+
+		forEachShardBatch( keys, [&]( ShardType& shard, std::span<const K> shardKeys, std::span<const std::size_t> positions ) {
+			shardResults.resize( shardKeys.size() );
+			loaded += shard.getMany( shardKeys, shardResults, factory, configure );
+
+			for ( std::size_t j{ 0 }; j < positions.size(); ++j )
+			{
+				results[positions[j]] = shardResults[j];
+			}
+		} );
+
+		return loaded;
+	}
+
+	//----------------------------------------------
+	// Lookup operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline TValue* ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::find( const TKey& key )
+	{
+		return shardFor( key ).find( key );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline TValue* ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::find( const K& key )
+	{
+		return shardFor( key ).find( key );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline typename ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::findPinned( const TKey& key )
+	{
+		return shardFor( key ).findPinned( key );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline typename ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ValueHandle ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::findPinned( const K& key )
+	{
+		return shardFor( key ).findPinned( key );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::findMany( std::span<const TKey> keys, std::span<TValue*> results )
+	{
+		return findManyImpl( keys, results );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <std::ranges::contiguous_range Keys>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::findMany( const Keys& keys, std::span<TValue*> results )
+	{
+		return findManyImpl( std::span<const std::ranges::range_value_t<Keys>>{ keys }, results );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::findManyImpl( std::span<const K> keys, std::span<TValue*> results )
+	{
+		std::size_t hits{ 0 };
+		std::vector<TValue*> shardResults;
+
+		forEachShardBatch( keys, [&]( ShardType& shard, std::span<const K> shardKeys, std::span<const std::size_t> positions ) {
+			shardResults.resize( shardKeys.size() );
+			hits += shard.findMany( shardKeys, shardResults );
+
+			for ( std::size_t j{ 0 }; j < positions.size(); ++j )
+			{
+				results[positions[j]] = shardResults[j];
+			}
+		} );
+
+		return hits;
+	}
+
+	//----------------------------------------------
+	// Modification operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename V, EntryConfigurator Configure>
+		requires std::constructible_from<TValue, V>
+	inline TValue* ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::set( const TKey& key, V&& value, Configure&& configure )
+	{
+		return shardFor( key ).set( key, std::forward<V>( value ), std::forward<Configure>( configure ) );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename V>
+		requires std::constructible_from<TValue, V>
+	inline std::pair<TValue*, bool> ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::insertOrAssign( const TKey& key, V&& value )
+	{
+		return shardFor( key ).insertOrAssign( key, std::forward<V>( value ) );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename... Args>
+		requires std::constructible_from<TValue, Args...>
+	inline std::pair<TValue*, bool> ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::emplace( const TKey& key, Args&&... args )
+	{
+		return shardFor( key ).emplace( key, std::forward<Args>( args )... );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline bool ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::remove( const TKey& key )
+	{
+		return shardFor( key ).remove( key );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline bool ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::remove( const K& key )
+	{
+		return shardFor( key ).remove( key );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::removeMany( std::span<const TKey> keys )
+	{
+		return removeManyImpl( keys );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <std::ranges::contiguous_range Keys>
+		requires TransparentKeyLookup<Hash, KeyEqual>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::removeMany( const Keys& keys )
+	{
+		return removeManyImpl( std::span<const std::ranges::range_value_t<Keys>>{ keys } );
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::removeManyImpl( std::span<const K> keys )
+	{
+		std::size_t removed{ 0 };
+
+		forEachShardBatch( keys, [&]( ShardType& shard, std::span<const K> shardKeys, std::span<const std::size_t> ) {
+			removed += shard.removeMany( shardKeys );
+		} );
+
+		return removed;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::clear()
+	{
+		for ( auto& shard : m_shards )
+		{
+			shard->clear();
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::size() const
+	{
+		std::size_t total{ 0 };
+		for ( const auto& shard : m_shards )
+		{
+			total += shard->size();
+		}
+
+		return total;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::memoryUsage() const
+	{
+		std::size_t total{ 0 };
+		for ( const auto& shard : m_shards )
+		{
+			total += shard->memoryUsage();
+		}
+
+		return total;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::tombstoneCount() const
+	{
+		std::size_t total{ 0 };
+		for ( const auto& shard : m_shards )
+		{
+			total += shard->tombstoneCount();
+		}
+
+		return total;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::secondTierSize() const
+	{
+		std::size_t total{ 0 };
+		for ( const auto& shard : m_shards )
+		{
+			total += shard->secondTierSize();
+		}
+
+		return total;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::secondTierMemoryUsage() const
+	{
+		std::size_t total{ 0 };
+		for ( const auto& shard : m_shards )
+		{
+			total += shard->secondTierMemoryUsage();
+		}
+
+		return total;
+	}
+
+	//----------------------------------------------
+	// State inspection
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline bool ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::isEmpty() const
+	{
+		for ( const auto& shard : m_shards )
+		{
+			if ( !shard->isEmpty() )
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline CacheStats ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::stats() const noexcept
+	{
+		CacheStats total;
+		for ( const auto& shard : m_shards )
+		{
+			total += shard->stats();
+		}
+
+		return total;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline void ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::cleanupExpired()
+	{
+		for ( auto& shard : m_shards )
+		{
+			shard->cleanupExpired();
+		}
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::shardCount() const noexcept
+	{
+		return m_shards.size();
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::sizeLimit() const noexcept
+	{
+		return m_sizeLimit;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::memoryLimit() const noexcept
+	{
+		return m_memoryLimit;
+	}
+
+	//----------------------------------------------
+	// Shard selection
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline std::size_t ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::shardIndexFor( const K& key ) const
+	{
+		// Fibonacci mixing decorrelates shard selection from the shard's own bucket selection,
+		// which matters for identity hashes such as std::hash<int>
+		const std::uint64_t mixed{ static_cast<std::uint64_t>( m_hasher( key ) ) * 0x9E3779B97F4A7C15ull };
+
+		return static_cast<std::size_t>( mixed >> 32 ) & m_shardMask;
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K>
+	inline typename ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::ShardType& ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::shardFor( const K& key ) const
+	{
+		return *m_shards[shardIndexFor( key )];
+	}
+
+	template <typename TKey, typename TValue, typename Hash, typename KeyEqual, typename Index, typename Policy, typename Clock, typename Stats>
+	template <typename K, typename Apply>
+	inline void ShardedLruCache<TKey, TValue, Hash, KeyEqual, Index, Policy, Clock, Stats>::forEachShardBatch( std::span<const K> keys, Apply&& apply ) const
+	{
+		// Counting sort of the key positions by shard, keeping the batch order within each shard
+		std::vector<std::size_t> shardOf( keys.size() );
+		std::vector<std::size_t> offsets( m_shards.size() + 1, 0 );
+		for ( std::size_t i{ 0 }; i < keys.size(); ++i )
+		{
+			shardOf[i] = shardIndexFor( keys[i] );
+			++offsets[shardOf[i] + 1];
+		}
+
+		for ( std::size_t shard{ 0 }; shard < m_shards.size(); ++shard )
+		{
+			offsets[shard + 1] += offsets[shard];
+		}
+
+		std::vector<std::size_t> positions( keys.size() );
+		std::vector<std::size_t> cursors( offsets.begin(), offsets.end() - 1 );
+		for ( std::size_t i{ 0 }; i < keys.size(); ++i )
+		{
+			positions[cursors[shardOf[i]]++] = i;
+		}
+
+		std::vector<K> shardKeys;
+		shardKeys.reserve( keys.size() );
+		for ( const std::size_t i : positions )
+		{
+			shardKeys.push_back( keys[i] );
+		}
+
+		for ( std::size_t shard{ 0 }; shard < m_shards.size(); ++shard )
+		{
+			const std::size_t count{ offsets[shard + 1] - offsets[shard] };
+			if ( count > 0 )
+			{
+				apply( *m_shards[shard], std::span<const K>{ shardKeys }.subspan( offsets[shard], count ), std::span<const std::size_t>{ positions }.subspan( offsets[shard], count ) );
+			}
+		}
+	}
+} // namespace nfx::cache
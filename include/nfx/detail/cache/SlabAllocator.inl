@@ -0,0 +1,224 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file SlabAllocator.inl
+ * @brief Implementation of SlabPool and SlabAllocator
+ * @details Slab carving, free list recycling and heap fallback for non-node requests
+ */
+
+#include <algorithm>
+#include <new>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// SlabPool
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline SlabPool::SlabPool( std::size_t initialCapacity, std::size_t minBlockSize ) noexcept
+		: m_freeList{ nullptr },
+		  m_initialCapacity{ initialCapacity },
+		  m_minBlockSize{ minBlockSize },
+		  m_blockSize{ 0 },
+		  m_blockAlignment{ 0 },
+		  m_blockStride{ 0 },
+		  m_capacity{ 0 },
+		  m_inUse{ 0 }
+	{
+	}
+
+	//----------------------------------------------
+	// Destruction
+	//----------------------------------------------
+
+	inline SlabPool::~SlabPool()
+	{
+		for ( std::byte* slab : m_slabs )
+		{
+			::operator delete( slab, std::align_val_t{ m_blockAlignment } );
+		}
+	}
+
+	//----------------------------------------------
+	// Block management
+	//----------------------------------------------
+
+	inline void* SlabPool::allocate( std::size_t bytes, std::size_t alignment )
+	{
+		if ( m_blockSize == 0 && bytes >= m_minBlockSize )
+		{
+			// First node request fixes the block shape
+			m_blockSize = bytes;
+			m_blockAlignment = std::max( alignment, alignof( FreeBlock ) );
+			const std::size_t size{ std::max( bytes, sizeof( FreeBlock ) ) };
+			m_blockStride = ( size + m_blockAlignment - 1 ) / m_blockAlignment * m_blockAlignment;
+		}
+
+		if ( !accepts( bytes, alignment ) )
+		{
+			return nullptr;
+		}
+
+		if ( m_freeList == nullptr )
+		{
+			const std::size_t initial{ m_capacity == 0 ? m_initialCapacity : 0 };
+			grow( std::max( { initial, m_capacity, std::size_t{ 64 } } ) );
+		}
+
+		FreeBlock* block{ m_freeList };
+		m_freeList = block->next;
+		++m_inUse;
+
+		return block;
+	}
+
+	inline bool SlabPool::deallocate( void* ptr, std::size_t bytes, std::size_t alignment ) noexcept
+	{
+		if ( !accepts( bytes, alignment ) )
+		{
+			return false;
+		}
+
+		FreeBlock* block{ ::new( ptr ) FreeBlock{ m_freeList } };
+		m_freeList = block;
+		--m_inUse;
+
+		return true;
+	}
+
+	//----------------------------------------------
+	// State inspection
+	//----------------------------------------------
+
+	inline std::size_t SlabPool::capacity() const noexcept
+	{
+		return m_capacity;
+	}
+
+	inline std::size_t SlabPool::inUse() const noexcept
+	{
+		return m_inUse;
+	}
+
+	//----------------------------------------------
+	// Private helper methods
+	//----------------------------------------------
+
+	inline bool SlabPool::accepts( std::size_t bytes, std::size_t alignment ) const noexcept
+	{
+		return m_blockSize != 0 && bytes == m_blockSize && alignment <= m_blockAlignment;
+	}
+
+	inline void SlabPool::grow( std::size_t blocks )
+	{
+		m_slabs.reserve( m_slabs.size() + 1 );
+
+		auto* slab{ static_cast<std::byte*>( ::operator new( blocks * m_blockStride, std::align_val_t{ m_blockAlignment } ) ) };
+		m_slabs.push_back( slab );
+
+		// Thread blocks in address order so fresh slabs are consumed sequentially
+		for ( std::size_t i{ blocks }; i-- > 0; )
+		{
+			m_freeList = ::new( slab + i * m_blockStride ) FreeBlock{ m_freeList };
+		}
+
+		m_capacity += blocks;
+	}
+
+	//=====================================================================
+	// SlabAllocator
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	template <typename T>
+	inline SlabAllocator<T>::SlabAllocator( SlabPool* pool ) noexcept
+		: m_pool{ pool }
+	{
+	}
+
+	template <typename T>
+	template <typename U>
+	inline SlabAllocator<T>::SlabAllocator( const SlabAllocator<U>& other ) noexcept
+		: m_pool{ other.pool() }
+	{
+	}
+
+	//----------------------------------------------
+	// Allocation
+	//----------------------------------------------
+
+	template <typename T>
+	inline T* SlabAllocator<T>::allocate( std::size_t n )
+	{
+		if ( n == 1 && m_pool != nullptr )
+		{
+			if ( void* block{ m_pool->allocate( sizeof( T ), alignof( T ) ) } )
+			{
+				return static_cast<T*>( block );
+			}
+		}
+
+		return std::allocator<T>{}.allocate( n );
+	}
+
+	template <typename T>
+	inline void SlabAllocator<T>::deallocate( T* ptr, std::size_t n ) noexcept
+	{
+		if ( n == 1 && m_pool != nullptr && m_pool->deallocate( ptr, sizeof( T ), alignof( T ) ) )
+		{
+			return;
+		}
+
+		std::allocator<T>{}.deallocate( ptr, n );
+	}
+
+	//----------------------------------------------
+	// Accessors
+	//----------------------------------------------
+
+	template <typename T>
+	inline SlabPool* SlabAllocator<T>::pool() const noexcept
+	{
+		return m_pool;
+	}
+
+	//----------------------------------------------
+	// Comparison
+	//----------------------------------------------
+
+	template <typename T>
+	template <typename U>
+	inline bool SlabAllocator<T>::operator==( const SlabAllocator<U>& other ) const noexcept
+	{
+		return m_pool == other.pool();
+	}
+} // namespace nfx::cache
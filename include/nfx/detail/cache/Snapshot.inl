@@ -0,0 +1,114 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file Snapshot.inl
+ * @brief Implementation of the snapshot format and serializers
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+namespace nfx::cache
+{
+	//=====================================================================
+	// SnapshotSerializer
+	//=====================================================================
+
+	template <typename T>
+		requires std::is_trivially_copyable_v<T>
+	inline void SnapshotSerializer<T>::write( std::vector<std::byte>& out, const T& value )
+	{
+		const std::size_t offset{ out.size() };
+		out.resize( offset + sizeof( T ) );
+		std::memcpy( out.data() + offset, &value, sizeof( T ) );
+	}
+
+	template <typename T>
+		requires std::is_trivially_copyable_v<T>
+	inline T SnapshotSerializer<T>::read( std::span<const std::byte> bytes )
+	{
+		if ( bytes.size() != sizeof( T ) )
+		{
+			throw std::runtime_error{ "Snapshot field size does not match the serialized type" };
+		}
+
+		T value;
+		std::memcpy( &value, bytes.data(), sizeof( T ) );
+
+		return value;
+	}
+
+	inline void SnapshotSerializer<std::string>::write( std::vector<std::byte>& out, const std::string& value )
+	{
+		const std::size_t offset{ out.size() };
+		out.resize( offset + value.size() );
+		std::memcpy( out.data() + offset, value.data(), value.size() );
+	}
+
+	inline std::string SnapshotSerializer<std::string>::read( std::span<const std::byte> bytes )
+	{
+		return std::string{ reinterpret_cast<const char*>( bytes.data() ), bytes.size() };
+	}
+
+	//=====================================================================
+	// SnapshotHeader
+	//=====================================================================
+
+	inline void SnapshotHeader::write( std::ostream& out ) const
+	{
+		const std::uint32_t version{ VERSION };
+		const std::uint32_t reserved{ 0 };
+
+		out.write( MAGIC.data(), MAGIC.size() );
+		out.write( reinterpret_cast<const char*>( &version ), sizeof( version ) );
+		out.write( reinterpret_cast<const char*>( &reserved ), sizeof( reserved ) );
+		out.write( reinterpret_cast<const char*>( &count ), sizeof( count ) );
+	}
+
+	inline SnapshotHeader SnapshotHeader::read( std::istream& in )
+	{
+		std::array<char, 8> magic{};
+		std::uint32_t version{ 0 };
+		std::uint32_t reserved{ 0 };
+		SnapshotHeader header;
+
+		in.read( magic.data(), magic.size() );
+		in.read( reinterpret_cast<char*>( &version ), sizeof( version ) );
+		in.read( reinterpret_cast<char*>( &reserved ), sizeof( reserved ) );
+		in.read( reinterpret_cast<char*>( &header.count ), sizeof( header.count ) );
+
+		if ( !in || magic != MAGIC )
+		{
+			throw std::runtime_error{ "Not a cache snapshot" };
+		}
+
+		if ( version != VERSION )
+		{
+			throw std::runtime_error{ "Unsupported cache snapshot version" };
+		}
+
+		return header;
+	}
+} // namespace nfx::cache
@@ -0,0 +1,148 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TESTS_CacheStats.cpp
+ * @brief Tests for cache statistics collectors
+ * @details Tests covering the snapshot arithmetic and the striped counters
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <nfx/cache/CacheStats.h>
+
+namespace nfx::cache::test
+{
+	//=====================================================================
+	// CacheStats Tests
+	//=====================================================================
+
+	TEST( CacheStats, DerivedValues )
+	{
+		CacheStats stats;
+		EXPECT_EQ( stats.hitRatio(), 0.0 );
+		EXPECT_EQ( stats.averageLoadTime(), std::chrono::nanoseconds{ 0 } );
+
+		stats.hits = 3;
+		stats.misses = 1;
+		stats.loads = 2;
+		stats.totalLoadTime = std::chrono::nanoseconds{ 100 };
+		EXPECT_DOUBLE_EQ( stats.hitRatio(), 0.75 );
+		EXPECT_EQ( stats.averageLoadTime(), std::chrono::nanoseconds{ 50 } );
+	}
+
+	TEST( CacheStats, SnapshotsAdd )
+	{
+		CacheStats total{ 1, 2, 3, 4, 5, 6, 7, std::chrono::nanoseconds{ 8 } };
+		total += CacheStats{ 1, 1, 1, 1, 1, 1, 1, std::chrono::nanoseconds{ 1 } };
+
+		EXPECT_EQ( total.hits, 2 );
+		EXPECT_EQ( total.misses, 3 );
+		EXPECT_EQ( total.inserts, 4 );
+		EXPECT_EQ( total.evictions, 5 );
+		EXPECT_EQ( total.expirations, 6 );
+		EXPECT_EQ( total.loads, 7 );
+		EXPECT_EQ( total.loadFailures, 8 );
+		EXPECT_EQ( total.totalLoadTime, std::chrono::nanoseconds{ 9 } );
+	}
+
+	//=====================================================================
+	// NoStats Tests
+	//=====================================================================
+
+	TEST( NoStats, RecordsNothing )
+	{
+		static_assert( std::is_empty_v<NoStats> );
+
+		NoStats stats;
+		stats.recordHits( 10 );
+		stats.recordLoad( stats.loadStart(), true );
+
+		EXPECT_EQ( stats.loadStart(), std::chrono::steady_clock::time_point{} );
+		EXPECT_EQ( stats.snapshot().hits, 0 );
+		EXPECT_EQ( stats.snapshot().loads, 0 );
+	}
+
+	//=====================================================================
+	// StripedStats Tests
+	//=====================================================================
+
+	TEST( StripedStats, CountsEveryRecorder )
+	{
+		StripedStats stats;
+		stats.recordHits( 3 );
+		stats.recordMisses( 2 );
+		stats.recordInserts( 2 );
+		stats.recordEvictions( 1 );
+		stats.recordExpirations( 4 );
+
+		const auto start{ stats.loadStart() };
+		std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+		stats.recordLoad( start, false );
+		stats.recordLoad( stats.loadStart(), true );
+
+		const CacheStats snapshot{ stats.snapshot() };
+		EXPECT_EQ( snapshot.hits, 3 );
+		EXPECT_EQ( snapshot.misses, 2 );
+		EXPECT_EQ( snapshot.inserts, 2 );
+		EXPECT_EQ( snapshot.evictions, 1 );
+		EXPECT_EQ( snapshot.expirations, 4 );
+		EXPECT_EQ( snapshot.loads, 2 );
+		EXPECT_EQ( snapshot.loadFailures, 1 );
+		EXPECT_GE( snapshot.totalLoadTime, std::chrono::milliseconds( 2 ) );
+	}
+
+	TEST( StripedStats, SnapshotSumsAllThreads )
+	{
+		StripedStats stats;
+
+		constexpr int numThreads{ 8 };
+		constexpr int perThread{ 10000 };
+		std::vector<std::thread> threads;
+
+		for ( int t{ 0 }; t < numThreads; ++t )
+		{
+			threads.emplace_back( [&stats]() {
+				for ( int i{ 0 }; i < perThread; ++i )
+				{
+					stats.recordHits( 1 );
+					stats.recordMisses( 2 );
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		EXPECT_EQ( stats.snapshot().hits, numThreads * perThread );
+		EXPECT_EQ( stats.snapshot().misses, 2 * numThreads * perThread );
+	}
+} // namespace nfx::cache::test
@@ -0,0 +1,80 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TESTS_Clock.cpp
+ * @brief Tests for cache time sources
+ * @details Tests covering the steady, coarse ticker-driven and manual clocks
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include <nfx/cache/Clock.h>
+
+namespace nfx::cache::test
+{
+	//=====================================================================
+	// Clock Tests
+	//=====================================================================
+
+	TEST( SteadyClock, FollowsSteadyClock )
+	{
+		const auto before = std::chrono::steady_clock::now();
+		const auto now = SteadyClock::now();
+		const auto after = std::chrono::steady_clock::now();
+
+		EXPECT_LE( before, now );
+		EXPECT_LE( now, after );
+	}
+
+	TEST( CoarseClock, AdvancesOncePerTick )
+	{
+		using Clock = CoarseClock<5>;
+		EXPECT_EQ( Clock::resolution(), std::chrono::milliseconds( 5 ) );
+
+		const auto start = Clock::now();
+		EXPECT_LE( start, std::chrono::steady_clock::now() );
+
+		// Ticks never run ahead of the steady clock and follow it within a few intervals
+		std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+		const auto later = Clock::now();
+		EXPECT_GT( later, start );
+		EXPECT_LE( later, std::chrono::steady_clock::now() );
+	}
+
+	TEST( ManualClock, MovesOnlyWhenAdvanced )
+	{
+		const auto start = ManualClock::now();
+		EXPECT_EQ( ManualClock::now(), start );
+
+		ManualClock::advance( std::chrono::milliseconds( 250 ) );
+		EXPECT_EQ( ManualClock::now() - start, std::chrono::milliseconds( 250 ) );
+
+		ManualClock::set( start + std::chrono::hours( 1 ) );
+		EXPECT_EQ( ManualClock::now(), start + std::chrono::hours( 1 ) );
+	}
+} // namespace nfx::cache::test
@@ -0,0 +1,374 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file TESTS_CompactLruCache.cpp
+ * @brief Tests for CompactLruCache slot storage, key index and expiration classes
+ * @details Tests covering cache operations, LRU eviction across expiration classes,
+ *          index deletion under collisions, epoch rebasing and single-flight loading
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nfx/cache/CompactLruCache.h>
+
+namespace nfx::cache::test
+{
+	//=====================================================================
+	// Test helpers
+	//=====================================================================
+
+	/** @brief Compact cache on ManualClock, so expiration tests advance time instead of sleeping */
+	template <typename TKey, typename TValue, typename Hash = std::hash<TKey>>
+	using ManualCompactCache = CompactLruCache<TKey, TValue, Hash, std::equal_to<TKey>, ManualClock>;
+
+	/** @brief Hash sending every key to the same home bucket */
+	struct CollidingHash
+	{
+		std::size_t operator()( int ) const noexcept { return 0; }
+	};
+
+	//=====================================================================
+	// CompactLruCache Tests
+	//=====================================================================
+
+	//----------------------------------------------
+	// Layout
+	//----------------------------------------------
+
+	TEST( CompactLruCacheLayout, MetadataIsAtMostHalfOfCacheEntry )
+	{
+		EXPECT_EQ( sizeof( CompactEntry ), 16 );
+		EXPECT_LE( sizeof( CompactEntry ) * 2, sizeof( CacheEntry ) );
+	}
+
+	//----------------------------------------------
+	// Basic operations
+	//----------------------------------------------
+
+	TEST( CompactLruCacheOperations, GetFindRemoveClear )
+	{
+		CompactLruCache<std::string, std::string> cache;
+
+		EXPECT_TRUE( cache.isEmpty() );
+		EXPECT_EQ( *cache.get( "a", []() { return std::string{ "1" }; } ), "1" );
+		EXPECT_EQ( *cache.get( "a", []() { return std::string{ "should_not_create" }; } ), "1" );
+		EXPECT_EQ( *cache.get( "b", []() { return std::string{ "2" }; } ), "2" );
+		EXPECT_EQ( cache.size(), 2 );
+
+		ASSERT_NE( cache.find( "b" ), nullptr );
+		EXPECT_EQ( cache.find( "missing" ), nullptr );
+
+		EXPECT_TRUE( cache.remove( "a" ) );
+		EXPECT_FALSE( cache.remove( "a" ) );
+		EXPECT_EQ( cache.find( "a" ), nullptr );
+
+		cache.clear();
+		EXPECT_TRUE( cache.isEmpty() );
+		EXPECT_EQ( *cache.get( "b", []() { return std::string{ "3" }; } ), "3" );
+	}
+
+	TEST( CompactLruCacheOperations, ManyEntriesGrowIndexAndRecycleSlots )
+	{
+		CompactLruCache<int, int> cache;
+
+		for ( int i{ 0 }; i < 10000; ++i )
+		{
+			cache.get( i, [i]() { return i * 2; } );
+		}
+		EXPECT_EQ( cache.size(), 10000 );
+
+		for ( int i{ 0 }; i < 10000; i += 2 )
+		{
+			EXPECT_TRUE( cache.remove( i ) );
+		}
+
+		for ( int i{ 0 }; i < 10000; ++i )
+		{
+			auto* value = cache.find( i );
+			if ( i % 2 == 0 )
+			{
+				EXPECT_EQ( value, nullptr ) << i;
+			}
+			else
+			{
+				ASSERT_NE( value, nullptr ) << i;
+				EXPECT_EQ( *value, i * 2 );
+			}
+		}
+
+		// Released slots are reused by new keys
+		for ( int i{ 10000 }; i < 15000; ++i )
+		{
+			cache.get( i, [i]() { return i * 2; } );
+		}
+		EXPECT_EQ( cache.size(), 10000 );
+		EXPECT_EQ( *cache.find( 14999 ), 29998 );
+	}
+
+	TEST( CompactLruCacheOperations, RemovalKeepsCollidingKeysReachable )
+	{
+		CompactLruCache<int, int, CollidingHash> cache;
+
+		for ( int i{ 0 }; i < 12; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		// Holes left in the middle of the probe run must not cut it short
+		EXPECT_TRUE( cache.remove( 3 ) );
+		EXPECT_TRUE( cache.remove( 0 ) );
+		EXPECT_TRUE( cache.remove( 7 ) );
+
+		for ( int i{ 0 }; i < 12; ++i )
+		{
+			if ( i == 0 || i == 3 || i == 7 )
+			{
+				EXPECT_EQ( cache.find( i ), nullptr ) << i;
+			}
+			else
+			{
+				ASSERT_NE( cache.find( i ), nullptr ) << i;
+				EXPECT_EQ( *cache.find( i ), i );
+			}
+		}
+	}
+
+	//----------------------------------------------
+	// Size limits and LRU eviction
+	//----------------------------------------------
+
+	TEST( CompactLruCacheLRU, EvictsLeastRecentlyUsed )
+	{
+		CompactLruCache<int, int> cache{ LruCacheOptions{ 3 } };
+
+		cache.get( 1, []() { return 1; } );
+		cache.get( 2, []() { return 2; } );
+		cache.get( 3, []() { return 3; } );
+
+		EXPECT_NE( cache.find( 1 ), nullptr ); // 2 becomes least recently used
+
+		cache.get( 4, []() { return 4; } );
+
+		EXPECT_EQ( cache.size(), 3 );
+		EXPECT_EQ( cache.find( 2 ), nullptr );
+		EXPECT_NE( cache.find( 1 ), nullptr );
+		EXPECT_NE( cache.find( 3 ), nullptr );
+		EXPECT_NE( cache.find( 4 ), nullptr );
+	}
+
+	TEST( CompactLruCacheLRU, EvictsOldestEntryAcrossExpirationClasses )
+	{
+		ManualCompactCache<int, int> cache{ LruCacheOptions{ 3, std::chrono::minutes( 10 ) } };
+		const auto shortLived = []( CacheEntry& entry ) { entry.slidingExpiration = std::chrono::minutes( 1 ); };
+
+		cache.get( 1, []() { return 1; } );
+		ManualClock::advance( std::chrono::milliseconds( 1 ) );
+		cache.get( 2, []() { return 2; }, shortLived );
+		ManualClock::advance( std::chrono::milliseconds( 1 ) );
+		cache.get( 3, []() { return 3; } );
+		ManualClock::advance( std::chrono::milliseconds( 1 ) );
+
+		EXPECT_EQ( cache.expirationClassCount(), 2 );
+
+		cache.get( 4, []() { return 4; }, shortLived ); // Evicts 1, the oldest tail of both classes
+		EXPECT_EQ( cache.find( 1 ), nullptr );
+
+		ManualClock::advance( std::chrono::milliseconds( 1 ) );
+		cache.get( 5, []() { return 5; } ); // Then 2
+		EXPECT_EQ( cache.find( 2 ), nullptr );
+		EXPECT_NE( cache.find( 3 ), nullptr );
+		EXPECT_NE( cache.find( 4 ), nullptr );
+		EXPECT_NE( cache.find( 5 ), nullptr );
+	}
+
+	//----------------------------------------------
+	// Expiration
+	//----------------------------------------------
+
+	TEST( CompactLruCacheExpiration, SlidingExpirationPerClass )
+	{
+		ManualCompactCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 100 ) } };
+
+		cache.get( 1, []() { return 1; } );
+		cache.get( 2, []() { return 2; }, []( CacheEntry& entry ) { entry.slidingExpiration = std::chrono::seconds( 10 ); } );
+
+		ManualClock::advance( std::chrono::milliseconds( 100 ) );
+		EXPECT_NE( cache.find( 1 ), nullptr ); // Expired only once strictly older than the expiration
+
+		ManualClock::advance( std::chrono::milliseconds( 101 ) );
+		EXPECT_EQ( cache.find( 1 ), nullptr );
+		EXPECT_NE( cache.find( 2 ), nullptr );
+		EXPECT_EQ( cache.size(), 1 );
+	}
+
+	TEST( CompactLruCacheExpiration, CleanupExpiredRemovesOnlyExpiredTails )
+	{
+		ManualCompactCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 50 ) } };
+
+		for ( int i{ 0 }; i < 10; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		ManualClock::advance( std::chrono::milliseconds( 40 ) );
+		EXPECT_NE( cache.find( 3 ), nullptr ); // Renewed
+		EXPECT_NE( cache.find( 7 ), nullptr );
+
+		ManualClock::advance( std::chrono::milliseconds( 20 ) );
+		cache.cleanupExpired();
+
+		EXPECT_EQ( cache.size(), 2 );
+		EXPECT_NE( cache.find( 3 ), nullptr );
+		EXPECT_NE( cache.find( 7 ), nullptr );
+	}
+
+	TEST( CompactLruCacheExpiration, BackgroundCleanupIsIncremental )
+	{
+		ManualCompactCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 10 ), std::chrono::milliseconds( 5 ) } };
+
+		for ( int i{ 0 }; i < 25; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		ManualClock::advance( std::chrono::milliseconds( 20 ) );
+		EXPECT_EQ( cache.find( 1000 ), nullptr ); // Triggers one bounded cleanup cycle
+		EXPECT_EQ( cache.size(), 15 );
+	}
+
+	TEST( CompactLruCacheExpiration, EpochRebaseKeepsLiveEntries )
+	{
+		ManualCompactCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::hours( 1 ) } };
+
+		cache.get( 1, []() { return 1; } );
+		cache.get( 2, []() { return 2; } );
+
+		// Keep entry 1 alive for longer than 32-bit millisecond timestamps can count
+		for ( int step{ 0 }; step < 24 * 60; ++step )
+		{
+			ManualClock::advance( std::chrono::minutes( 59 ) );
+			ASSERT_NE( cache.find( 1 ), nullptr ) << "step " << step;
+		}
+
+		EXPECT_EQ( cache.find( 2 ), nullptr );
+		EXPECT_EQ( *cache.find( 1 ), 1 );
+
+		ManualClock::advance( std::chrono::minutes( 61 ) );
+		EXPECT_EQ( cache.find( 1 ), nullptr );
+	}
+
+	//----------------------------------------------
+	// Single-flight loading
+	//----------------------------------------------
+
+	TEST( CompactLruCacheSingleFlight, ConcurrentMissesShareOneFactoryCall )
+	{
+		CompactLruCache<std::string, std::string> cache;
+
+		std::atomic<int> factoryCallCount{ 0 };
+		const int numThreads{ 8 };
+		std::vector<std::thread> threads;
+		std::vector<std::string> results( numThreads );
+
+		for ( int t{ 0 }; t < numThreads; ++t )
+		{
+			threads.emplace_back( [&, t]() {
+				auto* value = cache.get( "shared_key", [&]() {
+					++factoryCallCount;
+					std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+					return std::string{ "loaded_once" };
+				} );
+				results[t] = *value;
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		EXPECT_EQ( factoryCallCount.load(), 1 );
+		for ( const auto& result : results )
+		{
+			EXPECT_EQ( result, "loaded_once" );
+		}
+		EXPECT_EQ( cache.size(), 1 );
+	}
+
+	TEST( CompactLruCacheSingleFlight, FactoryExceptionLeavesNoEntry )
+	{
+		CompactLruCache<int, int> cache;
+
+		EXPECT_THROW( cache.get( 1, []() -> int { throw std::runtime_error{ "backend unavailable" }; } ), std::runtime_error );
+		EXPECT_TRUE( cache.isEmpty() );
+		EXPECT_EQ( *cache.get( 1, []() { return 7; } ), 7 );
+	}
+
+	//----------------------------------------------
+	// Thread safety
+	//----------------------------------------------
+
+	TEST( CompactLruCacheThreadSafety, ConcurrentAccessWithEviction )
+	{
+		CompactLruCache<int, int> cache{ LruCacheOptions{ 100 } };
+
+		std::vector<std::thread> threads;
+		for ( int t{ 0 }; t < 4; ++t )
+		{
+			threads.emplace_back( [&cache, t]() {
+				for ( int i{ 0 }; i < 2000; ++i )
+				{
+					// Other threads may evict and recycle the slot as soon as get() returns, so only
+					// the pointer is checked here
+					const int key{ ( i * 7 + t ) % 300 };
+					EXPECT_NE( cache.get( key, [key]() { return key; } ), nullptr );
+					cache.find( key + 1 );
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		EXPECT_LE( cache.size(), 100 );
+		for ( int key{ 0 }; key < 300; ++key )
+		{
+			auto* value = cache.find( key );
+			if ( value != nullptr )
+			{
+				EXPECT_EQ( *value, key );
+			}
+		}
+	}
+} // namespace nfx::cache::test
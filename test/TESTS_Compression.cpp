@@ -0,0 +1,170 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TESTS_Compression.cpp
+ * @brief Tests for the second tier compression codecs
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <nfx/cache/Compression.h>
+
+namespace nfx::cache::test
+{
+	//=====================================================================
+	// Test helpers
+	//=====================================================================
+
+	/** @brief Bytes of a string */
+	std::vector<std::byte> bytesOf( const std::string& text )
+	{
+		const auto* data{ reinterpret_cast<const std::byte*>( text.data() ) };
+
+		return std::vector<std::byte>( data, data + text.size() );
+	}
+
+	/** @brief Compress then decompress with LzCodec */
+	std::vector<std::byte> roundTrip( const std::vector<std::byte>& input, std::size_t* compressedSize = nullptr )
+	{
+		std::vector<std::byte> compressed;
+		LzCodec::compress( input, compressed );
+		if ( compressedSize != nullptr )
+		{
+			*compressedSize = compressed.size();
+		}
+
+		std::vector<std::byte> restored;
+		LzCodec::decompress( compressed, restored );
+
+		return restored;
+	}
+
+	//=====================================================================
+	// LzCodec
+	//=====================================================================
+
+	TEST( LzCodec, RoundTripsShortAndEmptyInputs )
+	{
+		for ( const std::string text : { "", "a", "abc", "abcd", "abcdabcd" } )
+		{
+			EXPECT_EQ( roundTrip( bytesOf( text ) ), bytesOf( text ) ) << text;
+		}
+	}
+
+	TEST( LzCodec, CompressesRepetitiveData )
+	{
+		std::string json;
+		for ( int i{ 0 }; i < 200; ++i )
+		{
+			json += R"({"id":)" + std::to_string( i ) + R"(,"status":"active","region":"eu-west-1","tags":["cache","tier"]},)";
+		}
+
+		std::size_t compressedSize{ 0 };
+		EXPECT_EQ( roundTrip( bytesOf( json ), &compressedSize ), bytesOf( json ) );
+		EXPECT_LT( compressedSize * 4, json.size() );
+
+		// Runs longer than the token nibbles and overlapping matches
+		const std::string run( 100000, 'x' );
+		EXPECT_EQ( roundTrip( bytesOf( run ), &compressedSize ), bytesOf( run ) );
+		EXPECT_LT( compressedSize, 1000 );
+	}
+
+	TEST( LzCodec, RoundTripsIncompressibleData )
+	{
+		std::mt19937 random{ 42 };
+		std::vector<std::byte> noise( 70000 );
+		for ( auto& byte : noise )
+		{
+			byte = static_cast<std::byte>( random() );
+		}
+
+		std::size_t compressedSize{ 0 };
+		EXPECT_EQ( roundTrip( noise, &compressedSize ), noise );
+		EXPECT_LT( compressedSize, noise.size() + noise.size() / 100 );
+	}
+
+	TEST( LzCodec, AppendsToOutput )
+	{
+		std::vector<std::byte> compressed{ std::byte{ 1 } };
+		LzCodec::compress( bytesOf( "hello hello hello" ), compressed );
+
+		std::vector<std::byte> restored{ std::byte{ 2 } };
+		LzCodec::decompress( std::span<const std::byte>{ compressed }.subspan( 1 ), restored );
+
+		EXPECT_EQ( restored.front(), std::byte{ 2 } );
+		EXPECT_EQ( std::vector<std::byte>( restored.begin() + 1, restored.end() ), bytesOf( "hello hello hello" ) );
+	}
+
+	TEST( LzCodec, RejectsCorruptBlocks )
+	{
+		std::vector<std::byte> compressed;
+		LzCodec::compress( bytesOf( "abcabcabcabcabcabcabc" ), compressed );
+
+		std::vector<std::byte> output;
+		EXPECT_THROW( LzCodec::decompress( {}, output ), std::runtime_error );
+		EXPECT_THROW( LzCodec::decompress( std::span<const std::byte>{ compressed }.first( 4 ), output ), std::runtime_error ); // Cut inside the literals
+
+		// Length header claiming more bytes than the block holds
+		std::vector<std::byte> wrongLength{ compressed };
+		wrongLength[0] = std::byte{ 100 };
+		EXPECT_THROW( LzCodec::decompress( wrongLength, output ), std::runtime_error );
+
+		// Match reaching before the start of the output
+		const std::vector<std::byte> badOffset{ std::byte{ 8 }, std::byte{ 0x10 }, std::byte{ 'a' }, std::byte{ 9 }, std::byte{ 0 } };
+		EXPECT_THROW( LzCodec::decompress( badOffset, output ), std::runtime_error );
+
+		// Absurd length, rejected before allocating it
+		const std::vector<std::byte> huge{ std::byte{ 0xFF }, std::byte{ 0xFF }, std::byte{ 0xFF }, std::byte{ 0xFF }, std::byte{ 0x7F }, std::byte{ 0 } };
+		EXPECT_THROW( LzCodec::decompress( huge, output ), std::runtime_error );
+	}
+
+	//=====================================================================
+	// CompressionCodec
+	//=====================================================================
+
+	TEST( CompressionCodec, DefaultsToLzCodec )
+	{
+		const CompressionCodec codec;
+		const std::vector<std::byte> input{ bytesOf( "tier tier tier tier tier" ) };
+
+		std::vector<std::byte> compressed;
+		codec.compress( input, compressed );
+
+		std::vector<std::byte> expected;
+		LzCodec::compress( input, expected );
+		EXPECT_EQ( compressed, expected );
+
+		std::vector<std::byte> restored;
+		codec.decompress( compressed, restored );
+		EXPECT_EQ( restored, input );
+	}
+} // namespace nfx::cache::test
@@ -0,0 +1,294 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TESTS_EvictionPolicy.cpp
+ * @brief Tests for eviction policies and their building blocks
+ * @details Tests covering the intrusive policy list, the frequency sketch and victim
+ *          selection of the LRU, SLRU, CLOCK and W-TinyLFU policies
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+
+#include <nfx/cache/EvictionPolicy.h>
+
+namespace nfx::cache::test
+{
+	//=====================================================================
+	// Test helpers
+	//=====================================================================
+
+	/** @brief Fixed set of entries hashed by their position */
+	struct PolicyEntries
+	{
+		std::array<CacheEntry, 16> entries{};
+
+		CacheEntry* operator[]( std::size_t i ) { return &entries[i]; }
+
+		auto hasher() const
+		{
+			return [this]( const CacheEntry* entry ) { return static_cast<std::size_t>( entry - entries.data() ); };
+		}
+	};
+
+	//=====================================================================
+	// PolicyList Tests
+	//=====================================================================
+
+	TEST( PolicyList, OrdersEntriesByRecency )
+	{
+		PolicyEntries e;
+		PolicyList list;
+
+		list.pushFront( e[0] );
+		list.pushFront( e[1] );
+		list.pushFront( e[2] );
+		EXPECT_EQ( list.size(), 3 );
+		EXPECT_EQ( list.front(), e[2] );
+		EXPECT_EQ( list.back(), e[0] );
+
+		list.moveToFront( e[0] );
+		EXPECT_EQ( list.front(), e[0] );
+		EXPECT_EQ( list.back(), e[1] );
+
+		list.remove( e[1] );
+		EXPECT_EQ( list.size(), 2 );
+		EXPECT_EQ( list.back(), e[2] );
+
+		list.clear();
+		EXPECT_EQ( list.size(), 0 );
+		EXPECT_EQ( list.front(), nullptr );
+		EXPECT_EQ( list.back(), nullptr );
+	}
+
+	//=====================================================================
+	// FrequencySketch Tests
+	//=====================================================================
+
+	TEST( FrequencySketch, CountsSaturateAndAge )
+	{
+		FrequencySketch sketch{ 16 };
+		EXPECT_EQ( sketch.frequency( 42 ), 0 );
+
+		for ( int i = 0; i < 5; ++i )
+		{
+			sketch.increment( 42 );
+		}
+		EXPECT_EQ( sketch.frequency( 42 ), 5 );
+
+		for ( int i = 0; i < 20; ++i )
+		{
+			sketch.increment( 42 );
+		}
+		EXPECT_EQ( sketch.frequency( 42 ), 15 );
+
+		// 160 increments on a sketch sized for 16 entries trigger aging, which halves the counters
+		for ( std::size_t key = 1000; key < 1135; ++key )
+		{
+			sketch.increment( key );
+		}
+		EXPECT_LT( sketch.frequency( 42 ), 15 );
+
+		sketch.clear();
+		EXPECT_EQ( sketch.frequency( 42 ), 0 );
+	}
+
+	//=====================================================================
+	// Policy Tests
+	//=====================================================================
+
+	TEST( LruPolicy, EvictsLeastRecentlyUsed )
+	{
+		PolicyEntries e;
+		LruPolicy policy{ 3 };
+
+		for ( std::size_t i = 0; i < 3; ++i )
+		{
+			policy.onInsert( e[i], e.hasher() );
+		}
+		policy.onAccess( e[0], e.hasher() );
+
+		EXPECT_EQ( policy.victim( e.hasher() ), e[1] );
+
+		policy.onRemove( e[1] );
+		EXPECT_EQ( policy.victim( e.hasher() ), e[2] );
+
+		policy.clear();
+		EXPECT_EQ( policy.victim( e.hasher() ), nullptr );
+	}
+
+	TEST( SlruPolicy, ProtectsEntriesAccessedTwice )
+	{
+		PolicyEntries e;
+		SlruPolicy policy{ 4 };
+
+		for ( std::size_t i = 0; i < 4; ++i )
+		{
+			policy.onInsert( e[i], e.hasher() );
+		}
+
+		// Entry 0 is the oldest but was hit, so the oldest probation entry goes first
+		policy.onAccess( e[0], e.hasher() );
+		EXPECT_EQ( policy.victim( e.hasher() ), e[1] );
+
+		policy.onRemove( e[1] );
+		policy.onRemove( e[2] );
+		policy.onRemove( e[3] );
+		EXPECT_EQ( policy.victim( e.hasher() ), e[0] );
+	}
+
+	TEST( SlruPolicy, DemotesProtectedOverflow )
+	{
+		PolicyEntries e;
+		SlruPolicy policy{ 5 };
+
+		for ( std::size_t i = 0; i < 5; ++i )
+		{
+			policy.onInsert( e[i], e.hasher() );
+			policy.onAccess( e[i], e.hasher() );
+		}
+
+		// Protected holds 80% of 5 entries, so the least recent protected entry was demoted
+		EXPECT_EQ( policy.victim( e.hasher() ), e[0] );
+	}
+
+	TEST( ClockPolicy, GivesReferencedEntriesASecondChance )
+	{
+		PolicyEntries e;
+		ClockPolicy policy{ 3 };
+
+		for ( std::size_t i = 0; i < 3; ++i )
+		{
+			policy.onInsert( e[i], e.hasher() );
+		}
+
+		policy.onAccess( e[0], e.hasher() );
+		EXPECT_EQ( policy.victim( e.hasher() ), e[1] );
+
+		// Every entry referenced: the hand sweeps once and evicts where it started
+		policy.onAccess( e[0], e.hasher() );
+		policy.onAccess( e[1], e.hasher() );
+		policy.onAccess( e[2], e.hasher() );
+		policy.onRemove( e[1] );
+		EXPECT_EQ( policy.victim( e.hasher() ), e[2] );
+
+		policy.onRemove( e[2] );
+		policy.onRemove( e[0] );
+		EXPECT_EQ( policy.victim( e.hasher() ), nullptr );
+	}
+
+	TEST( ClockPolicy, SkipsVictimWithoutReferencingIt )
+	{
+		PolicyEntries e;
+		ClockPolicy policy{ 3 };
+
+		for ( std::size_t i = 0; i < 3; ++i )
+		{
+			policy.onInsert( e[i], e.hasher() );
+		}
+
+		EXPECT_EQ( policy.victim( e.hasher() ), e[0] );
+		policy.onSkip( e[0] );
+		EXPECT_EQ( policy.victim( e.hasher() ), e[1] );
+
+		// Entry 0 got no second chance: once 1 and 2 are skipped too, the hand is back on it
+		policy.onSkip( e[1] );
+		policy.onSkip( e[2] );
+		EXPECT_EQ( policy.victim( e.hasher() ), e[0] );
+	}
+
+	TEST( WTinyLfuPolicy, RejectsCandidatesLessPopularThanTheVictim )
+	{
+		PolicyEntries e;
+		WTinyLfuPolicy policy{ 3 };
+
+		// Entry 0 was seen often before being inserted again
+		for ( int round = 0; round < 5; ++round )
+		{
+			policy.onInsert( e[0], e.hasher() );
+			policy.onRemove( e[0] );
+		}
+		policy.onInsert( e[0], e.hasher() );
+		policy.onInsert( e[1], e.hasher() );
+		policy.onInsert( e[2], e.hasher() );
+
+		// 0 and 1 leave the one-entry window; the candidate 1 loses against the popular victim 0
+		EXPECT_EQ( policy.victim( e.hasher() ), e[1] );
+		policy.onRemove( e[1] );
+
+		policy.onInsert( e[3], e.hasher() );
+		EXPECT_EQ( policy.victim( e.hasher() ), e[2] );
+	}
+
+	TEST( WTinyLfuPolicy, AdmitsCandidatesMorePopularThanTheVictim )
+	{
+		PolicyEntries e;
+		WTinyLfuPolicy policy{ 3 };
+
+		policy.onInsert( e[0], e.hasher() );
+		policy.onInsert( e[1], e.hasher() );
+
+		// Entry 2 was seen often (e.g. across earlier evictions) before being inserted again
+		for ( int round = 0; round < 5; ++round )
+		{
+			policy.onInsert( e[2], e.hasher() );
+			policy.onRemove( e[2] );
+		}
+		policy.onInsert( e[2], e.hasher() );
+
+		// The window holds one entry: 0 and 1 move to probation and tie, so the candidate 1 is rejected
+		EXPECT_EQ( policy.victim( e.hasher() ), e[1] );
+		policy.onRemove( e[1] );
+
+		// 2 leaves the window and is more popular than the probation victim 0, so 0 goes instead
+		policy.onInsert( e[3], e.hasher() );
+		EXPECT_EQ( policy.victim( e.hasher() ), e[0] );
+	}
+
+	TEST( WTinyLfuPolicy, SkippedVictimKeepsItsFrequency )
+	{
+		PolicyEntries e;
+		WTinyLfuPolicy policy{ 3 };
+
+		// Entry 2 was seen once before
+		policy.onInsert( e[2], e.hasher() );
+		policy.onRemove( e[2] );
+
+		policy.onInsert( e[0], e.hasher() );
+		policy.onInsert( e[1], e.hasher() );
+		policy.onInsert( e[2], e.hasher() );
+
+		// The candidate 1 is chosen but pinned: it is moved out of the way without counting as a hit
+		EXPECT_EQ( policy.victim( e.hasher() ), e[1] );
+		policy.onSkip( e[1] );
+
+		// A hit on 0 pushes 1 back to probation, where 2 leaving the window duels it
+		policy.onAccess( e[0], e.hasher() );
+		policy.onInsert( e[3], e.hasher() );
+		EXPECT_EQ( policy.victim( e.hasher() ), e[1] );
+	}
+} // namespace nfx::cache::test
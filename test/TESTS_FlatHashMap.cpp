@@ -0,0 +1,325 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TESTS_FlatHashMap.cpp
+ * @brief Tests for FlatHashMap open-addressing index and FlatHashGroup probing
+ * @details Tests covering SIMD and scalar control byte matching, insertion, lookup,
+ *          erasure with tombstones, rehashing with stable element addresses and iteration
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <nfx/cache/FlatHashMap.h>
+#include <nfx/cache/SlabAllocator.h>
+
+namespace nfx::cache::test
+{
+	//=====================================================================
+	// FlatHashGroup Tests
+	//=====================================================================
+
+	//----------------------------------------------
+	// Probing
+	//----------------------------------------------
+
+	TEST( FlatHashGroup, DispatchedProbesMatchScalarProbes )
+	{
+		std::mt19937 random{ 42 };
+		std::uniform_int_distribution<int> byte{ 0, 129 };
+
+		for ( int round{ 0 }; round < 1000; ++round )
+		{
+			std::int8_t ctrl[FlatHashGroup::WIDTH];
+			for ( auto& c : ctrl )
+			{
+				const int value{ byte( random ) };
+				c = value == 128 ? FlatHashGroup::EMPTY : value == 129 ? FlatHashGroup::DELETED : static_cast<std::int8_t>( value );
+			}
+
+			const auto h2{ static_cast<std::int8_t>( byte( random ) & 0x7F ) };
+			EXPECT_EQ( FlatHashGroup::match( ctrl, h2 ), FlatHashGroup::matchScalar( ctrl, h2 ) );
+			EXPECT_EQ( FlatHashGroup::matchEmpty( ctrl ), FlatHashGroup::matchEmptyScalar( ctrl ) );
+			EXPECT_EQ( FlatHashGroup::matchEmptyOrDeleted( ctrl ), FlatHashGroup::matchEmptyOrDeletedScalar( ctrl ) );
+		}
+	}
+
+	TEST( FlatHashGroup, ScalarProbeMasks )
+	{
+		std::int8_t ctrl[FlatHashGroup::WIDTH];
+		for ( std::size_t i{ 0 }; i < FlatHashGroup::WIDTH; ++i )
+		{
+			ctrl[i] = FlatHashGroup::EMPTY;
+		}
+
+		ctrl[0] = 5;
+		ctrl[3] = 5;
+		ctrl[7] = FlatHashGroup::DELETED;
+		ctrl[15] = 9;
+
+		EXPECT_EQ( FlatHashGroup::matchScalar( ctrl, 5 ), 0b1001u );
+		EXPECT_EQ( FlatHashGroup::matchScalar( ctrl, 9 ), 1u << 15 );
+		EXPECT_EQ( FlatHashGroup::matchEmptyScalar( ctrl ), 0x7FFFu & ~0b10001001u );
+		EXPECT_EQ( FlatHashGroup::matchEmptyOrDeletedScalar( ctrl ), 0x7FFFu & ~0b1001u );
+	}
+
+	//=====================================================================
+	// FlatHashMap Tests
+	//=====================================================================
+
+	//----------------------------------------------
+	// Basic operations
+	//----------------------------------------------
+
+	TEST( FlatHashMap, EmptyMap )
+	{
+		FlatHashMap<int, int> map;
+
+		EXPECT_TRUE( map.empty() );
+		EXPECT_EQ( map.size(), 0 );
+		EXPECT_EQ( map.capacity(), 0 );
+		EXPECT_EQ( map.find( 1 ), map.end() );
+		EXPECT_EQ( map.begin(), map.end() );
+	}
+
+	TEST( FlatHashMap, TryEmplaceAndFind )
+	{
+		FlatHashMap<std::string, int> map;
+
+		auto [it, inserted]{ map.try_emplace( "one", 1 ) };
+		EXPECT_TRUE( inserted );
+		EXPECT_EQ( it->first, "one" );
+		EXPECT_EQ( it->second, 1 );
+
+		auto [again, insertedAgain]{ map.try_emplace( "one", 100 ) };
+		EXPECT_FALSE( insertedAgain );
+		EXPECT_EQ( again, it );
+		EXPECT_EQ( again->second, 1 );
+
+		EXPECT_EQ( map.size(), 1 );
+		EXPECT_NE( map.find( "one" ), map.end() );
+		EXPECT_EQ( map.find( "two" ), map.end() );
+	}
+
+	TEST( FlatHashMap, PrehashedFindMatchesFind )
+	{
+		FlatHashMap<int, int> map;
+		map.prefetch( map.hash_code( 1 ) ); // No table yet
+		EXPECT_EQ( map.find( 1, map.hash_code( 1 ) ), map.end() );
+
+		for ( int i{ 0 }; i < 100; ++i )
+		{
+			map.try_emplace( i, i * 2 );
+		}
+
+		for ( int i{ 0 }; i < 200; ++i )
+		{
+			const std::uint64_t hash{ map.hash_code( i ) };
+			map.prefetch( hash );
+			EXPECT_EQ( map.find( i, hash ), map.find( i ) );
+		}
+	}
+
+	TEST( FlatHashMap, ReserveSizesForLoadFactor )
+	{
+		FlatHashMap<int, int> map{ 1000 };
+		const std::size_t capacity{ map.capacity() };
+
+		EXPECT_GE( capacity * 7 / 8, 1000 );
+		EXPECT_EQ( capacity % FlatHashGroup::WIDTH, 0 );
+
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			map.try_emplace( i, i );
+		}
+
+		EXPECT_EQ( map.capacity(), capacity );
+	}
+
+	//----------------------------------------------
+	// Stability and erasure
+	//----------------------------------------------
+
+	TEST( FlatHashMap, ElementAddressesSurviveRehash )
+	{
+		FlatHashMap<int, std::string> map;
+		std::vector<const std::string*> addresses;
+
+		for ( int i{ 0 }; i < 5000; ++i )
+		{
+			addresses.push_back( &map.try_emplace( i, std::to_string( i ) ).first->second );
+		}
+
+		for ( int i{ 0 }; i < 5000; ++i )
+		{
+			auto it = map.find( i );
+			ASSERT_NE( it, map.end() );
+			EXPECT_EQ( &it->second, addresses[static_cast<std::size_t>( i )] );
+			EXPECT_EQ( it->second, std::to_string( i ) );
+		}
+	}
+
+	TEST( FlatHashMap, EraseReturnsNextAndKeepsOthersReachable )
+	{
+		FlatHashMap<int, int> map;
+		for ( int i{ 0 }; i < 200; ++i )
+		{
+			map.try_emplace( i, i * 2 );
+		}
+
+		// Erase every even key while iterating
+		for ( auto it = map.begin(); it != map.end(); )
+		{
+			it = it->first % 2 == 0 ? map.erase( it ) : std::next( it );
+		}
+
+		EXPECT_EQ( map.size(), 100 );
+		for ( int i{ 0 }; i < 200; ++i )
+		{
+			EXPECT_EQ( map.find( i ) != map.end(), i % 2 == 1 );
+		}
+	}
+
+	TEST( FlatHashMap, ExtractKeepsElementAddress )
+	{
+		FlatHashMap<int, std::string> map;
+		for ( int i{ 0 }; i < 100; ++i )
+		{
+			map.try_emplace( i, std::to_string( i ) );
+		}
+
+		const std::string* address{ &map.find( 42 )->second };
+		auto node{ map.extract( map.find( 42 ) ) };
+
+		ASSERT_FALSE( node.empty() );
+		EXPECT_EQ( node.key(), 42 );
+		EXPECT_EQ( &node.mapped(), address );
+		EXPECT_EQ( map.size(), 99 );
+		EXPECT_EQ( map.find( 42 ), map.end() );
+
+		// The key can be inserted again while the extracted element is alive
+		map.try_emplace( 42, "new" );
+		EXPECT_EQ( map.find( 42 )->second, "new" );
+		EXPECT_EQ( node.mapped(), "42" );
+
+		auto moved{ std::move( node ) };
+		EXPECT_TRUE( node.empty() );
+		EXPECT_EQ( moved.mapped(), "42" );
+	}
+
+	TEST( FlatHashMap, ChurnMatchesUnorderedMap )
+	{
+		FlatHashMap<int, int> map{ 256 };
+		std::unordered_map<int, int> reference;
+		std::mt19937 random{ 7 };
+		std::uniform_int_distribution<int> keys{ 0, 511 };
+
+		// Steady insert/erase churn creates and recycles tombstones
+		for ( int i{ 0 }; i < 100000; ++i )
+		{
+			const int key{ keys( random ) };
+			auto it = map.find( key );
+			if ( it != map.end() )
+			{
+				ASSERT_EQ( reference.at( key ), it->second );
+				map.erase( it );
+				reference.erase( key );
+			}
+			else
+			{
+				ASSERT_EQ( reference.count( key ), 0 );
+				map.try_emplace( key, i );
+				reference.emplace( key, i );
+			}
+		}
+
+		EXPECT_EQ( map.size(), reference.size() );
+
+		std::size_t visited{ 0 };
+		for ( const auto& [key, value] : map )
+		{
+			EXPECT_EQ( reference.at( key ), value );
+			++visited;
+		}
+
+		EXPECT_EQ( visited, reference.size() );
+	}
+
+	TEST( FlatHashMap, ClearKeepsCapacity )
+	{
+		FlatHashMap<int, std::string> map;
+		for ( int i{ 0 }; i < 100; ++i )
+		{
+			map.try_emplace( i, "value" );
+		}
+
+		const std::size_t capacity{ map.capacity() };
+		map.clear();
+
+		EXPECT_TRUE( map.empty() );
+		EXPECT_EQ( map.capacity(), capacity );
+		EXPECT_EQ( map.begin(), map.end() );
+		EXPECT_EQ( map.find( 5 ), map.end() );
+
+		map.try_emplace( 5, "again" );
+		EXPECT_EQ( map.find( 5 )->second, "again" );
+	}
+
+	//----------------------------------------------
+	// Allocator support
+	//----------------------------------------------
+
+	TEST( FlatHashMap, ElementsComeFromSlabPool )
+	{
+		using Map = FlatHashMap<int, int, std::hash<int>, std::equal_to<int>, SlabAllocator<std::pair<const int, int>>>;
+
+		SlabPool pool{ 64, sizeof( Map::value_type ) };
+		{
+			Map map{ 64, std::hash<int>{}, std::equal_to<int>{}, SlabAllocator<Map::value_type>{ &pool } };
+
+			for ( int i{ 0 }; i < 64; ++i )
+			{
+				map.try_emplace( i, i );
+			}
+
+			EXPECT_EQ( pool.inUse(), 64 );
+
+			for ( int i{ 64 }; i < 1000; ++i )
+			{
+				map.erase( map.find( i - 64 ) );
+				map.try_emplace( i, i );
+			}
+
+			EXPECT_EQ( pool.capacity(), 64 );
+		}
+
+		EXPECT_EQ( pool.inUse(), 0 );
+	}
+} // namespace nfx::cache::test
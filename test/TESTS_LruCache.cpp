@@ -31,8 +31,19 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
@@ -40,6 +51,14 @@
 
 namespace nfx::cache::test
 {
+	//=====================================================================
+	// Test helpers
+	//=====================================================================
+
+	/** @brief Cache on ManualClock, so expiration tests advance time instead of sleeping */
+	template <typename TKey, typename TValue>
+	using ManualClockCache = LruCache<TKey, TValue, std::hash<TKey>, std::equal_to<TKey>, NodeIndex, LruPolicy, ManualClock>;
+
 	//=====================================================================
 	// LruCache Tests
 	//=====================================================================
@@ -152,14 +171,14 @@ namespace nfx::cache::test
 	{
 		LruCacheOptions options{ 0, std::chrono::milliseconds( 50 ) };
 
-		LruCache<std::string, std::string> cache( options );
+		ManualClockCache<std::string, std::string> cache( options );
 
 		// Add entry
 		[[maybe_unused]] auto* added = cache.get( "expire_key", []() { return std::string{ "expire_value" }; } );
 		EXPECT_EQ( cache.size(), 1 );
 
 		// Wait for expiration (don't access the entry to avoid refreshing the timer)
-		std::this_thread::sleep_for( std::chrono::milliseconds( 60 ) );
+		ManualClock::advance( std::chrono::milliseconds( 60 ) );
 
 		// Manually trigger cleanup to remove expired entries
 		cache.cleanupExpired();
@@ -172,7 +191,7 @@ namespace nfx::cache::test
 
 	TEST( LruCacheExpiration, CustomExpirationPerEntry )
 	{
-		LruCache<std::string, int> cache;
+		ManualClockCache<std::string, int> cache;
 
 		// Add entry with custom short expiration
 		[[maybe_unused]] auto* short_lived = cache.get( "short_expire", []() { return 100; }, []( CacheEntry& entry ) { entry.slidingExpiration = { std::chrono::milliseconds( 30 ) }; } );
@@ -183,7 +202,7 @@ namespace nfx::cache::test
 		EXPECT_EQ( cache.size(), 2 );
 
 		// Wait for short expiration
-		std::this_thread::sleep_for( std::chrono::milliseconds( 40 ) );
+		ManualClock::advance( std::chrono::milliseconds( 40 ) );
 
 		// Short should be expired, long should remain
 		EXPECT_EQ( cache.find( "short_expire" ), nullptr );
@@ -195,20 +214,20 @@ namespace nfx::cache::test
 	{
 		LruCacheOptions options{ 0, std::chrono::milliseconds( 100 ) };
 
-		LruCache<std::string, std::string> cache( options );
+		ManualClockCache<std::string, std::string> cache( options );
 
 		[[maybe_unused]] auto* initial = cache.get( "sliding_key", []() { return std::string{ "sliding_value" }; } );
 
 		// Access periodically to keep it alive
 		for ( int i{ 0 }; i < 5; ++i )
 		{
-			std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+			ManualClock::advance( std::chrono::milliseconds( 50 ) );
 			auto* result = cache.find( "sliding_key" );
 			EXPECT_NE( result, nullptr );
 		}
 
 		// Stop accessing and wait for expiration
-		std::this_thread::sleep_for( std::chrono::milliseconds( 120 ) );
+		ManualClock::advance( std::chrono::milliseconds( 120 ) );
 		auto* result = cache.find( "sliding_key" );
 		EXPECT_EQ( result, nullptr );
 	}
@@ -217,7 +236,7 @@ namespace nfx::cache::test
 	{
 		LruCacheOptions options{ 0, std::chrono::milliseconds( 30 ) };
 
-		LruCache<std::string, int> cache( options );
+		ManualClockCache<std::string, int> cache( options );
 
 		// Add multiple entries
 		[[maybe_unused]] auto* v1 = cache.get( "key1", []() { return 1; } );
@@ -226,7 +245,7 @@ namespace nfx::cache::test
 		EXPECT_EQ( cache.size(), 3 );
 
 		// Wait for expiration
-		std::this_thread::sleep_for( std::chrono::milliseconds( 40 ) );
+		ManualClock::advance( std::chrono::milliseconds( 40 ) );
 
 		// Size should still be 3 until cleanup
 		EXPECT_EQ( cache.size(), 3 );
@@ -236,6 +255,247 @@ namespace nfx::cache::test
 		EXPECT_EQ( cache.size(), 0 );
 	}
 
+	TEST( LruCacheExpiration, CleanupExpiredKeepsLiveAndRenewedEntries )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::hours( 1 ) } };
+
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		// Short-lived entries, one of which gets renewed before the others expire
+		for ( int i{ 1000 }; i < 1010; ++i )
+		{
+			cache.get( i, [i]() { return i; }, []( CacheEntry& entry ) { entry.slidingExpiration = std::chrono::milliseconds( 60 ); } );
+		}
+
+		ManualClock::advance( std::chrono::milliseconds( 40 ) );
+		EXPECT_NE( cache.find( 1005 ), nullptr );
+		ManualClock::advance( std::chrono::milliseconds( 40 ) );
+
+		cache.cleanupExpired();
+		EXPECT_EQ( cache.size(), 1001 );
+		EXPECT_NE( cache.find( 1005 ), nullptr );
+		EXPECT_EQ( cache.find( 1000 ), nullptr );
+		EXPECT_NE( cache.find( 0 ), nullptr );
+	}
+
+	TEST( LruCacheExpiration, AbsoluteExpirationIgnoresHits )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{}.setAbsoluteExpiration( std::chrono::milliseconds( 100 ) ).setExpirationMode( ExpirationMode::Absolute ) };
+
+		cache.get( 1, []() { return 1; } );
+
+		for ( int i{ 0 }; i < 3; ++i )
+		{
+			ManualClock::advance( std::chrono::milliseconds( 30 ) );
+			EXPECT_NE( cache.find( 1 ), nullptr );
+		}
+
+		ManualClock::advance( std::chrono::milliseconds( 20 ) );
+		EXPECT_EQ( cache.find( 1 ), nullptr );
+	}
+
+	TEST( LruCacheExpiration, AbsoluteHitsWriteNoTimestamp )
+	{
+		CacheEntry entry{ std::chrono::milliseconds( 100 ) };
+		entry.expirationMode = ExpirationMode::Absolute;
+		entry.resetTimestamps( ManualClock::now() );
+
+		const auto stored{ entry.lastAccessed };
+		entry.touch( ManualClock::now() + std::chrono::milliseconds( 50 ) );
+		EXPECT_EQ( entry.lastAccessed, stored );
+
+		entry.expirationMode = ExpirationMode::SlidingAndAbsolute;
+		entry.touch( ManualClock::now() + std::chrono::milliseconds( 50 ) );
+		EXPECT_EQ( entry.lastAccessed, stored + std::chrono::milliseconds( 50 ) );
+		EXPECT_EQ( entry.writeTime, stored );
+	}
+
+	TEST( LruCacheExpiration, SlidingAndAbsoluteExpiresAtEarlierDeadline )
+	{
+		auto options = LruCacheOptions{ 0, std::chrono::milliseconds( 50 ) }.setAbsoluteExpiration( std::chrono::milliseconds( 120 ) ).setExpirationMode( ExpirationMode::SlidingAndAbsolute );
+		ManualClockCache<int, int> cache{ options };
+
+		cache.get( 1, []() { return 1; } );
+		cache.get( 2, []() { return 2; } );
+
+		// Key 1 is kept alive by hits until its absolute deadline, key 2 idles out first
+		for ( int i{ 0 }; i < 3; ++i )
+		{
+			ManualClock::advance( std::chrono::milliseconds( 35 ) );
+			EXPECT_NE( cache.find( 1 ), nullptr );
+		}
+
+		EXPECT_EQ( cache.find( 2 ), nullptr );
+
+		ManualClock::advance( std::chrono::milliseconds( 20 ) );
+		EXPECT_EQ( cache.find( 1 ), nullptr );
+	}
+
+	TEST( LruCacheExpiration, ExpirationModePerEntry )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 100 ) } };
+
+		cache.get( 1, []() { return 1; } );
+		cache.get( 2, []() { return 2; }, []( CacheEntry& entry ) {
+			entry.expirationMode = ExpirationMode::Absolute;
+			entry.absoluteExpiration = std::chrono::milliseconds( 100 );
+		} );
+
+		ManualClock::advance( std::chrono::milliseconds( 60 ) );
+		EXPECT_NE( cache.find( 1 ), nullptr );
+		EXPECT_NE( cache.find( 2 ), nullptr );
+
+		ManualClock::advance( std::chrono::milliseconds( 60 ) );
+		cache.cleanupExpired();
+		EXPECT_EQ( cache.size(), 1 );
+		EXPECT_NE( cache.find( 1 ), nullptr );
+	}
+
+	TEST( LruCacheExpiration, CleanupExpiredHonoursAbsoluteDeadlines )
+	{
+		auto options = LruCacheOptions{ 0, std::chrono::hours( 1 ) }.setAbsoluteExpiration( std::chrono::milliseconds( 100 ) ).setExpirationMode( ExpirationMode::SlidingAndAbsolute );
+		ManualClockCache<int, int> cache{ options };
+
+		for ( int i{ 0 }; i < 100; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		ManualClock::advance( std::chrono::milliseconds( 60 ) );
+		cache.get( 100, []() { return 100; } );
+		EXPECT_NE( cache.find( 5 ), nullptr );
+
+		ManualClock::advance( std::chrono::milliseconds( 60 ) );
+		cache.cleanupExpired();
+		EXPECT_EQ( cache.size(), 1 );
+		EXPECT_NE( cache.find( 100 ), nullptr );
+	}
+
+	//----------------------------------------------
+	// Timer wheel
+	//----------------------------------------------
+
+	TEST( LruCacheTimerWheel, HandsOutOnlyDueEntries )
+	{
+		const auto start = std::chrono::steady_clock::now();
+		TimerWheel wheel{ start };
+
+		CacheEntry shortLived{ std::chrono::milliseconds( 5 ) };
+		CacheEntry mediumLived{ std::chrono::milliseconds( 500 ) };
+		CacheEntry longLived{ std::chrono::seconds( 10 ) };
+		for ( CacheEntry* entry : { &shortLived, &mediumLived, &longLived } )
+		{
+			entry->lastAccessed = start;
+			wheel.schedule( entry );
+		}
+
+		std::vector<CacheEntry*> expired;
+		const auto collect = [&expired]( CacheEntry* entry ) { expired.push_back( entry ); };
+
+		EXPECT_EQ( wheel.advance( start + std::chrono::milliseconds( 4 ), SIZE_MAX, collect ), 0 );
+		EXPECT_EQ( wheel.advance( start + std::chrono::milliseconds( 6 ), SIZE_MAX, collect ), 1 );
+		EXPECT_EQ( wheel.advance( start + std::chrono::milliseconds( 501 ), SIZE_MAX, collect ), 1 );
+		EXPECT_EQ( wheel.advance( start + std::chrono::seconds( 9 ), SIZE_MAX, collect ), 0 );
+		EXPECT_EQ( wheel.advance( start + std::chrono::seconds( 11 ), SIZE_MAX, collect ), 1 );
+
+		ASSERT_EQ( expired.size(), 3 );
+		EXPECT_EQ( expired[0], &shortLived );
+		EXPECT_EQ( expired[1], &mediumLived );
+		EXPECT_EQ( expired[2], &longLived );
+		EXPECT_EQ( longLived.expiryPrevNext, nullptr );
+	}
+
+	TEST( LruCacheTimerWheel, RenewedEntriesAreRescheduled )
+	{
+		const auto start = std::chrono::steady_clock::now();
+		TimerWheel wheel{ start };
+
+		CacheEntry entry{ std::chrono::milliseconds( 10 ) };
+		entry.lastAccessed = start;
+		wheel.schedule( &entry );
+
+		// Renewal is not reported to the wheel; the entry is rescheduled when its bucket comes up
+		entry.lastAccessed = start + std::chrono::milliseconds( 8 );
+
+		std::size_t expired{ 0 };
+		const auto count = [&expired]( CacheEntry* ) { ++expired; };
+
+		wheel.advance( start + std::chrono::milliseconds( 15 ), SIZE_MAX, count );
+		EXPECT_EQ( expired, 0 );
+		EXPECT_NE( entry.expiryPrevNext, nullptr );
+
+		wheel.advance( start + std::chrono::milliseconds( 19 ), SIZE_MAX, count );
+		EXPECT_EQ( expired, 1 );
+	}
+
+	TEST( LruCacheTimerWheel, BudgetResumesOnNextAdvance )
+	{
+		const auto start = std::chrono::steady_clock::now();
+		TimerWheel wheel{ start };
+
+		std::vector<CacheEntry> entries( 100, CacheEntry{ std::chrono::milliseconds( 1 ) } );
+		for ( auto& entry : entries )
+		{
+			entry.lastAccessed = start;
+			wheel.schedule( &entry );
+		}
+
+		const auto later = start + std::chrono::milliseconds( 100 );
+		const auto ignore = []( CacheEntry* ) {};
+
+		EXPECT_EQ( wheel.advance( later, 10, ignore ), 10 );
+		EXPECT_EQ( wheel.advance( later, 10, ignore ), 10 );
+		EXPECT_EQ( wheel.advance( later, SIZE_MAX, ignore ), 80 );
+		EXPECT_EQ( wheel.advance( later, SIZE_MAX, ignore ), 0 );
+	}
+
+	TEST( LruCacheTimerWheel, UnscheduledEntriesAreNotHandedOut )
+	{
+		const auto start = std::chrono::steady_clock::now();
+		TimerWheel wheel{ start };
+
+		CacheEntry kept{ std::chrono::milliseconds( 1 ) };
+		CacheEntry removed{ std::chrono::milliseconds( 1 ) };
+		kept.lastAccessed = start;
+		removed.lastAccessed = start;
+		wheel.schedule( &kept );
+		wheel.schedule( &removed );
+
+		wheel.unschedule( &removed );
+		wheel.unschedule( &removed ); // No-op once unscheduled
+
+		std::vector<CacheEntry*> expired;
+		wheel.advance( start + std::chrono::seconds( 1 ), SIZE_MAX, [&expired]( CacheEntry* entry ) { expired.push_back( entry ); } );
+
+		ASSERT_EQ( expired.size(), 1 );
+		EXPECT_EQ( expired[0], &kept );
+	}
+
+	TEST( LruCacheTimerWheel, ExpirationsBeyondWheelRangeCascade )
+	{
+		const auto start = std::chrono::steady_clock::now();
+		TimerWheel wheel{ start };
+
+		CacheEntry days{ std::chrono::hours( 24 * 10 ) };
+		CacheEntry months{ std::chrono::hours( 24 * 60 ) };
+		days.lastAccessed = start;
+		months.lastAccessed = start;
+		wheel.schedule( &days );
+		wheel.schedule( &months );
+
+		std::size_t expired{ 0 };
+		const auto count = [&expired]( CacheEntry* ) { ++expired; };
+
+		for ( int day{ 1 }; day <= 61; ++day )
+		{
+			wheel.advance( start + std::chrono::hours( 24 * day ), SIZE_MAX, count );
+			EXPECT_EQ( expired, day <= 10 ? 0u : day <= 60 ? 1u : 2u ) << "day " << day;
+		}
+	}
+
 	//----------------------------------------------
 	// Size limits and LRU eviction
 	//----------------------------------------------
@@ -317,6 +577,98 @@ namespace nfx::cache::test
 		}
 	}
 
+	//----------------------------------------------
+	// Memory limits
+	//----------------------------------------------
+
+	TEST( LruCacheMemoryLimit, SizerDrivesEviction )
+	{
+		auto options = LruCacheOptions{}.setMemoryLimit( 100 );
+		LruCache<std::string, std::string> cache{ options, []( const std::string&, const std::string& value ) { return value.size(); } };
+
+		cache.get( "a", []() { return std::string( 40, 'a' ); } );
+		cache.get( "b", []() { return std::string( 40, 'b' ); } );
+		EXPECT_EQ( cache.memoryUsage(), 80 );
+
+		// 80 + 50 exceeds the budget: only the LRU entry needs to go
+		cache.get( "c", []() { return std::string( 50, 'c' ); } );
+		EXPECT_EQ( cache.find( "a" ), nullptr );
+		EXPECT_NE( cache.find( "b" ), nullptr );
+		EXPECT_NE( cache.find( "c" ), nullptr );
+		EXPECT_EQ( cache.memoryUsage(), 90 );
+
+		// A large entry evicts several entries in one insertion
+		cache.get( "d", []() { return std::string( 95, 'd' ); } );
+		EXPECT_EQ( cache.size(), 1 );
+		EXPECT_EQ( cache.memoryUsage(), 95 );
+		EXPECT_NE( cache.find( "d" ), nullptr );
+	}
+
+	TEST( LruCacheMemoryLimit, ConfigFunctionSetsSize )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{}.setMemoryLimit( 1000 ) };
+
+		auto sized = []( std::size_t bytes ) {
+			return [bytes]( CacheEntry& entry ) { entry.size = bytes; };
+		};
+
+		cache.get( 1, []() { return 1; }, sized( 600 ) );
+		cache.get( 2, []() { return 2; }, sized( 300 ) );
+		EXPECT_EQ( cache.memoryUsage(), 900 );
+
+		cache.get( 3, []() { return 3; }, sized( 200 ) );
+		EXPECT_EQ( cache.find( 1 ), nullptr );
+		EXPECT_EQ( cache.memoryUsage(), 500 );
+	}
+
+	TEST( LruCacheMemoryLimit, OversizedEntryReplacesEverything )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{}.setMemoryLimit( 100 ) };
+
+		cache.get( 1, []() { return 1; }, []( CacheEntry& entry ) { entry.size = 10; } );
+		cache.get( 2, []() { return 2; }, []( CacheEntry& entry ) { entry.size = 500; } );
+
+		EXPECT_EQ( cache.size(), 1 );
+		ASSERT_NE( cache.find( 2 ), nullptr );
+		EXPECT_EQ( cache.memoryUsage(), 500 );
+	}
+
+	TEST( LruCacheMemoryLimit, CombinedWithSizeLimit )
+	{
+		auto options = LruCacheOptions{ 2 }.setMemoryLimit( 1000 );
+		LruCache<int, int> cache{ options, []( const int&, const int& ) { return std::size_t{ 10 }; } };
+
+		cache.get( 1, []() { return 1; } );
+		cache.get( 2, []() { return 2; } );
+		cache.get( 3, []() { return 3; } );
+
+		// The entry count limit is reached long before the memory budget
+		EXPECT_EQ( cache.size(), 2 );
+		EXPECT_EQ( cache.memoryUsage(), 20 );
+	}
+
+	TEST( LruCacheMemoryLimit, AccountingFollowsRemoval )
+	{
+		LruCacheOptions options{ 0, std::chrono::milliseconds( 30 ) };
+		ManualClockCache<int, int> cache{ options, []( const int&, const int& value ) { return static_cast<std::size_t>( value ); } };
+
+		cache.get( 1, []() { return 100; } );
+		cache.get( 2, []() { return 200; } );
+		cache.get( 3, []() { return 300; } );
+		EXPECT_EQ( cache.memoryUsage(), 600 );
+
+		EXPECT_TRUE( cache.remove( 2 ) );
+		EXPECT_EQ( cache.memoryUsage(), 400 );
+
+		ManualClock::advance( std::chrono::milliseconds( 40 ) );
+		cache.cleanupExpired();
+		EXPECT_EQ( cache.memoryUsage(), 0 );
+
+		cache.get( 4, []() { return 50; } );
+		cache.clear();
+		EXPECT_EQ( cache.memoryUsage(), 0 );
+	}
+
 	//----------------------------------------------
 	// Factory function and configuration
 	//----------------------------------------------
@@ -358,71 +710,123 @@ namespace nfx::cache::test
 		EXPECT_TRUE( configCalled );
 	}
 
-	//----------------------------------------------
-	// Value type tests
-	//----------------------------------------------
+	TEST( LruCacheFactory, MoveOnlyFactory )
+	{
+		LruCache<int, int> cache;
 
-	TEST( LruCacheValueTypes, ComplexValues )
+		auto* value = cache.get( 1, [owned = std::make_unique<int>( 42 )]() { return *owned; } );
+
+		EXPECT_EQ( *value, 42 );
+	}
+
+	TEST( LruCacheFactory, HitDoesNotCopyFactory )
 	{
-		struct ComplexValue
+		struct CountingFactory
 		{
-			std::string name;
-			std::vector<int> data;
-			double weight;
+			int* copies;
+			int* calls;
 
-			ComplexValue( std::string n, std::vector<int> d, double w )
-				: name{ std::move( n ) }, data{ std::move( d ) }, weight{ w } {}
-		};
+			CountingFactory( int* copyCount, int* callCount )
+				: copies{ copyCount },
+				  calls{ callCount }
+			{
+			}
 
-		LruCache<std::string, ComplexValue> cache;
+			CountingFactory( const CountingFactory& other )
+				: copies{ other.copies },
+				  calls{ other.calls }
+			{
+				++*copies;
+			}
 
-		auto factory = []() {
-			return ComplexValue{ "test", { 1, 2, 3, 4, 5 }, 3.14 };
+			int operator()()
+			{
+				++*calls;
+				return 7;
+			}
 		};
 
-		auto* value = cache.get( "complex_key", factory );
-		EXPECT_EQ( value->name, "test" );
-		EXPECT_EQ( value->data.size(), 5 );
-		EXPECT_DOUBLE_EQ( value->weight, 3.14 );
+		LruCache<int, int> cache;
+		int copies{ 0 };
+		int calls{ 0 };
+		CountingFactory factory{ &copies, &calls };
+
+		cache.get( 1, factory );
+		cache.get( 1, factory );
+		cache.get( 1, factory );
+
+		EXPECT_EQ( calls, 1 );
+		EXPECT_EQ( copies, 0 );
 	}
 
-	TEST( LruCacheValueTypes, MoveSemantics )
+	TEST( LruCacheFactory, EmptyConfigurationIsSkipped )
 	{
-		LruCache<std::string, std::unique_ptr<std::string>> cache;
+		LruCache<int, int> cache;
 
-		auto factory = []() {
-			return std::make_unique<std::string>( "unique_value" );
-		};
+		LruCache<int, int>::ConfigFunction empty;
+		EXPECT_EQ( *cache.get( 1, []() { return 1; }, empty ), 1 );
+		EXPECT_EQ( *cache.get( 2, []() { return 2; }, nullptr ), 2 );
 
-		auto* ptr = cache.get( "unique_key", factory );
-		ASSERT_NE( ptr, nullptr );
-		ASSERT_NE( *ptr, nullptr );
-		EXPECT_EQ( **ptr, "unique_value" );
+		LruCache<int, int>::FactoryFunction typeErased{ []() { return 3; } };
+		EXPECT_EQ( *cache.get( 3, typeErased ), 3 );
+		EXPECT_EQ( cache.size(), 3 );
 	}
 
 	//----------------------------------------------
-	// Thread safety
+	// Single-flight loading
 	//----------------------------------------------
 
-	TEST( LruCacheThreadSafety, ConcurrentAccess )
+	TEST( LruCacheSingleFlight, SlowFactoryDoesNotBlockOtherKeys )
 	{
-		LruCache<int, std::string> cache;
+		LruCache<std::string, int> cache;
+		cache.get( "hot", []() { return 1; } );
 
-		const int numThreads{ 10 };
-		const int itemsPerThread{ 100 };
+		std::promise<void> factoryStarted;
+		std::promise<void> releaseFactory;
+		auto release = releaseFactory.get_future().share();
+
+		std::thread loader{ [&]() {
+			cache.get( "slow", [&]() {
+				factoryStarted.set_value();
+				release.wait();
+				return 2;
+			} );
+		} };
+
+		factoryStarted.get_future().wait();
+
+		// The cache lock is not held while the factory runs
+		auto* hot = cache.find( "hot" );
+		ASSERT_NE( hot, nullptr );
+		EXPECT_EQ( *hot, 1 );
+		EXPECT_EQ( *cache.get( "other", []() { return 3; } ), 3 );
+
+		releaseFactory.set_value();
+		loader.join();
+
+		auto* slow = cache.find( "slow" );
+		ASSERT_NE( slow, nullptr );
+		EXPECT_EQ( *slow, 2 );
+	}
+
+	TEST( LruCacheSingleFlight, ConcurrentMissesShareOneFactoryCall )
+	{
+		LruCache<std::string, std::string> cache;
+
+		std::atomic<int> factoryCallCount{ 0 };
+		const int numThreads{ 8 };
 		std::vector<std::thread> threads;
+		std::vector<std::string> results( numThreads );
 
-		// Concurrent insertions
 		for ( int t{ 0 }; t < numThreads; ++t )
 		{
-			threads.emplace_back( [&cache, t]() {
-				for ( int i{ 0 }; i < itemsPerThread; ++i )
-				{
-					int key{ t * itemsPerThread + i };
-					cache.get( key, [key]() {
-						return std::string{ "value_" + std::to_string( key ) };
-					} );
-				}
+			threads.emplace_back( [&, t]() {
+				auto* value = cache.get( "shared_key", [&]() {
+					++factoryCallCount;
+					std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+					return std::string{ "loaded_once" };
+				} );
+				results[t] = *value;
 			} );
 		}
 
@@ -431,46 +835,2212 @@ namespace nfx::cache::test
 			thread.join();
 		}
 
-		// Verify all entries were created
-		EXPECT_EQ( cache.size(), numThreads * itemsPerThread );
+		EXPECT_EQ( factoryCallCount.load(), 1 );
+		for ( const auto& result : results )
+		{
+			EXPECT_EQ( result, "loaded_once" );
+		}
+		EXPECT_EQ( cache.size(), 1 );
+	}
+
+	TEST( LruCacheSingleFlight, FactoryExceptionWakesWaiters )
+	{
+		LruCache<std::string, int> cache;
+
+		std::atomic<int> factoryCallCount{ 0 };
+		std::atomic<int> failures{ 0 };
+		const int numThreads{ 4 };
+		std::vector<std::thread> threads;
 
-		// Verify all values are accessible
 		for ( int t{ 0 }; t < numThreads; ++t )
 		{
-			for ( int i{ 0 }; i < itemsPerThread; ++i )
-			{
-				int key{ t * itemsPerThread + i };
-				auto* result = cache.find( key );
-				ASSERT_NE( result, nullptr );
-				EXPECT_EQ( *result, "value_" + std::to_string( key ) );
-			}
+			threads.emplace_back( [&]() {
+				try
+				{
+					cache.get( "failing_key", [&]() -> int {
+						++factoryCallCount;
+						std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+						throw std::runtime_error{ "backend unavailable" };
+					} );
+				}
+				catch ( const std::runtime_error& )
+				{
+					++failures;
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
 		}
+
+		EXPECT_EQ( failures.load(), numThreads );
+		EXPECT_LT( factoryCallCount.load(), numThreads ); // Waiters did not run their own factory
+		EXPECT_TRUE( cache.isEmpty() );
+
+		// A failed load leaves no state behind
+		EXPECT_EQ( *cache.get( "failing_key", []() { return 7; } ), 7 );
 	}
 
 	//----------------------------------------------
-	// Performance characteristics
+	// Batch operations
 	//----------------------------------------------
 
-	TEST( LruCachePerformance, LargeDataHandling )
+	TEST( LruCacheBatch, FindManyReportsHitsAndMisses )
 	{
-		LruCache<std::string, std::vector<int>> cache;
-
-		const std::size_t numEntries{ 1000 };
-		const std::size_t vectorSize{ 1000 };
+		LruCache<int, int> cache;
+		cache.get( 1, []() { return 10; } );
+		cache.get( 3, []() { return 30; } );
+
+		const std::vector<int> keys{ 1, 2, 3, 4 };
+		std::vector<int*> results( keys.size() );
+
+		EXPECT_EQ( cache.findMany( keys, results ), 2 );
+		ASSERT_NE( results[0], nullptr );
+		EXPECT_EQ( *results[0], 10 );
+		EXPECT_EQ( results[1], nullptr );
+		ASSERT_NE( results[2], nullptr );
+		EXPECT_EQ( *results[2], 30 );
+		EXPECT_EQ( results[3], nullptr );
+	}
 
-		// Add large data structures
-		auto start = std::chrono::high_resolution_clock::now();
+	TEST( LruCacheBatch, FindManyMatchesFindWithFlatIndex )
+	{
+		LruCache<int, int, std::hash<int>, std::equal_to<int>, FlatIndex> cache;
+		for ( int i{ 0 }; i < 1000; i += 2 )
+		{
+			cache.get( i, [i]() { return i * 3; } );
+		}
 
-		for ( std::size_t i{ 0 }; i < numEntries; ++i )
+		// Longer than the prefetch distance and not a multiple of it
+		std::vector<int> keys;
+		for ( int i{ 0 }; i < 1001; ++i )
 		{
-			std::string key{ "large_key_" + std::to_string( i ) };
-			cache.get( key, [i]() {
-				std::vector<int> data( vectorSize, static_cast<int>( i ) );
-				return data;
-			} );
+			keys.push_back( ( i * 7919 ) % 1000 );
 		}
+		std::vector<int*> results( keys.size() );
 
-		auto end = std::chrono::high_resolution_clock::now();
+		EXPECT_EQ( cache.findMany( keys, results ), 501 );
+		for ( std::size_t i{ 0 }; i < keys.size(); ++i )
+		{
+			if ( keys[i] % 2 == 0 )
+			{
+				ASSERT_NE( results[i], nullptr );
+				EXPECT_EQ( *results[i], keys[i] * 3 );
+			}
+			else
+			{
+				EXPECT_EQ( results[i], nullptr );
+			}
+		}
+	}
+
+	TEST( LruCacheBatch, FindManyRefreshesRecencyAndDropsExpired )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 3, std::chrono::milliseconds( 100 ) } };
+		cache.get( 1, []() { return 1; } );
+		cache.get( 2, []() { return 2; } );
+
+		ManualClock::advance( std::chrono::milliseconds( 60 ) );
+		cache.get( 3, []() { return 3; } );
+		ManualClock::advance( std::chrono::milliseconds( 60 ) );
+
+		const std::vector<int> keys{ 1, 3 };
+		std::vector<int*> results( keys.size() );
+		EXPECT_EQ( cache.findMany( keys, results ), 1 );
+		EXPECT_EQ( results[0], nullptr );
+		EXPECT_NE( results[1], nullptr );
+		EXPECT_EQ( cache.size(), 2 ); // Expired key 1 erased by the lookup, key 2 not visited
+
+		// Key 3 was refreshed by the batch, so key 2 is the LRU victim
+		cache.get( 4, []() { return 4; } );
+		cache.get( 5, []() { return 5; } );
+		EXPECT_EQ( cache.find( 2 ), nullptr );
+		EXPECT_NE( cache.find( 3 ), nullptr );
+	}
+
+	TEST( LruCacheBatch, RemoveManyCountsRemovedEntries )
+	{
+		LruCache<std::string, int> cache{ LruCacheOptions{}.setMemoryLimit( 100 ), []( const std::string&, const int& ) { return std::size_t{ 10 }; } };
+		for ( const char* key : { "a", "b", "c", "d" } )
+		{
+			cache.get( key, []() { return 0; } );
+		}
+
+		const std::vector<std::string> keys{ "a", "c", "missing", "a" };
+		EXPECT_EQ( cache.removeMany( keys ), 2 );
+		EXPECT_EQ( cache.size(), 2 );
+		EXPECT_EQ( cache.memoryUsage(), 20 );
+		EXPECT_NE( cache.find( "b" ), nullptr );
+		EXPECT_NE( cache.find( "d" ), nullptr );
+	}
+
+	TEST( LruCacheBatch, GetManyLoadsMissingKeysInOneCall )
+	{
+		LruCache<int, std::string> cache;
+		cache.get( 2, []() { return std::string{ "cached" }; } );
+
+		int factoryCallCount{ 0 };
+		std::vector<int> requested;
+		const std::vector<int> keys{ 1, 2, 3, 1 };
+		std::vector<std::string*> results( keys.size() );
+
+		const std::size_t loaded{ cache.getMany( keys, results, [&]( std::span<const int> missing ) {
+			++factoryCallCount;
+			requested.assign( missing.begin(), missing.end() );
+
+			std::vector<std::string> values;
+			for ( int key : missing )
+			{
+				values.push_back( "loaded_" + std::to_string( key ) );
+			}
+
+			return values;
+		} ) };
+
+		EXPECT_EQ( loaded, 2 );
+		EXPECT_EQ( factoryCallCount, 1 );
+		EXPECT_EQ( requested, ( std::vector<int>{ 1, 3 } ) ); // Each missing key once, in batch order
+		ASSERT_NE( results[0], nullptr );
+		EXPECT_EQ( *results[0], "loaded_1" );
+		EXPECT_EQ( *results[1], "cached" );
+		EXPECT_EQ( *results[2], "loaded_3" );
+		EXPECT_EQ( results[3], results[0] );
+		EXPECT_EQ( cache.size(), 3 );
+
+		// Everything cached: no factory call
+		EXPECT_EQ( cache.getMany( keys, results, [&]( std::span<const int> ) {
+			++factoryCallCount;
+			return std::vector<std::string>{};
+		} ),
+			0 );
+		EXPECT_EQ( factoryCallCount, 1 );
+	}
+
+	TEST( LruCacheBatch, GetManyAppliesSizerAndConfigure )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{}.setMemoryLimit( 1000 ), []( const int&, const int& value ) { return static_cast<std::size_t>( value ); } };
+
+		const std::vector<int> keys{ 1, 2 };
+		std::vector<int*> results( keys.size() );
+		int configured{ 0 };
+
+		cache.getMany(
+			keys, results, []( std::span<const int> missing ) { return std::vector<int>( missing.size(), 50 ); },
+			[&]( CacheEntry& entry ) {
+				EXPECT_EQ( entry.size, 50 );
+				++configured;
+			} );
+
+		EXPECT_EQ( configured, 2 );
+		EXPECT_EQ( cache.memoryUsage(), 100 );
+	}
+
+	TEST( LruCacheBatch, GetManyFactoryFailureLeavesNoPendingLoads )
+	{
+		LruCache<int, int> cache;
+
+		const std::vector<int> keys{ 1, 2 };
+		std::vector<int*> results( keys.size() );
+
+		EXPECT_THROW( cache.getMany( keys, results, []( std::span<const int> ) -> std::vector<int> { throw std::runtime_error{ "backend unavailable" }; } ), std::runtime_error );
+		EXPECT_THROW( cache.getMany( keys, results, []( std::span<const int> ) { return std::vector<int>{ 1 }; } ), std::length_error );
+		EXPECT_TRUE( cache.isEmpty() );
+
+		// Failed batches leave no in-flight state behind
+		EXPECT_EQ( *cache.get( 1, []() { return 7; } ), 7 );
+		EXPECT_EQ( *cache.get( 2, []() { return 8; } ), 8 );
+	}
+
+	TEST( LruCacheBatch, GetWaitsForKeyLoadedByBatch )
+	{
+		LruCache<int, int> cache;
+
+		std::promise<void> factoryStarted;
+		std::promise<void> releaseFactory;
+		auto release = releaseFactory.get_future().share();
+
+		std::thread loader{ [&]() {
+			const std::vector<int> keys{ 1, 2 };
+			std::vector<int*> results( keys.size() );
+			cache.getMany( keys, results, [&]( std::span<const int> missing ) {
+				factoryStarted.set_value();
+				release.wait();
+				return std::vector<int>( missing.begin(), missing.end() );
+			} );
+		} };
+
+		factoryStarted.get_future().wait();
+
+		std::atomic<int> singleFactoryCalls{ 0 };
+		std::thread waiter{ [&]() {
+			auto* value = cache.get( 2, [&]() {
+				++singleFactoryCalls;
+				return -1;
+			} );
+			EXPECT_EQ( *value, 2 );
+		} };
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+		releaseFactory.set_value();
+		loader.join();
+		waiter.join();
+
+		EXPECT_EQ( singleFactoryCalls.load(), 0 );
+	}
+
+	//----------------------------------------------
+	// Heterogeneous lookup
+	//----------------------------------------------
+
+	/** @brief String key counting how often it is built from a std::string_view */
+	struct CountedKey
+	{
+		explicit CountedKey( std::string_view text )
+			: value{ text }
+		{
+			++constructions;
+		}
+
+		std::string value;
+
+		static inline int constructions{ 0 };
+	};
+
+	/** @brief Transparent hash and equality over CountedKey and std::string_view */
+	struct CountedKeyHash
+	{
+		using is_transparent = void;
+
+		std::size_t operator()( std::string_view text ) const { return std::hash<std::string_view>{}( text ); }
+		std::size_t operator()( const CountedKey& key ) const { return ( *this )( std::string_view{ key.value } ); }
+	};
+
+	struct CountedKeyEqual
+	{
+		using is_transparent = void;
+
+		static std::string_view view( std::string_view text ) { return text; }
+		static std::string_view view( const CountedKey& key ) { return key.value; }
+
+		template <typename A, typename B>
+		bool operator()( const A& a, const B& b ) const
+		{
+			return view( a ) == view( b );
+		}
+	};
+
+	template <typename TIndex>
+	using CountedKeyCache = LruCache<CountedKey, int, CountedKeyHash, CountedKeyEqual, TIndex>;
+
+	template <typename TIndex>
+	static void expectKeysBuiltOnlyOnInsert()
+	{
+		CountedKeyCache<TIndex> cache;
+		CountedKey::constructions = 0;
+
+		EXPECT_EQ( cache.find( std::string_view{ "missing" } ), nullptr );
+		EXPECT_EQ( CountedKey::constructions, 0 );
+
+		EXPECT_EQ( *cache.get( std::string_view{ "a" }, []() { return 1; } ), 1 );
+		EXPECT_EQ( CountedKey::constructions, 1 ); // Built once, for the insert
+
+		const int afterInsert{ CountedKey::constructions };
+		EXPECT_EQ( *cache.get( std::string_view{ "a" }, []() { return -1; } ), 1 );
+		ASSERT_NE( cache.find( std::string_view{ "a" } ), nullptr );
+		EXPECT_EQ( CountedKey::constructions, afterInsert );
+
+		const std::vector<std::string_view> keys{ "a", "b", "c" };
+		std::vector<int*> results( keys.size() );
+		EXPECT_EQ( cache.findMany( keys, results ), 1 );
+		EXPECT_EQ( CountedKey::constructions, afterInsert );
+
+		cache.getMany( keys, results, []( std::span<const CountedKey> missing ) { return std::vector<int>( missing.size(), 2 ); } );
+		EXPECT_EQ( CountedKey::constructions, afterInsert + 2 ); // Only the two missing keys
+		EXPECT_EQ( *results[0], 1 );
+		EXPECT_EQ( *results[2], 2 );
+
+		EXPECT_TRUE( cache.remove( std::string_view{ "b" } ) );
+		EXPECT_EQ( cache.removeMany( keys ), 2 );
+		EXPECT_EQ( CountedKey::constructions, afterInsert + 2 );
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( LruCacheHeterogeneous, NodeIndexBuildsKeysOnlyOnInsert )
+	{
+		expectKeysBuiltOnlyOnInsert<NodeIndex>();
+	}
+
+	TEST( LruCacheHeterogeneous, FlatIndexBuildsKeysOnlyOnInsert )
+	{
+		expectKeysBuiltOnlyOnInsert<FlatIndex>();
+	}
+
+	TEST( LruCacheHeterogeneous, TransparentStringHashAcceptsStringLikeKeys )
+	{
+		LruCache<std::string, int, TransparentStringHash, std::equal_to<>> cache;
+
+		const std::string owned{ "https://example.com/a" };
+		cache.get( owned, []() { return 1; } );
+
+		EXPECT_EQ( TransparentStringHash{}( owned ), std::hash<std::string>{}( owned ) );
+		ASSERT_NE( cache.find( std::string_view{ owned } ), nullptr );
+		ASSERT_NE( cache.find( "https://example.com/a" ), nullptr );
+		EXPECT_EQ( *cache.get( "https://example.com/b", []() { return 2; } ), 2 );
+		EXPECT_NE( cache.find( std::string{ "https://example.com/b" } ), nullptr );
+		EXPECT_TRUE( cache.remove( "https://example.com/a" ) );
+		EXPECT_EQ( cache.size(), 1 );
+	}
+
+	//----------------------------------------------
+	// Value handles
+	//----------------------------------------------
+
+	TEST( LruCachePinning, PinnedEntriesAreSkippedByEviction )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{ 2 } };
+
+		auto pinned = cache.getPinned( 1, []() { return 10; } );
+		cache.get( 2, []() { return 20; } );
+		cache.get( 3, []() { return 30; } ); // 1 is least recent but pinned: 2 goes
+
+		EXPECT_EQ( cache.size(), 2 );
+		ASSERT_NE( cache.find( 1 ), nullptr );
+		EXPECT_EQ( cache.find( 2 ), nullptr );
+		EXPECT_EQ( *pinned, 10 );
+
+		// Once unpinned, the entry is evictable again
+		pinned.reset();
+		cache.get( 3, []() { return 30; } );
+		cache.get( 4, []() { return 40; } );
+		EXPECT_EQ( cache.find( 1 ), nullptr );
+	}
+
+	TEST( LruCachePinning, FullyPinnedCacheExceedsItsLimit )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{ 2 } };
+
+		auto first = cache.getPinned( 1, []() { return 1; } );
+		auto second = cache.getPinned( 2, []() { return 2; } );
+		cache.get( 3, []() { return 3; } );
+
+		EXPECT_EQ( cache.size(), 3 );
+		EXPECT_EQ( *first, 1 );
+		EXPECT_EQ( *second, 2 );
+	}
+
+	TEST( LruCachePinning, FindPinnedMissReturnsEmptyHandle )
+	{
+		LruCache<int, int> cache;
+
+		auto missing = cache.findPinned( 1 );
+		EXPECT_FALSE( missing );
+		EXPECT_EQ( missing.get(), nullptr );
+
+		cache.get( 1, []() { return 1; } );
+		auto found = cache.findPinned( 1 );
+		ASSERT_TRUE( found );
+		EXPECT_EQ( found.get(), cache.find( 1 ) );
+	}
+
+	TEST( LruCachePinning, SharedLockHitsPinInReadOptimizedMode )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{ 2 }.setReadOptimized( true ) };
+		cache.get( 1, []() { return std::string{ "one" }; } );
+
+		auto handle = cache.findPinned( 1 ); // Served under the shared lock
+		ASSERT_TRUE( handle );
+
+		cache.get( 2, []() { return std::string{ "two" }; } );
+		cache.get( 3, []() { return std::string{ "three" }; } );
+		EXPECT_NE( cache.find( 1 ), nullptr );
+
+		EXPECT_TRUE( cache.remove( 1 ) );
+		EXPECT_EQ( *handle, "one" );
+	}
+
+	/** @brief Removing, clearing or expiring a pinned entry keeps its value alive until the last handle is dropped */
+	template <typename TIndex>
+	static void expectRemovedValueOutlivesHandles()
+	{
+		LruCache<int, std::shared_ptr<int>, std::hash<int>, std::equal_to<int>, TIndex, LruPolicy, ManualClock> cache{ LruCacheOptions{ 10, std::chrono::milliseconds( 100 ) }.setSlabStorage( true ) };
+
+		auto removed = cache.getPinned( 1, []() { return std::make_shared<int>( 1 ); } );
+		auto copy = removed;
+		const std::weak_ptr<int> removedValue{ *removed };
+
+		EXPECT_TRUE( cache.remove( 1 ) );
+		EXPECT_EQ( cache.find( 1 ), nullptr );
+		EXPECT_EQ( cache.size(), 0 );
+		EXPECT_EQ( **removed, 1 );
+
+		removed.reset();
+		EXPECT_FALSE( removedValue.expired() );
+		copy.reset();
+		EXPECT_TRUE( removedValue.expired() );
+
+		// A new entry for the same key is independent of the detached one
+		auto cleared = cache.getPinned( 1, []() { return std::make_shared<int>( 2 ); } );
+		cache.get( 2, []() { return std::make_shared<int>( 3 ); } );
+		const std::weak_ptr<int> clearedValue{ *cleared };
+		const std::weak_ptr<int> unpinnedValue{ *cache.find( 2 ) };
+
+		cache.clear();
+		EXPECT_TRUE( cache.isEmpty() );
+		EXPECT_TRUE( unpinnedValue.expired() );
+		EXPECT_EQ( **cleared, 2 );
+		cleared = {};
+		EXPECT_TRUE( clearedValue.expired() );
+
+		auto expired = cache.getPinned( 3, []() { return std::make_shared<int>( 4 ); } );
+		const std::weak_ptr<int> expiredValue{ *expired };
+
+		ManualClock::advance( std::chrono::milliseconds( 200 ) );
+		cache.cleanupExpired();
+		EXPECT_TRUE( cache.isEmpty() );
+		EXPECT_EQ( **expired, 4 );
+		expired.reset();
+		EXPECT_TRUE( expiredValue.expired() );
+	}
+
+	TEST( LruCachePinning, NodeIndexRemovedValueOutlivesHandles )
+	{
+		expectRemovedValueOutlivesHandles<NodeIndex>();
+	}
+
+	TEST( LruCachePinning, FlatIndexRemovedValueOutlivesHandles )
+	{
+		expectRemovedValueOutlivesHandles<FlatIndex>();
+	}
+
+	TEST( LruCachePinning, HandlesStayValidUnderConcurrentEviction )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{ 16 } };
+
+		constexpr int numThreads{ 8 };
+		constexpr int iterations{ 2000 };
+		std::atomic<int> mismatches{ 0 };
+		std::vector<std::thread> threads;
+
+		for ( int t{ 0 }; t < numThreads; ++t )
+		{
+			threads.emplace_back( [&cache, &mismatches, t]() {
+				for ( int i{ 0 }; i < iterations; ++i )
+				{
+					const int key{ ( t * iterations + i ) % 64 };
+					auto handle = cache.getPinned( key, [key]() { return std::string( 64, static_cast<char>( 'a' + key % 26 ) ); } );
+
+					// Other threads keep inserting and evicting while the value is read
+					if ( handle->size() != 64 || handle->front() != static_cast<char>( 'a' + key % 26 ) )
+					{
+						++mismatches;
+					}
+
+					if ( i % 8 == 0 )
+					{
+						cache.remove( key );
+					}
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		EXPECT_EQ( mismatches.load(), 0 );
+	}
+
+	//----------------------------------------------
+	// Statistics
+	//----------------------------------------------
+
+	/** @brief Cache on ManualClock counting statistics */
+	template <typename TKey, typename TValue>
+	using StatsCache = LruCache<TKey, TValue, std::hash<TKey>, std::equal_to<TKey>, NodeIndex, LruPolicy, ManualClock, StripedStats>;
+
+	TEST( LruCacheStats, DisabledByDefault )
+	{
+		LruCache<int, int> cache;
+		cache.get( 1, []() { return 1; } );
+		cache.find( 1 );
+
+		EXPECT_EQ( cache.stats().hits, 0 );
+		EXPECT_EQ( cache.stats().misses, 0 );
+	}
+
+	TEST( LruCacheStats, CountsLookupsInsertsAndEvictions )
+	{
+		StatsCache<int, int> cache{ LruCacheOptions{ 2 } };
+
+		cache.get( 1, []() { return 1; } ); // Miss, load, insert
+		cache.get( 1, []() { return 1; } ); // Hit
+		cache.find( 1 );                    // Hit
+		cache.find( 2 );                    // Miss
+		cache.get( 2, []() { return 2; } );
+		cache.get( 3, []() { return 3; } ); // Evicts 1
+
+		const CacheStats stats{ cache.stats() };
+		EXPECT_EQ( stats.hits, 2 );
+		EXPECT_EQ( stats.misses, 4 );
+		EXPECT_EQ( stats.inserts, 3 );
+		EXPECT_EQ( stats.evictions, 1 );
+		EXPECT_EQ( stats.loads, 3 );
+		EXPECT_EQ( stats.loadFailures, 0 );
+		EXPECT_DOUBLE_EQ( stats.hitRatio(), 2.0 / 6.0 );
+	}
+
+	TEST( LruCacheStats, CountsLazyAndCleanupExpirations )
+	{
+		StatsCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 100 ) } };
+		for ( int i{ 0 }; i < 4; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		ManualClock::advance( std::chrono::milliseconds( 200 ) );
+		EXPECT_EQ( cache.find( 0 ), nullptr ); // Lazy expiration
+		cache.cleanupExpired();                // The other three
+
+		EXPECT_EQ( cache.stats().expirations, 4 );
+		EXPECT_EQ( cache.stats().evictions, 0 );
+	}
+
+	TEST( LruCacheStats, CountsFactoryFailuresAndBatches )
+	{
+		StatsCache<int, int> cache;
+
+		EXPECT_THROW( cache.get( 1, []() -> int { throw std::runtime_error{ "load failed" }; } ), std::runtime_error );
+
+		const std::vector<int> keys{ 1, 2, 3 };
+		std::vector<int*> results( keys.size() );
+		cache.get( 2, []() { return 2; } );
+		cache.getMany( keys, results, []( std::span<const int> missing ) { return std::vector<int>( missing.begin(), missing.end() ); } );
+		EXPECT_EQ( cache.findMany( keys, results ), 3 );
+
+		const CacheStats stats{ cache.stats() };
+		EXPECT_EQ( stats.loads, 3 ); // Failed get(), get( 2 ), one batch
+		EXPECT_EQ( stats.loadFailures, 1 );
+		EXPECT_EQ( stats.inserts, 3 );
+		EXPECT_EQ( stats.hits, 1 + 3 );
+		EXPECT_EQ( stats.misses, 2 + 2 );
+	}
+
+	//----------------------------------------------
+	// Removal listener
+	//----------------------------------------------
+
+	/** @brief Removal reported to a test listener */
+	struct RecordedRemoval
+	{
+		int key;
+		int value;
+		RemovalCause cause;
+
+		bool operator==( const RecordedRemoval& ) const = default;
+	};
+
+	TEST( LruCacheRemovalListener, ReportsEachCause )
+	{
+		std::vector<RecordedRemoval> removals;
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 2, std::chrono::milliseconds( 100 ) }, nullptr, [&removals]( std::span<ManualClockCache<int, int>::RemovalNotification> batch ) {
+											 for ( const auto& removal : batch )
+											 {
+												 removals.push_back( { removal.key, removal.value, removal.cause } );
+											 }
+										 } };
+
+		cache.get( 1, []() { return 10; } );
+		cache.get( 2, []() { return 20; } );
+		cache.get( 3, []() { return 30; } ); // Evicts 1
+		cache.remove( 2 );
+
+		ManualClock::advance( std::chrono::milliseconds( 200 ) );
+		EXPECT_EQ( cache.find( 3 ), nullptr );
+
+		cache.get( 4, []() { return 40; } );
+		cache.clear();
+
+		const std::vector<RecordedRemoval> expected{
+			{ 1, 10, RemovalCause::Size },
+			{ 2, 20, RemovalCause::Explicit },
+			{ 3, 30, RemovalCause::Expired },
+			{ 4, 40, RemovalCause::Cleared } };
+		EXPECT_EQ( removals, expected );
+	}
+
+	TEST( LruCacheRemovalListener, DeliversOneBatchPerOperation )
+	{
+		std::vector<std::size_t> batchSizes;
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 100 ) }, nullptr, [&batchSizes]( std::span<ManualClockCache<int, int>::RemovalNotification> batch ) {
+											 batchSizes.push_back( batch.size() );
+										 } };
+
+		for ( int i{ 0 }; i < 5; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		const std::vector<int> keys{ 0, 1 };
+		EXPECT_EQ( cache.removeMany( keys ), 2 );
+
+		ManualClock::advance( std::chrono::milliseconds( 200 ) );
+		cache.cleanupExpired();
+
+		EXPECT_EQ( batchSizes, ( std::vector<std::size_t>{ 2, 3 } ) );
+	}
+
+	TEST( LruCacheRemovalListener, RunsOutsideTheLock )
+	{
+		LruCache<int, int>* self{ nullptr };
+		std::size_t sizeSeen{ 0 };
+		LruCache<int, int> cache{ LruCacheOptions{ 1 }, nullptr, [&]( std::span<LruCache<int, int>::RemovalNotification> ) {
+									 // Would deadlock if the listener were called under the cache lock
+									 sizeSeen = self->size();
+									 self->get( 100, []() { return 100; } );
+								 } };
+		self = &cache;
+
+		cache.get( 1, []() { return 1; } );
+		cache.get( 2, []() { return 2; } ); // Evicts 1, the listener then evicts 2
+
+		EXPECT_EQ( sizeSeen, 1 );
+		EXPECT_NE( cache.find( 100 ), nullptr );
+	}
+
+	TEST( LruCacheRemovalListener, TakesOwnershipOfValues )
+	{
+		std::vector<std::unique_ptr<std::string>> released;
+		LruCache<int, std::unique_ptr<std::string>> cache{ LruCacheOptions{}, nullptr, [&released]( std::span<LruCache<int, std::unique_ptr<std::string>>::RemovalNotification> batch ) {
+															  for ( auto& removal : batch )
+															  {
+																  released.push_back( std::move( removal.value ) );
+															  }
+														  } };
+
+		cache.get( 1, []() { return std::make_unique<std::string>( "handle" ); } );
+		cache.remove( 1 );
+
+		ASSERT_EQ( released.size(), 1 );
+		ASSERT_NE( released[0], nullptr );
+		EXPECT_EQ( *released[0], "handle" );
+	}
+
+	TEST( LruCacheRemovalListener, ReportsPinnedEntriesOnRelease )
+	{
+		std::vector<RecordedRemoval> removals;
+		LruCache<int, int> cache{ LruCacheOptions{}, nullptr, [&removals]( std::span<LruCache<int, int>::RemovalNotification> batch ) {
+									 for ( const auto& removal : batch )
+									 {
+										 removals.push_back( { removal.key, removal.value, removal.cause } );
+									 }
+								 } };
+
+		auto handle{ cache.getPinned( 1, []() { return 10; } ) };
+		cache.get( 2, []() { return 20; } );
+		cache.clear();
+
+		// The pinned value is still in use: only the other entry is reported
+		EXPECT_EQ( removals, ( std::vector<RecordedRemoval>{ { 2, 20, RemovalCause::Cleared } } ) );
+
+		handle.reset();
+		EXPECT_EQ( removals.back(), ( RecordedRemoval{ 1, 10, RemovalCause::Cleared } ) );
+	}
+
+	//----------------------------------------------
+	// In-place writes
+	//----------------------------------------------
+
+	/** @brief Value that can be neither copied nor moved, so it only fits in through emplace() */
+	struct Immovable
+	{
+		Immovable( int first, int second )
+			: sum{ first + second }
+		{
+		}
+
+		Immovable( const Immovable& ) = delete;
+		Immovable& operator=( const Immovable& ) = delete;
+
+		int sum;
+	};
+
+	TEST( LruCacheWrites, InsertOrAssignReusesTheEntry )
+	{
+		std::vector<RecordedRemoval> removals;
+		LruCache<int, int> cache{ LruCacheOptions{}, nullptr, [&removals]( std::span<LruCache<int, int>::RemovalNotification> batch ) {
+									 for ( const auto& removal : batch )
+									 {
+										 removals.push_back( { removal.key, removal.value, removal.cause } );
+									 }
+								 } };
+
+		const auto [inserted, wasInserted] = cache.insertOrAssign( 1, 10 );
+		EXPECT_TRUE( wasInserted );
+		EXPECT_EQ( *inserted, 10 );
+
+		const auto [assigned, wasAssignedInserted] = cache.insertOrAssign( 1, 11 );
+		EXPECT_FALSE( wasAssignedInserted );
+		EXPECT_EQ( assigned, inserted );
+		EXPECT_EQ( *cache.find( 1 ), 11 );
+		EXPECT_EQ( cache.size(), 1 );
+
+		const std::vector<RecordedRemoval> expected{ { 1, 10, RemovalCause::Replaced } };
+		EXPECT_EQ( removals, expected );
+	}
+
+	TEST( LruCacheWrites, SetMarksEntryRecentlyUsed )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{ 2 } };
+
+		cache.set( 1, 10 );
+		cache.set( 2, 20 );
+		cache.set( 1, 11 );
+		cache.set( 3, 30 ); // Evicts 2
+
+		EXPECT_EQ( cache.find( 2 ), nullptr );
+		EXPECT_EQ( *cache.find( 1 ), 11 );
+		EXPECT_EQ( *cache.find( 3 ), 30 );
+	}
+
+	TEST( LruCacheWrites, SetRestartsExpirationWithNewSettings )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 100 ) } };
+
+		cache.set( 1, 10 );
+		ManualClock::advance( std::chrono::milliseconds( 80 ) );
+		cache.set( 1, 11, []( CacheEntry& entry ) { entry.slidingExpiration = std::chrono::milliseconds( 50 ); } );
+
+		ManualClock::advance( std::chrono::milliseconds( 40 ) );
+		cache.cleanupExpired();
+		EXPECT_EQ( cache.size(), 1 );
+
+		ManualClock::advance( std::chrono::milliseconds( 20 ) );
+		cache.cleanupExpired();
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( LruCacheWrites, ExpiredEntryCountsAsMissing )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 100 ) } };
+
+		cache.set( 1, 10 );
+		ManualClock::advance( std::chrono::milliseconds( 150 ) );
+
+		const auto [value, inserted] = cache.emplace( 1, 11 );
+		EXPECT_TRUE( inserted );
+		EXPECT_EQ( *value, 11 );
+	}
+
+	TEST( LruCacheWrites, EmplaceConstructsInPlace )
+	{
+		LruCache<int, Immovable> cache{ LruCacheOptions{ 2 } };
+
+		const auto [value, inserted] = cache.emplace( 1, 2, 3 );
+		EXPECT_TRUE( inserted );
+		EXPECT_EQ( value->sum, 5 );
+
+		// A live entry is left untouched
+		const auto [existing, replaced] = cache.emplace( 1, 10, 10 );
+		EXPECT_FALSE( replaced );
+		EXPECT_EQ( existing, value );
+		EXPECT_EQ( existing->sum, 5 );
+
+		cache.emplace( 2, 1, 1 );
+		cache.emplace( 3, 1, 2 );
+		EXPECT_EQ( cache.size(), 2 );
+		EXPECT_EQ( cache.find( 1 ), nullptr );
+		EXPECT_TRUE( cache.remove( 3 ) );
+	}
+
+	TEST( LruCacheWrites, MoveOnlyValues )
+	{
+		std::vector<int> removed;
+		LruCache<int, std::unique_ptr<int>> cache{ LruCacheOptions{}, nullptr, [&removed]( std::span<LruCache<int, std::unique_ptr<int>>::RemovalNotification> batch ) {
+													  for ( auto& removal : batch )
+													  {
+														  removed.push_back( *removal.value );
+													  }
+												  } };
+
+		cache.set( 1, std::make_unique<int>( 10 ) );
+		cache.insertOrAssign( 1, std::make_unique<int>( 11 ) );
+		cache.emplace( 2, new int{ 20 } );
+
+		EXPECT_EQ( **cache.find( 1 ), 11 );
+		EXPECT_EQ( **cache.find( 2 ), 20 );
+		EXPECT_EQ( removed, std::vector<int>{ 10 } );
+	}
+
+	TEST( LruCacheWrites, PinnedValueIsReplacedByNewEntry )
+	{
+		LruCache<int, std::string> cache;
+
+		cache.set( 1, std::string{ "old" } );
+		auto handle = cache.findPinned( 1 );
+
+		cache.set( 1, "new" );
+		EXPECT_EQ( *handle, "old" );
+		EXPECT_EQ( *cache.find( 1 ), "new" );
+	}
+
+	TEST( LruCacheWrites, SizedOnceConstructedWithoutEvictingTheWrite )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{}.setMemoryLimit( 10 ), []( const int&, const std::string& value ) { return value.size(); } };
+
+		cache.emplace( 1, 4, 'a' );
+		cache.emplace( 2, 4, 'b' );
+		EXPECT_EQ( cache.memoryUsage(), 8 );
+
+		// Growing entry 2 in place evicts entry 1, never entry 2 itself
+		cache.set( 2, std::string( 8, 'c' ) );
+		EXPECT_EQ( cache.size(), 1 );
+		EXPECT_EQ( cache.memoryUsage(), 8 );
+		EXPECT_EQ( *cache.find( 2 ), "cccccccc" );
+	}
+
+	TEST( LruCacheWrites, WriteWaitsForLoadInFlight )
+	{
+		std::vector<std::string> replaced;
+		LruCache<int, std::string> cache{ LruCacheOptions{}, nullptr, [&replaced]( std::span<LruCache<int, std::string>::RemovalNotification> batch ) {
+											 for ( const auto& removal : batch )
+											 {
+												 replaced.push_back( removal.value );
+											 }
+										 } };
+
+		std::promise<void> started;
+		std::thread loader{ [&]() {
+			cache.get( 1, [&]() {
+				started.set_value();
+				std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+				return std::string{ "loaded" };
+			} );
+		} };
+
+		started.get_future().wait();
+		cache.set( 1, "written" );
+		loader.join();
+
+		EXPECT_EQ( *cache.find( 1 ), "written" );
+		EXPECT_EQ( replaced, std::vector<std::string>{ "loaded" } );
+	}
+
+	//----------------------------------------------
+	// Negative caching
+	//----------------------------------------------
+
+	TEST( LruCacheNegative, AbsentKeyIsNotRememberedByDefault )
+	{
+		LruCache<int, std::string> cache;
+		int calls{ 0 };
+		auto lookup = [&calls]() -> std::optional<std::string> {
+			++calls;
+			return std::nullopt;
+		};
+
+		EXPECT_EQ( cache.get( 1, lookup ), nullptr );
+		EXPECT_FALSE( cache.getPinned( 1, lookup ) );
+		EXPECT_EQ( calls, 2 );
+		EXPECT_EQ( cache.tombstoneCount(), 0 );
+
+		// A factory that finds the value caches it as usual
+		EXPECT_EQ( *cache.get( 2, []() { return std::optional<std::string>{ "two" }; } ), "two" );
+		EXPECT_EQ( cache.size(), 1 );
+	}
+
+	TEST( LruCacheNegative, TombstoneAnswersUntilExpired )
+	{
+		StatsCache<int, int> cache{ LruCacheOptions{}.setNegativeExpiration( std::chrono::milliseconds( 100 ) ) };
+		int calls{ 0 };
+		auto lookup = [&calls]() -> std::optional<int> {
+			++calls;
+			return std::nullopt;
+		};
+
+		EXPECT_EQ( cache.get( 1, lookup ), nullptr );
+		ManualClock::advance( std::chrono::milliseconds( 100 ) );
+		EXPECT_EQ( cache.get( 1, lookup ), nullptr );
+		EXPECT_EQ( calls, 1 );
+
+		const CacheStats stats{ cache.stats() };
+		EXPECT_EQ( stats.hits, 1 );
+		EXPECT_EQ( stats.misses, 1 );
+		EXPECT_EQ( stats.inserts, 0 );
+
+		ManualClock::advance( std::chrono::milliseconds( 1 ) );
+		EXPECT_EQ( cache.get( 1, lookup ), nullptr );
+		EXPECT_EQ( calls, 2 );
+	}
+
+	TEST( LruCacheNegative, TombstonesTakeNoEntrySpace )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 1 }.setNegativeExpiration( std::chrono::milliseconds( 100 ) ) };
+
+		cache.set( 1, 10 );
+		const std::size_t memoryUsage{ cache.memoryUsage() };
+		cache.get( 2, []() { return std::optional<int>{}; } );
+		cache.get( 3, []() { return std::optional<int>{}; } );
+
+		EXPECT_EQ( cache.size(), 1 );
+		EXPECT_EQ( cache.memoryUsage(), memoryUsage );
+		EXPECT_EQ( cache.tombstoneCount(), 2 );
+		EXPECT_EQ( *cache.find( 1 ), 10 );
+
+		ManualClock::advance( std::chrono::milliseconds( 150 ) );
+		cache.cleanupExpired();
+		EXPECT_EQ( cache.tombstoneCount(), 0 );
+
+		cache.get( 2, []() { return std::optional<int>{}; } );
+		cache.clear();
+		EXPECT_EQ( cache.tombstoneCount(), 0 );
+	}
+
+	TEST( LruCacheNegative, WritesAndRemovesForgetTheTombstone )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{}.setNegativeExpiration( std::chrono::minutes( 1 ) ) };
+		auto absent = []() { return std::optional<int>{}; };
+
+		cache.get( 1, absent );
+		cache.set( 1, 10 );
+		EXPECT_EQ( cache.tombstoneCount(), 0 );
+		EXPECT_EQ( *cache.get( 1, absent ), 10 );
+
+		cache.get( 2, absent );
+		EXPECT_FALSE( cache.remove( 2 ) );
+		EXPECT_EQ( cache.tombstoneCount(), 0 );
+		EXPECT_EQ( *cache.get( 2, []() { return 20; } ), 20 );
+	}
+
+	TEST( LruCacheNegative, SizeLimitDropsOldestTombstone )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{}.setNegativeExpiration( std::chrono::minutes( 1 ) ).setNegativeSizeLimit( 2 ) };
+		int calls{ 0 };
+		auto lookup = [&calls]() -> std::optional<int> {
+			++calls;
+			return std::nullopt;
+		};
+
+		cache.get( 1, lookup );
+		cache.get( 2, lookup );
+		cache.get( 3, lookup );
+		EXPECT_EQ( cache.tombstoneCount(), 2 );
+
+		cache.get( 3, lookup );
+		cache.get( 1, lookup ); // Its tombstone was dropped for key 3
+		EXPECT_EQ( calls, 4 );
+		EXPECT_EQ( cache.tombstoneCount(), 2 );
+	}
+
+	TEST( LruCacheNegative, WaitersShareTheAbsentResult )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{}.setNegativeExpiration( std::chrono::minutes( 1 ) ) };
+		std::atomic<int> calls{ 0 };
+		std::promise<void> started;
+		std::promise<void> release;
+		std::shared_future<void> released{ release.get_future() };
+
+		std::thread loader{ [&]() {
+			EXPECT_EQ( cache.get( 1, [&]() -> std::optional<int> {
+				++calls;
+				started.set_value();
+				released.wait();
+				return std::nullopt;
+			} ),
+				nullptr );
+		} };
+
+		started.get_future().wait();
+		std::thread waiter{ [&]() { EXPECT_EQ( cache.get( 1, [&]() -> std::optional<int> { ++calls; return 1; } ), nullptr ); } };
+		std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+		release.set_value();
+
+		loader.join();
+		waiter.join();
+		EXPECT_EQ( calls, 1 );
+	}
+
+	TEST( LruCacheNegative, BatchAndAsyncLookupsHonourTombstones )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{}.setNegativeExpiration( std::chrono::minutes( 1 ) ) };
+		cache.get( 2, []() { return std::optional<int>{}; } );
+
+		const std::vector<int> keys{ 1, 2 };
+		std::vector<int*> results( keys.size() );
+		std::vector<int> loaded;
+		const std::size_t created = cache.getMany( keys, results, [&loaded]( std::span<const int> missing ) {
+			loaded.assign( missing.begin(), missing.end() );
+			return std::vector<int>( missing.size(), 1 );
+		} );
+
+		EXPECT_EQ( created, 1 );
+		EXPECT_EQ( loaded, std::vector<int>{ 1 } );
+		EXPECT_EQ( *results[0], 1 );
+		EXPECT_EQ( results[1], nullptr );
+
+		auto future = cache.getFuture( 2, []() { return 2; } );
+		EXPECT_FALSE( future.get() );
+		EXPECT_EQ( cache.find( 2 ), nullptr );
+	}
+
+	//----------------------------------------------
+	// Second tier
+	//----------------------------------------------
+
+	TEST( LruCacheSecondTier, EvictedValueIsPromotedWithoutReload )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{ 1 }.setSecondTierMemoryLimit( 1 << 20 ) };
+		const std::string large( 4096, 'x' );
+		int calls{ 0 };
+
+		cache.set( 1, large );
+		cache.set( 2, "two" );
+		EXPECT_EQ( cache.size(), 1 );
+		EXPECT_EQ( cache.secondTierSize(), 1 );
+		EXPECT_GT( cache.secondTierMemoryUsage(), 0 );
+		EXPECT_LT( cache.secondTierMemoryUsage(), large.size() / 10 );
+
+		EXPECT_EQ( *cache.get( 1, [&calls]() { ++calls; return std::string{}; } ), large );
+		EXPECT_EQ( calls, 0 );
+
+		// Key 2 took its place in the second tier
+		EXPECT_EQ( cache.secondTierSize(), 1 );
+		EXPECT_EQ( *cache.get( 2, [&calls]() { ++calls; return std::string{}; } ), "two" );
+		EXPECT_EQ( calls, 0 );
+	}
+
+	TEST( LruCacheSecondTier, DisabledByDefault )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{ 1 } };
+		int calls{ 0 };
+
+		cache.set( 1, "one" );
+		cache.set( 2, "two" );
+		EXPECT_EQ( cache.secondTierSize(), 0 );
+
+		EXPECT_EQ( *cache.get( 1, [&calls]() { ++calls; return std::string{ "reloaded" }; } ), "reloaded" );
+		EXPECT_EQ( calls, 1 );
+	}
+
+	TEST( LruCacheSecondTier, BudgetDropsOldestValues )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{ 1 }.setSecondTierMemoryLimit( 64 ) };
+		int calls{ 0 };
+		auto reload = [&calls]() {
+			++calls;
+			return std::string{};
+		};
+
+		for ( int i{ 0 }; i < 10; ++i )
+		{
+			cache.set( i, std::string( 1000, static_cast<char>( 'a' + i ) ) );
+		}
+
+		EXPECT_LE( cache.secondTierMemoryUsage(), 64 );
+		EXPECT_GT( cache.secondTierSize(), 0 );
+		EXPECT_LT( cache.secondTierSize(), 9 );
+
+		EXPECT_EQ( *cache.get( 8, reload ), std::string( 1000, 'i' ) );
+		EXPECT_EQ( calls, 0 );
+		EXPECT_EQ( cache.get( 0, reload )->size(), 0 );
+		EXPECT_EQ( calls, 1 );
+
+		// A value larger than the whole budget once compressed is not kept
+		std::string noise( 256, '\0' );
+		std::uint32_t seed{ 1 };
+		for ( char& c : noise )
+		{
+			seed = seed * 1664525u + 1013904223u;
+			c = static_cast<char>( seed >> 24 );
+		}
+
+		cache.set( 30, noise );
+		cache.set( 31, "x" );
+		EXPECT_LE( cache.secondTierMemoryUsage(), 64 );
+		EXPECT_EQ( cache.get( 30, reload )->size(), 0 );
+		EXPECT_EQ( calls, 2 );
+	}
+
+	TEST( LruCacheSecondTier, PromotionKeepsExpirationState )
+	{
+		StatsCache<int, int> cache{ LruCacheOptions{ 1 }.setSecondTierMemoryLimit( 1024 ) };
+		auto absolute = []( CacheEntry& entry ) {
+			entry.expirationMode = ExpirationMode::Absolute;
+			entry.absoluteExpiration = std::chrono::milliseconds( 100 );
+		};
+		int calls{ 0 };
+		auto reload = [&calls]() {
+			++calls;
+			return 0;
+		};
+
+		cache.set( 1, 10, absolute );
+		cache.set( 2, 20, absolute );
+		ManualClock::advance( std::chrono::milliseconds( 60 ) );
+		EXPECT_EQ( *cache.get( 1, reload ), 10 );
+		EXPECT_EQ( calls, 0 );
+
+		// Still 100 ms after the value was first stored, not after its promotion
+		ManualClock::advance( std::chrono::milliseconds( 50 ) );
+		EXPECT_EQ( cache.find( 1 ), nullptr );
+
+		// An expired copy is dropped rather than promoted
+		EXPECT_EQ( *cache.get( 2, reload ), 0 );
+		EXPECT_EQ( calls, 1 );
+
+		const CacheStats stats{ cache.stats() };
+		EXPECT_EQ( stats.loads, 1 );
+		EXPECT_GE( stats.expirations, 1 );
+	}
+
+	TEST( LruCacheSecondTier, WritesAndRemovesForgetCompressedValue )
+	{
+		ManualClockCache<int, std::string> cache{ LruCacheOptions{ 1 }.setSecondTierMemoryLimit( 1024 ) };
+		auto reload = []() { return std::string{ "reloaded" }; };
+
+		cache.set( 1, "one" );
+		cache.set( 2, "two" );
+		EXPECT_FALSE( cache.remove( 1 ) );
+		EXPECT_EQ( cache.secondTierSize(), 0 );
+		EXPECT_EQ( *cache.get( 1, reload ), "reloaded" );
+
+		// Key 2 was demoted by the reload of key 1, then written again
+		cache.set( 2, "new" );
+		EXPECT_EQ( cache.secondTierSize(), 1 ); // Key 1, evicted by the write
+		cache.set( 3, "three" );
+		EXPECT_EQ( *cache.get( 2, reload ), "new" );
+
+		cache.clear();
+		EXPECT_EQ( cache.secondTierSize(), 0 );
+		EXPECT_EQ( cache.secondTierMemoryUsage(), 0 );
+	}
+
+	TEST( LruCacheSecondTier, CustomCodecAndMinimumSize )
+	{
+		std::atomic<int> compressed{ 0 };
+		bool corrupt{ false };
+		CompressionCodec codec;
+		codec.compress = [&compressed]( std::span<const std::byte> input, std::vector<std::byte>& output ) {
+			++compressed;
+			output.insert( output.end(), input.begin(), input.end() );
+		};
+		codec.decompress = [&corrupt]( std::span<const std::byte> input, std::vector<std::byte>& output ) {
+			if ( corrupt )
+			{
+				throw std::runtime_error{ "corrupt" };
+			}
+			output.insert( output.end(), input.begin(), input.end() );
+		};
+
+		LruCache<int, std::string> cache{ LruCacheOptions{ 1 }.setSecondTierMemoryLimit( 1024 ).setSecondTierMinimumSize( 4 ).setSecondTierCodec( codec ) };
+		int calls{ 0 };
+		auto reload = [&calls]() {
+			++calls;
+			return std::string{ "reloaded" };
+		};
+
+		cache.set( 1, "abc" ); // Below the minimum size
+		cache.set( 2, "long enough" );
+		cache.set( 3, "three" );
+		EXPECT_EQ( compressed, 1 );
+		EXPECT_EQ( cache.secondTierSize(), 1 );
+		EXPECT_EQ( cache.secondTierMemoryUsage(), std::string_view{ "long enough" }.size() );
+
+		EXPECT_EQ( *cache.get( 2, reload ), "long enough" );
+		EXPECT_EQ( calls, 0 );
+
+		// A value the codec cannot restore is loaded again
+		corrupt = true;
+		EXPECT_EQ( *cache.get( 3, reload ), "reloaded" );
+		EXPECT_EQ( *cache.get( 1, reload ), "reloaded" );
+		EXPECT_EQ( calls, 2 );
+	}
+
+	TEST( LruCacheSecondTier, RemovingOneKeyKeepsOtherDemotions )
+	{
+		LruCache<int, std::string>* target{ nullptr };
+		int removeDuring{ 0 };
+		CompressionCodec codec;
+		codec.compress = [&]( std::span<const std::byte> input, std::vector<std::byte>& output ) {
+			// Runs after the evicting operation released the lock, while the demotion is in flight
+			if ( removeDuring != 0 )
+			{
+				target->remove( removeDuring );
+			}
+			LzCodec::compress( input, output );
+		};
+
+		LruCache<int, std::string> cache{ LruCacheOptions{ 1 }.setSecondTierMemoryLimit( 1024 ).setSecondTierCodec( codec ) };
+		target = &cache;
+		int calls{ 0 };
+		auto reload = [&calls]() {
+			++calls;
+			return std::string{ "reloaded" };
+		};
+
+		removeDuring = 99;
+		cache.set( 1, "one" );
+		cache.set( 2, "two" );
+		EXPECT_EQ( cache.secondTierSize(), 1 );
+
+		// Removing the demoted key itself drops it
+		removeDuring = 2;
+		EXPECT_EQ( *cache.get( 1, reload ), "one" );
+		EXPECT_EQ( cache.secondTierSize(), 0 );
+		EXPECT_EQ( *cache.get( 2, reload ), "reloaded" );
+		EXPECT_EQ( calls, 1 );
+	}
+
+	TEST( LruCacheSecondTier, EveryLookupPromotes )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{ 3 }.setSecondTierMemoryLimit( 1024 ) };
+		for ( int i{ 1 }; i <= 6; ++i )
+		{
+			cache.set( i, "value_" + std::to_string( i ) );
+		}
+		EXPECT_EQ( cache.secondTierSize(), 3 );
+
+		// getMany() only passes the keys without a compressed value to the factory
+		std::vector<int> requested;
+		const std::vector<int> keys{ 1, 2, 9 };
+		std::vector<std::string*> results( keys.size() );
+		EXPECT_EQ( cache.getMany( keys, results, [&requested]( std::span<const int> missing ) {
+			requested.assign( missing.begin(), missing.end() );
+			return std::vector<std::string>( missing.size(), "loaded" );
+		} ),
+			1 );
+		EXPECT_EQ( requested, std::vector<int>{ 9 } );
+		ASSERT_NE( results[0], nullptr );
+		ASSERT_NE( results[1], nullptr );
+		ASSERT_NE( results[2], nullptr );
+		EXPECT_EQ( *results[0], "value_1" );
+		EXPECT_EQ( *results[1], "value_2" );
+		EXPECT_EQ( *results[2], "loaded" );
+
+		// find() and findMany() promote as well
+		ASSERT_NE( cache.find( 3 ), nullptr );
+		EXPECT_EQ( *cache.find( 3 ), "value_3" );
+
+		const std::vector<int> found{ 4, 42 };
+		std::vector<std::string*> foundResults( found.size() );
+		EXPECT_EQ( cache.findMany( found, foundResults ), 1 );
+		ASSERT_NE( foundResults[0], nullptr );
+		EXPECT_EQ( *foundResults[0], "value_4" );
+		EXPECT_EQ( foundResults[1], nullptr );
+
+		int calls{ 0 };
+		std::future<LruCache<int, std::string>::ValueHandle> future{ cache.getFuture( 6, [&calls]() {
+			++calls;
+			return std::string{ "reloaded" };
+		} ) };
+		EXPECT_EQ( *future.get(), "value_6" );
+		EXPECT_EQ( calls, 0 );
+	}
+
+	TEST( LruCacheSecondTier, CleanupPurgesExpiredValues )
+	{
+		ManualClockCache<int, std::string> cache{ LruCacheOptions{ 1, std::chrono::milliseconds( 100 ) }.setSecondTierMemoryLimit( 1024 ) };
+
+		cache.set( 1, "one" );
+		cache.set( 2, "two" );
+		EXPECT_EQ( cache.secondTierSize(), 1 );
+
+		ManualClock::advance( std::chrono::milliseconds( 200 ) );
+		cache.cleanupExpired();
+		EXPECT_EQ( cache.secondTierSize(), 0 );
+		EXPECT_EQ( cache.secondTierMemoryUsage(), 0 );
+	}
+
+	TEST( LruCacheSecondTier, RequiresValueSerializer )
+	{
+		const auto options{ LruCacheOptions{ 1 }.setSecondTierMemoryLimit( 1024 ) };
+
+		EXPECT_THROW( ( LruCache<int, std::vector<int>>{ options } ), std::invalid_argument );
+		EXPECT_NO_THROW( ( LruCache<int, std::vector<int>>{ LruCacheOptions{ 1 } } ) );
+		EXPECT_NO_THROW( ( LruCache<int, int>{ options } ) );
+	}
+
+	//----------------------------------------------
+	// Maintenance thread
+	//----------------------------------------------
+
+	/** @brief Poll a condition until it holds or a generous timeout elapses */
+	template <typename Condition>
+	bool eventually( Condition condition )
+	{
+		const auto deadline{ std::chrono::steady_clock::now() + std::chrono::seconds( 5 ) };
+		while ( !condition() )
+		{
+			if ( std::chrono::steady_clock::now() > deadline )
+			{
+				return false;
+			}
+
+			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+		}
+
+		return true;
+	}
+
+	TEST( LruCacheMaintenance, ExpiresIdleCache )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 100 ), std::chrono::milliseconds( 1 ) }.setMaintenanceThread( true ) };
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		// No operation runs after the entries expire: only the maintenance thread can shed them
+		ManualClock::advance( std::chrono::milliseconds( 200 ) );
+		EXPECT_TRUE( eventually( [&cache]() { return cache.isEmpty(); } ) );
+	}
+
+	TEST( LruCacheMaintenance, SharedSchedulerServesSeveralCaches )
+	{
+		MaintenanceScheduler scheduler;
+		const auto options{ LruCacheOptions{ 0, std::chrono::milliseconds( 100 ), std::chrono::milliseconds( 1 ) }.setMaintenanceScheduler( &scheduler ) };
+
+		{
+			ManualClockCache<int, int> first{ options };
+			ManualClockCache<int, int> second{ options };
+			EXPECT_EQ( scheduler.taskCount(), 2 );
+
+			first.get( 1, []() { return 1; } );
+			second.get( 2, []() { return 2; } );
+
+			ManualClock::advance( std::chrono::milliseconds( 200 ) );
+			EXPECT_TRUE( eventually( [&]() { return first.isEmpty() && second.isEmpty(); } ) );
+		}
+
+		EXPECT_EQ( scheduler.taskCount(), 0 );
+	}
+
+	TEST( LruCacheMaintenance, EnforcesLimitsAfterPinsAreReleased )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{ 2, std::chrono::hours( 1 ), std::chrono::milliseconds( 1 ) }.setMaintenanceThread( true ) };
+
+		{
+			auto first{ cache.getPinned( 1, []() { return 1; } ) };
+			auto second{ cache.getPinned( 2, []() { return 2; } ) };
+			cache.get( 3, []() { return 3; } ); // Every other entry is pinned: the limit is exceeded
+			EXPECT_EQ( cache.size(), 3 );
+		}
+
+		EXPECT_TRUE( eventually( [&cache]() { return cache.size() == 2; } ) );
+	}
+
+	//----------------------------------------------
+	// Refresh-ahead
+	//----------------------------------------------
+
+	/** @brief Executor holding reload tasks until the test runs them */
+	struct QueuedExecutor
+	{
+		std::vector<std::function<void()>> tasks;
+
+		LruCacheOptions::Executor executor()
+		{
+			return [this]( std::function<void()> task ) { tasks.push_back( std::move( task ) ); };
+		}
+
+		void runAll()
+		{
+			auto pending{ std::move( tasks ) };
+			tasks.clear();
+			for ( auto& task : pending )
+			{
+				task();
+			}
+		}
+	};
+
+	TEST( LruCacheRefresh, ServesCurrentValueWhileReloading )
+	{
+		QueuedExecutor executor;
+		std::vector<RemovalCause> causes;
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::hours( 1 ) }.setRefreshAfter( std::chrono::milliseconds( 100 ) ).setRefreshExecutor( executor.executor() ), nullptr,
+			[&causes]( std::span<ManualClockCache<int, int>::RemovalNotification> batch ) {
+				for ( const auto& removal : batch )
+				{
+					causes.push_back( removal.cause );
+				}
+			} };
+
+		int version{ 1 };
+		const auto load{ [&version]() { return version; } };
+
+		EXPECT_EQ( *cache.get( 1, load ), 1 );
+		ManualClock::advance( std::chrono::milliseconds( 50 ) );
+		version = 2;
+		EXPECT_EQ( *cache.get( 1, load ), 1 );
+		EXPECT_TRUE( executor.tasks.empty() );
+
+		// Old enough: the hit still returns the current value, and one reload is scheduled
+		ManualClock::advance( std::chrono::milliseconds( 60 ) );
+		EXPECT_EQ( *cache.get( 1, load ), 1 );
+		EXPECT_EQ( *cache.get( 1, load ), 1 );
+		EXPECT_EQ( executor.tasks.size(), 1 );
+
+		executor.runAll();
+		EXPECT_EQ( *cache.find( 1 ), 2 );
+		EXPECT_EQ( causes, ( std::vector<RemovalCause>{ RemovalCause::Replaced } ) );
+
+		// The reloaded value starts a new refresh period
+		ManualClock::advance( std::chrono::milliseconds( 50 ) );
+		cache.get( 1, load );
+		EXPECT_TRUE( executor.tasks.empty() );
+	}
+
+	TEST( LruCacheRefresh, ServesStaleValueWithinWindow )
+	{
+		QueuedExecutor executor;
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 100 ) }.setStaleWhileRevalidate( std::chrono::seconds( 1 ) ).setRefreshExecutor( executor.executor() ) };
+
+		int version{ 1 };
+		const auto load{ [&version]() { return version; } };
+
+		cache.get( 1, load );
+		version = 2;
+		ManualClock::advance( std::chrono::milliseconds( 200 ) );
+
+		// Expired: find() and findMany() miss but keep the entry, get() serves it and schedules a reload
+		EXPECT_EQ( cache.find( 1 ), nullptr );
+		const std::vector<int> keys{ 1 };
+		std::vector<int*> results( keys.size() );
+		EXPECT_EQ( cache.findMany( keys, results ), 0 );
+		EXPECT_EQ( results[0], nullptr );
+		cache.cleanupExpired();
+		EXPECT_EQ( cache.size(), 1 );
+		EXPECT_EQ( *cache.get( 1, load ), 1 );
+		EXPECT_EQ( executor.tasks.size(), 1 );
+
+		executor.runAll();
+		EXPECT_EQ( *cache.find( 1 ), 2 );
+	}
+
+	TEST( LruCacheRefresh, KeepsStaleValueWhileBackendFails )
+	{
+		QueuedExecutor executor;
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 100 ) }.setStaleWhileRevalidate( std::chrono::seconds( 1 ) ).setRefreshExecutor( executor.executor() ) };
+
+		bool failing{ false };
+		const auto load{ [&failing]() {
+			if ( failing )
+			{
+				throw std::runtime_error{ "backend down" };
+			}
+
+			return 1;
+		} };
+
+		cache.get( 1, load );
+		failing = true;
+		ManualClock::advance( std::chrono::milliseconds( 200 ) );
+
+		EXPECT_EQ( *cache.get( 1, load ), 1 );
+		executor.runAll();
+
+		// The failed reload kept the stale value, and the next hit retries
+		EXPECT_EQ( *cache.get( 1, load ), 1 );
+		EXPECT_EQ( executor.tasks.size(), 1 );
+		executor.runAll();
+
+		// Past the window the entry is gone and get() loads synchronously
+		ManualClock::advance( std::chrono::seconds( 1 ) );
+		EXPECT_THROW( cache.get( 1, load ), std::runtime_error );
+		EXPECT_TRUE( executor.tasks.empty() );
+	}
+
+	TEST( LruCacheRefresh, DefaultExecutorReloadsOnAnotherThread )
+	{
+		std::atomic<int> version{ 1 };
+		const auto load{ [&version]() { return version.load(); } };
+
+		{
+			ManualClockCache<int, int> cache{ LruCacheOptions{}.setRefreshAfter( std::chrono::milliseconds( 10 ) ) };
+			cache.get( 1, load );
+
+			// The reload may replace the entry at any time: read the served value through a pin
+			version = 2;
+			ManualClock::advance( std::chrono::milliseconds( 20 ) );
+			EXPECT_EQ( *cache.getPinned( 1, load ), 1 );
+			EXPECT_TRUE( eventually( [&cache]() {
+				const auto value{ cache.findPinned( 1 ) };
+				return value && *value == 2;
+			} ) );
+		}
+
+		// The destructor waits for a reload still running
+		{
+			ManualClockCache<int, int> cache{ LruCacheOptions{}.setRefreshAfter( std::chrono::milliseconds( 10 ) ) };
+			cache.get( 1, load );
+
+			ManualClock::advance( std::chrono::milliseconds( 20 ) );
+			cache.get( 1, [&version]() {
+				std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+				return version.load();
+			} );
+		}
+	}
+
+	//----------------------------------------------
+	// Asynchronous get
+	//----------------------------------------------
+
+	/** @brief Coroutine started eagerly and never awaited, driving getAsync() from the tests */
+	struct DetachedTask
+	{
+		struct promise_type
+		{
+			DetachedTask get_return_object() noexcept { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() noexcept {}
+			void unhandled_exception() noexcept { std::terminate(); }
+		};
+	};
+
+	/** @brief Await a key, storing its value or the message of the exception thrown */
+	template <typename Cache, typename Factory>
+	DetachedTask awaitValue( Cache& cache, int key, Factory factory, std::optional<int>& result, std::string& error )
+	{
+		try
+		{
+			const auto value{ co_await cache.getAsync( key, factory ) };
+			result = *value;
+		}
+		catch ( const std::exception& e )
+		{
+			error = e.what();
+		}
+	}
+
+	TEST( LruCacheAsync, HitCompletesSynchronously )
+	{
+		QueuedExecutor executor;
+		LruCache<int, int> cache{ LruCacheOptions{}.setLoadExecutor( executor.executor() ) };
+		cache.get( 1, []() { return 10; } );
+
+		int calls{ 0 };
+		const auto load{ [&calls]() { return ++calls; } };
+
+		auto awaitable{ cache.getAsync( 1, load ) };
+		EXPECT_TRUE( awaitable.await_ready() );
+		EXPECT_EQ( *awaitable.await_resume(), 10 );
+
+		std::optional<int> result;
+		std::string error;
+		awaitValue( cache, 1, load, result, error );
+		EXPECT_EQ( result, 10 );
+		EXPECT_EQ( calls, 0 );
+		EXPECT_TRUE( executor.tasks.empty() );
+	}
+
+	TEST( LruCacheAsync, MissResumesEveryWaiterAfterOneLoad )
+	{
+		QueuedExecutor executor;
+		StatsCache<int, int> cache{ LruCacheOptions{}.setLoadExecutor( executor.executor() ) };
+
+		int calls{ 0 };
+		const auto load{ [&calls]() { return 40 + ++calls; } };
+
+		std::optional<int> first;
+		std::optional<int> second;
+		std::string error;
+		awaitValue( cache, 1, load, first, error );
+		awaitValue( cache, 1, load, second, error );
+
+		// Both coroutines are suspended on the single load queued on the executor
+		EXPECT_FALSE( first );
+		EXPECT_FALSE( second );
+		EXPECT_EQ( executor.tasks.size(), 1 );
+
+		executor.runAll();
+		EXPECT_EQ( first, 41 );
+		EXPECT_EQ( second, 41 );
+		EXPECT_EQ( calls, 1 );
+		EXPECT_EQ( *cache.find( 1 ), 41 );
+
+		const CacheStats stats{ cache.stats() };
+		EXPECT_EQ( stats.misses, 2 );
+		EXPECT_EQ( stats.loads, 1 );
+	}
+
+	TEST( LruCacheAsync, FactoryExceptionResumesWaitersWithIt )
+	{
+		QueuedExecutor executor;
+		LruCache<int, int> cache{ LruCacheOptions{}.setLoadExecutor( executor.executor() ) };
+
+		std::optional<int> first;
+		std::optional<int> second;
+		std::string firstError;
+		std::string secondError;
+		const auto load{ []() -> int { throw std::runtime_error{ "backend down" }; } };
+		awaitValue( cache, 1, load, first, firstError );
+		awaitValue( cache, 1, load, second, secondError );
+
+		executor.runAll();
+		EXPECT_FALSE( first );
+		EXPECT_EQ( firstError, "backend down" );
+		EXPECT_EQ( secondError, "backend down" );
+		EXPECT_TRUE( cache.isEmpty() );
+
+		// Nothing was cached: the next caller loads again
+		awaitValue( cache, 1, []() { return 7; }, first, firstError );
+		executor.runAll();
+		EXPECT_EQ( first, 7 );
+	}
+
+	TEST( LruCacheAsync, SharesLoadsWithBlockingGet )
+	{
+		QueuedExecutor executor;
+		LruCache<int, int> cache{ LruCacheOptions{}.setLoadExecutor( executor.executor() ) };
+
+		// A get() for a key being loaded asynchronously waits for that load
+		std::optional<int> result;
+		std::string error;
+		awaitValue( cache, 1, []() { return 1; }, result, error );
+
+		std::atomic<bool> syncLoaded{ false };
+		std::thread getter{ [&cache, &syncLoaded]() {
+			EXPECT_EQ( *cache.get( 1, [&syncLoaded]() { syncLoaded = true; return 2; } ), 1 );
+		} };
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+		executor.runAll();
+		getter.join();
+		EXPECT_EQ( result, 1 );
+		EXPECT_FALSE( syncLoaded );
+
+		// A getAsync() for a key a get() is loading is resumed by that get()
+		std::promise<void> started;
+		std::promise<void> release;
+		std::thread loader{ [&cache, &started, releaseFuture = release.get_future()]() mutable {
+			cache.get( 2, [&started, &releaseFuture]() {
+				started.set_value();
+				releaseFuture.wait();
+				return 20;
+			} );
+		} };
+
+		started.get_future().wait();
+		result.reset();
+		awaitValue( cache, 2, []() { return 21; }, result, error );
+		EXPECT_FALSE( result );
+
+		release.set_value();
+		loader.join();
+		EXPECT_EQ( result, 20 );
+		EXPECT_TRUE( executor.tasks.empty() );
+	}
+
+	TEST( LruCacheAsync, FutureForNonCoroutineCallers )
+	{
+		LruCache<int, int> cache;
+
+		// Default executor: the miss loads on a new thread
+		std::future<LruCache<int, int>::ValueHandle> miss{ cache.getFuture( 1, []() { return 5; } ) };
+		EXPECT_EQ( *miss.get(), 5 );
+
+		std::future<LruCache<int, int>::ValueHandle> hit{ cache.getFuture( 1, []() { return 6; } ) };
+		EXPECT_EQ( hit.wait_for( std::chrono::seconds( 0 ) ), std::future_status::ready );
+		EXPECT_EQ( *hit.get(), 5 );
+
+		std::future<LruCache<int, int>::ValueHandle> failed{ cache.getFuture( 2, []() -> int { throw std::runtime_error{ "backend down" }; } ) };
+		EXPECT_THROW( failed.get(), std::runtime_error );
+	}
+
+	//----------------------------------------------
+	// Value type tests
+	//----------------------------------------------
+
+	TEST( LruCacheValueTypes, ComplexValues )
+	{
+		struct ComplexValue
+		{
+			std::string name;
+			std::vector<int> data;
+			double weight;
+
+			ComplexValue( std::string n, std::vector<int> d, double w )
+				: name{ std::move( n ) }, data{ std::move( d ) }, weight{ w } {}
+		};
+
+		LruCache<std::string, ComplexValue> cache;
+
+		auto factory = []() {
+			return ComplexValue{ "test", { 1, 2, 3, 4, 5 }, 3.14 };
+		};
+
+		auto* value = cache.get( "complex_key", factory );
+		EXPECT_EQ( value->name, "test" );
+		EXPECT_EQ( value->data.size(), 5 );
+		EXPECT_DOUBLE_EQ( value->weight, 3.14 );
+	}
+
+	TEST( LruCacheValueTypes, MoveSemantics )
+	{
+		LruCache<std::string, std::unique_ptr<std::string>> cache;
+
+		auto factory = []() {
+			return std::make_unique<std::string>( "unique_value" );
+		};
+
+		auto* ptr = cache.get( "unique_key", factory );
+		ASSERT_NE( ptr, nullptr );
+		ASSERT_NE( *ptr, nullptr );
+		EXPECT_EQ( **ptr, "unique_value" );
+	}
+
+	//----------------------------------------------
+	// Thread safety
+	//----------------------------------------------
+
+	TEST( LruCacheThreadSafety, ConcurrentAccess )
+	{
+		LruCache<int, std::string> cache;
+
+		const int numThreads{ 10 };
+		const int itemsPerThread{ 100 };
+		std::vector<std::thread> threads;
+
+		// Concurrent insertions
+		for ( int t{ 0 }; t < numThreads; ++t )
+		{
+			threads.emplace_back( [&cache, t]() {
+				for ( int i{ 0 }; i < itemsPerThread; ++i )
+				{
+					int key{ t * itemsPerThread + i };
+					cache.get( key, [key]() {
+						return std::string{ "value_" + std::to_string( key ) };
+					} );
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		// Verify all entries were created
+		EXPECT_EQ( cache.size(), numThreads * itemsPerThread );
+
+		// Verify all values are accessible
+		for ( int t{ 0 }; t < numThreads; ++t )
+		{
+			for ( int i{ 0 }; i < itemsPerThread; ++i )
+			{
+				int key{ t * itemsPerThread + i };
+				auto* result = cache.find( key );
+				ASSERT_NE( result, nullptr );
+				EXPECT_EQ( *result, "value_" + std::to_string( key ) );
+			}
+		}
+	}
+
+	//----------------------------------------------
+	// Read-optimized mode
+	//----------------------------------------------
+
+	TEST( LruCacheReadOptimized, BufferedHitsUpdateLruOrder )
+	{
+		auto options = LruCacheOptions{ 3 }.setReadOptimized( true );
+		LruCache<std::string, int> cache{ options };
+		EXPECT_TRUE( options.readOptimized() );
+
+		cache.get( "oldest", []() { return 1; } );
+		cache.get( "middle", []() { return 2; } );
+		cache.get( "newest", []() { return 3; } );
+
+		// Hit served under the shared lock; recency is applied before the next eviction
+		ASSERT_NE( cache.find( "oldest" ), nullptr );
+
+		cache.get( "fourth", []() { return 4; } );
+
+		EXPECT_NE( cache.find( "oldest" ), nullptr );
+		EXPECT_EQ( cache.find( "middle" ), nullptr );
+		EXPECT_NE( cache.find( "newest" ), nullptr );
+		EXPECT_NE( cache.find( "fourth" ), nullptr );
+	}
+
+	TEST( LruCacheReadOptimized, BufferedHitsRenewSlidingExpiration )
+	{
+		auto options = LruCacheOptions{ 0, std::chrono::milliseconds( 100 ) }.setReadOptimized( true );
+		ManualClockCache<std::string, int> cache{ options };
+
+		cache.get( "sliding_key", []() { return 1; } );
+
+		for ( int i{ 0 }; i < 5; ++i )
+		{
+			ManualClock::advance( std::chrono::milliseconds( 50 ) );
+			EXPECT_NE( cache.find( "sliding_key" ), nullptr );
+		}
+
+		ManualClock::advance( std::chrono::milliseconds( 120 ) );
+		EXPECT_EQ( cache.find( "sliding_key" ), nullptr );
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( LruCacheReadOptimized, BufferedHitsKeepAbsoluteExpiration )
+	{
+		auto options = LruCacheOptions{}.setAbsoluteExpiration( std::chrono::milliseconds( 100 ) ).setExpirationMode( ExpirationMode::Absolute ).setReadOptimized( true );
+		ManualClockCache<std::string, int> cache{ options };
+
+		cache.get( "absolute_key", []() { return 1; } );
+
+		for ( int i{ 0 }; i < 3; ++i )
+		{
+			ManualClock::advance( std::chrono::milliseconds( 30 ) );
+			EXPECT_NE( cache.find( "absolute_key" ), nullptr );
+		}
+
+		ManualClock::advance( std::chrono::milliseconds( 20 ) );
+		cache.cleanupExpired();
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( LruCacheReadOptimized, FullReadBufferFallsBackToExclusivePath )
+	{
+		auto options = LruCacheOptions{ 2 }.setReadOptimized( true );
+		LruCache<int, int> cache{ options };
+
+		cache.get( 1, []() { return 1; } );
+		cache.get( 2, []() { return 2; } );
+
+		// Far more hits than a read buffer stripe can hold
+		for ( int i{ 0 }; i < 10000; ++i )
+		{
+			ASSERT_NE( cache.find( 1 ), nullptr );
+		}
+
+		cache.get( 3, []() { return 3; } );
+		EXPECT_NE( cache.find( 1 ), nullptr );
+		EXPECT_EQ( cache.find( 2 ), nullptr );
+	}
+
+	TEST( LruCacheReadOptimized, ConcurrentReadersAndWriters )
+	{
+		auto options = LruCacheOptions{ 100 }.setReadOptimized( true );
+		LruCache<int, int> cache{ options };
+
+		const int numThreads{ 8 };
+		const int operationsPerThread{ 5000 };
+		std::vector<std::thread> threads;
+
+		for ( int t{ 0 }; t < numThreads; ++t )
+		{
+			threads.emplace_back( [&cache, t]() {
+				for ( int i{ 0 }; i < operationsPerThread; ++i )
+				{
+					const int key{ ( t * 31 + i ) % 150 };
+					if ( i % 20 == 0 )
+					{
+						cache.remove( key );
+					}
+
+					// Returned pointers may be evicted by other threads at any time, so they are not dereferenced here
+					ASSERT_NE( cache.get( key, [key]() { return key; } ), nullptr );
+					cache.find( ( key + 1 ) % 150 );
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		EXPECT_LE( cache.size(), 100 );
+
+		for ( int key{ 0 }; key < 150; ++key )
+		{
+			if ( auto* found = cache.find( key ) )
+			{
+				EXPECT_EQ( *found, key );
+			}
+		}
+	}
+
+	//----------------------------------------------
+	// Slab storage
+	//----------------------------------------------
+
+	TEST( LruCacheSlabStorage, EvictionRecyclesNodes )
+	{
+		auto options = LruCacheOptions{ 3 }.setSlabStorage( true );
+		LruCache<std::string, int> cache{ options };
+		EXPECT_TRUE( options.slabStorage() );
+
+		for ( int i{ 0 }; i < 100; ++i )
+		{
+			auto* value = cache.get( "key_" + std::to_string( i ), [i]() { return i; } );
+			ASSERT_NE( value, nullptr );
+			EXPECT_EQ( *value, i );
+		}
+
+		EXPECT_EQ( cache.size(), 3 );
+		EXPECT_EQ( cache.find( "key_96" ), nullptr );
+
+		for ( int i{ 97 }; i < 100; ++i )
+		{
+			auto* value = cache.find( "key_" + std::to_string( i ) );
+			ASSERT_NE( value, nullptr );
+			EXPECT_EQ( *value, i );
+		}
+	}
+
+	TEST( LruCacheSlabStorage, UnlimitedCacheGrowsSlabs )
+	{
+		auto options = LruCacheOptions{}.setSlabStorage( true );
+		LruCache<int, std::string> cache{ options };
+
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			cache.get( i, [i]() { return std::to_string( i ); } );
+		}
+
+		for ( int i{ 0 }; i < 1000; i += 2 )
+		{
+			EXPECT_TRUE( cache.remove( i ) );
+		}
+
+		EXPECT_EQ( cache.size(), 500 );
+
+		for ( int i{ 1 }; i < 1000; i += 2 )
+		{
+			auto* value = cache.find( i );
+			ASSERT_NE( value, nullptr );
+			EXPECT_EQ( *value, std::to_string( i ) );
+		}
+	}
+
+	TEST( LruCacheSlabStorage, ClearAndReuse )
+	{
+		auto options = LruCacheOptions{ 10 }.setSlabStorage( true );
+		LruCache<int, int> cache{ options };
+
+		for ( int round{ 0 }; round < 3; ++round )
+		{
+			for ( int i{ 0 }; i < 20; ++i )
+			{
+				cache.get( i, [round, i]() { return round * 100 + i; } );
+			}
+
+			EXPECT_EQ( cache.size(), 10 );
+			EXPECT_EQ( *cache.find( 19 ), round * 100 + 19 );
+
+			cache.clear();
+			EXPECT_TRUE( cache.isEmpty() );
+		}
+	}
+
+	//----------------------------------------------
+	// Flat index
+	//----------------------------------------------
+
+	TEST( LruCacheFlatIndex, EvictsLeastRecentlyUsed )
+	{
+		LruCache<std::string, int, std::hash<std::string>, std::equal_to<std::string>, FlatIndex> cache{ LruCacheOptions{ 3 } };
+
+		cache.get( "first", []() { return 1; } );
+		cache.get( "second", []() { return 2; } );
+		cache.get( "third", []() { return 3; } );
+		cache.find( "first" );
+		cache.get( "fourth", []() { return 4; } );
+
+		EXPECT_EQ( cache.size(), 3 );
+		EXPECT_NE( cache.find( "first" ), nullptr );
+		EXPECT_EQ( cache.find( "second" ), nullptr );
+		EXPECT_EQ( *cache.find( "fourth" ), 4 );
+	}
+
+	TEST( LruCacheFlatIndex, ExpiredEntriesAreCleanedUp )
+	{
+		LruCache<int, int, std::hash<int>, std::equal_to<int>, FlatIndex, LruPolicy, ManualClock> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 20 ) } };
+
+		for ( int i{ 0 }; i < 100; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		ManualClock::advance( std::chrono::milliseconds( 40 ) );
+		cache.cleanupExpired();
+
+		EXPECT_TRUE( cache.isEmpty() );
+		EXPECT_EQ( cache.find( 5 ), nullptr );
+	}
+
+	TEST( LruCacheFlatIndex, SlabStorageChurn )
+	{
+		auto options = LruCacheOptions{ 100 }.setSlabStorage( true );
+		LruCache<int, int, std::hash<int>, std::equal_to<int>, FlatIndex> cache{ options };
+
+		for ( int i{ 0 }; i < 10000; ++i )
+		{
+			EXPECT_EQ( *cache.get( i, [i]() { return i; } ), i );
+			cache.remove( i - 150 );
+		}
+
+		EXPECT_EQ( cache.size(), 100 );
+		for ( int i{ 9900 }; i < 10000; ++i )
+		{
+			ASSERT_NE( cache.find( i ), nullptr );
+			EXPECT_EQ( *cache.find( i ), i );
+		}
+	}
+
+	//----------------------------------------------
+	// Eviction policies
+	//----------------------------------------------
+
+	TEST( LruCacheEvictionPolicy, SlruKeepsHotEntriesDuringScan )
+	{
+		LruCache<int, int, std::hash<int>, std::equal_to<int>, NodeIndex, SlruPolicy> cache{ LruCacheOptions{ 10 } };
+
+		for ( int i{ 0 }; i < 5; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+			cache.find( i );
+		}
+
+		for ( int i{ 100 }; i < 200; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		EXPECT_EQ( cache.size(), 10 );
+		for ( int i{ 0 }; i < 5; ++i )
+		{
+			EXPECT_NE( cache.find( i ), nullptr );
+		}
+		EXPECT_NE( cache.find( 199 ), nullptr );
+	}
+
+	TEST( LruCacheEvictionPolicy, WTinyLfuKeepsFrequentEntriesDuringScan )
+	{
+		LruCache<int, int, std::hash<int>, std::equal_to<int>, NodeIndex, WTinyLfuPolicy> cache{ LruCacheOptions{ 10 } };
+
+		for ( int round{ 0 }; round < 3; ++round )
+		{
+			for ( int i{ 0 }; i < 5; ++i )
+			{
+				cache.get( i, [i]() { return i; } );
+			}
+		}
+
+		for ( int i{ 100 }; i < 200; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		EXPECT_EQ( cache.size(), 10 );
+		for ( int i{ 0 }; i < 5; ++i )
+		{
+			EXPECT_NE( cache.find( i ), nullptr );
+		}
+	}
+
+	TEST( LruCacheEvictionPolicy, ClockSparesReferencedEntries )
+	{
+		LruCache<std::string, int, std::hash<std::string>, std::equal_to<std::string>, NodeIndex, ClockPolicy> cache{ LruCacheOptions{ 3 } };
+
+		cache.get( "first", []() { return 1; } );
+		cache.get( "second", []() { return 2; } );
+		cache.get( "third", []() { return 3; } );
+		cache.find( "first" );
+		cache.get( "fourth", []() { return 4; } );
+
+		EXPECT_EQ( cache.size(), 3 );
+		EXPECT_NE( cache.find( "first" ), nullptr );
+		EXPECT_EQ( cache.find( "second" ), nullptr );
+		EXPECT_NE( cache.find( "fourth" ), nullptr );
+	}
+
+	TEST( LruCacheEvictionPolicy, PoliciesFollowRemoveAndClear )
+	{
+		LruCache<int, int, std::hash<int>, std::equal_to<int>, FlatIndex, WTinyLfuPolicy> cache{ LruCacheOptions{ 50 }.setSlabStorage( true ) };
+
+		for ( int round{ 0 }; round < 3; ++round )
+		{
+			for ( int i{ 0 }; i < 500; ++i )
+			{
+				cache.get( i % 97, [i]() { return i; } );
+				if ( i % 7 == 0 )
+				{
+					cache.remove( i % 89 );
+				}
+			}
+
+			EXPECT_LE( cache.size(), 50 );
+			cache.clear();
+			EXPECT_TRUE( cache.isEmpty() );
+		}
+	}
+
+	//----------------------------------------------
+	// Clocks
+	//----------------------------------------------
+
+	TEST( LruCacheClock, ManualClockGivesExactExpiration )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 100 ) } };
+
+		cache.get( 1, []() { return 1; } );
+
+		ManualClock::advance( std::chrono::milliseconds( 100 ) );
+		EXPECT_NE( cache.find( 1 ), nullptr ); // Expired only once strictly older than the expiration
+
+		ManualClock::advance( std::chrono::milliseconds( 100 ) );
+		EXPECT_NE( cache.find( 1 ), nullptr ); // Renewed by the previous hit
+
+		ManualClock::advance( std::chrono::milliseconds( 101 ) );
+		EXPECT_EQ( cache.find( 1 ), nullptr );
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( LruCacheClock, CoarseClockExpiresEntries )
+	{
+		LruCache<int, int, std::hash<int>, std::equal_to<int>, NodeIndex, LruPolicy, CoarseClock<1>> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 20 ) } };
+
+		for ( int i{ 0 }; i < 10; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+		EXPECT_NE( cache.find( 0 ), nullptr );
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 80 ) );
+		cache.cleanupExpired();
+
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	//----------------------------------------------
+	// Performance characteristics
+	//----------------------------------------------
+
+	TEST( LruCachePerformance, LargeDataHandling )
+	{
+		LruCache<std::string, std::vector<int>> cache;
+
+		const std::size_t numEntries{ 1000 };
+		const std::size_t vectorSize{ 1000 };
+
+		// Add large data structures
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for ( std::size_t i{ 0 }; i < numEntries; ++i )
+		{
+			std::string key{ "large_key_" + std::to_string( i ) };
+			cache.get( key, [i]() {
+				std::vector<int> data( vectorSize, static_cast<int>( i ) );
+				return data;
+			} );
+		}
+
+		auto end = std::chrono::high_resolution_clock::now();
 		auto duration = std::chrono::duration_cast<std::chrono::milliseconds>( end - start );
 
 		EXPECT_EQ( cache.size(), numEntries );
@@ -529,7 +3099,7 @@ namespace nfx::cache::test
 	TEST( LruCacheBackgroundCleanup, BackgroundCleanupDisabled )
 	{
 		LruCacheOptions options{ 0, std::chrono::milliseconds( 10 ), std::chrono::milliseconds( 0 ) }; // Disabled
-		LruCache<std::string, int> cache( options );
+		ManualClockCache<std::string, int> cache( options );
 
 		// Add entries
 		cache.get( "key1", []() { return 1; } );
@@ -537,7 +3107,7 @@ namespace nfx::cache::test
 		EXPECT_EQ( cache.size(), 2 );
 
 		// Wait for expiration
-		std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+		ManualClock::advance( std::chrono::milliseconds( 50 ) );
 
 		// Access cache to trigger potential background cleanup (should not happen)
 		cache.get( "key3", []() { return 3; } );
@@ -558,7 +3128,7 @@ namespace nfx::cache::test
 			std::chrono::milliseconds( 20 ), // Short expiration
 			std::chrono::milliseconds( 10 )	 // Background cleanup every 10ms
 		};
-		LruCache<std::string, int> cache( options );
+		ManualClockCache<std::string, int> cache( options );
 
 		// Add entries that will expire
 		cache.get( "expire1", []() { return 1; } );
@@ -566,18 +3136,18 @@ namespace nfx::cache::test
 		EXPECT_EQ( cache.size(), 2 );
 
 		// Wait for expiration
-		std::this_thread::sleep_for( std::chrono::milliseconds( 25 ) );
+		ManualClock::advance( std::chrono::milliseconds( 25 ) );
 
 		// Add new entry and wait for background cleanup interval
 		cache.get( "fresh", []() { return 3; } );
-		std::this_thread::sleep_for( std::chrono::milliseconds( 15 ) );
+		ManualClock::advance( std::chrono::milliseconds( 15 ) );
 
 		// Trigger background cleanup by accessing cache
 		cache.find( "fresh" );
 
 		// Background cleanup should have removed some expired entries
 		auto sizeAfterCleanup = cache.size();
-		EXPECT_LE( sizeAfterCleanup, 2 ); // Should be <= 2 (some cleanup happened)
+		EXPECT_EQ( sizeAfterCleanup, 1 ); // Both expired entries were cleaned, only "fresh" remains
 	}
 
 	TEST( LruCacheBackgroundCleanup, IncrementalCleanupLimiting )
@@ -588,7 +3158,7 @@ namespace nfx::cache::test
 			std::chrono::milliseconds( 5 ), // Very short expiration
 			std::chrono::milliseconds( 10 ) // Background cleanup
 		};
-		LruCache<std::string, int> cache( options );
+		ManualClockCache<std::string, int> cache( options );
 
 		// Add many entries that will expire
 		const int numEntries = 50;
@@ -600,13 +3170,13 @@ namespace nfx::cache::test
 		EXPECT_EQ( cache.size(), numEntries );
 
 		// Wait for expiration
-		std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+		ManualClock::advance( std::chrono::milliseconds( 10 ) );
 
 		// Trigger background cleanup multiple times
 		for ( int cycle = 0; cycle < 10; ++cycle )
 		{
 			cache.get( "trigger_" + std::to_string( cycle ), [cycle]() { return cycle + 1000; } );
-			std::this_thread::sleep_for( std::chrono::milliseconds( 12 ) );
+			ManualClock::advance( std::chrono::milliseconds( 12 ) );
 		}
 
 		// Should have cleaned up incrementally (not all at once)
@@ -615,6 +3185,63 @@ namespace nfx::cache::test
 		EXPECT_GT( finalSize, 0 );			// But not necessarily all at once
 	}
 
+	TEST( LruCacheBackgroundCleanup, ConfigurableCleanupBudget )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 5 ), std::chrono::milliseconds( 10 ) }.setCleanupBudget( 100 ) };
+		for ( int i{ 0 }; i < 500; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		ManualClock::advance( std::chrono::milliseconds( 20 ) );
+		cache.find( -1 ); // Triggers one cleanup cycle
+
+		EXPECT_EQ( cache.size(), 400 );
+	}
+
+	TEST( LruCacheBackgroundCleanup, AdaptiveBudgetGrowsWithBacklog )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 5 ), std::chrono::milliseconds( 10 ) }
+											  .setAdaptiveCleanup( true )
+											  .setCleanupTimeBudget( std::chrono::seconds( 1 ) ) };
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		// Each cycle ending with a backlog doubles the next one: 10, 20, 40
+		std::vector<std::size_t> sizes;
+		for ( int cycle{ 0 }; cycle < 3; ++cycle )
+		{
+			ManualClock::advance( std::chrono::milliseconds( 20 ) );
+			cache.find( -1 );
+			sizes.push_back( cache.size() );
+		}
+
+		EXPECT_EQ( sizes, ( std::vector<std::size_t>{ 990, 970, 930 } ) );
+	}
+
+	TEST( LruCacheBackgroundCleanup, AdaptiveCycleStopsAtTimeBudget )
+	{
+		ManualClockCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 5 ), std::chrono::milliseconds( 10 ) }
+											  .setCleanupBudget( 64 )
+											  .setAdaptiveCleanup( true )
+											  .setCleanupTimeBudget( std::chrono::microseconds( 0 ) ) };
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		// An exhausted time budget still lets one batch of 16 entries through, and stops there
+		ManualClock::advance( std::chrono::milliseconds( 20 ) );
+		cache.find( -1 );
+		EXPECT_EQ( cache.size(), 1000 - 16 );
+
+		ManualClock::advance( std::chrono::milliseconds( 20 ) );
+		cache.find( -1 );
+		EXPECT_EQ( cache.size(), 1000 - 32 );
+	}
+
 	TEST( LruCacheBackgroundCleanup, CleanupTimingAccuracy )
 	{
 		// Test that cleanup happens at the right intervals
@@ -623,13 +3250,13 @@ namespace nfx::cache::test
 			std::chrono::milliseconds( 10 ), // Short expiration
 			std::chrono::milliseconds( 30 )	 // Background cleanup every 30ms
 		};
-		LruCache<std::string, int> cache( options );
+		ManualClockCache<std::string, int> cache( options );
 
 		// Add entry that will expire
 		cache.get( "timed_key", []() { return 42; } );
 
 		// Wait for expiration but not cleanup interval
-		std::this_thread::sleep_for( std::chrono::milliseconds( 15 ) );
+		ManualClock::advance( std::chrono::milliseconds( 15 ) );
 
 		// Access cache
 		cache.find( "timed_key" );
@@ -637,7 +3264,7 @@ namespace nfx::cache::test
 		EXPECT_GE( sizeBeforeCleanup, 0 ); // Should be >= 0
 
 		// Wait for cleanup interval to pass
-		std::this_thread::sleep_for( std::chrono::milliseconds( 35 ) );
+		ManualClock::advance( std::chrono::milliseconds( 35 ) );
 
 		// Now access should trigger cleanup
 		cache.find( "another_key" );
@@ -655,28 +3282,28 @@ namespace nfx::cache::test
 			std::chrono::milliseconds( 200 ), // Generous expiration time
 			std::chrono::milliseconds( 0 )	  // Disable background cleanup for predictable behavior
 		};
-		LruCache<std::string, int> cache( options );
+		ManualClockCache<std::string, int> cache( options );
 
 		// Add entry and verify it's accessible
 		cache.get( "sliding1", []() { return 1; } );
 		EXPECT_NE( cache.find( "sliding1" ), nullptr );
 
 		// Wait 150ms (still within 200ms expiration)
-		std::this_thread::sleep_for( std::chrono::milliseconds( 150 ) );
+		ManualClock::advance( std::chrono::milliseconds( 150 ) );
 
 		// Access the entry to refresh its expiration timer
 		auto* beforeRefresh = cache.find( "sliding1" );
 		EXPECT_NE( beforeRefresh, nullptr ) << "Entry should still be alive before expiration";
 
 		// Wait another 150ms (total 300ms from creation, but only 150ms since last access)
-		std::this_thread::sleep_for( std::chrono::milliseconds( 150 ) );
+		ManualClock::advance( std::chrono::milliseconds( 150 ) );
 
 		// Entry should still be alive because we accessed it 150ms ago (within 200ms sliding window)
 		auto* afterRefresh = cache.find( "sliding1" );
 		EXPECT_NE( afterRefresh, nullptr ) << "Entry should still be alive due to sliding expiration refresh";
 
 		// Now wait 250ms without accessing (exceeds 200ms expiration)
-		std::this_thread::sleep_for( std::chrono::milliseconds( 250 ) );
+		ManualClock::advance( std::chrono::milliseconds( 250 ) );
 
 		// Entry should now be expired
 		auto* afterExpiration = cache.find( "sliding1" );
@@ -0,0 +1,137 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file TESTS_MaintenanceScheduler.cpp
+ * @brief Tests for the background maintenance scheduler
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <nfx/cache/MaintenanceScheduler.h>
+
+namespace nfx::cache::test
+{
+	//=====================================================================
+	// Test helpers
+	//=====================================================================
+
+	/** @brief Poll a condition until it holds or a generous timeout elapses */
+	template <typename Condition>
+	bool eventually( Condition condition )
+	{
+		const auto deadline{ std::chrono::steady_clock::now() + std::chrono::seconds( 5 ) };
+		while ( !condition() )
+		{
+			if ( std::chrono::steady_clock::now() > deadline )
+			{
+				return false;
+			}
+
+			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+		}
+
+		return true;
+	}
+
+	//=====================================================================
+	// MaintenanceScheduler Tests
+	//=====================================================================
+
+	TEST( MaintenanceScheduler, RunsTasksPeriodically )
+	{
+		MaintenanceScheduler scheduler;
+		std::atomic<int> fast{ 0 };
+		std::atomic<int> slow{ 0 };
+
+		auto fastTask{ scheduler.schedule( std::chrono::milliseconds( 1 ), [&fast]() { ++fast; } ) };
+		auto slowTask{ scheduler.schedule( std::chrono::hours( 1 ), [&slow]() { ++slow; } ) };
+		EXPECT_EQ( scheduler.taskCount(), 2 );
+
+		EXPECT_TRUE( eventually( [&fast]() { return fast >= 3; } ) );
+		EXPECT_EQ( slow, 0 );
+	}
+
+	TEST( MaintenanceScheduler, ResetWaitsForRunningTask )
+	{
+		MaintenanceScheduler scheduler;
+		std::atomic<bool> started{ false };
+		std::atomic<bool> finished{ false };
+		std::atomic<int> runs{ 0 };
+
+		auto registration{ scheduler.schedule( std::chrono::milliseconds( 1 ), [&]() {
+			++runs;
+			started = true;
+			std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+			finished = true;
+		} ) };
+
+		ASSERT_TRUE( eventually( [&started]() { return started.load(); } ) );
+		registration.reset();
+
+		// Whatever the task uses may be destroyed once reset() returns
+		EXPECT_TRUE( finished );
+		EXPECT_FALSE( registration );
+		EXPECT_EQ( scheduler.taskCount(), 0 );
+
+		const int runsAfterReset{ runs };
+		std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+		EXPECT_EQ( runs, runsAfterReset );
+	}
+
+	TEST( MaintenanceScheduler, TaskMayReleaseItsOwnRegistration )
+	{
+		MaintenanceScheduler scheduler;
+		MaintenanceScheduler::Registration registration;
+		std::atomic<bool> assigned{ false };
+		std::atomic<bool> released{ false };
+
+		registration = scheduler.schedule( std::chrono::milliseconds( 1 ), [&]() {
+			if ( assigned )
+			{
+				registration.reset();
+				released = true;
+			}
+		} );
+		assigned = true;
+
+		EXPECT_TRUE( eventually( [&released]() { return released.load(); } ) );
+		EXPECT_EQ( scheduler.taskCount(), 0 );
+	}
+
+	TEST( MaintenanceScheduler, SharedInstance )
+	{
+		EXPECT_EQ( &MaintenanceScheduler::shared(), &MaintenanceScheduler::shared() );
+
+		std::atomic<int> runs{ 0 };
+		auto registration{ MaintenanceScheduler::shared().schedule( std::chrono::milliseconds( 1 ), [&runs]() { ++runs; } ) };
+
+		EXPECT_TRUE( eventually( [&runs]() { return runs > 0; } ) );
+	}
+} // namespace nfx::cache::test
@@ -0,0 +1,433 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TESTS_ShardedLruCache.cpp
+ * @brief Tests for ShardedLruCache shard partitioning and thread-safe caching
+ * @details Tests covering shard configuration, size limit distribution,
+ *          cache operations forwarded to shards, and concurrent access
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <nfx/cache/ShardedLruCache.h>
+
+namespace nfx::cache::test
+{
+	//=====================================================================
+	// ShardedLruCache Tests
+	//=====================================================================
+
+	//----------------------------------------------
+	// Basic construction
+	//----------------------------------------------
+
+	TEST( ShardedLruCacheConstruction, DefaultConstruction )
+	{
+		ShardedLruCache<std::string, int> cache;
+
+		EXPECT_TRUE( cache.isEmpty() );
+		EXPECT_EQ( cache.size(), 0 );
+		EXPECT_GE( cache.shardCount(), 1 );
+		EXPECT_EQ( cache.sizeLimit(), 0 );
+	}
+
+	TEST( ShardedLruCacheConstruction, ShardCountRoundedToPowerOfTwo )
+	{
+		ShardedLruCache<int, int> cache{ LruCacheOptions{ 1000 }, 6 };
+
+		EXPECT_EQ( cache.shardCount(), 8 );
+		EXPECT_EQ( cache.sizeLimit(), 1000 );
+	}
+
+	TEST( ShardedLruCacheConstruction, ShardCountClampedToSizeLimit )
+	{
+		ShardedLruCache<int, int> cache{ LruCacheOptions{ 5 }, 16 };
+
+		// Every shard needs at least one slot
+		EXPECT_EQ( cache.shardCount(), 4 );
+		EXPECT_EQ( cache.sizeLimit(), 5 );
+	}
+
+	//----------------------------------------------
+	// Basic operations
+	//----------------------------------------------
+
+	TEST( ShardedLruCacheOperations, GetFindRemove )
+	{
+		ShardedLruCache<std::string, std::string> cache{ {}, 4 };
+
+		auto* value = cache.get( "key1", []() { return std::string{ "value1" }; } );
+		ASSERT_NE( value, nullptr );
+		EXPECT_EQ( *value, "value1" );
+
+		auto* existing = cache.get( "key1", []() { return std::string{ "should_not_create" }; } );
+		ASSERT_NE( existing, nullptr );
+		EXPECT_EQ( *existing, "value1" );
+
+		auto* found = cache.find( "key1" );
+		ASSERT_NE( found, nullptr );
+		EXPECT_EQ( *found, "value1" );
+		EXPECT_EQ( cache.find( "missing" ), nullptr );
+
+		EXPECT_TRUE( cache.remove( "key1" ) );
+		EXPECT_FALSE( cache.remove( "key1" ) );
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( ShardedLruCacheOperations, ClearAllShards )
+	{
+		ShardedLruCache<int, int> cache{ {}, 8 };
+
+		for ( int i{ 0 }; i < 100; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+		EXPECT_EQ( cache.size(), 100 );
+
+		cache.clear();
+		EXPECT_EQ( cache.size(), 0 );
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( ShardedLruCacheOperations, BatchOperationsAcrossShards )
+	{
+		ShardedLruCache<int, int> cache{ LruCacheOptions{}, 4 };
+
+		std::vector<int> keys;
+		for ( int i{ 0 }; i < 64; ++i )
+		{
+			keys.push_back( i );
+		}
+		std::vector<int*> results( keys.size() );
+
+		const std::size_t loaded{ cache.getMany( keys, results, []( std::span<const int> missing ) {
+			std::vector<int> values;
+			for ( int key : missing )
+			{
+				values.push_back( key * 2 );
+			}
+
+			return values;
+		} ) };
+
+		EXPECT_EQ( loaded, keys.size() );
+		for ( std::size_t i{ 0 }; i < keys.size(); ++i )
+		{
+			ASSERT_NE( results[i], nullptr );
+			EXPECT_EQ( *results[i], keys[i] * 2 );
+		}
+
+		const std::vector<int> removed{ 1, 5, 9, 100 };
+		EXPECT_EQ( cache.removeMany( removed ), 3 );
+
+		EXPECT_EQ( cache.findMany( keys, results ), keys.size() - 3 );
+		EXPECT_EQ( results[5], nullptr );
+		ASSERT_NE( results[6], nullptr );
+		EXPECT_EQ( *results[6], 12 );
+	}
+
+	TEST( ShardedLruCacheOperations, HeterogeneousLookup )
+	{
+		ShardedLruCache<std::string, int, TransparentStringHash, std::equal_to<>> cache{ LruCacheOptions{}, 4 };
+
+		for ( int i{ 0 }; i < 32; ++i )
+		{
+			cache.get( "key_" + std::to_string( i ), [i]() { return i; } );
+		}
+
+		// A view selects the same shard as the owning string
+		auto* value = cache.find( std::string_view{ "key_7" } );
+		ASSERT_NE( value, nullptr );
+		EXPECT_EQ( *value, 7 );
+
+		const std::vector<std::string_view> keys{ "key_1", "key_2", "nope" };
+		std::vector<int*> results( keys.size() );
+		EXPECT_EQ( cache.findMany( keys, results ), 2 );
+		EXPECT_EQ( *results[1], 2 );
+		EXPECT_EQ( results[2], nullptr );
+
+		EXPECT_TRUE( cache.remove( "key_7" ) );
+		EXPECT_EQ( cache.removeMany( keys ), 2 );
+		EXPECT_EQ( cache.size(), 29 );
+	}
+
+	TEST( ShardedLruCacheOperations, PinnedHandles )
+	{
+		ShardedLruCache<std::string, int, TransparentStringHash, std::equal_to<>> cache{ LruCacheOptions{}, 4 };
+
+		auto created = cache.getPinned( "a", []() { return 1; } );
+		auto found = cache.findPinned( std::string_view{ "a" } );
+		ASSERT_TRUE( found );
+		EXPECT_EQ( found.get(), created.get() );
+		EXPECT_FALSE( cache.findPinned( "b" ) );
+
+		cache.clear();
+		EXPECT_EQ( *found, 1 );
+	}
+
+	TEST( ShardedLruCacheOperations, AsynchronousGet )
+	{
+		ShardedLruCache<int, int> cache{ LruCacheOptions{}.setLoadExecutor( []( std::function<void()> task ) { task(); } ), 4 };
+
+		// With an inline executor, a miss completes before getFuture() returns
+		auto loaded = cache.getFuture( 1, []() { return 10; } );
+		EXPECT_EQ( *loaded.get(), 10 );
+
+		auto awaitable = cache.getAsync( 1, []() { return 11; } );
+		ASSERT_TRUE( awaitable.await_ready() );
+		EXPECT_EQ( *awaitable.await_resume(), 10 );
+	}
+
+	TEST( ShardedLruCacheOperations, InPlaceWrites )
+	{
+		ShardedLruCache<int, std::unique_ptr<int>> cache{ LruCacheOptions{}, 4 };
+
+		for ( int i{ 0 }; i < 16; ++i )
+		{
+			EXPECT_TRUE( cache.emplace( i, new int{ i } ).second );
+		}
+
+		EXPECT_FALSE( cache.insertOrAssign( 3, std::make_unique<int>( 30 ) ).second );
+		EXPECT_EQ( **cache.set( 4, std::make_unique<int>( 40 ) ), 40 );
+		EXPECT_EQ( **cache.find( 3 ), 30 );
+		EXPECT_EQ( cache.size(), 16 );
+	}
+
+	TEST( ShardedLruCacheOperations, NegativeCaching )
+	{
+		ShardedLruCache<int, int> cache{ LruCacheOptions{}.setNegativeExpiration( std::chrono::minutes( 1 ) ).setNegativeSizeLimit( 2 ), 4 };
+		int calls{ 0 };
+
+		for ( int i{ 0 }; i < 16; ++i )
+		{
+			EXPECT_EQ( cache.get( i, [&calls]() -> std::optional<int> {
+				++calls;
+				return std::nullopt;
+			} ),
+				nullptr );
+		}
+
+		// A limit below the shard count still leaves one tombstone per shard
+		EXPECT_EQ( calls, 16 );
+		EXPECT_EQ( cache.tombstoneCount(), 4 );
+		EXPECT_EQ( cache.size(), 0 );
+	}
+
+	//----------------------------------------------
+	// Size limits and LRU eviction
+	//----------------------------------------------
+
+	TEST( ShardedLruCacheLRU, TotalSizeNeverExceedsLimit )
+	{
+		ShardedLruCache<int, int> cache{ LruCacheOptions{ 100 }, 8 };
+
+		for ( int i{ 0 }; i < 10000; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+			ASSERT_LE( cache.size(), 100 );
+		}
+
+		// Every shard fills up to its own limit, and the limits sum to sizeLimit()
+		EXPECT_EQ( cache.size(), 100 );
+	}
+
+	TEST( ShardedLruCacheLRU, SingleShardKeepsExactLruOrder )
+	{
+		ShardedLruCache<std::string, int> cache{ LruCacheOptions{ 3 }, 1 };
+
+		cache.get( "oldest", []() { return 1; } );
+		cache.get( "middle", []() { return 2; } );
+		cache.get( "newest", []() { return 3; } );
+		cache.find( "oldest" );
+		cache.get( "fourth", []() { return 4; } );
+
+		EXPECT_NE( cache.find( "oldest" ), nullptr );
+		EXPECT_EQ( cache.find( "middle" ), nullptr );
+		EXPECT_NE( cache.find( "newest" ), nullptr );
+		EXPECT_NE( cache.find( "fourth" ), nullptr );
+	}
+
+	TEST( ShardedLruCacheLRU, MemoryLimitSplitAcrossShards )
+	{
+		auto options = LruCacheOptions{}.setMemoryLimit( 1000 );
+		ShardedLruCache<int, int> cache{ options, 4, []( const int&, const int& ) { return std::size_t{ 10 }; } };
+
+		EXPECT_EQ( cache.memoryLimit(), 1000 );
+
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+			ASSERT_LE( cache.memoryUsage(), 1000 );
+		}
+
+		EXPECT_EQ( cache.memoryUsage(), cache.size() * 10 );
+	}
+
+	//----------------------------------------------
+	// Expiration policies
+	//----------------------------------------------
+
+	TEST( ShardedLruCacheExpiration, ManualCleanupExpired )
+	{
+		ShardedLruCache<int, int, std::hash<int>, std::equal_to<int>, NodeIndex, LruPolicy, ManualClock> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 30 ) }, 4 };
+
+		for ( int i{ 0 }; i < 20; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+		EXPECT_EQ( cache.size(), 20 );
+
+		ManualClock::advance( std::chrono::milliseconds( 40 ) );
+
+		cache.cleanupExpired();
+		EXPECT_EQ( cache.size(), 0 );
+	}
+
+	TEST( ShardedLruCacheExpiration, RemovalListenerSharedByShards )
+	{
+		using Cache = ShardedLruCache<int, int, std::hash<int>, std::equal_to<int>, NodeIndex, LruPolicy, ManualClock>;
+
+		std::size_t expired{ 0 };
+		Cache cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 30 ) }, 4, nullptr, [&expired]( std::span<Cache::RemovalNotification> batch ) {
+						for ( const auto& removal : batch )
+						{
+							expired += removal.cause == RemovalCause::Expired ? 1 : 0;
+						}
+					} };
+
+		for ( int i{ 0 }; i < 20; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		ManualClock::advance( std::chrono::milliseconds( 40 ) );
+
+		cache.cleanupExpired();
+		EXPECT_EQ( expired, 20 );
+	}
+
+	TEST( ShardedLruCacheExpiration, MaintenanceThreadSharedByShards )
+	{
+		ShardedLruCache<int, int, std::hash<int>, std::equal_to<int>, NodeIndex, LruPolicy, ManualClock> cache{
+			LruCacheOptions{ 0, std::chrono::milliseconds( 30 ), std::chrono::milliseconds( 1 ) }.setMaintenanceThread( true ), 4 };
+
+		for ( int i{ 0 }; i < 20; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		ManualClock::advance( std::chrono::milliseconds( 40 ) );
+
+		const auto deadline{ std::chrono::steady_clock::now() + std::chrono::seconds( 5 ) };
+		while ( cache.size() > 0 && std::chrono::steady_clock::now() < deadline )
+		{
+			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+		}
+
+		EXPECT_EQ( cache.size(), 0 );
+	}
+
+	//----------------------------------------------
+	// Thread safety
+	//----------------------------------------------
+
+	TEST( ShardedLruCacheThreadSafety, ConcurrentAccess )
+	{
+		ShardedLruCache<int, std::string> cache{ {}, 8 };
+
+		const int numThreads{ 8 };
+		const int itemsPerThread{ 200 };
+		std::vector<std::thread> threads;
+
+		for ( int t{ 0 }; t < numThreads; ++t )
+		{
+			threads.emplace_back( [&cache, t]() {
+				for ( int i{ 0 }; i < itemsPerThread; ++i )
+				{
+					int key{ t * itemsPerThread + i };
+					cache.get( key, [key]() { return std::string{ "value_" + std::to_string( key ) }; } );
+					cache.find( ( key * 7 ) % ( numThreads * itemsPerThread ) );
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		EXPECT_EQ( cache.size(), numThreads * itemsPerThread );
+
+		for ( int key{ 0 }; key < numThreads * itemsPerThread; ++key )
+		{
+			auto* result = cache.find( key );
+			ASSERT_NE( result, nullptr );
+			EXPECT_EQ( *result, "value_" + std::to_string( key ) );
+		}
+	}
+
+	//----------------------------------------------
+	// Index policy
+	//----------------------------------------------
+
+	TEST( ShardedLruCacheIndex, FlatIndexShards )
+	{
+		ShardedLruCache<int, int, std::hash<int>, std::equal_to<int>, FlatIndex> cache{ LruCacheOptions{ 64 }, 4 };
+
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			cache.get( i, [i]() { return i; } );
+		}
+
+		EXPECT_LE( cache.size(), 64 );
+		EXPECT_EQ( *cache.get( 999, []() { return -1; } ), 999 );
+	}
+
+	//----------------------------------------------
+	// Eviction policy
+	//----------------------------------------------
+
+	TEST( ShardedLruCachePolicy, WTinyLfuShards )
+	{
+		ShardedLruCache<int, int, std::hash<int>, std::equal_to<int>, NodeIndex, WTinyLfuPolicy> cache{ LruCacheOptions{ 64 }, 4 };
+
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			cache.get( i % 300, [i]() { return i; } );
+		}
+
+		EXPECT_LE( cache.size(), 64 );
+		EXPECT_FALSE( cache.isEmpty() );
+	}
+} // namespace nfx::cache::test
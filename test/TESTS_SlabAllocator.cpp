@@ -0,0 +1,180 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TESTS_SlabAllocator.cpp
+ * @brief Tests for SlabPool block recycling and SlabAllocator heap fallback
+ * @details Tests covering block shape selection, free list reuse, slab growth
+ *          and use of the allocator with standard node-based containers
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include <nfx/cache/SlabAllocator.h>
+
+namespace nfx::cache::test
+{
+	//=====================================================================
+	// SlabPool Tests
+	//=====================================================================
+
+	//----------------------------------------------
+	// Block management
+	//----------------------------------------------
+
+	TEST( SlabPool, FirstAllocationPreallocatesCapacity )
+	{
+		SlabPool pool{ 100 };
+		EXPECT_EQ( pool.capacity(), 0 );
+
+		void* block = pool.allocate( 48, 8 );
+		ASSERT_NE( block, nullptr );
+		EXPECT_EQ( pool.capacity(), 100 );
+		EXPECT_EQ( pool.inUse(), 1 );
+
+		EXPECT_TRUE( pool.deallocate( block, 48, 8 ) );
+		EXPECT_EQ( pool.inUse(), 0 );
+	}
+
+	TEST( SlabPool, FreedBlocksAreReused )
+	{
+		SlabPool pool{ 4 };
+
+		void* first = pool.allocate( 32, 8 );
+		void* second = pool.allocate( 32, 8 );
+		EXPECT_NE( first, second );
+
+		EXPECT_TRUE( pool.deallocate( first, 32, 8 ) );
+		EXPECT_EQ( pool.allocate( 32, 8 ), first );
+
+		EXPECT_TRUE( pool.deallocate( first, 32, 8 ) );
+		EXPECT_TRUE( pool.deallocate( second, 32, 8 ) );
+	}
+
+	TEST( SlabPool, RejectsOtherBlockShapes )
+	{
+		SlabPool pool{ 4, 16 };
+
+		// Smaller than the minimum block size: never fixes the block shape
+		EXPECT_EQ( pool.allocate( 8, 8 ), nullptr );
+
+		void* block = pool.allocate( 24, 8 );
+		ASSERT_NE( block, nullptr );
+
+		EXPECT_EQ( pool.allocate( 40, 8 ), nullptr );
+		EXPECT_FALSE( pool.deallocate( block, 40, 8 ) );
+		EXPECT_TRUE( pool.deallocate( block, 24, 8 ) );
+	}
+
+	TEST( SlabPool, GrowsWhenExhausted )
+	{
+		SlabPool pool{ 0 };
+		std::list<void*> blocks;
+
+		for ( int i{ 0 }; i < 200; ++i )
+		{
+			void* block = pool.allocate( 16, 16 );
+			ASSERT_NE( block, nullptr );
+			EXPECT_EQ( reinterpret_cast<std::uintptr_t>( block ) % 16, 0 );
+			blocks.push_back( block );
+		}
+
+		EXPECT_GE( pool.capacity(), 200 );
+		EXPECT_EQ( pool.inUse(), 200 );
+
+		for ( void* block : blocks )
+		{
+			EXPECT_TRUE( pool.deallocate( block, 16, 16 ) );
+		}
+
+		EXPECT_EQ( pool.inUse(), 0 );
+	}
+
+	//=====================================================================
+	// SlabAllocator Tests
+	//=====================================================================
+
+	//----------------------------------------------
+	// Container integration
+	//----------------------------------------------
+
+	TEST( SlabAllocator, WithoutPoolUsesHeap )
+	{
+		std::list<int, SlabAllocator<int>> values;
+
+		for ( int i{ 0 }; i < 10; ++i )
+		{
+			values.push_back( i );
+		}
+
+		EXPECT_EQ( values.size(), 10 );
+		EXPECT_EQ( values.front(), 0 );
+	}
+
+	TEST( SlabAllocator, UnorderedMapNodesComeFromPool )
+	{
+		using Map = std::unordered_map<int, std::string, std::hash<int>, std::equal_to<int>, SlabAllocator<std::pair<const int, std::string>>>;
+
+		SlabPool pool{ 64, sizeof( Map::value_type ) };
+		{
+			Map map{ 0, std::hash<int>{}, std::equal_to<int>{}, SlabAllocator<Map::value_type>{ &pool } };
+			map.reserve( 64 );
+
+			for ( int i{ 0 }; i < 64; ++i )
+			{
+				map.emplace( i, std::to_string( i ) );
+			}
+
+			EXPECT_EQ( pool.inUse(), 64 );
+			EXPECT_EQ( pool.capacity(), 64 );
+
+			// Erase then insert: the freed node is recycled, the pool does not grow
+			for ( int i{ 64 }; i < 1000; ++i )
+			{
+				map.erase( i - 64 );
+				map.emplace( i, std::to_string( i ) );
+			}
+
+			EXPECT_EQ( pool.capacity(), 64 );
+			EXPECT_EQ( map.at( 999 ), "999" );
+		}
+
+		EXPECT_EQ( pool.inUse(), 0 );
+	}
+
+	TEST( SlabAllocator, EqualityFollowsPool )
+	{
+		SlabPool first{ 1 };
+		SlabPool second{ 1 };
+
+		EXPECT_EQ( SlabAllocator<int>{ &first }, SlabAllocator<double>{ &first } );
+		EXPECT_NE( SlabAllocator<int>{ &first }, SlabAllocator<int>{ &second } );
+		EXPECT_EQ( SlabAllocator<int>{}, SlabAllocator<int>{ nullptr } );
+	}
+} // namespace nfx::cache::test
@@ -0,0 +1,361 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TESTS_Snapshot.cpp
+ * @brief Tests for cache snapshots and their serializers
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nfx/cache/LruCache.h>
+
+namespace nfx::cache::test
+{
+	//=====================================================================
+	// Test helpers
+	//=====================================================================
+
+	/** @brief Cache on ManualClock, so expiration tests advance time instead of sleeping */
+	template <typename TKey, typename TValue>
+	using ManualClockCache = LruCache<TKey, TValue, std::hash<TKey>, std::equal_to<TKey>, NodeIndex, LruPolicy, ManualClock>;
+
+	/** @brief Value that is not trivially copyable, written with a custom serializer */
+	struct Samples
+	{
+		std::vector<std::int32_t> values;
+	};
+
+	/** @brief Serializer writing the sample count followed by the samples */
+	struct SamplesSerializer
+	{
+		static void write( std::vector<std::byte>& out, const Samples& samples )
+		{
+			SnapshotSerializer<std::uint32_t>::write( out, static_cast<std::uint32_t>( samples.values.size() ) );
+			for ( const std::int32_t value : samples.values )
+			{
+				SnapshotSerializer<std::int32_t>::write( out, value );
+			}
+		}
+
+		static Samples read( std::span<const std::byte> bytes )
+		{
+			const std::uint32_t count{ SnapshotSerializer<std::uint32_t>::read( bytes.first( sizeof( std::uint32_t ) ) ) };
+
+			Samples samples;
+			for ( std::uint32_t i{ 0 }; i < count; ++i )
+			{
+				samples.values.push_back( SnapshotSerializer<std::int32_t>::read( bytes.subspan( sizeof( std::uint32_t ) + i * sizeof( std::int32_t ), sizeof( std::int32_t ) ) ) );
+			}
+
+			return samples;
+		}
+	};
+
+	//=====================================================================
+	// SnapshotSerializer Tests
+	//=====================================================================
+
+	TEST( SnapshotSerializer, RoundTripsBuiltInTypes )
+	{
+		std::vector<std::byte> bytes;
+		SnapshotSerializer<double>::write( bytes, 2.5 );
+		EXPECT_EQ( bytes.size(), sizeof( double ) );
+		EXPECT_EQ( SnapshotSerializer<double>::read( bytes ), 2.5 );
+
+		bytes.clear();
+		SnapshotSerializer<std::string>::write( bytes, "snapshot" );
+		EXPECT_EQ( bytes.size(), 8 );
+		EXPECT_EQ( SnapshotSerializer<std::string>::read( bytes ), "snapshot" );
+
+		static_assert( SnapshotCodec<SamplesSerializer, Samples> );
+		static_assert( !SnapshotCodec<SnapshotSerializer<std::string>, int> );
+	}
+
+	TEST( SnapshotSerializer, RejectsWrongFieldSize )
+	{
+		const std::vector<std::byte> bytes( 3 );
+
+		EXPECT_THROW( (void)SnapshotSerializer<std::int32_t>::read( bytes ), std::runtime_error );
+	}
+
+	//=====================================================================
+	// LruCache snapshot Tests
+	//=====================================================================
+
+	TEST( LruCacheSnapshot, RestoresEntriesInRecencyOrder )
+	{
+		LruCacheOptions options;
+		options.setSizeLimit( 3 );
+
+		LruCache<std::string, int> source( options );
+		source.get( "a", []() { return 1; } );
+		source.get( "b", []() { return 2; } );
+		source.get( "c", []() { return 3; } );
+		source.find( "a" ); // "b" is now the least recently used
+
+		std::stringstream snapshot;
+		EXPECT_EQ( source.saveSnapshot( snapshot ), 3 );
+
+		LruCache<std::string, int> restored( options );
+		EXPECT_EQ( restored.loadSnapshot( snapshot ), 3 );
+		ASSERT_NE( restored.find( "c" ), nullptr );
+		EXPECT_EQ( *restored.find( "c" ), 3 );
+
+		restored.get( "d", []() { return 4; } );
+		EXPECT_EQ( restored.find( "b" ), nullptr );
+		EXPECT_NE( restored.find( "a" ), nullptr );
+		EXPECT_NE( restored.find( "c" ), nullptr );
+	}
+
+	TEST( LruCacheSnapshot, ResumesRemainingExpiration )
+	{
+		LruCacheOptions options;
+		options.setSlidingExpiration( std::chrono::milliseconds( 100 ) );
+
+		ManualClockCache<int, int> source( options, []( const int&, const int& ) { return std::size_t{ 7 }; } );
+		source.get( 1, []() { return 10; } );
+		ManualClock::advance( std::chrono::milliseconds( 60 ) );
+		source.get( 2, []() { return 20; } );
+
+		std::stringstream snapshot;
+		EXPECT_EQ( source.saveSnapshot( snapshot ), 2 );
+
+		// Downtime between save and load does not count
+		ManualClock::advance( std::chrono::seconds( 10 ) );
+
+		ManualClockCache<int, int> restored( options );
+		EXPECT_EQ( restored.loadSnapshot( snapshot ), 2 );
+		EXPECT_EQ( restored.memoryUsage(), 14 );
+
+		ManualClock::advance( std::chrono::milliseconds( 30 ) );
+		restored.cleanupExpired();
+		EXPECT_EQ( restored.size(), 2 );
+
+		ManualClock::advance( std::chrono::milliseconds( 20 ) );
+		restored.cleanupExpired();
+		EXPECT_EQ( restored.size(), 1 );
+		EXPECT_EQ( restored.find( 1 ), nullptr );
+		EXPECT_NE( restored.find( 2 ), nullptr );
+	}
+
+	TEST( LruCacheSnapshot, ResumesAbsoluteExpiration )
+	{
+		auto options = LruCacheOptions{ 0, std::chrono::milliseconds( 50 ) }.setAbsoluteExpiration( std::chrono::milliseconds( 100 ) ).setExpirationMode( ExpirationMode::SlidingAndAbsolute );
+
+		ManualClockCache<int, int> source( options );
+		source.get( 1, []() { return 10; } );
+		source.get( 2, []() { return 20; }, []( CacheEntry& entry ) { entry.expirationMode = ExpirationMode::Absolute; } );
+		ManualClock::advance( std::chrono::milliseconds( 40 ) );
+		EXPECT_NE( source.find( 1 ), nullptr );
+
+		std::stringstream snapshot;
+		EXPECT_EQ( source.saveSnapshot( snapshot ), 2 );
+		ManualClock::advance( std::chrono::seconds( 10 ) );
+
+		// Key 2 outlives its sliding expiration, and absolute deadlines count the age saved with each value
+		ManualClockCache<int, int> restored( LruCacheOptions{ 0, std::chrono::hours( 1 ) } );
+		EXPECT_EQ( restored.loadSnapshot( snapshot ), 2 );
+
+		ManualClock::advance( std::chrono::milliseconds( 40 ) );
+		EXPECT_NE( restored.find( 1 ), nullptr );
+		EXPECT_NE( restored.find( 2 ), nullptr );
+
+		ManualClock::advance( std::chrono::milliseconds( 30 ) );
+		restored.cleanupExpired();
+		EXPECT_TRUE( restored.isEmpty() );
+	}
+
+	TEST( LruCacheSnapshot, SkipsRecordsBeyondSizeLimit )
+	{
+		LruCache<int, int> source;
+		for ( int i{ 0 }; i < 10; ++i )
+		{
+			source.get( i, [i]() { return i * i; } );
+		}
+
+		std::stringstream snapshot;
+		EXPECT_EQ( source.saveSnapshot( snapshot ), 10 );
+
+		LruCacheOptions options;
+		options.setSizeLimit( 4 );
+		LruCache<int, int, std::hash<int>, std::equal_to<int>, NodeIndex, LruPolicy, SteadyClock, StripedStats> restored( options );
+
+		EXPECT_EQ( restored.loadSnapshot( snapshot ), 4 );
+		EXPECT_EQ( restored.stats().evictions, 0 );
+		for ( int i{ 6 }; i < 10; ++i )
+		{
+			ASSERT_NE( restored.find( i ), nullptr );
+			EXPECT_EQ( *restored.find( i ), i * i );
+		}
+	}
+
+	TEST( LruCacheSnapshot, KeepsCachedValues )
+	{
+		LruCache<std::string, std::string> source;
+		source.get( "shared", []() { return std::string{ "snapshot" }; } );
+		source.get( "extra", []() { return std::string{ "snapshot" }; } );
+
+		std::stringstream snapshot;
+		source.saveSnapshot( snapshot );
+
+		LruCache<std::string, std::string> restored;
+		restored.get( "shared", []() { return std::string{ "live" }; } );
+
+		EXPECT_EQ( restored.loadSnapshot( snapshot ), 1 );
+		EXPECT_EQ( *restored.find( "shared" ), "live" );
+		EXPECT_EQ( *restored.find( "extra" ), "snapshot" );
+	}
+
+	TEST( LruCacheSnapshot, SkipsKeysBeingLoaded )
+	{
+		LruCache<int, int> source;
+		source.get( 1, []() { return 10; } );
+		source.get( 2, []() { return 20; } );
+
+		std::stringstream snapshot;
+		source.saveSnapshot( snapshot );
+
+		LruCache<int, int> restored;
+		std::promise<void> started;
+		std::promise<void> release;
+		std::shared_future<void> released{ release.get_future().share() };
+
+		std::thread loader{ [&]() {
+			restored.get( 1, [&]() {
+				started.set_value();
+				released.wait();
+				return 11;
+			} );
+		} };
+
+		// The load of key 1 is in flight: the snapshot leaves it to the factory
+		started.get_future().wait();
+		EXPECT_EQ( restored.loadSnapshot( snapshot ), 1 );
+		release.set_value();
+		loader.join();
+
+		EXPECT_EQ( restored.size(), 2 );
+		EXPECT_EQ( *restored.find( 1 ), 11 );
+		EXPECT_TRUE( restored.remove( 1 ) );
+		EXPECT_EQ( restored.find( 1 ), nullptr );
+		EXPECT_EQ( restored.size(), 1 );
+	}
+
+	TEST( LruCacheSnapshot, UsesCustomSerializers )
+	{
+		LruCache<int, Samples> source;
+		source.get( 1, []() { return Samples{ { 1, 2, 3 } }; } );
+		source.get( 2, []() { return Samples{}; } );
+
+		std::stringstream snapshot;
+		source.saveSnapshot<SnapshotSerializer<int>, SamplesSerializer>( snapshot );
+
+		LruCache<int, Samples> restored;
+		EXPECT_EQ( ( restored.loadSnapshot<SnapshotSerializer<int>, SamplesSerializer>( snapshot ) ), 2 );
+		EXPECT_EQ( restored.find( 1 )->values, ( std::vector<std::int32_t>{ 1, 2, 3 } ) );
+		EXPECT_TRUE( restored.find( 2 )->values.empty() );
+	}
+
+	TEST( LruCacheSnapshot, LoadsLargeSnapshotInParallel )
+	{
+		constexpr int entries{ 50000 };
+
+		LruCacheOptions options;
+		options.setSizeLimit( entries );
+
+		LruCache<int, std::string, std::hash<int>, std::equal_to<int>, FlatIndex> source( options );
+		for ( int i{ 0 }; i < entries; ++i )
+		{
+			source.get( i, [i]() { return std::to_string( i ); } );
+		}
+
+		const std::filesystem::path path{ std::filesystem::temp_directory_path() / "nfx_lrucache_snapshot_test.bin" };
+		EXPECT_EQ( source.saveSnapshot( path ), entries );
+		EXPECT_FALSE( std::filesystem::exists( path.string() + ".tmp" ) );
+
+		LruCache<int, std::string, std::hash<int>, std::equal_to<int>, FlatIndex> restored( options );
+		EXPECT_EQ( restored.loadSnapshot( path, 4 ), entries );
+		std::filesystem::remove( path );
+
+		for ( int i{ 0 }; i < entries; i += 997 )
+		{
+			ASSERT_NE( restored.find( i ), nullptr );
+			EXPECT_EQ( *restored.find( i ), std::to_string( i ) );
+		}
+
+		// Insertion order was kept: the oldest entry not read above is the next victim
+		restored.get( entries, []() { return std::string{}; } );
+		EXPECT_EQ( restored.find( 1 ), nullptr );
+		EXPECT_NE( restored.find( 2 ), nullptr );
+	}
+
+	TEST( LruCacheSnapshot, RejectsInvalidSnapshots )
+	{
+		LruCache<int, int> cache;
+
+		std::stringstream foreign{ "definitely not a cache snapshot" };
+		EXPECT_THROW( cache.loadSnapshot( foreign ), std::runtime_error );
+
+		LruCache<int, int> source;
+		source.get( 1, []() { return 1; } );
+		source.get( 2, []() { return 2; } );
+
+		std::stringstream snapshot;
+		source.saveSnapshot( snapshot );
+		const std::string bytes{ snapshot.str() };
+
+		std::stringstream truncated{ bytes.substr( 0, bytes.size() - 3 ) };
+		EXPECT_THROW( cache.loadSnapshot( truncated ), std::runtime_error );
+
+		// Counts and lengths from a corrupt file are checked before anything is allocated for them
+		const std::uint64_t count{ std::numeric_limits<std::uint64_t>::max() };
+		std::string hugeCount{ bytes };
+		std::memcpy( hugeCount.data() + 16, &count, sizeof( count ) );
+		std::stringstream corruptCount{ hugeCount };
+		EXPECT_THROW( cache.loadSnapshot( corruptCount ), std::runtime_error );
+
+		const std::uint32_t length{ std::numeric_limits<std::uint32_t>::max() };
+		std::string hugeRecord{ bytes };
+		std::memcpy( hugeRecord.data() + 24 + offsetof( SnapshotRecord, keyBytes ), &length, sizeof( length ) );
+		std::stringstream corruptRecord{ hugeRecord };
+		EXPECT_THROW( cache.loadSnapshot( corruptRecord ), std::runtime_error );
+
+		EXPECT_THROW( cache.loadSnapshot( std::filesystem::path{ "/nonexistent/snapshot.bin" } ), std::runtime_error );
+	}
+} // namespace nfx::cache::test